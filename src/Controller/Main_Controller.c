@@ -13,9 +13,42 @@
 #include "Main_Controller.h"
 #include <stdio.h>
 #include <string.h>
+#include <time.h>
 #include "Err_Log.h"
+#include "Help_Screen.h"
+#include "Patch_File.h"
+#include "Signature_List.h"
 
 //* ---------------------------- Globale Konstanten oder Defines --------------------------
+// Vorwärtsdeklarationen der Helferfunktionen
+static void save_as(Main_Controller *self);
+static void reload(Main_Controller *self);
+static void start_watch(Main_Controller *self);
+static int watch_file(Main_Controller *self);
+static int watch_compare(Main_Controller *self);
+static int follow_file(DataBuffer *buffer, FileWatch *watch, const FileSignature *before);
+static void undo_redo(Main_Controller *self, int redo);
+static void jump_difference(Main_Controller *self, int backward);
+static void jump_change(Main_Controller *self, int backward);
+static void prompt_search(Main_Controller *self);
+static void find_match(Main_Controller *self, int backward);
+static void find_bit_match(Main_Controller *self, int backward);
+static void show_signatures(Main_Controller *self);
+static void show_digest(Main_Controller *self);
+static void prompt_range_op(Main_Controller *self);
+static void export_patch(Main_Controller *self);
+static void choose_view(Main_Controller *self);
+static int scan_signatures(Main_Controller *self);
+static int scan_map(Main_Controller *self);
+static void jump_region(Main_Controller *self);
+static void click(Main_Controller *self);
+static void prefetch_ahead(Main_Controller *self);
+static int poll_source(Main_Controller *self);
+static int input_pending(WINDOW *win);
+static int drain_input(Main_Controller *self, WINDOW *win);
+static int opens_dialog(const Main_Controller *self, int key);
+static long elapsed_ms(const struct timespec *since);
+static void draw_frame(Main_Controller *self);
 
 //* ------------------------------------- Funktionen --------------------------------------
 /**
@@ -31,6 +64,7 @@ void main_controller_handle_input(Main_Controller *self, int key) {
     int row_count = getmaxy(self->view.editor.win) - 3;       // nutzbare Zeilen ohne Rahmen und Kopfzeile
     int bytes_per_line = getBytesPerLine(&self->view.editor); // Bytes pro Zeile ermitteln
     size_t page = (size_t)row_count * (size_t)bytes_per_line; // Bytes, die eine Seite umfasst
+    bottom_bar_clear_message(&self->view.bottom_bar);         // Meldung gilt bis zur nächsten Taste
 
     // Tastatureingabe auswerten und passende Aktion ausführen
     switch (key) {
@@ -61,28 +95,113 @@ void main_controller_handle_input(Main_Controller *self, int key) {
         break;
     case KEY_NPAGE: // Bild nach unten
         // Eine Seite weiter scrollen
-        editor_scroll(&self->view.editor, (int)page);
+        editor_scroll(&self->view.editor, (long long)page);
         self->view.editor.hex_pending = -1;
         break;
     case KEY_PPAGE: // Bild nach oben
         // Eine Seite zurück scrollen
-        editor_scroll(&self->view.editor, -(int)page);
+        editor_scroll(&self->view.editor, -(long long)page);
         self->view.editor.hex_pending = -1;
         break;
+    case KEY_IC: // Einfügetaste wechselt zwischen Einfügen und Überschreiben
+        editor_toggle_insert_mode(&self->view.editor);
+        break;
+    case KEY_DC: // Entfernen löscht das Byte unter dem Cursor
+        editor_delete_byte(&self->view.editor, 0);
+        break;
+    case KEY_BACKSPACE: // Rücktaste löscht das Byte vor dem Cursor
+    case 127:
+    case '\b':
+        editor_delete_byte(&self->view.editor, 1);
+        break;
     case KEY_F(1): // Anzeige zwischen Hex und Binär umschalten
-        editor_toggle_display_mode(&self->view.editor);      // Modus wechseln
-        main_window_draw(&self->view);                       // Ansicht neu zeichnen
+        editor_toggle_display_mode(&self->view.editor);      // Modus wechseln, gezeichnet wird mit dem nächsten Bild
         break;
     case KEY_F(2): // Datei speichern
-        // Änderungen auf Datenträger schreiben, Fehler sind fatal
+        if (data_buffer_is_stream(&self->buffer)) {
+            save_as(self);                                   // Strom braucht ein Ziel
+            break;
+        }
+        // Änderungen auf Datenträger schreiben, Schreibfehler sind fatal
         if (data_buffer_save_file(&self->buffer, self->file_path) == 0) {
-            printf("File %s saved\n", self->file_path);
+            if (self->watching) {
+                file_watch_sync(&self->watch);               // eigene Änderung nicht melden
+            }
+            bottom_bar_set_message(&self->view.bottom_bar, "File saved");
+        } else {
+            bottom_bar_set_message(&self->view.bottom_bar,
+                                   "File changed on disk, not saved (F3 reloads, F4 saves elsewhere)");
         }
         break;
     case KEY_F(3): // Änderungen verwerfen und neu laden
-        // Datei erneut laden und Editor zurücksetzen
-        data_buffer_load_file(&self->buffer, self->file_path);
-        editor_reset(&self->view.editor);                    // Editor-Ansicht zurücksetzen
+        if (data_buffer_is_stream(&self->buffer)) {
+            bottom_bar_set_message(&self->view.bottom_bar, "A stream cannot be reloaded");
+            break;
+        }
+        reload(self);                                        // Ansicht und Cursor bleiben
+        break;
+    case KEY_F(4): // unter neuem Namen speichern
+        save_as(self);
+        break;
+    case KEY_F(5): // letzten Bearbeitungsschritt zurücknehmen
+        undo_redo(self, 0);
+        break;
+    case KEY_F(6): // zurückgenommenen Schritt wiederholen
+        undo_redo(self, 1);
+        break;
+    case KEY_F(7): // Ansicht am Dateiende halten
+        main_controller_set_follow(self, !self->view.editor.follow);
+        bottom_bar_set_message(&self->view.bottom_bar,
+                               self->view.editor.follow ? "Follow on" : "Follow off");
+        break;
+    case KEY_F(9): // nächster Unterschied zur Vergleichsdatei
+        jump_difference(self, 0);
+        break;
+    case KEY_F(10): // vorheriger Unterschied zur Vergleichsdatei
+        jump_difference(self, 1);
+        break;
+    case CONTROLLER_KEY_NEXT_CHANGE: // nächster seit Laden/Speichern geänderter Bereich
+        jump_change(self, 0);
+        break;
+    case CONTROLLER_KEY_PREV_CHANGE: // vorheriger geänderter Bereich
+        jump_change(self, 1);
+        break;
+    case KEY_F(8): // Muster eingeben und vorwärts suchen
+        prompt_search(self);
+        break;
+    case CONTROLLER_KEY_FIND_NEXT: // nächster Treffer
+        find_match(self, 0);
+        break;
+    case CONTROLLER_KEY_FIND_PREV: // vorheriger Treffer
+        find_match(self, 1);
+        break;
+    case KEY_F(11): // Signatursatz laden oder Ergebnisliste zeigen
+        show_signatures(self);
+        break;
+    case CONTROLLER_KEY_SELECT: // Auswahl am Cursor beginnen oder aufheben
+        editor_toggle_selection(&self->view.editor);
+        break;
+    case CONTROLLER_KEY_DIGEST: // nächste Prüfsumme der Auswahl oder Datei
+        show_digest(self);
+        break;
+    case CONTROLLER_KEY_RANGE_OP: // Auswahl füllen, verknüpfen, drehen oder umkehren
+        prompt_range_op(self);
+        break;
+    case CONTROLLER_KEY_EXPORT_PATCH: // Änderungen als IPS, BPS oder Liste speichern
+        export_patch(self);
+        break;
+    case CONTROLLER_KEY_VALUE_VIEW: // Datenbereich als u16 bis f64 zeigen
+        choose_view(self);
+        break;
+    case CONTROLLER_KEY_HELP: // alle Tasten zeigen
+        help_screen_run();
+        main_window_invalidate(&self->view);              // Übersicht hat alle Bereiche überdeckt
+        break;
+    case CONTROLLER_KEY_NEXT_REGION: // zum nächsten Bereich anderer Byteklasse
+        jump_region(self);
+        break;
+    case KEY_MOUSE: // Klick in die Übersicht springt dorthin
+        click(self);
         break;
     default: // reguläre Zeicheneingabe
         editor_handle_char(&self->view.editor, key);
@@ -90,9 +209,76 @@ void main_controller_handle_input(Main_Controller *self, int key) {
     }
 }
 
+/**
+ * @brief Schaltet das Mitlaufen am Ende wachsender Dateien ein oder aus.
+ *
+ * Beim Einschalten springt die Ansicht sofort ans Ende. Danach rückt
+ * sie mit jedem Zuwachs von Datei oder Datenstrom nach.
+ *
+ * @param self   Zeiger auf den Controller
+ * @param follow 1 = Ansicht bleibt am Dateiende
+ */
+void main_controller_set_follow(Main_Controller *self, int follow) {
+    self->view.editor.follow = follow;
+    if (follow) {
+        editor_show_end(&self->view.editor);
+    }
+}
+
+/**
+ * @brief Begrenzt die Bildrate der Anzeige.
+ *
+ * Änderungen zwischen zwei Bildern werden nicht einzeln gezeichnet;
+ * das nächste Bild zeigt immer den neuesten Stand.
+ *
+ * @param self Zeiger auf den Controller
+ * @param fps  höchstens so viele Bilder je Sekunde, 0 = unbegrenzt
+ */
+void main_controller_set_fps(Main_Controller *self, int fps) {
+    self->frame_interval_ms = (fps > 0) ? 1000 / fps : 0;
+}
+
+/**
+ * @brief Lädt einen Signatursatz und startet die Suche im Hintergrund.
+ *
+ * Durchsucht wird zwischen den Eingaben in der Hauptschleife; die
+ * Ergebnisliste zeigt jederzeit den bisherigen Stand.
+ *
+ * @param self Zeiger auf den Controller
+ * @param path Pfad der Signaturdatei
+ * @return 0 bei Erfolg, sonst die fehlerhafte Zeile oder -1
+ */
+int main_controller_load_signatures(Main_Controller *self, const char *path) {
+    SignatureScan loaded;
+    int result = signature_scan_init(&loaded, path, &self->buffer);
+    char message[128];
+    if (result > 0) {
+        snprintf(message, sizeof(message), "Invalid signature in line %d", result);
+    } else if (result < 0) {
+        snprintf(message, sizeof(message), "Cannot read signatures: %s", path);
+    } else {
+        if (self->has_signatures) {
+            signature_scan_deinit(&self->signatures); // bisherigen Satz ersetzen
+        }
+        self->signatures = loaded;
+        self->has_signatures = 1;
+        self->signature_selected = 0;
+        snprintf(message, sizeof(message), "Scanning for %zu signatures (F11: results)",
+                 loaded.count);
+    }
+    bottom_bar_set_message(&self->view.bottom_bar, message);
+    return result;
+}
+
 /**
  * @brief Startet die Hauptschleife des Controllers.
  *
+ * Eingaben, Datenströme und Hintergrundarbeit ändern nur den Stand von
+ * Model und Ansicht. Gezeichnet wird getrennt davon, sobald das nächste
+ * Bild fällig ist; bis dahin wartet `wgetch` höchstens so lange. Bilder
+ * dazwischen entfallen, sodass eine langsame Ausgabe die Verarbeitung
+ * der Eingaben nicht aufhält.
+ *
  * @param self Zeiger auf den Controller
  * @return 0 bei normalem Ende
  */
@@ -101,31 +287,936 @@ int main_controller_run(Main_Controller *self) {
     printf("TinyHexa is running file: %s\n", self->file_path);
 
     // Anfangszustand der Oberfläche zeichnen
-    main_window_draw(&self->view);
+    draw_frame(self);
 
     // Hauptschleife: Eingaben lesen bis F12 gedrückt wird
-    int input_key;
-    while ((input_key = wgetch(self->view.editor.win)) != KEY_F(12)) {
-        main_controller_handle_input(self, input_key); // Eingabe verarbeiten
-        main_window_draw(&self->view);                 // Anzeige aktualisieren
+    WINDOW *win = self->view.editor.win;
+    while (1) {
+        // Datenströme, Ladevorgänge und die Datei regelmäßig abfragen, sonst blockierend warten
+        int poll = data_buffer_needs_poll(&self->buffer) || self->watching || self->compare_watching ||
+                   (self->comparing && data_buffer_needs_poll(&self->compare_buffer));
+        byte_map_sync(&self->map);                         // Bearbeitungen für die Übersicht vormerken
+        int scanning = (self->has_signatures && signature_scan_pending(&self->signatures)) ||
+                       byte_map_pending(&self->map);
+        long timeout = scanning ? 0 : (poll ? CONTROLLER_POLL_MS : -1); // Suche läuft ohne Warten
+        if (self->frame_pending) {
+            long wait = -elapsed_ms(&self->next_frame);   // bis das nächste Bild fällig ist
+            wait = (wait > 0) ? wait : 0;
+            timeout = (timeout < 0 || wait < timeout) ? wait : timeout;
+        }
+        wtimeout(win, (int)timeout);
+        int input_key = wgetch(win);
+        if (input_key == KEY_F(12)) {
+            break;                                         // Programm beenden
+        }
+        if (input_key != ERR && self->frame_pending && opens_dialog(self, input_key)) {
+            draw_frame(self);                              // Dialog über dem aktuellen Stand
+        }
+        int changed = (input_key != ERR);
+        if (changed) {
+            main_controller_handle_input(self, input_key); // Eingabe verarbeiten
+            if (drain_input(self, win)) {
+                break;                                     // F12 lag schon im Vorlauf
+            }
+        }
+        changed |= poll_source(self);                      // neue Bytes oder Fortschritt
+        changed |= watch_file(self);                       // Änderungen anderer Anwendungen
+        changed |= watch_compare(self);
+        changed |= scan_signatures(self);                  // Signatursuche fortsetzen
+        changed |= scan_map(self);                         // Übersicht fortsetzen
+        self->frame_pending |= changed;
+        if (self->frame_pending && elapsed_ms(&self->next_frame) >= 0) {
+            draw_frame(self);                              // neuesten Stand zeichnen
+            prefetch_ahead(self);                          // Wartezeit zum Vorausladen nutzen
+        }
     }
 
     return 0; // reguläres Ende
 }
 
 //* ---------------------------------- Helfer Funktionen ----------------------------------
+/**
+ * @brief Fragt einen Zielpfad ab und speichert den Inhalt dorthin.
+ *
+ * Bei Erfolg arbeitet der Controller anschließend mit dem neuen Pfad
+ * weiter. Fehler werden nur gemeldet, die Bearbeitung bleibt erhalten.
+ * Wurde die Datei mit ungespeicherten Änderungen von außen verändert,
+ * können unveränderte Bytes schon aus ihrem neuen Stand stammen; dann
+ * wird vorher nachgefragt.
+ *
+ * @param self Zeiger auf den Controller
+ */
+static void save_as(Main_Controller *self) {
+    char path[sizeof(self->file_path)];                  // Eingabe-Buffer
+    memcpy(path, self->file_path, sizeof(path));         // aktuellen Pfad vorschlagen
+    if (data_buffer_is_stream(&self->buffer)) {
+        path[0] = '\0';                                   // Strom hat keinen Dateipfad
+    }
+    if (self->buffer.source_stale) {                     // unveränderte Bytes evtl. schon fremd
+        char answer[4] = "";
+        if (bottom_bar_prompt(&self->view.bottom_bar, "Unedited bytes may be from the changed file. Save? (y/n): ",
+                              answer, sizeof(answer)) != 0 ||
+            (answer[0] != 'y' && answer[0] != 'Y')) {
+            bottom_bar_set_message(&self->view.bottom_bar, "Not saved, F3 reloads the changed file");
+            return;
+        }
+    }
+    if (bottom_bar_prompt(&self->view.bottom_bar, "Save as: ", path, sizeof(path)) != 0) {
+        return;                                          // abgebrochen
+    }
+    if (data_buffer_save_as(&self->buffer, path) != 0) {
+        bottom_bar_set_message(&self->view.bottom_bar, "Save as failed");
+        return;
+    }
+    memcpy(self->file_path, path, sizeof(self->file_path)); // neuen Pfad übernehmen
+    start_watch(self);                                      // ab jetzt die neue Datei überwachen
+    bottom_bar_set_message(&self->view.bottom_bar, "File saved");
+}
+
+/**
+ * @brief Lädt die Datei neu, ohne Ansicht und Cursor zu verlieren.
+ *
+ * Die Backends lesen nur die Blöcke, die tatsächlich angezeigt werden;
+ * unveränderte Bereiche außerhalb der Ansicht kosten beim Neuladen
+ * nichts. Ist die Datei kürzer geworden, wird der Cursor begrenzt.
+ *
+ * @param self Zeiger auf den Controller
+ */
+static void reload(Main_Controller *self) {
+    Editor *editor = &self->view.editor;
+    size_t cursor = idx(editor, editor->cursor_y, editor->cursor_x); // Position vor dem Laden
+    size_t start = editor->start_offset;
+    data_buffer_load_file(&self->buffer, self->file_path); // Fehler sind fatal
+    editor->strategy->reset_pending(editor);
+    editor->start_offset = start;                           // Ansicht beibehalten
+    if (editor->follow) {
+        editor_show_end(editor);
+    } else {
+        editor_jump_to(editor, cursor);                     // scrollt nur, wenn nötig
+    }
+    if (self->watching) {
+        file_watch_sync(&self->watch);                      // geladener Stand ist bekannt
+    }
+}
+
+/**
+ * @brief Beginnt die Überwachung der aktuellen Datei.
+ *
+ * Datenströme haben keinen Dateizustand und werden nicht überwacht.
+ *
+ * @param self Zeiger auf den Controller
+ */
+static void start_watch(Main_Controller *self) {
+    if (self->watching) {
+        file_watch_deinit(&self->watch);
+        self->watching = 0;
+    }
+    if (data_buffer_is_stream(&self->buffer)) {
+        return;
+    }
+    self->watching = (file_watch_init(&self->watch, self->file_path) == 0);
+}
+
+/**
+ * @brief Reagiert auf Änderungen anderer Anwendungen an der Datei.
+ *
+ * Wurde nur angehängt, werden allein die neuen Bytes übernommen. Sonst
+ * wird die Datei mit erhaltener Ansicht neu geladen, sofern keine
+ * ungespeicherten Änderungen verloren gingen. Andernfalls erscheint ein
+ * Hinweis, und wurde die Datei an Ort und Stelle geändert oder gekürzt,
+ * liest der Buffer nicht länger aus ihrer Einblendung: Die Bearbeitungen
+ * bleiben erhalten, statt dass ein Zugriff hinter dem neuen Ende das
+ * Programm beendet.
+ *
+ * @param self Zeiger auf den Controller
+ * @return 1 wenn neu gezeichnet werden muss, sonst 0
+ */
+static int watch_file(Main_Controller *self) {
+    if (!self->watching) {
+        return 0;
+    }
+    FileSignature before = self->watch.known;               // Stand vor dieser Änderung
+    FileWatchEvent event = file_watch_poll(&self->watch);
+    if (event == FILE_WATCH_NONE) {
+        return 0;
+    }
+    if (event == FILE_WATCH_GONE) {
+        bottom_bar_set_message(&self->view.bottom_bar, "File was deleted on disk");
+        return 1;
+    }
+    if (event == FILE_WATCH_GROWN && file_watch_is_file(&self->watch, self->buffer.source.fd)) {
+        int result = follow_file(&self->buffer, &self->watch, &before);
+        if (result >= 0) {                                  // nur angehängt
+            if (result > 0 && self->view.editor.follow) {
+                editor_show_end(&self->view.editor);
+            }
+            return result > 0;
+        }
+    }
+    if (self->buffer.edited) {
+        if (event != FILE_WATCH_REPLACED) {
+            data_buffer_detach(&self->buffer);              // dieselbe Datei wurde verändert
+        }
+        bottom_bar_set_message(&self->view.bottom_bar, event == FILE_WATCH_REPLACED
+                                                           ? "File changed on disk, F3 reloads"
+                                                           : "File changed on disk, unedited bytes may differ, F3 reloads");
+        return 1;
+    }
+    reload(self);
+    bottom_bar_set_message(&self->view.bottom_bar, "File reloaded");
+    return 1;
+}
+
+/**
+ * @brief Reagiert auf Änderungen anderer Anwendungen an der Vergleichsdatei.
+ *
+ * Die Vergleichsdatei wird nie bearbeitet und deshalb wie die Datei
+ * ohne Änderungen behandelt: Angehängte Bytes werden übernommen, sonst
+ * wird sie neu geladen. Die Unterschiede folgen dem neuen Stand.
+ *
+ * @param self Zeiger auf den Controller
+ * @return 1 wenn neu gezeichnet werden muss, sonst 0
+ */
+static int watch_compare(Main_Controller *self) {
+    if (!self->compare_watching) {
+        return 0;
+    }
+    FileSignature before = self->compare_watch.known;
+    FileWatchEvent event = file_watch_poll(&self->compare_watch);
+    if (event == FILE_WATCH_NONE) {
+        return 0;
+    }
+    if (event == FILE_WATCH_GONE) {
+        bottom_bar_set_message(&self->view.bottom_bar, "Compare file was deleted on disk");
+        return 1;
+    }
+    if (event == FILE_WATCH_GROWN &&
+        file_watch_is_file(&self->compare_watch, self->compare_buffer.source.fd) &&
+        follow_file(&self->compare_buffer, &self->compare_watch, &before) >= 0) {
+        return 1;                                           // nur angehängt
+    }
+    data_buffer_load_file(&self->compare_buffer, self->compare_path); // Fehler sind fatal
+    file_watch_sync(&self->compare_watch);
+    bottom_bar_set_message(&self->view.bottom_bar, "Compare file reloaded");
+    return 1;
+}
+
+/**
+ * @brief Übernimmt angehängte Bytes und das neue Kennzeichen der Datei.
+ *
+ * Kannte der Buffer den Stand vor dem Anhängen, gilt der neue Stand als
+ * bekannt, sonst würde jedes spätere Speichern als fremde Änderung
+ * abgelehnt. Wurde die Datei vorher schon an Ort und Stelle verändert,
+ * bleibt das alte Kennzeichen stehen und das Speichern weiter gesperrt.
+ *
+ * @param buffer Buffer der Datei
+ * @param watch  Überwachung der Datei, bereits abgefragt
+ * @param before Kennzeichen vor der Abfrage
+ * @return Ergebnis von `data_buffer_follow`
+ */
+static int follow_file(DataBuffer *buffer, FileWatch *watch, const FileSignature *before) {
+    int result = data_buffer_follow(buffer);
+    const FileSignature *disk = &buffer->disk;
+    if (result > 0 && disk->exists && disk->device == before->device && disk->inode == before->inode &&
+        disk->size == before->size && disk->mtime_ns == before->mtime_ns) {
+        buffer->disk = watch->known; // nur angehängt: eigener Stand bleibt gültig
+    }
+    return result;
+}
+
+/**
+ * @brief Nimmt einen Bearbeitungsschritt zurück oder wiederholt ihn.
+ *
+ * Der Cursor springt an die Stelle der Bearbeitung, eine angefangene
+ * Eingabe wird verworfen.
+ *
+ * @param self Zeiger auf den Controller
+ * @param redo 1 = wiederholen, 0 = zurücknehmen
+ */
+static void undo_redo(Main_Controller *self, int redo) {
+    size_t position = 0;
+    int result = redo ? data_buffer_redo(&self->buffer, &position)
+                      : data_buffer_undo(&self->buffer, &position);
+    if (result != 0) {
+        bottom_bar_set_message(&self->view.bottom_bar,
+                               redo ? "Nothing to redo" : "Nothing to undo");
+        return;
+    }
+    self->view.editor.strategy->reset_pending(&self->view.editor);
+    editor_jump_to(&self->view.editor, position);
+}
+
+/**
+ * @brief Springt zum nächsten oder vorherigen Unterschied zur Vergleichsdatei.
+ *
+ * Der Cursor landet auf dem ersten abweichenden Byte, die Meldung
+ * nennt Position und Länge des Unterschieds.
+ *
+ * @param self     Zeiger auf den Controller
+ * @param backward 1 = vorheriger, 0 = nächster Unterschied
+ */
+static void jump_difference(Main_Controller *self, int backward) {
+    if (!self->comparing) {
+        bottom_bar_set_message(&self->view.bottom_bar, "No file to compare");
+        return;
+    }
+    Editor *editor = &self->view.editor;
+    size_t cursor = idx(editor, editor->cursor_y, editor->cursor_x);
+    DiffRange range;
+    int result = backward ? diff_index_prev(&self->diff, cursor, &range)
+                          : diff_index_next(&self->diff, cursor, &range);
+    if (result != 0) {
+        bottom_bar_set_message(&self->view.bottom_bar,
+                               backward ? "No previous difference" : "No further difference");
+        return;
+    }
+    editor->strategy->reset_pending(editor);
+    editor_jump_to(editor, range.start);
+    char message[64];
+    snprintf(message, sizeof(message), "Difference at %llx, %llu bytes",
+             (unsigned long long)range.start, (unsigned long long)(range.end - range.start));
+    bottom_bar_set_message(&self->view.bottom_bar, message);
+}
+
+/**
+ * @brief Springt zum nächsten oder vorherigen Bereich geänderter Bytes.
+ *
+ * Vorwärts wird ein Bereich unter dem Cursor übersprungen, rückwärts
+ * landet der Cursor am Anfang des Bereichs vor ihm. Jede Suche kostet
+ * nur wenige Wortzugriffe je Stufe der Bitmap.
+ *
+ * @param self     Zeiger auf den Controller
+ * @param backward 1 = vorheriger, 0 = nächster Bereich
+ */
+static void jump_change(Main_Controller *self, int backward) {
+    const ChangeBitmap *modified = &self->buffer.modified;
+    Editor *editor = &self->view.editor;
+    size_t cursor = idx(editor, editor->cursor_y, editor->cursor_x);
+    size_t start;
+    if (backward) {
+        size_t last = change_bitmap_prev(modified, cursor, 1);
+        start = last;
+        if (last != CHANGE_BITMAP_NONE) {
+            size_t before = change_bitmap_prev(modified, last, 0); // Anfang dieses Bereichs
+            start = (before == CHANGE_BITMAP_NONE) ? 0 : before + 1;
+        }
+    } else {
+        size_t after = change_bitmap_test(modified, cursor) ? change_bitmap_next(modified, cursor, 0)
+                                                           : cursor;
+        start = (after == CHANGE_BITMAP_NONE) ? after : change_bitmap_next(modified, after, 1);
+    }
+    if (start == CHANGE_BITMAP_NONE) {
+        bottom_bar_set_message(&self->view.bottom_bar,
+                               backward ? "No previous change" : "No further change");
+        return;
+    }
+    size_t end = change_bitmap_next(modified, start, 0);
+    if (end == CHANGE_BITMAP_NONE) {
+        end = self->buffer.size;
+    }
+    editor->strategy->reset_pending(editor);
+    editor_jump_to(editor, start);
+    char message[96];
+    snprintf(message, sizeof(message), "Change at %llx, %llu bytes (%llu changed in total)",
+             (unsigned long long)start, (unsigned long long)(end - start),
+             (unsigned long long)change_bitmap_count(modified));
+    bottom_bar_set_message(&self->view.bottom_bar, message);
+}
+
+/**
+ * @brief Fragt ein Suchmuster ab und springt zum nächsten Treffer.
+ *
+ * Das letzte Muster wird zur Bearbeitung vorgeschlagen. Beginnt die
+ * Eingabe mit `%`, folgt ein Bitmuster, das an jeder Bitposition
+ * gesucht wird.
+ *
+ * @param self Zeiger auf den Controller
+ */
+static void prompt_search(Main_Controller *self) {
+    char text[sizeof(self->search_text)];
+    memcpy(text, self->search_text, sizeof(text));
+    if (bottom_bar_prompt(&self->view.bottom_bar, "Find: ", text, sizeof(text)) != 0) {
+        return;                                          // abgebrochen
+    }
+    int bits = (text[0] == '%');                         // Bitmuster statt Bytes
+    int result = bits ? bit_search_parse(&self->bit_search, text + 1)
+                      : pattern_search_parse(&self->search, text);
+    if (result != 0) {
+        bottom_bar_set_message(&self->view.bottom_bar, "Invalid pattern");
+        return;
+    }
+    memcpy(self->search_text, text, sizeof(self->search_text));
+    self->searching = 1;
+    self->searching_bits = bits;
+    editor_mark_bits(&self->view.editor, 0, 0);          // alten Treffer vergessen
+    find_match(self, 0);
+}
+
+/**
+ * @brief Springt zum nächsten oder vorherigen Treffer des Suchmusters.
+ *
+ * Vorwärts wird hinter dem Cursor gesucht, damit wiederholtes Suchen
+ * nicht am aktuellen Treffer hängen bleibt.
+ *
+ * @param self     Zeiger auf den Controller
+ * @param backward 1 = vorheriger, 0 = nächster Treffer
+ */
+static void find_match(Main_Controller *self, int backward) {
+    if (!self->searching) {
+        bottom_bar_set_message(&self->view.bottom_bar, "No search pattern (F8)");
+        return;
+    }
+    if (self->searching_bits) {
+        find_bit_match(self, backward);
+        return;
+    }
+    Editor *editor = &self->view.editor;
+    size_t cursor = idx(editor, editor->cursor_y, editor->cursor_x);
+    size_t hit;
+    int result = backward ? pattern_search_prev(&self->buffer, &self->search, cursor, &hit)
+                          : pattern_search_next(&self->buffer, &self->search, cursor + 1, &hit);
+    if (result != 0) {
+        bottom_bar_set_message(&self->view.bottom_bar,
+                               backward ? "No previous match" : "No further match");
+        return;
+    }
+    editor->strategy->reset_pending(editor);
+    editor_jump_to(editor, hit);
+    char message[64];
+    snprintf(message, sizeof(message), "Match at %llx", (unsigned long long)hit);
+    bottom_bar_set_message(&self->view.bottom_bar, message);
+}
+
+/**
+ * @brief Springt zum nächsten oder vorherigen Treffer des Bitmusters.
+ *
+ * Steht der Cursor auf dem Byte des zuletzt hervorgehobenen Treffers,
+ * wird ab dem Bit danach bzw. davor gesucht, sonst ab dem ersten Bit
+ * des Cursorbytes. So werden auch mehrere Treffer in einem Byte
+ * nacheinander gefunden. Der Treffer wird bitgenau hervorgehoben.
+ *
+ * @param self     Zeiger auf den Controller
+ * @param backward 1 = vorheriger, 0 = nächster Treffer
+ */
+static void find_bit_match(Main_Controller *self, int backward) {
+    Editor *editor = &self->view.editor;
+    size_t cursor = idx(editor, editor->cursor_y, editor->cursor_x);
+    uint64_t position = (uint64_t)cursor * 8u;
+    int onMark = editor->mark_bits > 0 && editor->mark_revision == self->buffer.revision &&
+                 editor->mark_bit / 8u == cursor;        // Cursor steht auf dem letzten Treffer
+    if (onMark) {
+        position = editor->mark_bit + (backward ? 0u : 1u);
+    }
+    BitHit hit;
+    int result = backward ? bit_search_prev(&self->buffer, &self->bit_search, position, &hit)
+                          : bit_search_next(&self->buffer, &self->bit_search, position, &hit);
+    if (result != 0) {
+        bottom_bar_set_message(&self->view.bottom_bar,
+                               backward ? "No previous match" : "No further match");
+        return;
+    }
+    editor->strategy->reset_pending(editor);
+    editor_jump_to(editor, hit.offset);
+    editor_mark_bits(editor, bit_hit_position(hit), self->bit_search.length);
+    char message[64];
+    snprintf(message, sizeof(message), "Bit match at %llx.%d", (unsigned long long)hit.offset,
+             hit.shift);
+    bottom_bar_set_message(&self->view.bottom_bar, message);
+}
+
+/**
+ * @brief Lädt einen Signatursatz oder zeigt die Ergebnisliste.
+ *
+ * Ohne geladenen Satz wird nach der Signaturdatei gefragt. In der
+ * Liste gewählte Fundstellen werden wie Suchtreffer angesprungen.
+ *
+ * @param self Zeiger auf den Controller
+ */
+static void show_signatures(Main_Controller *self) {
+    if (!self->has_signatures) {
+        char path[256] = "";
+        if (bottom_bar_prompt(&self->view.bottom_bar, "Signatures: ", path, sizeof(path)) == 0) {
+            main_controller_load_signatures(self, path);
+        }
+        return;
+    }
+    Editor *editor = &self->view.editor;
+    size_t cursor = idx(editor, editor->cursor_y, editor->cursor_x);
+    size_t hit;
+    int result = signature_list_run(&self->signatures, cursor, &self->signature_selected, &hit);
+    main_window_invalidate(&self->view);                 // Liste hat alle Bereiche überdeckt
+    if (result != 0) {
+        return;                                          // geschlossen
+    }
+    editor->strategy->reset_pending(editor);
+    editor_jump_to(editor, hit);
+    char message[64];
+    snprintf(message, sizeof(message), "%s at %llx",
+             self->signatures.signatures[self->signature_selected].name,
+             (unsigned long long)hit);
+    bottom_bar_set_message(&self->view.bottom_bar, message);
+}
+
+/**
+ * @brief Zeigt die nächste Prüfsumme der Auswahl oder der ganzen Datei.
+ *
+ * Der erste Druck zeigt CRC32, jeder weitere für denselben Bereich und
+ * Stand das nächste Verfahren. CRC32 stammt aus dem Prüfsummenbaum, der
+ * nach einer Bearbeitung nur die betroffenen Blöcke neu liest; für die
+ * ganze Datei folgt zuletzt sein Baumwert. MD5 und die SHA-Verfahren
+ * lassen sich nicht aus Blöcken zusammensetzen und werden beim ersten
+ * Bedarf gemeinsam in einem Durchlauf berechnet.
+ *
+ * @param self Zeiger auf den Controller
+ */
+static void show_digest(Main_Controller *self) {
+    size_t start = 0;
+    size_t end = self->buffer.size;
+    int selected = editor_get_selection(&self->view.editor, &start, &end) == 0;
+    int steps = HASH_KIND_COUNT + (selected ? 1 : 2); // CRC32, Verfahren, Baumwert
+    int same = self->digest_step >= 0 && start == self->digest_start &&
+               end == self->digest_end && self->buffer.revision == self->digest_revision;
+    if (!same) {
+        self->digest_valid = 0;
+        self->digest_start = start;
+        self->digest_end = end;
+        self->digest_revision = self->buffer.revision;
+    }
+    int step = same ? (self->digest_step + 1) % steps : 0;
+    self->digest_step = step;
+
+    const char *scope = selected ? "Selection" : "File";
+    const char *nextName = "CRC32";
+    if (step + 1 < steps) {
+        nextName = (step < HASH_KIND_COUNT) ? hash_kind_name((HashKind)step) : "tree";
+    }
+    char hex[2 * HASH_DIGEST_MAX + 1];
+    char message[128];
+    if (step == 0) {
+        size_t rehashed = hash_tree_update(&self->hash_tree);
+        uint32_t crc = hash_tree_crc32(&self->hash_tree, start, end);
+        snprintf(message, sizeof(message), "%s CRC32: %08x (%llu blocks rehashed, Ctrl+D: %s)",
+                 scope, (unsigned int)crc, (unsigned long long)rehashed, nextName);
+    } else if (step <= HASH_KIND_COUNT) {
+        if (!self->digest_valid) {
+            range_digest_compute(&self->buffer, start, end, &self->digest);
+            self->digest_valid = 1;
+        }
+        HashKind kind = (HashKind)(step - 1);
+        hash_digest_hex(self->digest.digests[kind], hash_digest_size(kind), hex);
+        snprintf(message, sizeof(message), "%s %s: %s (Ctrl+D: %s)", scope,
+                 hash_kind_name(kind), hex, nextName);
+    } else {
+        unsigned char root[HASH_TREE_DIGEST];
+        hash_tree_update(&self->hash_tree);
+        hash_tree_root(&self->hash_tree, root);
+        hash_digest_hex(root, sizeof(root), hex);
+        snprintf(message, sizeof(message), "File SHA-256 tree: %s (Ctrl+D: %s)", hex, nextName);
+    }
+    bottom_bar_set_message(&self->view.bottom_bar, message);
+}
+
+/**
+ * @brief Fragt eine Operation ab und wendet sie auf die Auswahl an.
+ *
+ * Die letzte Eingabe wird zur Bearbeitung vorgeschlagen. Die ganze
+ * Operation ist ein Bearbeitungsschritt; neu gezeichnet wird einmal
+ * danach in der Hauptschleife. Passt sie nicht ins Budget des Journals,
+ * wird vorher nachgefragt und danach gemeldet, dass sie nicht
+ * zurückgenommen werden kann.
+ *
+ * @param self Zeiger auf den Controller
+ */
+static void prompt_range_op(Main_Controller *self) {
+    size_t start = 0;
+    size_t end = 0;
+    if (editor_get_selection(&self->view.editor, &start, &end) != 0) {
+        bottom_bar_set_message(&self->view.bottom_bar, "No selection (Ctrl+B)");
+        return;
+    }
+    char text[sizeof(self->range_op_text)];
+    memcpy(text, self->range_op_text, sizeof(text));
+    if (bottom_bar_prompt(&self->view.bottom_bar, "Operation: ", text, sizeof(text)) != 0) {
+        return;                                          // abgebrochen
+    }
+    RangeOp op;
+    if (range_op_parse(&op, text) != 0) {
+        bottom_bar_set_message(&self->view.bottom_bar,
+                               "Usage: fill|xor|and|or|add|sub <hex or \"text>, swap16|32|64, reverse");
+        return;
+    }
+    memcpy(self->range_op_text, text, sizeof(self->range_op_text));
+    if (!range_op_fits_undo(&op, &self->buffer, start, end)) {
+        char answer[4] = "";
+        if (bottom_bar_prompt(&self->view.bottom_bar, "Too large to undo, clears undo history. Apply? (y/n): ",
+                              answer, sizeof(answer)) != 0 ||
+            (answer[0] != 'y' && answer[0] != 'Y')) {
+            bottom_bar_set_message(&self->view.bottom_bar, "Operation cancelled");
+            return;
+        }
+    }
+    size_t done = range_op_apply(&op, &self->buffer, start, end);
+    self->view.editor.strategy->reset_pending(&self->view.editor);
+    char message[128];
+    snprintf(message, sizeof(message), "%s applied to %llu bytes%s", range_op_name(op.kind),
+             (unsigned long long)done,
+             (done > 0 && !data_buffer_can_undo(&self->buffer)) ? ", cannot be undone" : "");
+    bottom_bar_set_message(&self->view.bottom_bar, message);
+}
+
+/**
+ * @brief Fragt nach einem Pfad und speichert die Änderungen als Patch.
+ *
+ * Die Endung wählt das Format: `.ips`, `.bps`, sonst die Liste
+ * `offset: hexbytes`. Der Patch passt auf die Datei, wie sie zuletzt
+ * geladen oder gespeichert wurde.
+ *
+ * @param self Zeiger auf den Controller
+ */
+static void export_patch(Main_Controller *self) {
+    char path[sizeof(self->file_path)];
+    snprintf(path, sizeof(path), "%.*s.bps", (int)sizeof(path) - 5, self->file_path);
+    if (bottom_bar_prompt(&self->view.bottom_bar, "Export patch: ", path, sizeof(path)) != 0) {
+        return;                                          // abgebrochen
+    }
+    int result = patch_export(&self->buffer, self->file_path, path, patch_format_for_path(path));
+    if (result == PATCH_UNSUPPORTED) {
+        bottom_bar_set_message(&self->view.bottom_bar, "Patch format cannot express these changes");
+    } else if (result != 0) {
+        bottom_bar_set_message(&self->view.bottom_bar, "Patch export failed");
+    } else {
+        bottom_bar_set_message(&self->view.bottom_bar, "Patch exported");
+    }
+}
+
+/**
+ * @brief Fragt nach der Darstellung des Datenbereichs.
+ *
+ * `hex` und `bin` wählen die Byteansichten, Typnamen wie `u16`, `s32be`
+ * oder `f64le` zeigen Zahlenwerte; ohne Endung gilt Little-Endian.
+ * Vorgegeben ist die aktuelle Werteansicht.
+ *
+ * @param self Zeiger auf den Controller
+ */
+static void choose_view(Main_Controller *self) {
+    Editor *editor = &self->view.editor;
+    char name[16] = "";
+    if (editor->display_mode == DISPLAY_VALUE) {
+        snprintf(name, sizeof(name), "%s%s", value_type_name(editor->value_type),
+                 editor->big_endian ? "be" : "le");
+    }
+    if (bottom_bar_prompt(&self->view.bottom_bar, "View (hex, bin, u16..f64 with le/be): ", name,
+                          sizeof(name)) != 0) {
+        return;                                          // abgebrochen
+    }
+    ValueType type;
+    int bigEndian;
+    if (strcmp(name, "hex") == 0 || strcmp(name, "bin") == 0) {
+        DisplayMode wanted = (name[0] == 'h') ? DISPLAY_HEX : DISPLAY_BIN;
+        while (editor->display_mode != wanted) {
+            editor_toggle_display_mode(editor);          // aus der Werteansicht über Hex
+        }
+    } else if (value_type_parse(name, &type, &bigEndian) != 0) {
+        bottom_bar_set_message(&self->view.bottom_bar, "Unknown view");
+    } else if (editor_set_value_view(editor, type, bigEndian) != 0) {
+        bottom_bar_set_message(&self->view.bottom_bar, "View does not fit the terminal width");
+    }
+}
+
+/**
+ * @brief Setzt die Signatursuche fort, solange keine Eingabe wartet.
+ *
+ * Wie beim Vorladen wird in kleinen Schritten gearbeitet, zwischen
+ * denen auf Tasten geprüft wird. Nach `CONTROLLER_SCAN_BUDGET` Bytes
+ * kehrt die Funktion zurück, damit Datenströme und Dateiänderungen
+ * nicht warten müssen.
+ *
+ * @param self Zeiger auf den Controller
+ * @return 1 wenn neu gezeichnet werden muss, sonst 0
+ */
+static int scan_signatures(Main_Controller *self) {
+    BottomBar *bar = &self->view.bottom_bar;
+    if (!self->has_signatures || !signature_scan_pending(&self->signatures)) {
+        int finished = bar->scanning;
+        bar->scanning = 0;
+        return finished;                                 // Ende einmal anzeigen
+    }
+    unsigned int before = bar->scan_percent;
+    size_t done = 0;
+    while (done < CONTROLLER_SCAN_BUDGET && !input_pending(self->view.editor.win)) {
+        if (!signature_scan_step(&self->signatures, CONTROLLER_SCAN_STEP)) {
+            break;                                       // alles durchsucht
+        }
+        done += CONTROLLER_SCAN_STEP;
+    }
+    bar->scanning = signature_scan_pending(&self->signatures);
+    bar->scan_percent = signature_scan_progress(&self->signatures);
+    return !bar->scanning || bar->scan_percent != before;
+}
+
+/**
+ * @brief Setzt die Berechnung der Übersicht fort, solange keine Eingabe wartet.
+ *
+ * Gearbeitet wird wie bei der Signatursuche in kleinen Schritten, nach
+ * `CONTROLLER_MAP_BUDGET` Bytes wird neu gezeichnet.
+ *
+ * @param self Zeiger auf den Controller
+ * @return 1 wenn neu gezeichnet werden muss, sonst 0
+ */
+static int scan_map(Main_Controller *self) {
+    if (!byte_map_pending(&self->map)) {
+        return 0;
+    }
+    size_t done = 0;
+    while (done < CONTROLLER_MAP_BUDGET && !input_pending(self->view.editor.win)) {
+        if (!byte_map_step(&self->map, CONTROLLER_SCAN_STEP)) {
+            break;                                       // alles gelesen
+        }
+        done += CONTROLLER_SCAN_STEP;
+    }
+    return 1;
+}
+
+/**
+ * @brief Springt zum Anfang des nächsten Blocks mit anderer Byteklasse.
+ *
+ * So lassen sich Füllbereiche aus Nullbytes oder 0xFF und lange
+ * Textabschnitte mit einem Tastendruck überspringen.
+ *
+ * @param self Zeiger auf den Controller
+ */
+static void jump_region(Main_Controller *self) {
+    Editor *editor = &self->view.editor;
+    const ByteMap *map = &self->map;
+    size_t size = self->buffer.size;
+    size_t block = map->block;
+    size_t cursor = idx(editor, editor->cursor_y, editor->cursor_x);
+    if (block == 0 || cursor >= size) {
+        return;
+    }
+    ByteMapStats stats;
+    byte_map_query(map, cursor, cursor + 1, &stats);
+    ByteClass current = byte_map_classify(&stats);
+    for (size_t start = (cursor / block + 1) * block; start < size; start += block) {
+        byte_map_query(map, start, start + 1, &stats); // genau ein Block
+        ByteClass next = byte_map_classify(&stats);
+        if (next != current && next != BYTE_CLASS_UNKNOWN) {
+            editor->strategy->reset_pending(editor);
+            editor_jump_to(editor, start);
+            return;
+        }
+    }
+    bottom_bar_set_message(&self->view.bottom_bar, "No further region");
+}
+
+/**
+ * @brief Wertet einen Mausklick aus; Klicks in die Übersicht springen an ihre Stelle.
+ *
+ * @param self Zeiger auf den Controller
+ */
+static void click(Main_Controller *self) {
+    MEVENT event;
+    if (getmouse(&event) != OK) {
+        return;
+    }
+    Editor *editor = &self->view.editor;
+    int y = event.y;
+    int x = event.x;
+    size_t offset;
+    if (!wmouse_trafo(editor->win, &y, &x, FALSE) || editor_map_hit(editor, y, x, &offset) != 0) {
+        return;                                          // nicht in der Übersicht
+    }
+    editor->strategy->reset_pending(editor);
+    editor_jump_to(editor, offset);
+}
+
+/**
+ * @brief Lädt den Bereich in Scrollrichtung vor, solange keine Eingabe wartet.
+ *
+ * Das Vorladen läuft erst nach dem Zeichnen und in kleinen Schritten,
+ * zwischen denen auf neue Tasten geprüft wird. Eine Eingabe wird so nie
+ * durch Lesezugriffe verzögert.
+ *
+ * @param self Zeiger auf den Controller
+ */
+static void prefetch_ahead(Main_Controller *self) {
+    size_t start;
+    size_t end;
+    editor_get_prefetch_range(&self->view.editor, &start, &end);
+    while (start < end && !input_pending(self->view.editor.win)) {
+        size_t step = end - start;
+        if (step > CONTROLLER_PREFETCH_STEP) {
+            step = CONTROLLER_PREFETCH_STEP;
+        }
+        data_buffer_prefetch(&self->buffer, start, start + step);
+        start += step;
+    }
+}
+
+/**
+ * @brief Übernimmt neue Bytes eines Datenstroms oder den Ladefortschritt.
+ *
+ * Verwirft der Strom im Ringmodus alte Bytes, bleibt die Ansicht auf
+ * denselben Daten stehen.
+ *
+ * @param self Zeiger auf den Controller
+ * @return 1 wenn neu gezeichnet werden muss, sonst 0
+ */
+static int poll_source(Main_Controller *self) {
+    int changed = 0;
+    if (self->comparing && data_buffer_needs_poll(&self->compare_buffer)) {
+        size_t ignored = 0;                               // Ansicht folgt dem ersten Editor
+        changed = data_buffer_poll(&self->compare_buffer, &ignored) != 0;
+    }
+    if (!data_buffer_needs_poll(&self->buffer)) {
+        return changed; // Quelle ändert sich nicht mehr
+    }
+    size_t dropped = 0;
+    int loading = self->buffer.source.loading;
+    int result = data_buffer_poll(&self->buffer, &dropped);
+    if (loading && !self->buffer.source.loading && self->buffer.source.incomplete) {
+        bottom_bar_set_message(&self->view.bottom_bar, "Read error while loading, missing bytes shown as 00");
+    }
+    if (dropped > 0) {
+        editor_discard_front(&self->view.editor, dropped);
+    }
+    if (result > 0 && self->view.editor.follow) {
+        editor_show_end(&self->view.editor);            // wie `tail -f` am Ende bleiben
+    }
+    return changed || result != 0; // auch das Ende von Strom oder Ladevorgang wird angezeigt
+}
+
+/**
+ * @brief Prüft ohne zu blockieren, ob eine Taste wartet.
+ *
+ * Eine gelesene Taste wird zurückgelegt und von der Hauptschleife
+ * regulär verarbeitet.
+ *
+ * @param win Fenster, aus dem gelesen wird
+ * @return 1 wenn eine Eingabe wartet, sonst 0
+ */
+static int input_pending(WINDOW *win) {
+    wtimeout(win, 0);            // nicht blockierend lesen
+    int key = wgetch(win);
+    wtimeout(win, -1);           // wieder blockierend
+    if (key == ERR) {
+        return 0;
+    }
+    ungetch(key);                // Taste für die Hauptschleife zurücklegen
+    return 1;
+}
+
+/**
+ * @brief Verarbeitet alle bereits wartenden Tasten, bevor einmal gezeichnet wird.
+ *
+ * Bei gehaltenen Pfeiltasten, eingefügtem Text oder über langsame
+ * Verbindungen treffen viele Tasten auf einmal ein. Statt für jede ein
+ * Bild auszugeben, das niemand sieht, werden sie bis zu
+ * `CONTROLLER_INPUT_BUDGET_MS` lang nacheinander verarbeitet; erst danach
+ * zeichnet die Hauptschleife. Eine Taste, die eine Eingabezeile oder
+ * Liste öffnet, wird zurückgelegt, damit der Dialog über dem
+ * aktuellen Stand erscheint.
+ *
+ * @param self Zeiger auf den Controller
+ * @param win  Fenster, aus dem gelesen wird
+ * @return 1 wenn F12 gelesen wurde, sonst 0
+ */
+static int drain_input(Main_Controller *self, WINDOW *win) {
+    struct timespec start;
+    timespec_get(&start, TIME_UTC);
+    wtimeout(win, 0);                                      // nur bereits wartende Tasten
+    for (int count = 0; count < CONTROLLER_INPUT_BATCH; count++) {
+        if (elapsed_ms(&start) >= CONTROLLER_INPUT_BUDGET_MS) {
+            break;                                         // Rest nach dem nächsten Bild
+        }
+        int key = wgetch(win);
+        if (key == ERR) {
+            break;
+        }
+        if (key == KEY_F(12)) {
+            return 1;
+        }
+        if (opens_dialog(self, key)) {
+            ungetch(key);                                  // erst zeichnen, dann Dialog
+            break;
+        }
+        main_controller_handle_input(self, key);
+    }
+    return 0;
+}
+
+/**
+ * @brief Prüft, ob eine Taste eine Eingabezeile oder Liste öffnet.
+ */
+static int opens_dialog(const Main_Controller *self, int key) {
+    switch (key) {
+    case KEY_F(2):
+        return data_buffer_is_stream(&self->buffer);      // Strom fragt nach dem Ziel
+    case KEY_F(4):
+    case KEY_F(8):
+    case KEY_F(11):
+    case CONTROLLER_KEY_RANGE_OP:
+    case CONTROLLER_KEY_EXPORT_PATCH:
+    case CONTROLLER_KEY_VALUE_VIEW:
+    case CONTROLLER_KEY_HELP:
+        return 1;
+    default:
+        return 0;
+    }
+}
+
+/**
+ * @brief Vergangene Millisekunden seit einem Zeitpunkt.
+ */
+static long elapsed_ms(const struct timespec *since) {
+    struct timespec now;
+    timespec_get(&now, TIME_UTC);
+    return (long)(now.tv_sec - since->tv_sec) * 1000L + (now.tv_nsec - since->tv_nsec) / 1000000L;
+}
+
+/**
+ * @brief Zeichnet den aktuellen Stand und legt das nächste Bild fest.
+ *
+ * Der Abstand zum nächsten Bild ist mindestens `frame_interval_ms` und
+ * mindestens `CONTROLLER_FRAME_COST_FACTOR`-mal so lang wie diese
+ * Ausgabe gedauert hat. Blockiert ein langsames Terminal die Ausgabe,
+ * werden Bilder also seltener, und zwischen ihnen bleibt Zeit für
+ * Eingaben.
+ *
+ * @param self Zeiger auf den Controller
+ */
+static void draw_frame(Main_Controller *self) {
+    struct timespec start;
+    timespec_get(&start, TIME_UTC);
+    main_window_draw(&self->view);
+    long gap = elapsed_ms(&start) * CONTROLLER_FRAME_COST_FACTOR;
+    if (gap < self->frame_interval_ms) {
+        gap = self->frame_interval_ms;
+    }
+    long nanoseconds = start.tv_nsec + (gap % 1000) * 1000000L;
+    self->next_frame.tv_sec = start.tv_sec + gap / 1000 + nanoseconds / 1000000000L;
+    self->next_frame.tv_nsec = nanoseconds % 1000000000L;
+    self->frame_pending = 0;
+}
 
 //* ----------------------------------- Init und Deinit -----------------------------------
 /**
  * @brief Initialisiert den Controller und lädt eine Datei.
  *
- * @param self      Zeiger auf den Controller
- * @param file_path Pfad zur Datei
+ * Mit einer Vergleichsdatei werden beide Dateien über dasselbe Backend
+ * geladen und nebeneinander im Hauptfenster angezeigt.
+ *
+ * @param self         Zeiger auf den Controller
+ * @param file_path    Pfad zur Datei oder `-` für die Standardeingabe
+ * @param compare_path Pfad der Vergleichsdatei, NULL = kein Vergleich
+ * @param options      Wahl und Budgets des Backends, NULL = Vorgaben
  * @return 0 bei Erfolg
  */
-int main_controller_init(Main_Controller *self, const char *file_path) {
+int main_controller_init(Main_Controller *self, const char *file_path,
+                         const char *compare_path, const DataSourceOptions *options) {
     // Struktur mit Nullen füllen, um definierte Ausgangswerte zu haben
     memset(self, 0, sizeof(*self));
+    main_controller_set_fps(self, CONTROLLER_DEFAULT_FPS);
 
     // Übergebenen Dateipfad kopieren und sicher terminieren
     strncpy(self->file_path, file_path, sizeof(self->file_path) - 1);
@@ -135,14 +1226,36 @@ int main_controller_init(Main_Controller *self, const char *file_path) {
     if (data_buffer_init(&self->buffer) != 0) {
         fatal_error("main_controller_init", "data_buffer_init");
     }
+    if (options) {
+        self->buffer.options = *options; // Wahl des Backends für alle Ladevorgänge
+    }
 
     // Datei in den Buffer laden, bei Fehler wird beendet
     data_buffer_load_file(&self->buffer, self->file_path);
 
+    // Vergleichsdatei ebenso laden
+    if (compare_path) {
+        strncpy(self->compare_path, compare_path, sizeof(self->compare_path) - 1);
+        data_buffer_init(&self->compare_buffer);
+        self->compare_buffer.options = self->buffer.options;
+        data_buffer_load_file(&self->compare_buffer, self->compare_path);
+        diff_index_init(&self->diff, &self->buffer, &self->compare_buffer);
+        self->comparing = 1;
+    }
+
     // grafische Oberfläche starten
-    if (main_window_init(&self->view, &self->buffer) != 0) {
+    if (main_window_init(&self->view, &self->buffer,
+                         self->comparing ? &self->compare_buffer : NULL) != 0) {
         fatal_error("main_controller_init", "main_window_init");
     }
+    start_watch(self);
+    if (self->comparing && !data_buffer_is_stream(&self->compare_buffer)) {
+        self->compare_watching = (file_watch_init(&self->compare_watch, self->compare_path) == 0);
+    }
+    hash_tree_init(&self->hash_tree, &self->buffer); // aufgebaut erst beim ersten Strg+D
+    byte_map_init(&self->map, &self->buffer);         // berechnet zwischen den Eingaben
+    self->view.editor.map = &self->map;
+    self->digest_step = -1;
 
     return 0; // Erfolg
 }
@@ -159,6 +1272,23 @@ int main_controller_deinit(Main_Controller *self) {
 
     // Buffer freigeben
     data_buffer_deinit(&self->buffer);
+    if (self->comparing) {
+        diff_index_deinit(&self->diff);
+        data_buffer_deinit(&self->compare_buffer);
+    }
+
+    // Überwachung der Datei beenden
+    if (self->watching) {
+        file_watch_deinit(&self->watch);
+    }
+    if (self->compare_watching) {
+        file_watch_deinit(&self->compare_watch);
+    }
+    if (self->has_signatures) {
+        signature_scan_deinit(&self->signatures);
+    }
+    hash_tree_deinit(&self->hash_tree);
+    byte_map_deinit(&self->map);
 
     // Controller-Struktur säubern
     memset(self, 0, sizeof(*self));
@@ -14,10 +14,40 @@
  * Lebenszyklus der Anwendung zu steuern.
  */
 
+#include <time.h>
 #include "Data_Buffer.h"
+#include "Diff_Index.h"
+#include "File_Watch.h"
+#include "Pattern_Search.h"
+#include "Bit_Search.h"
+#include "Byte_Map.h"
+#include "Hash_Tree.h"
+#include "Range_Digest.h"
+#include "Range_Ops.h"
+#include "Signature_Scan.h"
 #include "Main_Window.h"
 
 //* ---------------------------- Globale Konstanten oder Defines --------------------------
+#define CONTROLLER_PREFETCH_STEP (64 * 1024) /**< Bytes pro Vorladeschritt zwischen Eingabeprüfungen */
+#define CONTROLLER_POLL_MS 50                 /**< Abfrageintervall für Datenströme und Dateiänderungen */
+#define CONTROLLER_INPUT_BUDGET_MS 20         /**< so lange werden wartende Tasten vor dem Zeichnen verarbeitet */
+#define CONTROLLER_INPUT_BATCH 4096           /**< höchstens so viele wartende Tasten je Bild */
+#define CONTROLLER_DEFAULT_FPS 60             /**< höchstens so viele Bilder je Sekunde ohne `--fps` */
+#define CONTROLLER_FRAME_COST_FACTOR 2        /**< Bildabstand mindestens so viele Ausgabedauern */
+#define CONTROLLER_SCAN_STEP (1024 * 1024)    /**< Bytes der Signatursuche zwischen Eingabeprüfungen */
+#define CONTROLLER_SCAN_BUDGET (64u * 1024u * 1024u) /**< höchstens so viele Bytes je Durchlauf der Hauptschleife */
+#define CONTROLLER_KEY_FIND_NEXT 14           /**< Strg+N: nächster Treffer */
+#define CONTROLLER_KEY_FIND_PREV 16           /**< Strg+P: vorheriger Treffer */
+#define CONTROLLER_KEY_SELECT 2               /**< Strg+B: Auswahl beginnen oder aufheben */
+#define CONTROLLER_KEY_DIGEST 4               /**< Strg+D: Prüfsummen der Auswahl oder Datei */
+#define CONTROLLER_KEY_NEXT_REGION 7          /**< Strg+G: nächster Bereich anderer Byteklasse */
+#define CONTROLLER_KEY_RANGE_OP 5             /**< Strg+E: Operation über die Auswahl */
+#define CONTROLLER_KEY_NEXT_CHANGE 6          /**< Strg+F: nächstes geändertes Byte */
+#define CONTROLLER_KEY_PREV_CHANGE 18         /**< Strg+R: vorheriges geändertes Byte */
+#define CONTROLLER_KEY_EXPORT_PATCH 24        /**< Strg+X: Änderungen als Patch speichern */
+#define CONTROLLER_KEY_VALUE_VIEW 20          /**< Strg+T: Darstellung als Zahlenwerte wählen */
+#define CONTROLLER_KEY_HELP 11                /**< Strg+K: Übersicht aller Tasten */
+#define CONTROLLER_MAP_BUDGET (16u * 1024u * 1024u) /**< Bytes der Übersicht je Durchlauf der Hauptschleife */
 
 //* ------------------------------------- Strukturen --------------------------------------
 /**
@@ -27,6 +57,34 @@ typedef struct {
     char file_path[256]; /**< Pfad der zu bearbeitenden Datei */
     DataBuffer buffer;   /**< Eingelesene Dateidaten */
     Main_Window view;    /**< Hauptfenster der Anwendung */
+    FileWatch watch;     /**< erkennt Änderungen anderer Anwendungen an der Datei */
+    int watching;        /**< 1, wenn `watch` aktiv ist */
+    DataBuffer compare_buffer; /**< Vergleichsdatei, nur im Vergleichsmodus geladen */
+    char compare_path[256];    /**< Pfad der Vergleichsdatei */
+    FileWatch compare_watch;   /**< erkennt Änderungen anderer Anwendungen an der Vergleichsdatei */
+    int compare_watching;      /**< 1, wenn `compare_watch` aktiv ist */
+    DiffIndex diff;      /**< bekannte Unterschiede zwischen `buffer` und `compare_buffer` */
+    int comparing;       /**< 1 im Vergleichsmodus */
+    char search_text[256]; /**< zuletzt eingegebenes Suchmuster */
+    SearchPattern search;  /**< übersetztes Suchmuster */
+    int searching;         /**< 1, sobald ein gültiges Muster eingegeben wurde */
+    BitPattern bit_search; /**< übersetztes Bitmuster */
+    int searching_bits;    /**< 1, wenn das letzte Muster ein Bitmuster war */
+    SignatureScan signatures;  /**< Signatursatz und Fundstellen */
+    int has_signatures;        /**< 1, wenn `signatures` geladen ist */
+    size_t signature_selected; /**< zuletzt gewählte Zeile der Ergebnisliste */
+    HashTree hash_tree;        /**< Prüfsummenbaum über `buffer`, beim ersten Strg+D aufgebaut */
+    RangeDigest digest;        /**< zuletzt berechnete Prüfsummen über den ganzen Bereich */
+    int digest_valid;          /**< 1, wenn `digest` zu Bereich und Stand passt */
+    size_t digest_start;       /**< Bereich der zuletzt angezeigten Prüfsumme */
+    size_t digest_end;         /**< hinter dem letzten Byte dieses Bereichs */
+    unsigned long digest_revision; /**< Stand des Buffers dieser Prüfsumme */
+    int digest_step;           /**< zuletzt angezeigtes Verfahren, -1 = keines */
+    ByteMap map;               /**< Entropie und Byteklassen für die Übersichtsspalte */
+    char range_op_text[96];    /**< zuletzt eingegebene Operation über die Auswahl */
+    int frame_interval_ms;     /**< Mindestabstand zweier Bilder, 0 = unbegrenzt */
+    int frame_pending;         /**< Stand hat sich geändert, ist aber noch nicht gezeichnet */
+    struct timespec next_frame; /**< frühester Zeitpunkt des nächsten Bildes */
 } Main_Controller;
 
 //* ------------------------------------- Funktionen --------------------------------------
@@ -43,14 +101,43 @@ int main_controller_run(Main_Controller *self);
  */
 void main_controller_handle_input(Main_Controller *self, int key);
 
+/**
+ * @brief Schaltet das Mitlaufen am Ende wachsender Dateien ein oder aus.
+ * @param self   Zeiger auf den Controller
+ * @param follow 1 = Ansicht bleibt am Dateiende
+ */
+void main_controller_set_follow(Main_Controller *self, int follow);
+
+/**
+ * @brief Begrenzt die Bildrate der Anzeige.
+ * @param self Zeiger auf den Controller
+ * @param fps  höchstens so viele Bilder je Sekunde, 0 = unbegrenzt
+ */
+void main_controller_set_fps(Main_Controller *self, int fps);
+
+/**
+ * @brief Lädt einen Signatursatz und startet die Suche im Hintergrund.
+ *
+ * Ein zuvor geladener Satz wird ersetzt. Fehler werden in der
+ * Bottom-Bar gemeldet.
+ *
+ * @param self Zeiger auf den Controller
+ * @param path Pfad der Signaturdatei
+ * @return 0 bei Erfolg, sonst die fehlerhafte Zeile oder -1
+ */
+int main_controller_load_signatures(Main_Controller *self, const char *path);
+
 //* ----------------------------------- Init und Deinit -----------------------------------
 /**
  * @brief Initialisiert den Controller.
  * @param self      Zeiger auf den Controller
- * @param file_path Pfad zur Datei
+ * @param file_path    Pfad zur Datei oder `-` für die Standardeingabe
+ * @param compare_path Pfad der Vergleichsdatei, NULL = kein Vergleich
+ * @param options      Wahl und Budgets des Backends, NULL = Vorgaben
  * @return 0 bei Erfolg, sonst -1
  */
-int main_controller_init(Main_Controller *self, const char *file_path);
+int main_controller_init(Main_Controller *self, const char *file_path,
+                         const char *compare_path, const DataSourceOptions *options);
 
 /**
  * @brief Gibt Ressourcen frei.
@@ -0,0 +1,282 @@
+/**
+ * @file Async_Loader.c
+ * @brief Einlesen einer Datei im Hintergrund.
+ *
+ * Jeder Abschnitt durchläuft die Zustände offen, in Arbeit und fertig.
+ * Die Lese-Threads nehmen sich unter einer Sperre den nächsten offenen
+ * Abschnitt, bevorzugt den, auf den die Oberfläche gerade wartet, und
+ * lesen ihn ohne Sperre per `pread` direkt an seine Zielposition. Danach
+ * wird der Abschnitt als fertig markiert und alle Wartenden geweckt.
+ * Kann ein Abschnitt nicht vollständig gelesen werden, etwa weil die
+ * Datei inzwischen kürzer ist, gelten die fehlenden Bytes wie beim
+ * Block-Cache als Nullbytes; so wartet niemand auf einen Abschnitt, der
+ * nie eintrifft, und der Fehler wird beim Abschluss gemeldet.
+ */
+
+//* -------------------------------------- Includes ---------------------------------------
+#include "Async_Loader.h"   // Schnittstelle dieses Moduls
+#include <stdlib.h>          // malloc, calloc und free
+#include <string.h>          // memcpy und memset
+#ifndef _WIN32
+#include <pthread.h>         // Threads, Sperre und Bedingungsvariable
+#endif
+#include "File_Manager.h"   // positionsgenaues Lesen
+#include "Err_Log.h"        // Fehlerbehandlung
+
+//* ---------------------------- Globale Konstanten oder Defines --------------------------
+/** Zustand eines Abschnitts */
+enum {
+    CHUNK_OPEN,    /**< noch nicht begonnen */
+    CHUNK_BUSY,    /**< wird gerade gelesen */
+    CHUNK_DONE     /**< im Speicher, nach einem Lesefehler mit Nullbytes aufgefüllt */
+};
+
+#ifndef _WIN32
+/**
+ * @brief Synchronisationsdaten, die nur die Threads des Loaders teilen.
+ */
+struct AsyncLoaderState {
+    pthread_mutex_t lock;                     /**< schützt alle folgenden Felder */
+    pthread_cond_t changed;                   /**< signalisiert fertige Abschnitte */
+    pthread_t threads[ASYNC_LOADER_THREADS];  /**< Lese-Threads */
+    int thread_count;                         /**< gestartete Threads */
+    unsigned char *chunk_state;               /**< Zustand je Abschnitt */
+    size_t chunk_count;                       /**< Anzahl der Abschnitte */
+    size_t next_chunk;                        /**< nächster Kandidat in Dateireihenfolge */
+    size_t wanted_chunk;                      /**< von der Oberfläche benötigt, sonst SIZE_MAX */
+    size_t loaded;                            /**< bereits eingelesene Bytes */
+    size_t failed;                            /**< Abschnitte mit Lesefehler */
+    int stop;                                 /**< 1 = Threads sollen enden */
+};
+
+// Vorwärtsdeklarationen der Helferfunktionen
+static void *worker(void *context);
+static int claim_chunk(struct AsyncLoaderState *state, size_t *outChunk);
+static size_t chunk_length(const AsyncLoader *self, size_t chunk);
+#endif
+
+//* ------------------------------------- Funktionen --------------------------------------
+/**
+ * @brief Kopiert einen Bereich und wartet dabei nur auf fehlende Abschnitte.
+ *
+ * Fehlt ein Abschnitt noch, wird er den Threads als nächster Auftrag
+ * genannt und auf ihn gewartet.
+ *
+ * @param self   Zeiger auf den Loader
+ * @param offset Startposition
+ * @param dest   Ziel-Buffer
+ * @param length Anzahl der Bytes
+ */
+void async_loader_read(AsyncLoader *self, size_t offset, unsigned char *dest, size_t length) {
+#ifndef _WIN32
+    struct AsyncLoaderState *state = self->state;
+    if (state && length > 0) {
+        size_t first = offset / ASYNC_LOADER_CHUNK_SIZE;
+        size_t last = (offset + length - 1) / ASYNC_LOADER_CHUNK_SIZE;
+        pthread_mutex_lock(&state->lock);
+        for (size_t chunk = first; chunk <= last; chunk++) {
+            while (state->chunk_state[chunk] != CHUNK_DONE) {
+                if (state->chunk_state[chunk] == CHUNK_OPEN) {
+                    state->wanted_chunk = chunk;  // vorziehen
+                }
+                pthread_cond_wait(&state->changed, &state->lock);
+            }
+        }
+        pthread_mutex_unlock(&state->lock);
+    }
+#endif
+    memcpy(dest, self->bytes + offset, length);   // Abschnitte ändern sich nicht mehr
+}
+
+/**
+ * @brief Liefert die Anzahl bereits eingelesener Bytes.
+ * @param self Zeiger auf den Loader
+ * @return eingelesene Bytes, `size` wenn fertig
+ */
+size_t async_loader_progress(AsyncLoader *self) {
+#ifndef _WIN32
+    struct AsyncLoaderState *state = self->state;
+    if (state) {
+        pthread_mutex_lock(&state->lock);
+        size_t loaded = state->loaded;
+        pthread_mutex_unlock(&state->lock);
+        return loaded;
+    }
+#endif
+    return self->size;
+}
+
+/**
+ * @brief Wartet, bis alle Threads beendet sind.
+ *
+ * Danach ist kein weiterer Abgleich mit den Threads mehr nötig.
+ *
+ * @param self Zeiger auf den Loader
+ * @return 0 wenn alle Bytes gelesen wurden, -1 nach einem Lesefehler
+ *         oder Abbruch
+ */
+int async_loader_finish(AsyncLoader *self) {
+#ifndef _WIN32
+    struct AsyncLoaderState *state = self->state;
+    if (!state) {
+        return 0; // bereits abgeschlossen
+    }
+    for (int i = 0; i < state->thread_count; i++) {
+        pthread_join(state->threads[i], NULL);
+    }
+    int complete = (state->loaded == self->size && state->failed == 0);
+    pthread_cond_destroy(&state->changed);
+    pthread_mutex_destroy(&state->lock);
+    free(state->chunk_state);
+    free(state);
+    self->state = NULL;
+    return complete ? 0 : -1;
+#else
+    (void)self;
+    return 0;
+#endif
+}
+
+//* ---------------------------------- Helfer Funktionen ----------------------------------
+#ifndef _WIN32
+/**
+ * @brief Liest Abschnitte, bis keiner mehr offen ist.
+ */
+static void *worker(void *context) {
+    AsyncLoader *self = (AsyncLoader *)context;
+    struct AsyncLoaderState *state = self->state;
+    size_t chunk;
+    while (claim_chunk(state, &chunk)) {
+        size_t start = chunk * ASYNC_LOADER_CHUNK_SIZE;
+        size_t length = chunk_length(self, chunk);
+        long long got = readFileAt(self->fd, start, self->bytes + start, length);
+
+        if (got != (long long)length) {                 // Datei geschrumpft oder Lesefehler
+            size_t valid = (got > 0) ? (size_t)got : 0;
+            memset(self->bytes + start + valid, 0, length - valid);
+        }
+
+        pthread_mutex_lock(&state->lock);
+        state->chunk_state[chunk] = CHUNK_DONE;
+        state->loaded += length;
+        state->failed += (got != (long long)length);
+        pthread_cond_broadcast(&state->changed);
+        pthread_mutex_unlock(&state->lock);
+    }
+    return NULL;
+}
+
+/**
+ * @brief Sucht den nächsten offenen Abschnitt und markiert ihn als in Arbeit.
+ * @return 1 wenn ein Abschnitt vergeben wurde, 0 wenn nichts mehr offen ist
+ */
+static int claim_chunk(struct AsyncLoaderState *state, size_t *outChunk) {
+    pthread_mutex_lock(&state->lock);
+    size_t chunk = state->chunk_count;
+    if (!state->stop) {
+        if (state->wanted_chunk < state->chunk_count &&
+            state->chunk_state[state->wanted_chunk] == CHUNK_OPEN) {
+            chunk = state->wanted_chunk;           // Oberfläche wartet darauf
+        } else {
+            while (state->next_chunk < state->chunk_count &&
+                   state->chunk_state[state->next_chunk] != CHUNK_OPEN) {
+                state->next_chunk++;               // vergebene überspringen
+            }
+            chunk = state->next_chunk;
+        }
+    }
+    state->wanted_chunk = (size_t)-1;
+    if (chunk < state->chunk_count) {
+        state->chunk_state[chunk] = CHUNK_BUSY;
+    }
+    pthread_mutex_unlock(&state->lock);
+    *outChunk = chunk;
+    return chunk < state->chunk_count;
+}
+
+/** @brief Länge eines Abschnitts, der letzte kann kürzer sein. */
+static size_t chunk_length(const AsyncLoader *self, size_t chunk) {
+    size_t start = chunk * ASYNC_LOADER_CHUNK_SIZE;
+    size_t rest = self->size - start;
+    return (rest < ASYNC_LOADER_CHUNK_SIZE) ? rest : ASYNC_LOADER_CHUNK_SIZE;
+}
+#endif
+
+//* ----------------------------------- Init und Deinit -----------------------------------
+/**
+ * @brief Öffnet eine Datei und startet das Einlesen im Hintergrund.
+ *
+ * Der Ziel-Speicher wird in voller Größe reserviert; belegt wird er
+ * erst, während die Threads ihn füllen.
+ *
+ * @param self Zeiger auf den Loader
+ * @param path Dateipfad
+ * @return 0 bei Erfolg, sonst -1
+ */
+int async_loader_init(AsyncLoader *self, const char *path) {
+    memset(self, 0, sizeof(*self));
+    self->fd = -1;
+#ifdef _WIN32
+    (void)path;
+    return -1; // unter Windows nicht unterstützt
+#else
+    if (openFileForRead(path, &self->fd, &self->size) != 0) {
+        return -1;
+    }
+    self->bytes = malloc(self->size ? self->size : 1);
+    struct AsyncLoaderState *state = calloc(1, sizeof(*state));
+    size_t chunks = (self->size + ASYNC_LOADER_CHUNK_SIZE - 1) / ASYNC_LOADER_CHUNK_SIZE;
+    if (state) {
+        state->chunk_state = calloc(chunks ? chunks : 1, 1); // alle CHUNK_OPEN
+    }
+    if (!self->bytes || !state || !state->chunk_state) {
+        if (state) {
+            free(state->chunk_state);
+        }
+        free(state);
+        async_loader_deinit(self);
+        return -1;
+    }
+
+    pthread_mutex_init(&state->lock, NULL);
+    pthread_cond_init(&state->changed, NULL);
+    state->chunk_count = chunks;
+    state->wanted_chunk = (size_t)-1;
+    self->state = state;
+
+    int threads = (chunks < ASYNC_LOADER_THREADS) ? (int)chunks : ASYNC_LOADER_THREADS;
+    for (int i = 0; i < threads; i++) {
+        if (pthread_create(&state->threads[i], NULL, worker, self) != 0) {
+            break; // mit den bereits laufenden Threads weitermachen
+        }
+        state->thread_count++;
+    }
+    if (state->thread_count == 0 && chunks > 0) {
+        async_loader_deinit(self);
+        return -1; // ohne Thread kein Fortschritt
+    }
+    return 0;
+#endif
+}
+
+/**
+ * @brief Bricht das Einlesen ab und gibt alles frei.
+ * @param self Zeiger auf den Loader
+ * @return 0 bei Erfolg
+ */
+int async_loader_deinit(AsyncLoader *self) {
+#ifndef _WIN32
+    struct AsyncLoaderState *state = self->state;
+    if (state) {
+        pthread_mutex_lock(&state->lock);
+        state->stop = 1;                // keine neuen Abschnitte mehr vergeben
+        pthread_mutex_unlock(&state->lock);
+        async_loader_finish(self);      // laufende Abschnitte abwarten
+    }
+#endif
+    free(self->bytes);
+    closeFile(self->fd);
+    memset(self, 0, sizeof(*self));
+    self->fd = -1;
+    return 0;
+}
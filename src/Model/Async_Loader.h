@@ -0,0 +1,64 @@
+#ifndef ASYNC_LOADER_H
+#define ASYNC_LOADER_H
+
+/**
+ * @file Async_Loader.h
+ * @brief Schnittstelle zum Einlesen einer Datei im Hintergrund.
+ *
+ * Der Loader liest eine Datei vollständig in den Speicher, ohne die
+ * Oberfläche aufzuhalten. Mehrere Hintergrund-Threads holen Abschnitte
+ * fester Größe per `pread`; ein Zugriff auf einen noch fehlenden
+ * Abschnitt wartet nur auf genau diesen Abschnitt, der dafür vorgezogen
+ * wird. Der erste Bildschirm steht damit nach dem ersten Abschnitt.
+ */
+
+#include <stddef.h> // stellt den Typ size_t bereit
+
+//* ---------------------------- Globale Konstanten oder Defines --------------------------
+#define ASYNC_LOADER_CHUNK_SIZE (4u * 1024u * 1024u) /**< Bytes pro Abschnitt */
+#define ASYNC_LOADER_THREADS 4                       /**< parallele Lese-Threads */
+
+//* ------------------------------------- Strukturen --------------------------------------
+struct AsyncLoaderState; /**< interne Synchronisationsdaten */
+
+/**
+ * @brief Datei, die im Hintergrund in den Speicher gelesen wird.
+ */
+typedef struct {
+    int fd;                          /**< Deskriptor der Datei */
+    size_t size;                     /**< Größe der Datei in Bytes */
+    unsigned char *bytes;            /**< Ziel-Speicher für die ganze Datei */
+    struct AsyncLoaderState *state;  /**< Threads, Sperre und Abschnittsstatus */
+} AsyncLoader;
+
+//* ------------------------------------- Funktionen --------------------------------------
+/**
+ * @brief Kopiert einen Bereich und wartet dabei nur auf fehlende Abschnitte.
+ */
+void async_loader_read(AsyncLoader *self, size_t offset, unsigned char *dest, size_t length);
+
+/**
+ * @brief Liefert die Anzahl bereits eingelesener Bytes.
+ */
+size_t async_loader_progress(AsyncLoader *self);
+
+/**
+ * @brief Wartet, bis alle Threads beendet sind.
+ */
+int async_loader_finish(AsyncLoader *self);
+
+//* ----------------------------------- Init und Deinit -----------------------------------
+/**
+ * @brief Öffnet eine Datei und startet das Einlesen im Hintergrund.
+ * @param self Zeiger auf den Loader
+ * @param path Dateipfad
+ * @return 0 bei Erfolg, sonst -1
+ */
+int async_loader_init(AsyncLoader *self, const char *path);
+
+/**
+ * @brief Bricht das Einlesen ab und gibt alles frei.
+ */
+int async_loader_deinit(AsyncLoader *self);
+
+#endif // ASYNC_LOADER_H
@@ -0,0 +1,235 @@
+/**
+ * @file Bit_Search.c
+ * @brief Suche nach Bitfolgen an beliebiger Bitposition.
+ *
+ * Das Shift-And-Verfahren führt für jedes Präfix des Musters ein Bit im
+ * Zustandswort, das gesetzt ist, solange das Präfix am aktuellen Bit
+ * endet. Acht Einzelschritte lassen sich zu einem zusammenfassen:
+ * `D = ((D << 8) | 0xFF) & table[byte]`. Weil die Masken oberhalb des
+ * Musters nur Einsen enthalten, wandert ein Treffer danach noch bis zu
+ * sieben Stellen weiter und bleibt erhalten; die acht Bits ab
+ * `length - 1` nennen so die Treffer, die in diesem Byte enden, für
+ * alle acht Bitversätze zugleich. Gelesen wird in Abschnitten von
+ * `BIT_SEARCH_CHUNK` Bytes, jeweils mit so vielen folgenden Bytes, dass
+ * auch Treffer über das Abschnittsende hinaus vollständig sind.
+ */
+
+//* -------------------------------------- Includes ---------------------------------------
+#include "Bit_Search.h"     // Schnittstelle dieses Moduls
+#include <stdlib.h>          // malloc und free
+#include <string.h>          // memset
+#include "Err_Log.h"        // Fehlerbehandlung
+
+//* ---------------------------- Globale Konstanten oder Defines --------------------------
+#define BIT_SEARCH_NONE UINT64_MAX /**< kein Treffer im Abschnitt */
+
+// Vorwärtsdeklarationen der Helferfunktionen
+static void build_table(BitPattern *self, uint64_t zeros, uint64_t ones);
+static uint64_t scan_chunk(const BitPattern *self, const unsigned char *data, size_t count,
+                           size_t base, uint64_t first, uint64_t last, int backward);
+static uint64_t search_chunk(const DataBuffer *buffer, const BitPattern *pattern,
+                             unsigned char *data, size_t start, size_t end, uint64_t first,
+                             uint64_t last, int backward);
+
+//* ------------------------------------- Funktionen --------------------------------------
+/**
+ * @brief Übersetzt die Eingabe in ein Bitmuster.
+ *
+ * @param self Zeiger auf das Muster
+ * @param text Eingabe aus `0`, `1`, `?` und `.`
+ * @return 0 bei Erfolg, -1 bei ungültiger, leerer oder zu langer Eingabe
+ */
+int bit_search_parse(BitPattern *self, const char *text) {
+    memset(self, 0, sizeof(*self));
+    uint64_t zeros = 0; // Bit i gesetzt: Musterbit i passt auf eine 0
+    uint64_t ones = 0;  // Bit i gesetzt: Musterbit i passt auf eine 1
+    for (; *text; text++) {
+        char c = *text;
+        if (c == ' ' || c == '_' || c == '\t') {
+            continue;
+        }
+        if (c != '0' && c != '1' && c != '?' && c != '.') {
+            return -1;
+        }
+        if (self->length == BIT_PATTERN_MAX) {
+            return -1; // Muster zu lang
+        }
+        uint64_t bit = (uint64_t)1 << self->length;
+        if (c != '1') {
+            zeros |= bit;
+        }
+        if (c != '0') {
+            ones |= bit;
+        }
+        self->length++;
+    }
+    if (self->length == 0) {
+        return -1;
+    }
+    build_table(self, zeros, ones);
+    return 0;
+}
+
+/**
+ * @brief Sucht den ersten Treffer, der ab Bit `from` beginnt.
+ */
+int bit_search_next(const DataBuffer *buffer, const BitPattern *pattern, uint64_t from,
+                    BitHit *out) {
+    uint64_t total = (uint64_t)buffer->size * 8u;
+    if (pattern->length > total) {
+        return -1;
+    }
+    uint64_t last = total - pattern->length + 1; // hinter der letzten Startposition
+    if (from >= last) {
+        return -1;
+    }
+    unsigned char *data = (unsigned char *)malloc(BIT_SEARCH_CHUNK + 8);
+    if (!data) {
+        fatal_error("bit_search_next", "out of memory");
+    }
+    uint64_t hit = BIT_SEARCH_NONE;
+    size_t lastByte = (size_t)((last + 7) / 8);
+    for (size_t start = (size_t)(from / 8); start < lastByte && hit == BIT_SEARCH_NONE;) {
+        size_t end = (lastByte - start > BIT_SEARCH_CHUNK) ? start + BIT_SEARCH_CHUNK : lastByte;
+        hit = search_chunk(buffer, pattern, data, start, end, from, last, 0);
+        start = end;
+    }
+    free(data);
+    if (hit == BIT_SEARCH_NONE) {
+        return -1;
+    }
+    out->offset = (size_t)(hit / 8);
+    out->shift = (int)(hit % 8);
+    return 0;
+}
+
+/**
+ * @brief Sucht den letzten Treffer, der vor Bit `before` beginnt.
+ */
+int bit_search_prev(const DataBuffer *buffer, const BitPattern *pattern, uint64_t before,
+                    BitHit *out) {
+    uint64_t total = (uint64_t)buffer->size * 8u;
+    if (pattern->length > total) {
+        return -1;
+    }
+    uint64_t last = total - pattern->length + 1;
+    if (before < last) {
+        last = before;
+    }
+    if (last == 0) {
+        return -1;
+    }
+    unsigned char *data = (unsigned char *)malloc(BIT_SEARCH_CHUNK + 8);
+    if (!data) {
+        fatal_error("bit_search_prev", "out of memory");
+    }
+    uint64_t hit = BIT_SEARCH_NONE;
+    for (size_t end = (size_t)((last + 7) / 8); end > 0 && hit == BIT_SEARCH_NONE;) {
+        size_t start = (end > BIT_SEARCH_CHUNK) ? end - BIT_SEARCH_CHUNK : 0;
+        hit = search_chunk(buffer, pattern, data, start, end, 0, last, 1);
+        end = start;
+    }
+    free(data);
+    if (hit == BIT_SEARCH_NONE) {
+        return -1;
+    }
+    out->offset = (size_t)(hit / 8);
+    out->shift = (int)(hit % 8);
+    return 0;
+}
+
+//* ---------------------------------- Helfer Funktionen ----------------------------------
+/**
+ * @brief Fasst je Bytewert die acht Einzelschritte zu einer Maske zusammen.
+ *
+ * Ein Einzelschritt ist `D = ((D << 1) | 1) & B[bit]`. Über acht Bits
+ * ergibt das `((D << 8) | 0xFF) & table[byte]`, wobei das Bit, das k
+ * Schritte vor dem letzten gelesen wird, mit `B << k` eingeht und die
+ * k untersten Stellen frei lässt.
+ *
+ * @param zeros Musterbits, die auf eine 0 passen
+ * @param ones  Musterbits, die auf eine 1 passen
+ */
+static void build_table(BitPattern *self, uint64_t zeros, uint64_t ones) {
+    uint64_t above = ~(uint64_t)0 << self->length; // Treffer dürfen weiterwandern
+    uint64_t masks[2] = {zeros | above, ones | above};
+    for (int value = 0; value < 256; value++) {
+        uint64_t table = ~(uint64_t)0;
+        for (int k = 0; k < 8; k++) {            // k Schritte vor dem letzten Bit
+            uint64_t mask = masks[(value >> k) & 1];
+            table &= (mask << k) | (((uint64_t)1 << k) - 1);
+        }
+        self->table[value] = table;
+    }
+}
+
+/**
+ * @brief Liest einen Abschnitt samt Überhang und durchsucht ihn.
+ *
+ * @param data     Puffer für `BIT_SEARCH_CHUNK + 8` Bytes
+ * @param start    erstes Byte, in dem ein Treffer beginnen darf
+ * @param end      hinter dem letzten solchen Byte
+ * @param first    erste zulässige Startposition in Bits
+ * @param last     hinter der letzten zulässigen Startposition in Bits
+ * @param backward 1 = letzter Treffer gesucht
+ * @return Startposition in Bits oder `BIT_SEARCH_NONE`
+ */
+static uint64_t search_chunk(const DataBuffer *buffer, const BitPattern *pattern,
+                             unsigned char *data, size_t start, size_t end, uint64_t first,
+                             uint64_t last, int backward) {
+    size_t readEnd = end + (pattern->length + 7) / 8; // Treffer über das Ende hinaus
+    if (readEnd > buffer->size) {
+        readEnd = buffer->size;
+    }
+    data_buffer_get_range(buffer, start, readEnd, data);
+    uint64_t chunkFirst = (uint64_t)start * 8u;
+    uint64_t chunkLast = (uint64_t)end * 8u;
+    return scan_chunk(pattern, data, readEnd - start, start, (first > chunkFirst) ? first : chunkFirst,
+                      (last < chunkLast) ? last : chunkLast, backward);
+}
+
+/**
+ * @brief Durchsucht zusammenhängende Bytes mit leerem Anfangszustand.
+ *
+ * @param data     Bytes ab Position `base`
+ * @param count    Anzahl der Bytes
+ * @param first    erste zulässige Startposition in Bits
+ * @param last     hinter der letzten zulässigen Startposition in Bits
+ * @param backward 1 = letzter Treffer gesucht
+ * @return Startposition in Bits oder `BIT_SEARCH_NONE`
+ */
+static uint64_t scan_chunk(const BitPattern *self, const unsigned char *data, size_t count,
+                           size_t base, uint64_t first, uint64_t last, int backward) {
+    size_t shift = self->length - 1;
+    uint64_t endMask = (uint64_t)0xFF << shift; // Treffer, die in diesem Byte enden
+    uint64_t best = BIT_SEARCH_NONE;
+    uint64_t state = 0;
+    for (size_t i = 0; i < count; i++) {
+        state = ((state << 8) | 0xFF) & self->table[data[i]];
+        // Das letzte Bit dieses Bytes liegt bei (base + i) * 8 + 7
+        uint64_t lastBit = ((uint64_t)(base + i) * 8u) + 7u;
+        if (lastBit - 7u >= last + shift) {
+            break;                                  // kein zulässiger Start mehr möglich
+        }
+        if ((state & endMask) == 0) {
+            continue;
+        }
+        unsigned int ends = (unsigned int)(state >> shift) & 0xFFu; // Bit s: Ende s Bits vor lastBit
+        for (int step = 0; step < 8; step++) {
+            int s = backward ? step : 7 - step;     // frühester Start zuerst, rückwärts spätester
+            if (!(ends & (1u << s))) {
+                continue;
+            }
+            uint64_t begin = lastBit - (uint64_t)s - shift;
+            if (begin < first || begin >= last) {
+                continue;
+            }
+            if (!backward) {
+                return begin;
+            }
+            best = begin;
+            break;
+        }
+    }
+    return best;
+}
@@ -0,0 +1,86 @@
+#ifndef BIT_SEARCH_H
+#define BIT_SEARCH_H
+
+/**
+ * @file Bit_Search.h
+ * @brief Schnittstelle der Suche nach Bitfolgen.
+ *
+ * Anders als die Mustersuche findet diese Suche Bitfolgen, die an
+ * beliebiger Bitposition beginnen, etwa in mitgeschnittenen seriellen
+ * Leitungen oder gepackten Bitströmen. Bits werden wie in der
+ * Binäransicht vom höchstwertigen zum niederwertigsten gelesen. Ein
+ * Treffer wird als Byteposition und Bitversatz gemeldet.
+ */
+
+#include <stddef.h>       // stellt den Typ size_t bereit
+#include <stdint.h>       // 64-Bit-Zustandswörter
+#include "Data_Buffer.h" // durchsuchter Inhalt
+
+//* ---------------------------- Globale Konstanten oder Defines --------------------------
+#define BIT_PATTERN_MAX 56          /**< längstes Muster in Bits, Zustand samt 8 Endstellen passt in 64 Bit */
+#define BIT_SEARCH_CHUNK (1u << 20) /**< Bytes je Leseschritt */
+
+//* ------------------------------------- Strukturen --------------------------------------
+/**
+ * @brief Übersetztes Bitmuster.
+ *
+ * `table` fasst für jeden Bytewert die acht Einzelschritte des
+ * Shift-And-Verfahrens zu einer Maske zusammen, sodass je Byte alle
+ * acht Bitversätze zugleich geprüft werden.
+ */
+typedef struct {
+    uint64_t table[256]; /**< Maske je Bytewert */
+    size_t length;       /**< Länge des Musters in Bits */
+} BitPattern;
+
+/**
+ * @brief Fundstelle einer Bitfolge.
+ */
+typedef struct {
+    size_t offset; /**< Byte, in dem die Folge beginnt */
+    int shift;     /**< Bit in diesem Byte, 0 = höchstwertiges */
+} BitHit;
+
+//* ------------------------------------- Funktionen --------------------------------------
+/**
+ * @brief Übersetzt die Eingabe in ein Bitmuster.
+ *
+ * Erlaubt sind `0`, `1` und `?` oder `.` für ein beliebiges Bit;
+ * Leerzeichen und `_` dienen nur der Gliederung (z. B. `0111 1110`).
+ *
+ * @param self Zeiger auf das Muster
+ * @param text Eingabe
+ * @return 0 bei Erfolg, -1 bei ungültiger, leerer oder zu langer Eingabe
+ */
+int bit_search_parse(BitPattern *self, const char *text);
+
+/**
+ * @brief Sucht den ersten Treffer, der ab Bit `from` beginnt.
+ * @param buffer  durchsuchter Buffer
+ * @param pattern Muster
+ * @param from    erste mögliche Startposition in Bits
+ * @param out     erhält die Fundstelle
+ * @return 0 bei Erfolg, -1 wenn es keinen Treffer gibt
+ */
+int bit_search_next(const DataBuffer *buffer, const BitPattern *pattern, uint64_t from,
+                    BitHit *out);
+
+/**
+ * @brief Sucht den letzten Treffer, der vor Bit `before` beginnt.
+ * @param buffer  durchsuchter Buffer
+ * @param pattern Muster
+ * @param before  Startpositionen ab diesem Bit zählen nicht mehr
+ * @param out     erhält die Fundstelle
+ * @return 0 bei Erfolg, -1 wenn es keinen Treffer gibt
+ */
+int bit_search_prev(const DataBuffer *buffer, const BitPattern *pattern, uint64_t before,
+                    BitHit *out);
+
+/**
+ * @brief Startposition einer Fundstelle in Bits.
+ */
+static inline uint64_t bit_hit_position(BitHit hit) {
+    return (uint64_t)hit.offset * 8u + (uint64_t)hit.shift;
+}
+
+#endif // BIT_SEARCH_H
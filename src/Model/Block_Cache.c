@@ -0,0 +1,344 @@
+/**
+ * @file Block_Cache.c
+ * @brief Blockweiser Lese-Cache mit LRU-Verdrängung.
+ *
+ * Jeder Blockplatz steht gleichzeitig in einer Hash-Kette (Suche nach
+ * Blocknummer) und in einer doppelt verketteten Liste nach letzter
+ * Benutzung. Treffer werden an den Anfang der Liste gehängt, beim
+ * Nachladen wird der Platz am Ende wiederverwendet. Alle Operationen
+ * kosten damit konstante Zeit pro Block.
+ */
+
+//* -------------------------------------- Includes ---------------------------------------
+#include "Block_Cache.h"    // Schnittstelle dieses Moduls
+#include <stdlib.h>          // malloc und free
+#include <string.h>          // memcpy und memset
+#include "File_Manager.h"   // positionsgenaues Lesen
+#include "Err_Log.h"        // Fehlerbehandlung
+
+//* ---------------------------- Globale Konstanten oder Defines --------------------------
+// Vorwärtsdeklarationen der Helferfunktionen
+static int lookup(const BlockCache *self, size_t block);
+static int load_block(BlockCache *self, size_t block);
+static void unlink_slot(BlockCache *self, int slot);
+static void push_newest(BlockCache *self, int slot);
+static void hash_remove(BlockCache *self, int slot);
+static size_t hash_block(const BlockCache *self, size_t block);
+static void forget_block(BlockCache *self, size_t block);
+
+//* ------------------------------------- Funktionen --------------------------------------
+/**
+ * @brief Kopiert einen Bereich der Datei über den Cache.
+ *
+ * Fehlende Blöcke werden nachgeladen, getroffene Blöcke als zuletzt
+ * benutzt markiert. Der Bereich muss innerhalb der Datei liegen.
+ *
+ * @param self   Zeiger auf den Cache
+ * @param offset Startposition
+ * @param dest   Ziel-Buffer
+ * @param length Anzahl der Bytes
+ */
+void block_cache_read(BlockCache *self, size_t offset, unsigned char *dest, size_t length) {
+    while (length > 0) {
+        size_t block = offset / BLOCK_CACHE_BLOCK_SIZE;
+        size_t inner = offset % BLOCK_CACHE_BLOCK_SIZE;
+        size_t part = BLOCK_CACHE_BLOCK_SIZE - inner;   // Rest des Blocks
+        if (part > length) {
+            part = length;
+        }
+
+        int slot = lookup(self, block);
+        if (slot < 0) {
+            slot = load_block(self, block);              // Fehlschlag: nachladen
+            if (slot < 0) {
+                fatal_error("block_cache_read", "pread");
+            }
+        } else if (slot != self->newest) {
+            unlink_slot(self, slot);                     // Treffer: nach vorne holen
+            push_newest(self, slot);
+        }
+
+        memcpy(dest, self->data + (size_t)slot * BLOCK_CACHE_BLOCK_SIZE + inner, part);
+        dest += part;
+        offset += part;
+        length -= part;
+    }
+}
+
+/**
+ * @brief Lädt die Blöcke eines Bereichs vorab in den Cache.
+ *
+ * Es wird höchstens die Hälfte der Plätze belegt, damit das Vorladen
+ * nie die gerade sichtbaren Blöcke verdrängt. Lesefehler werden hier
+ * ignoriert und erst beim eigentlichen Zugriff gemeldet.
+ *
+ * @param self   Zeiger auf den Cache
+ * @param offset Startposition
+ * @param length Länge des Bereichs
+ */
+void block_cache_prefetch(BlockCache *self, size_t offset, size_t length) {
+    if (length == 0 || offset >= self->size) {
+        return;
+    }
+    if (length > self->size - offset) {
+        length = self->size - offset; // nicht über das Dateiende hinaus
+    }
+    size_t first = offset / BLOCK_CACHE_BLOCK_SIZE;
+    size_t last = (offset + length - 1) / BLOCK_CACHE_BLOCK_SIZE;
+    size_t limit = (size_t)self->capacity / 2;
+    for (size_t block = first; block <= last && block - first < limit; block++) {
+        if (lookup(self, block) < 0 && load_block(self, block) < 0) {
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Übernimmt die Größe einer gewachsenen Datei.
+ *
+ * Der bisher letzte Block wird verworfen, damit er beim nächsten
+ * Zugriff mit den neuen Bytes und dem aktuellen Dateiende gelesen wird.
+ * Alle anderen Blöcke bleiben gültig.
+ *
+ * @param self Zeiger auf den Cache
+ * @return 1 wenn die Datei gewachsen ist, 0 ohne Zuwachs, -1 bei Fehler
+ */
+int block_cache_grow(BlockCache *self) {
+    size_t size = 0;
+    if (fileSizeOf(self->fd, &size) != 0) {
+        return -1;
+    }
+    if (size <= self->size) {
+        return 0;
+    }
+    if (self->size > 0) {
+        forget_block(self, (self->size - 1) / BLOCK_CACHE_BLOCK_SIZE); // bisheriges Ende neu lesen
+    }
+    self->size = size;
+    return 1;
+}
+
+//* ---------------------------------- Helfer Funktionen ----------------------------------
+/**
+ * @brief Verwirft einen geladenen Block, sein Platz wird als nächster wiederverwendet.
+ */
+static void forget_block(BlockCache *self, size_t block) {
+    int slot = lookup(self, block);
+    if (slot < 0) {
+        return; // nicht geladen
+    }
+    hash_remove(self, slot);
+    unlink_slot(self, slot);
+    self->slots[slot].block = (size_t)-1; // wie nach einem Lesefehler unbelegt
+    self->slots[slot].prev = self->oldest;
+    self->slots[slot].next = -1;
+    if (self->oldest >= 0) {
+        self->slots[self->oldest].next = slot;
+    } else {
+        self->newest = slot;
+    }
+    self->oldest = slot;
+}
+
+/** @brief Bucket einer Blocknummer (Fibonacci-Hashing). */
+static size_t hash_block(const BlockCache *self, size_t block) {
+    unsigned long long mixed = (unsigned long long)block * 0x9E3779B97F4A7C15ull;
+    return (size_t)(mixed >> 32) & self->bucket_mask;
+}
+
+/** @brief Sucht den Platz eines Blocks, -1 wenn nicht geladen. */
+static int lookup(const BlockCache *self, size_t block) {
+    int slot = self->buckets[hash_block(self, block)];
+    while (slot >= 0 && self->slots[slot].block != block) {
+        slot = self->slots[slot].hash_next;
+    }
+    return slot;
+}
+
+/**
+ * @brief Liest einen Block in einen freien oder verdrängten Platz.
+ * @return Platz des Blocks oder -1 bei Lesefehler
+ */
+static int load_block(BlockCache *self, size_t block) {
+    int slot;
+    if (self->used < self->capacity) {
+        slot = self->used++;              // noch freie Plätze vorhanden
+    } else {
+        slot = self->oldest;              // am längsten unbenutzten Block verdrängen
+        unlink_slot(self, slot);
+        hash_remove(self, slot);
+    }
+
+    unsigned char *dest = self->data + (size_t)slot * BLOCK_CACHE_BLOCK_SIZE;
+    size_t start = block * BLOCK_CACHE_BLOCK_SIZE;
+    size_t wanted = self->size - start;
+    if (wanted > BLOCK_CACHE_BLOCK_SIZE) {
+        wanted = BLOCK_CACHE_BLOCK_SIZE;
+    }
+    long long got = readFileAt(self->fd, start, dest, wanted);
+    if (got < 0) {
+        // Platz bleibt unbenutzt am Ende der Liste
+        self->slots[slot].block = (size_t)-1;
+        self->slots[slot].hash_next = -1;
+        self->slots[slot].prev = self->oldest;
+        self->slots[slot].next = -1;
+        if (self->oldest >= 0) {
+            self->slots[self->oldest].next = slot;
+        } else {
+            self->newest = slot;
+        }
+        self->oldest = slot;
+        return -1;
+    }
+    memset(dest + got, 0, BLOCK_CACHE_BLOCK_SIZE - (size_t)got); // Rest hinter dem Ende
+
+    size_t bucket = hash_block(self, block);
+    self->slots[slot].block = block;
+    self->slots[slot].hash_next = self->buckets[bucket]; // vorne in die Kette
+    self->buckets[bucket] = slot;
+    push_newest(self, slot);
+    return slot;
+}
+
+/** @brief Nimmt einen Platz aus der LRU-Liste. */
+static void unlink_slot(BlockCache *self, int slot) {
+    BlockSlot *entry = &self->slots[slot];
+    if (entry->prev >= 0) {
+        self->slots[entry->prev].next = entry->next;
+    } else {
+        self->newest = entry->next;
+    }
+    if (entry->next >= 0) {
+        self->slots[entry->next].prev = entry->prev;
+    } else {
+        self->oldest = entry->prev;
+    }
+    entry->prev = -1;
+    entry->next = -1;
+}
+
+/** @brief Hängt einen Platz als zuletzt benutzt an den Listenanfang. */
+static void push_newest(BlockCache *self, int slot) {
+    BlockSlot *entry = &self->slots[slot];
+    entry->prev = -1;
+    entry->next = self->newest;
+    if (self->newest >= 0) {
+        self->slots[self->newest].prev = slot;
+    }
+    self->newest = slot;
+    if (self->oldest < 0) {
+        self->oldest = slot;
+    }
+}
+
+/** @brief Entfernt einen Platz aus seiner Hash-Kette. */
+static void hash_remove(BlockCache *self, int slot) {
+    if (self->slots[slot].block == (size_t)-1) {
+        return; // Platz war nach einem Lesefehler unbelegt
+    }
+    int *link = &self->buckets[hash_block(self, self->slots[slot].block)];
+    while (*link >= 0 && *link != slot) {
+        link = &self->slots[*link].hash_next;
+    }
+    if (*link == slot) {
+        *link = self->slots[slot].hash_next;
+    }
+    self->slots[slot].hash_next = -1;
+}
+
+//* ----------------------------------- Init und Deinit -----------------------------------
+/**
+ * @brief Öffnet eine Datei und legt den Cache an.
+ *
+ * Der Speicher für die Blöcke wird in einem Stück reserviert, aber erst
+ * beim ersten Lesen eines Blocks tatsächlich belegt.
+ *
+ * @param self   Zeiger auf den Cache
+ * @param path   Dateipfad
+ * @param budget Speicherbudget in Bytes
+ * @return 0 bei Erfolg, sonst -1
+ */
+int block_cache_init(BlockCache *self, const char *path, size_t budget) {
+    int fd = -1;
+    size_t size = 0;
+    if (openFileForRead(path, &fd, &size) != 0) {
+        memset(self, 0, sizeof(*self));
+        self->fd = -1;
+        return -1;
+    }
+    if (block_cache_attach(self, fd, size, budget) != 0) {
+        closeFile(fd);
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Legt den Cache über einem bereits geöffneten Deskriptor an.
+ *
+ * Erst bei Erfolg übernimmt der Cache den Deskriptor und schließt ihn
+ * mit `block_cache_deinit`. Liefert die Datei inzwischen weniger als `size`
+ * Bytes, werden die fehlenden als Nullbytes gelesen.
+ *
+ * @param self   Zeiger auf den Cache
+ * @param fd     lesbarer Deskriptor der Datei
+ * @param size   Größe, die der Cache annimmt
+ * @param budget Speicherbudget in Bytes
+ * @return 0 bei Erfolg, sonst -1
+ */
+int block_cache_attach(BlockCache *self, int fd, size_t size, size_t budget) {
+    memset(self, 0, sizeof(*self));
+    self->fd = fd;
+    self->size = size;
+    self->newest = -1;
+    self->oldest = -1;
+
+    size_t blocks = budget / BLOCK_CACHE_BLOCK_SIZE;
+    size_t fileBlocks = (self->size + BLOCK_CACHE_BLOCK_SIZE - 1) / BLOCK_CACHE_BLOCK_SIZE;
+    if (blocks < BLOCK_CACHE_MIN_BLOCKS) {
+        blocks = BLOCK_CACHE_MIN_BLOCKS;
+    }
+    if (blocks > fileBlocks) {
+        blocks = fileBlocks ? fileBlocks : 1;       // nicht mehr als die Datei braucht
+    }
+    if (blocks > 0x7FFFFFF) {
+        blocks = 0x7FFFFFF;                          // Plätze werden als int gezählt
+    }
+    size_t buckets = 1;
+    while (buckets < blocks * 2) {
+        buckets <<= 1;                               // Zweierpotenz für die Maske
+    }
+
+    self->capacity = (int)blocks;
+    self->bucket_mask = buckets - 1;
+    self->data = malloc(blocks * BLOCK_CACHE_BLOCK_SIZE);
+    self->slots = malloc(blocks * sizeof(*self->slots));
+    self->buckets = malloc(buckets * sizeof(*self->buckets));
+    if (!self->data || !self->slots || !self->buckets) {
+        free(self->data);
+        free(self->slots);
+        free(self->buckets);
+        memset(self, 0, sizeof(*self));
+        self->fd = -1;                               // Deskriptor bleibt beim Aufrufer
+        return -1;
+    }
+    for (size_t i = 0; i < buckets; i++) {
+        self->buckets[i] = -1;                       // alle Ketten leer
+    }
+    return 0;
+}
+
+/**
+ * @brief Gibt alle Blöcke frei und schließt die Datei.
+ * @param self Zeiger auf den Cache
+ * @return 0 bei Erfolg
+ */
+int block_cache_deinit(BlockCache *self) {
+    free(self->data);
+    free(self->slots);
+    free(self->buckets);
+    closeFile(self->fd);
+    memset(self, 0, sizeof(*self));
+    self->fd = -1;
+    return 0;
+}
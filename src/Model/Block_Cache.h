@@ -0,0 +1,90 @@
+#ifndef BLOCK_CACHE_H
+#define BLOCK_CACHE_H
+
+/**
+ * @file Block_Cache.h
+ * @brief Schnittstelle des blockweisen Lese-Caches.
+ *
+ * Der Block-Cache liest eine Datei in Blöcken fester Größe per `pread`
+ * und hält die zuletzt benutzten Blöcke im Speicher. Die Anzahl der
+ * Blöcke ergibt sich aus einem Speicherbudget; ist es ausgeschöpft,
+ * wird der am längsten unbenutzte Block verdrängt (LRU). So bleibt der
+ * Speicherbedarf auch bei Abbildern mit vielen Gigabyte begrenzt.
+ */
+
+#include <stddef.h> // stellt den Typ size_t bereit
+
+//* ---------------------------- Globale Konstanten oder Defines --------------------------
+#define BLOCK_CACHE_BLOCK_SIZE (64 * 1024)              /**< Größe eines Blocks in Bytes */
+#define BLOCK_CACHE_MIN_BLOCKS 16                       /**< Mindestanzahl an Blöcken */
+#define BLOCK_CACHE_DEFAULT_BUDGET (64u * 1024u * 1024u) /**< Budget ohne Vorgabe in Bytes */
+
+//* ------------------------------------- Strukturen --------------------------------------
+/**
+ * @brief Verwaltungsdaten eines Blockplatzes.
+ */
+typedef struct {
+    size_t block;  /**< Nummer des geladenen Blocks */
+    int prev;      /**< zuletzt vorher benutzter Platz, -1 am Anfang */
+    int next;      /**< danach benutzter Platz, -1 am Ende */
+    int hash_next; /**< nächster Platz in derselben Hash-Kette */
+} BlockSlot;
+
+/**
+ * @brief Cache über einem Dateideskriptor.
+ */
+typedef struct {
+    int fd;                /**< Deskriptor der Datei */
+    size_t size;           /**< Größe der Datei in Bytes */
+    unsigned char *data;   /**< Speicher aller Blockplätze */
+    BlockSlot *slots;      /**< Verwaltungsdaten der Plätze */
+    int *buckets;          /**< Hash-Tabelle: Blocknummer -> erster Platz */
+    size_t bucket_mask;    /**< Anzahl der Buckets minus 1 */
+    int capacity;          /**< Anzahl der Plätze */
+    int used;              /**< belegte Plätze */
+    int newest;            /**< zuletzt benutzter Platz */
+    int oldest;            /**< am längsten unbenutzter Platz */
+} BlockCache;
+
+//* ------------------------------------- Funktionen --------------------------------------
+/**
+ * @brief Kopiert einen Bereich der Datei über den Cache.
+ */
+void block_cache_read(BlockCache *self, size_t offset, unsigned char *dest, size_t length);
+
+/**
+ * @brief Lädt die Blöcke eines Bereichs vorab in den Cache.
+ */
+void block_cache_prefetch(BlockCache *self, size_t offset, size_t length);
+
+/**
+ * @brief Übernimmt die Größe einer gewachsenen Datei.
+ */
+int block_cache_grow(BlockCache *self);
+
+//* ----------------------------------- Init und Deinit -----------------------------------
+/**
+ * @brief Öffnet eine Datei und legt den Cache an.
+ * @param self   Zeiger auf den Cache
+ * @param path   Dateipfad
+ * @param budget Speicherbudget in Bytes
+ * @return 0 bei Erfolg, sonst -1
+ */
+int block_cache_init(BlockCache *self, const char *path, size_t budget);
+
+/**
+ * @brief Legt den Cache über einem geöffneten Deskriptor an und übernimmt ihn bei Erfolg.
+ * @param self   Zeiger auf den Cache
+ * @param fd     lesbarer Deskriptor der Datei
+ * @param size   Größe, die der Cache annimmt
+ * @param budget Speicherbudget in Bytes
+ * @return 0 bei Erfolg, sonst -1
+ */
+int block_cache_attach(BlockCache *self, int fd, size_t size, size_t budget);
+
+/**
+ * @brief Gibt alle Blöcke frei und schließt die Datei.
+ */
+int block_cache_deinit(BlockCache *self);
+
+#endif // BLOCK_CACHE_H
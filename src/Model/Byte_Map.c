@@ -0,0 +1,380 @@
+/**
+ * @file Byte_Map.c
+ * @brief Übersicht über Entropie und Byteklassen.
+ *
+ * Je Block wird ein Histogramm der Bytewerte gebildet, aus dem sich
+ * Entropie und Klassenanteile ergeben. Das Histogramm zählt in vier
+ * getrennte Tabellen, damit aufeinanderfolgende gleiche Bytes nicht auf
+ * das Schreiben desselben Zählers warten müssen. Nach jedem Block werden
+ * nur seine Vorfahren in der Pyramide neu zusammengefasst.
+ */
+
+//* -------------------------------------- Includes ---------------------------------------
+#include "Byte_Map.h"   // Schnittstelle dieses Moduls
+#include <stdlib.h>      // calloc, malloc und free
+#include <string.h>      // memset
+#include "Err_Log.h"    // Fehlerbehandlung
+
+//* ---------------------------- Globale Konstanten oder Defines --------------------------
+#define HISTOGRAM_LANES 4 /**< getrennte Zählertabellen je Histogramm */
+#define BYTE_MAP_QUERY_NODES 4 /**< ein Bereich umfasst mindestens so viele Knoten der gewählten Stufe */
+#define LN2 0.69314718055994530942
+
+// Vorwärtsdeklarationen der Helferfunktionen
+static size_t block_size_for(size_t size);
+static void allocate(ByteMap *self, size_t block, size_t leaves);
+static void release(ByteMap *self);
+static void mark_change(ByteMap *self, const DataBufferChange *change);
+static void mark_block(ByteMap *self, size_t leaf);
+static void scan_block(ByteMap *self, size_t leaf);
+static void add_stats(ByteMapStats *sum, const ByteMapStats *part);
+static void add_scaled(ByteMapStats *sum, const ByteMapStats *part, double share);
+static unsigned int entropy_of(const uint32_t *histogram, size_t length);
+static double log2_of(uint64_t value);
+
+//* ------------------------------------- Funktionen --------------------------------------
+/**
+ * @brief Übernimmt die Änderungen des Buffers seit dem letzten Aufruf.
+ */
+void byte_map_sync(ByteMap *self) {
+    const DataBuffer *buffer = self->buffer;
+    if (self->level_count > 0 && self->revision == buffer->revision) {
+        return;
+    }
+    size_t block = block_size_for(buffer->size);
+    size_t leaves = (buffer->size + block - 1) / block;
+    if (leaves == 0) {
+        leaves = 1;
+    }
+    int rebuild = self->level_count == 0 || block != self->block || leaves > self->counts[0];
+    for (unsigned long r = self->revision + 1; !rebuild && r <= buffer->revision; r++) {
+        DataBufferChange change;
+        if (data_buffer_get_change(buffer, r, &change) != 0) {
+            rebuild = 1; // Änderung nicht mehr bekannt
+        } else {
+            mark_change(self, &change);
+        }
+    }
+    if (rebuild) {
+        allocate(self, block, leaves);
+    }
+    self->revision = buffer->revision;
+}
+
+/**
+ * @brief Liest veraltete Blöcke, bis das Budget erschöpft ist.
+ */
+int byte_map_step(ByteMap *self, size_t budget) {
+    size_t done = 0;
+    size_t count = self->counts[0];
+    while (self->stale_count > 0 && done < budget) {
+        while (!self->stale[self->next]) {
+            self->next = (self->next + 1 < count) ? self->next + 1 : 0;
+        }
+        scan_block(self, self->next);
+        done += self->block;
+    }
+    return self->stale_count > 0;
+}
+
+/**
+ * @brief Fasst die Werte eines Bereichs aus der passenden Stufe zusammen.
+ */
+void byte_map_query(const ByteMap *self, size_t start, size_t end, ByteMapStats *out) {
+    memset(out, 0, sizeof(*out));
+    if (self->level_count == 0 || start >= end) {
+        return;
+    }
+    int level = 0;
+    size_t span = self->block; // Bytes je Knoten der gewählten Stufe
+    while (level + 1 < self->level_count && span * BYTE_MAP_QUERY_NODES <= end - start) {
+        level++;
+        span *= 2;
+    }
+    size_t first = start / span;
+    size_t last = (end - 1) / span;
+    if (last >= self->counts[level]) {
+        last = self->counts[level] - 1;
+    }
+    for (size_t i = first; i <= last; i++) { // höchstens BYTE_MAP_QUERY_NODES + 1 Knoten
+        const ByteMapStats *node = &self->levels[level][i];
+        size_t nodeStart = i * span;
+        size_t nodeEnd = nodeStart + (size_t)node->length; // am Dateiende kürzer als `span`
+        size_t from = (start > nodeStart) ? start : nodeStart;
+        size_t to = (end < nodeEnd) ? end : nodeEnd;
+        if (from >= to) {
+            continue;
+        }
+        if (to - from == node->length) {
+            add_stats(out, node);
+        } else {
+            add_scaled(out, node, (double)(to - from) / (double)node->length);
+        }
+    }
+}
+
+/**
+ * @brief Ordnet zusammengefasste Werte einer Byteklasse zu.
+ *
+ * Eine Klasse gilt, wenn mindestens 90 % der Bytes zu ihr gehören.
+ */
+ByteClass byte_map_classify(const ByteMapStats *stats) {
+    uint64_t length = stats->length;
+    if (length == 0) {
+        return BYTE_CLASS_UNKNOWN;
+    }
+    if (stats->zeros * 10 >= length * 9) {
+        return BYTE_CLASS_ZERO;
+    }
+    if (stats->ones * 10 >= length * 9) {
+        return BYTE_CLASS_FF;
+    }
+    if (stats->text * 10 >= length * 9) {
+        return BYTE_CLASS_TEXT;
+    }
+    if (byte_map_entropy(stats) >= BYTE_MAP_RANDOM_ENTROPY) {
+        return BYTE_CLASS_RANDOM;
+    }
+    return BYTE_CLASS_BINARY;
+}
+
+/**
+ * @brief Mittlere Entropie in Millibit je Byte, 0 bis 8000.
+ */
+unsigned int byte_map_entropy(const ByteMapStats *stats) {
+    if (stats->length == 0) {
+        return 0;
+    }
+    return (unsigned int)(stats->entropy_sum / stats->length);
+}
+
+//* ---------------------------------- Helfer Funktionen ----------------------------------
+/** @brief Blockgröße, bei der höchstens `BYTE_MAP_MAX_BLOCKS` Blöcke entstehen. */
+static size_t block_size_for(size_t size) {
+    size_t block = BYTE_MAP_BLOCK;
+    while (size / block >= BYTE_MAP_MAX_BLOCKS) {
+        block *= 2;
+    }
+    return block;
+}
+
+/**
+ * @brief Legt die Stufen für mindestens `leaves` Blöcke an und markiert alle als veraltet.
+ *
+ * Die Zahl der Blockplätze wird auf eine Zweierpotenz aufgerundet, damit
+ * wachsende Dateien nicht bei jedem neuen Block alles neu lesen.
+ */
+static void allocate(ByteMap *self, size_t block, size_t leaves) {
+    release(self);
+    size_t count = 1;
+    while (count < leaves) {
+        count *= 2;
+    }
+    for (int level = 0; level < BYTE_MAP_LEVELS; level++) {
+        self->levels[level] = (ByteMapStats *)calloc(count, sizeof(ByteMapStats));
+        if (!self->levels[level]) {
+            fatal_error("byte_map", "out of memory");
+        }
+        self->counts[level] = count;
+        self->level_count = level + 1;
+        if (count == 1) {
+            break; // Spitze erreicht
+        }
+        count /= 2;
+    }
+    self->stale = (unsigned char *)malloc(self->counts[0]);
+    self->scratch = (unsigned char *)malloc(block);
+    if (!self->stale || !self->scratch) {
+        fatal_error("byte_map", "out of memory");
+    }
+    memset(self->stale, 1, self->counts[0]);
+    self->stale_count = self->counts[0];
+    self->next = 0;
+    self->block = block;
+}
+
+/** @brief Gibt Stufen und Puffer frei. */
+static void release(ByteMap *self) {
+    for (int level = 0; level < self->level_count; level++) {
+        free(self->levels[level]);
+        self->levels[level] = NULL;
+    }
+    self->level_count = 0;
+    free(self->stale);
+    free(self->scratch);
+    self->stale = NULL;
+    self->scratch = NULL;
+}
+
+/**
+ * @brief Markiert die Blöcke, die eine Änderung betrifft.
+ *
+ * Beim Überschreiben sind das die Blöcke des Bereichs, sonst alle ab
+ * dem Beginn der Änderung, weil sich die folgenden Bytes verschoben haben.
+ */
+static void mark_change(ByteMap *self, const DataBufferChange *change) {
+    size_t first = change->start / self->block;
+    size_t last = self->counts[0] - 1;
+    if (change->removed == change->added) {
+        if (change->added == 0) {
+            return;
+        }
+        last = (change->start + change->added - 1) / self->block;
+    }
+    if (last >= self->counts[0]) {
+        last = self->counts[0] - 1;
+    }
+    for (size_t leaf = first; leaf <= last; leaf++) {
+        mark_block(self, leaf);
+    }
+}
+
+/** @brief Markiert einen Block als veraltet; seine bisherigen Werte bleiben bis zum Lesen. */
+static void mark_block(ByteMap *self, size_t leaf) {
+    if (!self->stale[leaf]) {
+        self->stale[leaf] = 1;
+        self->stale_count++;
+    }
+}
+
+/**
+ * @brief Liest einen Block, bestimmt seine Werte und fasst seine Vorfahren neu zusammen.
+ */
+static void scan_block(ByteMap *self, size_t leaf) {
+    size_t size = self->buffer->size;
+    size_t start = leaf * self->block;
+    size_t length = 0;
+    if (start < size) {
+        length = (size - start < self->block) ? size - start : self->block;
+        data_buffer_get_range(self->buffer, start, start + length, self->scratch);
+    }
+
+    uint32_t lanes[HISTOGRAM_LANES][256];
+    memset(lanes, 0, sizeof(lanes));
+    const unsigned char *data = self->scratch;
+    size_t i = 0;
+    for (; i + HISTOGRAM_LANES <= length; i += HISTOGRAM_LANES) {
+        lanes[0][data[i]]++;
+        lanes[1][data[i + 1]]++;
+        lanes[2][data[i + 2]]++;
+        lanes[3][data[i + 3]]++;
+    }
+    for (; i < length; i++) {
+        lanes[0][data[i]]++;
+    }
+    uint32_t histogram[256];
+    uint64_t text = 0;
+    for (int value = 0; value < 256; value++) {
+        histogram[value] = lanes[0][value] + lanes[1][value] + lanes[2][value] + lanes[3][value];
+        if ((value >= 0x20 && value < 0x7F) || value == '\t' || value == '\n' || value == '\r') {
+            text += histogram[value];
+        }
+    }
+
+    ByteMapStats *stats = &self->levels[0][leaf];
+    stats->length = length;
+    stats->zeros = histogram[0x00];
+    stats->ones = histogram[0xFF];
+    stats->text = text;
+    stats->entropy_sum = (uint64_t)entropy_of(histogram, length) * length;
+    self->stale[leaf] = 0;
+    self->stale_count--;
+
+    size_t node = leaf;
+    for (int level = 1; level < self->level_count; level++) { // Vorfahren neu zusammenfassen
+        node /= 2;
+        ByteMapStats *parent = &self->levels[level][node];
+        *parent = self->levels[level - 1][2 * node];
+        add_stats(parent, &self->levels[level - 1][2 * node + 1]);
+    }
+}
+
+/** @brief Addiert die Werte eines Teilbereichs. */
+static void add_stats(ByteMapStats *sum, const ByteMapStats *part) {
+    sum->length += part->length;
+    sum->zeros += part->zeros;
+    sum->ones += part->ones;
+    sum->text += part->text;
+    sum->entropy_sum += part->entropy_sum;
+}
+
+/**
+ * @brief Addiert den Anteil `share` eines angeschnittenen Knotens.
+ *
+ * Angenommen wird, dass sich die Werte gleichmäßig über den Knoten
+ * verteilen; so stehen Randknoten nicht voll im Ergebnis.
+ */
+static void add_scaled(ByteMapStats *sum, const ByteMapStats *part, double share) {
+    sum->length += (uint64_t)((double)part->length * share + 0.5);
+    sum->zeros += (uint64_t)((double)part->zeros * share + 0.5);
+    sum->ones += (uint64_t)((double)part->ones * share + 0.5);
+    sum->text += (uint64_t)((double)part->text * share + 0.5);
+    sum->entropy_sum += (uint64_t)((double)part->entropy_sum * share + 0.5);
+}
+
+/**
+ * @brief Shannon-Entropie eines Histogramms in Millibit je Byte.
+ *
+ * Nutzt H = log2(n) - Σ c·log2(c) / n und kommt so ohne Division je
+ * Bytewert aus.
+ */
+static unsigned int entropy_of(const uint32_t *histogram, size_t length) {
+    if (length == 0) {
+        return 0;
+    }
+    double sum = 0.0;
+    for (int value = 0; value < 256; value++) {
+        if (histogram[value] > 1) {
+            sum += (double)histogram[value] * log2_of(histogram[value]);
+        }
+    }
+    double bits = log2_of(length) - sum / (double)length;
+    if (bits < 0.0) {
+        bits = 0.0;
+    }
+    return (unsigned int)(bits * 1000.0 + 0.5);
+}
+
+/**
+ * @brief Zweierlogarithmus einer positiven Ganzzahl ohne libm.
+ *
+ * Der Wert wird in Mantisse m aus [1, 2) und Exponent zerlegt, ln(m)
+ * über die Reihe 2·(t + t³/3 + t⁵/5 + …) mit t = (m - 1) / (m + 1)
+ * bestimmt; für t ≤ 1/3 genügen fünf Glieder.
+ */
+static double log2_of(uint64_t value) {
+    double mantissa = (double)value;
+    int exponent = 0;
+    while (mantissa >= 65536.0) {
+        mantissa /= 65536.0;
+        exponent += 16;
+    }
+    while (mantissa >= 2.0) {
+        mantissa *= 0.5;
+        exponent++;
+    }
+    double t = (mantissa - 1.0) / (mantissa + 1.0);
+    double t2 = t * t;
+    double ln = 2.0 * t * (1.0 + t2 * (1.0 / 3 + t2 * (1.0 / 5 + t2 * (1.0 / 7 + t2 / 9))));
+    return (double)exponent + ln / LN2;
+}
+
+//* ----------------------------------- Init und Deinit -----------------------------------
+/**
+ * @brief Initialisiert die Übersicht; alle Blöcke stehen zum Lesen an.
+ */
+int byte_map_init(ByteMap *self, const DataBuffer *buffer) {
+    memset(self, 0, sizeof(*self));
+    self->buffer = buffer;
+    byte_map_sync(self);
+    return 0;
+}
+
+/**
+ * @brief Gibt alle Stufen frei.
+ */
+int byte_map_deinit(ByteMap *self) {
+    release(self);
+    memset(self, 0, sizeof(*self));
+    return 0;
+}
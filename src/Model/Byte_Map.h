@@ -0,0 +1,138 @@
+#ifndef BYTE_MAP_H
+#define BYTE_MAP_H
+
+/**
+ * @file Byte_Map.h
+ * @brief Schnittstelle der Übersicht über Entropie und Byteklassen.
+ *
+ * Für jeden Block des Inhalts werden Entropie und die Anteile von
+ * Nullbytes, 0xFF und Text ermittelt. Die Werte liegen in einer
+ * Pyramide: Stufe 0 hält die Blöcke, jede weitere Stufe fasst je zwei
+ * Knoten der Stufe darunter zusammen. Ein beliebig großer Bereich ist
+ * so aus wenigen Knoten einer passenden Stufe abzulesen, eine Übersicht
+ * über die ganze Datei kostet je Zeile O(1).
+ *
+ * Berechnet wird schrittweise zwischen den Eingaben. Nach einer
+ * Bearbeitung werden nur die betroffenen Blöcke neu gelesen; bis dahin
+ * gelten ihre bisherigen Werte.
+ */
+
+#include <stddef.h>        // stellt den Typ size_t bereit
+#include <stdint.h>        // feste Breiten für Zähler
+#include "Data_Buffer.h"  // untersuchter Inhalt
+
+//* ---------------------------- Globale Konstanten oder Defines --------------------------
+#define BYTE_MAP_BLOCK 4096             /**< kleinste Blockgröße in Bytes */
+#define BYTE_MAP_MAX_BLOCKS (1u << 16)  /**< größere Inhalte bekommen größere Blöcke */
+#define BYTE_MAP_LEVELS 48              /**< höchstens so viele Stufen der Pyramide */
+#define BYTE_MAP_RANDOM_ENTROPY 7200    /**< ab dieser Entropie in Millibit gilt ein Bereich als zufällig */
+
+//* ------------------------------------- Strukturen --------------------------------------
+/**
+ * @brief Überwiegende Art der Bytes eines Bereichs.
+ */
+typedef enum {
+    BYTE_CLASS_UNKNOWN, /**< noch nicht untersucht */
+    BYTE_CLASS_ZERO,    /**< fast nur Nullbytes */
+    BYTE_CLASS_FF,      /**< fast nur 0xFF, etwa gelöschter Flash */
+    BYTE_CLASS_TEXT,    /**< fast nur druckbare Zeichen und Zeilenumbrüche */
+    BYTE_CLASS_RANDOM,  /**< hohe Entropie: komprimiert oder verschlüsselt */
+    BYTE_CLASS_BINARY   /**< alles andere, etwa Code oder Tabellen */
+} ByteClass;
+
+/**
+ * @brief Zusammengefasste Werte eines Bereichs.
+ *
+ * Die Entropie eines Knotens ist das nach Länge gewichtete Mittel der
+ * Entropie seiner Blöcke. Sie beschreibt damit, wie dicht die Daten
+ * lokal gepackt sind, und lässt sich ohne Histogramme zusammenfassen.
+ */
+typedef struct {
+    uint64_t length;      /**< untersuchte Bytes */
+    uint64_t zeros;       /**< davon Nullbytes */
+    uint64_t ones;        /**< davon 0xFF */
+    uint64_t text;        /**< davon druckbare Zeichen, Tabulator und Zeilenumbrüche */
+    uint64_t entropy_sum; /**< Summe aus Blockentropie in Millibit mal Blocklänge */
+} ByteMapStats;
+
+/**
+ * @brief Pyramide der Blockwerte über einem Buffer.
+ */
+typedef struct {
+    const DataBuffer *buffer;                 /**< untersuchter Buffer */
+    ByteMapStats *levels[BYTE_MAP_LEVELS];    /**< Knoten je Stufe, Stufe 0 = Blöcke */
+    size_t counts[BYTE_MAP_LEVELS];           /**< Anzahl der Knoten je Stufe */
+    int level_count;                          /**< belegte Stufen */
+    unsigned char *stale;                     /**< je Block 1 = neu zu lesen */
+    size_t stale_count;                       /**< Anzahl neu zu lesender Blöcke */
+    size_t next;                              /**< ab hier wird nach veralteten Blöcken gesucht */
+    size_t block;                             /**< Bytes je Block */
+    unsigned long revision;                   /**< Stand des Buffers, dessen Änderungen übernommen sind */
+    unsigned char *scratch;                   /**< ein Block zum Lesen */
+} ByteMap;
+
+//* ------------------------------------- Funktionen --------------------------------------
+/**
+ * @brief Übernimmt die Änderungen des Buffers seit dem letzten Aufruf.
+ *
+ * Betroffene Blöcke werden nur markiert, gelesen wird in
+ * `byte_map_step`. Sind Änderungen nicht mehr bekannt oder passt die
+ * Blockgröße nicht mehr, werden alle Blöcke neu gelesen.
+ *
+ * @param self Zeiger auf die Übersicht
+ */
+void byte_map_sync(ByteMap *self);
+
+/**
+ * @brief Liest veraltete Blöcke, bis das Budget erschöpft ist.
+ * @param self   Zeiger auf die Übersicht
+ * @param budget höchstens so viele Bytes lesen
+ * @return 1 wenn noch Blöcke ausstehen, sonst 0
+ */
+int byte_map_step(ByteMap *self, size_t budget);
+
+/**
+ * @brief Prüft, ob noch Blöcke gelesen werden müssen.
+ */
+static inline int byte_map_pending(const ByteMap *self) {
+    return self->stale_count > 0;
+}
+
+/**
+ * @brief Fasst die Werte eines Bereichs aus der passenden Stufe zusammen.
+ *
+ * Gewählt wird die gröbste Stufe, von deren Knoten mindestens vier in
+ * den Bereich passen; angeschnittene Randknoten zählen anteilig.
+ *
+ * @param self  Zeiger auf die Übersicht
+ * @param start erstes Byte
+ * @param end   hinter dem letzten Byte
+ * @param out   erhält die Werte
+ */
+void byte_map_query(const ByteMap *self, size_t start, size_t end, ByteMapStats *out);
+
+/**
+ * @brief Ordnet zusammengefasste Werte einer Byteklasse zu.
+ */
+ByteClass byte_map_classify(const ByteMapStats *stats);
+
+/**
+ * @brief Mittlere Entropie in Millibit je Byte, 0 bis 8000.
+ */
+unsigned int byte_map_entropy(const ByteMapStats *stats);
+
+//* ----------------------------------- Init und Deinit -----------------------------------
+/**
+ * @brief Initialisiert die Übersicht; alle Blöcke stehen zum Lesen an.
+ * @param self   Zeiger auf die Übersicht
+ * @param buffer untersuchter Buffer
+ * @return 0 bei Erfolg
+ */
+int byte_map_init(ByteMap *self, const DataBuffer *buffer);
+
+/**
+ * @brief Gibt alle Stufen frei.
+ */
+int byte_map_deinit(ByteMap *self);
+
+#endif // BYTE_MAP_H
@@ -0,0 +1,329 @@
+/**
+ * @file Byte_Scan.c
+ * @brief Vektorisierte Byte-Vergleiche.
+ *
+ * Jede Variante vergleicht ganze Vektoren und prüft nur, ob die
+ * Vergleichsmaske vollständig der gesuchten Bedingung entspricht. Erst
+ * im ersten abweichenden Vektor wird die genaue Position per
+ * Bit-Suche bestimmt. Lange gleiche Bereiche werden so mit voller
+ * Speicherbandbreite übersprungen.
+ */
+
+//* -------------------------------------- Includes ---------------------------------------
+#include "Byte_Scan.h" // Schnittstelle dieses Moduls
+#include <stdint.h>     // feste Breiten für den Ganzzahlvergleich
+#include <string.h>     // memcpy für unausgerichtete Ladezugriffe
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define BYTE_SCAN_X86 1
+#include <immintrin.h>  // SSE2- und AVX2-Intrinsics
+#endif
+
+//* ---------------------------- Globale Konstanten oder Defines --------------------------
+/** Signatur einer Vergleichsvariante */
+typedef size_t (*RunKernel)(const unsigned char *a, const unsigned char *b, size_t length,
+                            int equal);
+/** Signatur einer Suchvariante */
+typedef size_t (*FindKernel)(const unsigned char *data, size_t count, const ByteProbe *first,
+                             const ByteProbe *second);
+
+#define LOW_BITS 0x0101010101010101ull  /**< niedrigstes Bit jedes Bytes */
+#define HIGH_BITS 0x8080808080808080ull /**< höchstes Bit jedes Bytes */
+
+// Vorwärtsdeklarationen der Helferfunktionen
+static size_t run_words(const unsigned char *a, const unsigned char *b, size_t length,
+                        int equal);
+static size_t run_back_words(const unsigned char *a, const unsigned char *b, size_t length,
+                             int equal);
+static int word_matches(uint64_t difference, int equal);
+static size_t find_bytes(const unsigned char *data, size_t count, const ByteProbe *first,
+                         const ByteProbe *second);
+static void select_kernels(void);
+
+static RunKernel runKernel = NULL;     /**< gewählte Variante für die Vorwärtssuche */
+static RunKernel runBackKernel = NULL; /**< gewählte Variante für die Rückwärtssuche */
+static FindKernel findKernel = NULL;   /**< gewählte Variante für die Kandidatensuche */
+
+//* ------------------------------------- Funktionen --------------------------------------
+/**
+ * @brief Länge des Anfangs, in dem `a` und `b` gleich bzw. verschieden sind.
+ * @param a      erster Bereich
+ * @param b      zweiter Bereich
+ * @param length Länge beider Bereiche
+ * @param equal  1 = gleiche Bytes zählen, 0 = verschiedene Bytes zählen
+ * @return Anzahl der Bytes bis zum ersten abweichenden Byte, `length` wenn keins
+ */
+size_t byte_scan_run(const unsigned char *a, const unsigned char *b, size_t length, int equal) {
+    if (!runKernel) {
+        select_kernels(); // einmalig, das Ergebnis ist bei jedem Aufruf gleich
+    }
+    return runKernel(a, b, length, equal);
+}
+
+/**
+ * @brief Länge des Endes, in dem `a` und `b` gleich bzw. verschieden sind.
+ * @param a      erster Bereich
+ * @param b      zweiter Bereich
+ * @param length Länge beider Bereiche
+ * @param equal  1 = gleiche Bytes zählen, 0 = verschiedene Bytes zählen
+ * @return Anzahl der Bytes ab dem letzten abweichenden Byte, `length` wenn keins
+ */
+size_t byte_scan_run_back(const unsigned char *a, const unsigned char *b, size_t length,
+                          int equal) {
+    if (!runBackKernel) {
+        select_kernels();
+    }
+    return runBackKernel(a, b, length, equal);
+}
+
+/**
+ * @brief Sucht die erste Position, an der beide Bedingungen erfüllt sind.
+ *
+ * Zwei Bedingungen filtern deutlich stärker als eine: Bei seltenen
+ * Bytes bleibt kaum ein Kandidat übrig, der vollständig geprüft werden
+ * muss.
+ *
+ * @param data   Daten
+ * @param count  Anzahl der zu prüfenden Positionen
+ * @param first  erste Bedingung
+ * @param second zweite Bedingung, darf gleich der ersten sein
+ * @return erste passende Position, `count` wenn keine
+ */
+size_t byte_scan_find(const unsigned char *data, size_t count, const ByteProbe *first,
+                      const ByteProbe *second) {
+    if (!findKernel) {
+        select_kernels();
+    }
+    return findKernel(data, count, first, second);
+}
+
+/**
+ * @brief Ermittelt die passenden Varianten vorab.
+ *
+ * Die Auswahl beim ersten Aufruf ist sonst nicht gegen gleichzeitige
+ * Aufrufe aus mehreren Threads geschützt.
+ */
+void byte_scan_prepare(void) {
+    if (!findKernel) {
+        select_kernels();
+    }
+}
+
+//* ---------------------------------- Helfer Funktionen ----------------------------------
+/** @brief Kandidatensuche Byte für Byte. */
+static size_t find_bytes(const unsigned char *data, size_t count, const ByteProbe *first,
+                         const ByteProbe *second) {
+    const unsigned char *a = data + first->offset;
+    const unsigned char *b = data + second->offset;
+    for (size_t i = 0; i < count; i++) {
+        if ((a[i] & first->mask) == first->value && (b[i] & second->mask) == second->value) {
+            return i;
+        }
+    }
+    return count;
+}
+
+/**
+ * @brief Prüft, ob alle 8 Bytes eines XOR-Ergebnisses die Bedingung erfüllen.
+ *
+ * Gleiche Bytes ergeben 0. Für verschiedene Bytes darf daher kein
+ * Null-Byte enthalten sein (klassischer Null-Byte-Test).
+ */
+static int word_matches(uint64_t difference, int equal) {
+    if (equal) {
+        return difference == 0;
+    }
+    return ((difference - LOW_BITS) & ~difference & HIGH_BITS) == 0;
+}
+
+/** @brief Vorwärtssuche mit 8 Bytes je Schritt, Rest Byte für Byte. */
+static size_t run_words(const unsigned char *a, const unsigned char *b, size_t length,
+                        int equal) {
+    size_t i = 0;
+    for (; i + 8 <= length; i += 8) {
+        uint64_t x;
+        uint64_t y;
+        memcpy(&x, a + i, 8);
+        memcpy(&y, b + i, 8);
+        if (!word_matches(x ^ y, equal)) {
+            break; // Abweichung liegt in diesem Wort
+        }
+    }
+    for (; i < length; i++) {
+        if ((a[i] == b[i]) != equal) {
+            return i;
+        }
+    }
+    return length;
+}
+
+/** @brief Rückwärtssuche mit 8 Bytes je Schritt, Rest Byte für Byte. */
+static size_t run_back_words(const unsigned char *a, const unsigned char *b, size_t length,
+                             int equal) {
+    size_t end = length;
+    for (; end >= 8; end -= 8) {
+        uint64_t x;
+        uint64_t y;
+        memcpy(&x, a + end - 8, 8);
+        memcpy(&y, b + end - 8, 8);
+        if (!word_matches(x ^ y, equal)) {
+            break;
+        }
+    }
+    while (end > 0) {
+        if ((a[end - 1] == b[end - 1]) != equal) {
+            return length - end;
+        }
+        end--;
+    }
+    return length;
+}
+
+#ifdef BYTE_SCAN_X86
+/**
+ * @brief Vorwärtssuche mit 16 Bytes je Schritt.
+ *
+ * `want` ist die Maske, bei der alle Bytes die Bedingung erfüllen; die
+ * gesetzten Bits von `mask ^ want` markieren die abweichenden Bytes.
+ */
+__attribute__((target("sse2")))
+static size_t run_sse2(const unsigned char *a, const unsigned char *b, size_t length,
+                       int equal) {
+    unsigned int want = equal ? 0xFFFFu : 0u;
+    size_t i = 0;
+    for (; i + 16 <= length; i += 16) {
+        __m128i x = _mm_loadu_si128((const __m128i *)(a + i));
+        __m128i y = _mm_loadu_si128((const __m128i *)(b + i));
+        unsigned int miss = ((unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(x, y)) ^ want) & 0xFFFFu;
+        if (miss) {
+            return i + (size_t)__builtin_ctz(miss);
+        }
+    }
+    return i + run_words(a + i, b + i, length - i, equal);
+}
+
+/** @brief Rückwärtssuche mit 16 Bytes je Schritt. */
+__attribute__((target("sse2")))
+static size_t run_back_sse2(const unsigned char *a, const unsigned char *b, size_t length,
+                            int equal) {
+    unsigned int want = equal ? 0xFFFFu : 0u;
+    size_t end = length;
+    for (; end >= 16; end -= 16) {
+        __m128i x = _mm_loadu_si128((const __m128i *)(a + end - 16));
+        __m128i y = _mm_loadu_si128((const __m128i *)(b + end - 16));
+        unsigned int miss = ((unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(x, y)) ^ want) & 0xFFFFu;
+        if (miss) {
+            size_t last = end - 16 + (size_t)(31 - __builtin_clz(miss)); // letztes abweichendes Byte
+            return length - last - 1;
+        }
+    }
+    return (length - end) + run_back_words(a, b, end, equal);
+}
+
+/** @brief Vorwärtssuche mit 32 Bytes je Schritt. */
+__attribute__((target("avx2")))
+static size_t run_avx2(const unsigned char *a, const unsigned char *b, size_t length,
+                       int equal) {
+    unsigned int want = equal ? 0xFFFFFFFFu : 0u;
+    size_t i = 0;
+    for (; i + 32 <= length; i += 32) {
+        __m256i x = _mm256_loadu_si256((const __m256i *)(a + i));
+        __m256i y = _mm256_loadu_si256((const __m256i *)(b + i));
+        unsigned int miss = (unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(x, y)) ^ want;
+        if (miss) {
+            return i + (size_t)__builtin_ctz(miss);
+        }
+    }
+    return i + run_sse2(a + i, b + i, length - i, equal);
+}
+
+/** @brief Rückwärtssuche mit 32 Bytes je Schritt. */
+__attribute__((target("avx2")))
+static size_t run_back_avx2(const unsigned char *a, const unsigned char *b, size_t length,
+                            int equal) {
+    unsigned int want = equal ? 0xFFFFFFFFu : 0u;
+    size_t end = length;
+    for (; end >= 32; end -= 32) {
+        __m256i x = _mm256_loadu_si256((const __m256i *)(a + end - 32));
+        __m256i y = _mm256_loadu_si256((const __m256i *)(b + end - 32));
+        unsigned int miss = (unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(x, y)) ^ want;
+        if (miss) {
+            size_t last = end - 32 + (size_t)(31 - __builtin_clz(miss));
+            return length - last - 1;
+        }
+    }
+    return (length - end) + run_back_sse2(a, b, end, equal);
+}
+
+/** @brief Kandidatensuche mit 16 Positionen je Schritt. */
+__attribute__((target("sse2")))
+static size_t find_sse2(const unsigned char *data, size_t count, const ByteProbe *first,
+                        const ByteProbe *second) {
+    const unsigned char *a = data + first->offset;
+    const unsigned char *b = data + second->offset;
+    __m128i maskA = _mm_set1_epi8((char)first->mask);
+    __m128i valueA = _mm_set1_epi8((char)first->value);
+    __m128i maskB = _mm_set1_epi8((char)second->mask);
+    __m128i valueB = _mm_set1_epi8((char)second->value);
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m128i x = _mm_and_si128(_mm_loadu_si128((const __m128i *)(a + i)), maskA);
+        __m128i y = _mm_and_si128(_mm_loadu_si128((const __m128i *)(b + i)), maskB);
+        __m128i hit = _mm_and_si128(_mm_cmpeq_epi8(x, valueA), _mm_cmpeq_epi8(y, valueB));
+        unsigned int bits = (unsigned int)_mm_movemask_epi8(hit);
+        if (bits) {
+            return i + (size_t)__builtin_ctz(bits);
+        }
+    }
+    ByteProbe restFirst = { first->offset + i, first->mask, first->value };
+    ByteProbe restSecond = { second->offset + i, second->mask, second->value };
+    return i + find_bytes(data, count - i, &restFirst, &restSecond);
+}
+
+/** @brief Kandidatensuche mit 32 Positionen je Schritt. */
+__attribute__((target("avx2")))
+static size_t find_avx2(const unsigned char *data, size_t count, const ByteProbe *first,
+                        const ByteProbe *second) {
+    const unsigned char *a = data + first->offset;
+    const unsigned char *b = data + second->offset;
+    __m256i maskA = _mm256_set1_epi8((char)first->mask);
+    __m256i valueA = _mm256_set1_epi8((char)first->value);
+    __m256i maskB = _mm256_set1_epi8((char)second->mask);
+    __m256i valueB = _mm256_set1_epi8((char)second->value);
+    size_t i = 0;
+    for (; i + 32 <= count; i += 32) {
+        __m256i x = _mm256_and_si256(_mm256_loadu_si256((const __m256i *)(a + i)), maskA);
+        __m256i y = _mm256_and_si256(_mm256_loadu_si256((const __m256i *)(b + i)), maskB);
+        __m256i hit = _mm256_and_si256(_mm256_cmpeq_epi8(x, valueA), _mm256_cmpeq_epi8(y, valueB));
+        unsigned int bits = (unsigned int)_mm256_movemask_epi8(hit);
+        if (bits) {
+            return i + (size_t)__builtin_ctz(bits);
+        }
+    }
+    ByteProbe restFirst = { first->offset + i, first->mask, first->value };
+    ByteProbe restSecond = { second->offset + i, second->mask, second->value };
+    return i + find_sse2(data, count - i, &restFirst, &restSecond);
+}
+#endif // BYTE_SCAN_X86
+
+/** @brief Wählt die schnellste Variante, die der Prozessor unterstützt. */
+static void select_kernels(void) {
+#ifdef BYTE_SCAN_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        findKernel = find_avx2;
+        runBackKernel = run_back_avx2;
+        runKernel = run_avx2;
+        return;
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        findKernel = find_sse2;
+        runBackKernel = run_back_sse2;
+        runKernel = run_sse2;
+        return;
+    }
+#endif
+    findKernel = find_bytes;
+    runBackKernel = run_back_words;
+    runKernel = run_words;
+}
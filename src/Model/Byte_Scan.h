@@ -0,0 +1,73 @@
+#ifndef BYTE_SCAN_H
+#define BYTE_SCAN_H
+
+/**
+ * @file Byte_Scan.h
+ * @brief Schnittstelle der vektorisierten Byte-Vergleiche.
+ *
+ * Die Funktionen vergleichen zwei Speicherbereiche Byte für Byte und
+ * liefern, wie lange eine Folge gleicher bzw. unterschiedlicher Bytes
+ * anhält, oder suchen Kandidaten für ein Muster anhand zweier Bytes
+ * mit festem Abstand. Auf x86 werden dafür 32 (AVX2) oder 16 Bytes
+ * (SSE2) je Schritt verglichen; welche Variante der Prozessor kann, wird beim
+ * ersten Aufruf einmalig ermittelt. Andere Plattformen vergleichen
+ * 8 Bytes je Schritt als Ganzzahl.
+ */
+
+#include <stddef.h> // stellt den Typ size_t bereit
+
+//* ------------------------------------- Strukturen --------------------------------------
+/**
+ * @brief Bedingung an ein Byte mit festem Abstand: `(data[offset] & mask) == value`.
+ */
+typedef struct {
+    size_t offset;       /**< Abstand zum Kandidaten */
+    unsigned char mask;  /**< zu prüfende Bits */
+    unsigned char value; /**< erwarteter Wert der geprüften Bits */
+} ByteProbe;
+
+//* ------------------------------------- Funktionen --------------------------------------
+/**
+ * @brief Länge des Anfangs, in dem `a` und `b` gleich bzw. verschieden sind.
+ * @param a      erster Bereich
+ * @param b      zweiter Bereich
+ * @param length Länge beider Bereiche
+ * @param equal  1 = gleiche Bytes zählen, 0 = verschiedene Bytes zählen
+ * @return Anzahl der Bytes bis zum ersten abweichenden Byte, `length` wenn keins
+ */
+size_t byte_scan_run(const unsigned char *a, const unsigned char *b, size_t length, int equal);
+
+/**
+ * @brief Länge des Endes, in dem `a` und `b` gleich bzw. verschieden sind.
+ * @param a      erster Bereich
+ * @param b      zweiter Bereich
+ * @param length Länge beider Bereiche
+ * @param equal  1 = gleiche Bytes zählen, 0 = verschiedene Bytes zählen
+ * @return Anzahl der Bytes ab dem letzten abweichenden Byte, `length` wenn keins
+ */
+size_t byte_scan_run_back(const unsigned char *a, const unsigned char *b, size_t length,
+                          int equal);
+
+/**
+ * @brief Sucht die erste Position, an der beide Bedingungen erfüllt sind.
+ *
+ * Gelesen wird bis `data[count - 1 + offset]` der beiden Bedingungen.
+ *
+ * @param data   Daten
+ * @param count  Anzahl der zu prüfenden Positionen
+ * @param first  erste Bedingung
+ * @param second zweite Bedingung, darf gleich der ersten sein
+ * @return erste passende Position, `count` wenn keine
+ */
+size_t byte_scan_find(const unsigned char *data, size_t count, const ByteProbe *first,
+                      const ByteProbe *second);
+
+/**
+ * @brief Ermittelt die passenden Varianten vorab.
+ *
+ * Muss aufgerufen werden, bevor mehrere Threads die Funktionen
+ * gleichzeitig zum ersten Mal nutzen.
+ */
+void byte_scan_prepare(void);
+
+#endif // BYTE_SCAN_H
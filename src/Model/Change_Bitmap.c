@@ -0,0 +1,376 @@
+/**
+ * @file Change_Bitmap.c
+ * @brief Bitmap geänderter Bytes mit Zusammenfassungen je 64 Wörter.
+ *
+ * Gesucht wird wie in einem Baum mit 64 Kindern je Knoten: Hat das Wort
+ * der aktuellen Stufe ab der Position keinen Kandidaten, geht es eine
+ * Stufe höher zum nächsten Wort, sonst wieder hinab bis zum Bit. Beim
+ * Setzen werden nur die Zusammenfassungen der berührten Wörter
+ * erneuert. Einfügen und Löschen verschieben alle Bits dahinter
+ * wortweise.
+ */
+
+//* -------------------------------------- Includes ---------------------------------------
+#include "Change_Bitmap.h" // Schnittstelle dieses Moduls
+#include <stdlib.h>         // calloc, realloc und free
+#include <string.h>         // memset
+#include "Err_Log.h"       // Fehlerbehandlung
+
+//* ---------------------------- Globale Konstanten oder Defines --------------------------
+#define ALL_BITS (~(uint64_t)0) /**< vollständig gesetztes Wort */
+
+// Vorwärtsdeklarationen der Helferfunktionen
+static void ensure_capacity(ChangeBitmap *self, size_t size);
+static void build_levels(ChangeBitmap *self);
+static void update_levels(ChangeBitmap *self, size_t first, size_t last);
+static uint64_t level_word(const ChangeBitmap *self, int level, size_t index, int value);
+static uint64_t range_mask(size_t from, size_t to);
+static size_t count_range(const ChangeBitmap *self, size_t start, size_t end);
+static void free_levels(ChangeBitmap *self);
+
+//* ------------------------------------- Funktionen --------------------------------------
+/**
+ * @brief Setzt oder löscht die Bits von `[start, end)`.
+ */
+void change_bitmap_set(ChangeBitmap *self, size_t start, size_t end, int value) {
+    if (end > self->size) {
+        end = self->size;
+    }
+    if (start >= end || (!self->bits && !value)) {
+        return; // nichts zu tun
+    }
+    ensure_capacity(self, self->size);
+    size_t first = start / 64;
+    size_t last = (end - 1) / 64;
+    for (size_t word = first; word <= last; word++) {
+        size_t from = (word == first) ? start % 64 : 0;
+        size_t to = (word == last) ? (end - 1) % 64 + 1 : 64;
+        uint64_t mask = range_mask(from, to);
+        uint64_t old = self->bits[word];
+        uint64_t now = value ? (old | mask) : (old & ~mask);
+        self->count = self->count - (size_t)__builtin_popcountll(old) +
+                      (size_t)__builtin_popcountll(now);
+        self->bits[word] = now;
+    }
+    update_levels(self, first, last);
+}
+
+/**
+ * @brief Fügt `length` Bits bei `offset` ein; alle Bits dahinter rücken auf.
+ *
+ * Die Bits werden wortweise von hinten nach vorn um `length` Stellen
+ * verschoben, sodass kein Zwischenspeicher nötig ist.
+ */
+void change_bitmap_insert(ChangeBitmap *self, size_t offset, size_t length, int value) {
+    if (offset > self->size) {
+        offset = self->size;
+    }
+    if (length == 0) {
+        return;
+    }
+    self->size += length;
+    if (self->bits) {
+        ensure_capacity(self, self->size);
+        size_t first = offset / 64;
+        size_t last = (self->size - 1) / 64;
+        uint64_t lowMask = range_mask(0, offset % 64);
+        uint64_t keep = self->bits[first] & lowMask;   // Bits vor `offset` bleiben stehen
+        self->bits[first] &= ~lowMask;
+        size_t words = length / 64;
+        unsigned int shift = (unsigned int)(length % 64);
+        for (size_t word = last;; word--) {
+            uint64_t moved = 0;
+            if (word >= first + words) {
+                moved = self->bits[word - words] << shift;
+                if (shift && word - words > first) {
+                    moved |= self->bits[word - words - 1] >> (64 - shift);
+                }
+            }
+            self->bits[word] = moved;
+            if (word == first) {
+                break;
+            }
+        }
+        self->bits[first] |= keep;
+        update_levels(self, first, last);
+    }
+    if (value) {
+        change_bitmap_set(self, offset, offset + length, 1);
+    }
+}
+
+/**
+ * @brief Entfernt die Bits von `[offset, offset + length)`; alle Bits dahinter rücken nach.
+ */
+void change_bitmap_erase(ChangeBitmap *self, size_t offset, size_t length) {
+    if (offset >= self->size || length == 0) {
+        return;
+    }
+    if (length > self->size - offset) {
+        length = self->size - offset;
+    }
+    if (!self->bits) {
+        self->size -= length;
+        return;
+    }
+    self->count -= count_range(self, offset, offset + length);
+    size_t first = offset / 64;
+    size_t last = (self->size - 1) / 64;
+    uint64_t lowMask = range_mask(0, offset % 64);
+    uint64_t keep = self->bits[first] & lowMask;
+    size_t words = length / 64;
+    unsigned int shift = (unsigned int)(length % 64);
+    for (size_t word = first; word <= last; word++) {
+        size_t source = word + words; // Bit p stammt von Bit p + length
+        uint64_t moved = 0;
+        if (source <= last) {
+            moved = self->bits[source] >> shift;
+            if (shift && source + 1 <= last) {
+                moved |= self->bits[source + 1] << (64 - shift);
+            }
+        }
+        self->bits[word] = moved;
+    }
+    self->bits[first] = (self->bits[first] & ~lowMask) | keep;
+    self->size -= length;
+    update_levels(self, first, last);
+}
+
+/**
+ * @brief Löscht alle Bits, die Größe bleibt.
+ *
+ * Der Speicher wird freigegeben und erst beim nächsten gesetzten Bit
+ * wieder angelegt.
+ */
+void change_bitmap_clear(ChangeBitmap *self) {
+    free_levels(self);
+    free(self->bits);
+    self->bits = NULL;
+    self->words[0] = 0;
+    self->level_count = 0;
+    self->count = 0;
+}
+
+/**
+ * @brief Sucht das erste Bit ab `from` mit dem gewünschten Wert.
+ *
+ * Aufsteigen, bis ein Wort ab der Position einen Kandidaten hat, dann
+ * in dessen erstes Kind absteigen. Eine unvollständige Zusammenfassung
+ * (`all` = 0) garantiert ein freies Bit darunter, ein gesetztes
+ * `any`-Bit ein gesetztes.
+ */
+size_t change_bitmap_next(const ChangeBitmap *self, size_t from, int value) {
+    if (from >= self->size) {
+        return CHANGE_BITMAP_NONE;
+    }
+    if (!self->bits) {
+        return value ? CHANGE_BITMAP_NONE : from;
+    }
+    size_t pos = from;
+    int level = 0;
+    for (;;) {
+        size_t word = pos / 64;
+        if (word >= self->words[level]) {
+            return CHANGE_BITMAP_NONE;
+        }
+        uint64_t candidates = level_word(self, level, word, value) & (ALL_BITS << (pos % 64));
+        if (candidates) {
+            pos = word * 64 + (size_t)__builtin_ctzll(candidates);
+            break;
+        }
+        if (level + 1 >= self->level_count) {
+            return CHANGE_BITMAP_NONE;
+        }
+        pos = word + 1; // ab dem nächsten Wort eine Stufe höher weitersuchen
+        level++;
+    }
+    while (level > 0) {
+        level--;
+        if (pos >= self->words[level]) {
+            return CHANGE_BITMAP_NONE; // nur Füllbits hinter dem letzten Wort
+        }
+        pos = pos * 64 + (size_t)__builtin_ctzll(level_word(self, level, pos, value));
+    }
+    return (pos < self->size) ? pos : CHANGE_BITMAP_NONE;
+}
+
+/**
+ * @brief Sucht das letzte Bit vor `before` mit dem gewünschten Wert.
+ */
+size_t change_bitmap_prev(const ChangeBitmap *self, size_t before, int value) {
+    if (before > self->size) {
+        before = self->size;
+    }
+    if (before == 0) {
+        return CHANGE_BITMAP_NONE;
+    }
+    if (!self->bits) {
+        return value ? CHANGE_BITMAP_NONE : before - 1;
+    }
+    size_t pos = before; // gesucht wird vor `pos`
+    int level = 0;
+    for (;;) {
+        size_t word = pos / 64;
+        size_t bit = pos % 64;
+        uint64_t candidates = 0;
+        if (bit > 0) {
+            candidates = level_word(self, level, word, value) & (ALL_BITS >> (64 - bit));
+        }
+        if (candidates) {
+            pos = word * 64 + 63 - (size_t)__builtin_clzll(candidates);
+            break;
+        }
+        if (word == 0 || level + 1 >= self->level_count) {
+            return CHANGE_BITMAP_NONE;
+        }
+        pos = word; // vor diesem Wort eine Stufe höher weitersuchen
+        level++;
+    }
+    while (level > 0) {
+        level--;
+        pos = pos * 64 + 63 - (size_t)__builtin_clzll(level_word(self, level, pos, value));
+    }
+    return pos;
+}
+
+//* ---------------------------------- Helfer Funktionen ----------------------------------
+/**
+ * @brief Legt Stufe 0 für `size` Bits an oder vergrößert sie.
+ *
+ * Beim ersten Anlegen genügt `calloc`: Nie berührte Seiten belegen
+ * auch bei großen Dateien keinen Speicher. Danach wird verdoppelt.
+ */
+static void ensure_capacity(ChangeBitmap *self, size_t size) {
+    size_t needed = (size + 63) / 64;
+    if (needed == 0) {
+        needed = 1;
+    }
+    if (self->bits && needed <= self->words[0]) {
+        return;
+    }
+    if (!self->bits) {
+        self->bits = (uint64_t *)calloc(needed, sizeof(uint64_t));
+        if (!self->bits) {
+            fatal_error("change_bitmap", "out of memory");
+        }
+        self->words[0] = needed;
+    } else {
+        size_t capacity = (self->words[0] * 2 > needed) ? self->words[0] * 2 : needed;
+        uint64_t *grown = (uint64_t *)realloc(self->bits, capacity * sizeof(uint64_t));
+        if (!grown) {
+            fatal_error("change_bitmap", "out of memory");
+        }
+        memset(grown + self->words[0], 0, (capacity - self->words[0]) * sizeof(uint64_t));
+        self->bits = grown;
+        self->words[0] = capacity;
+    }
+    build_levels(self);
+}
+
+/**
+ * @brief Legt alle Zusammenfassungen passend zu Stufe 0 neu an.
+ */
+static void build_levels(ChangeBitmap *self) {
+    free_levels(self);
+    self->level_count = 1;
+    size_t words = self->words[0];
+    while (words > 1) { // bis eine Stufe aus einem Wort besteht
+        size_t above = (words + 63) / 64;
+        int level = self->level_count;
+        self->any[level] = (uint64_t *)calloc(above, sizeof(uint64_t));
+        self->all[level] = (uint64_t *)calloc(above, sizeof(uint64_t));
+        if (!self->any[level] || !self->all[level]) {
+            fatal_error("change_bitmap", "out of memory");
+        }
+        self->words[level] = above;
+        self->level_count++;
+        words = above;
+    }
+    update_levels(self, 0, self->words[0] - 1);
+}
+
+/**
+ * @brief Erneuert die Zusammenfassungen über den Wörtern `[first, last]` der Stufe 0.
+ */
+static void update_levels(ChangeBitmap *self, size_t first, size_t last) {
+    for (int level = 1; level < self->level_count; level++) {
+        const uint64_t *anyBelow = (level == 1) ? self->bits : self->any[level - 1];
+        const uint64_t *allBelow = (level == 1) ? self->bits : self->all[level - 1];
+        for (size_t index = first; index <= last; index++) {
+            uint64_t bit = (uint64_t)1 << (index % 64);
+            if (anyBelow[index] != 0) {
+                self->any[level][index / 64] |= bit;
+            } else {
+                self->any[level][index / 64] &= ~bit;
+            }
+            if (allBelow[index] == ALL_BITS) {
+                self->all[level][index / 64] |= bit;
+            } else {
+                self->all[level][index / 64] &= ~bit;
+            }
+        }
+        first /= 64;
+        last /= 64;
+    }
+}
+
+/**
+ * @brief Wort einer Stufe, in dem Kandidaten für den gesuchten Wert gesetzt sind.
+ */
+static uint64_t level_word(const ChangeBitmap *self, int level, size_t index, int value) {
+    if (level == 0) {
+        return value ? self->bits[index] : ~self->bits[index];
+    }
+    return value ? self->any[level][index] : ~self->all[level][index];
+}
+
+/** @brief Maske der Bits `[from, to)` eines Worts. */
+static uint64_t range_mask(size_t from, size_t to) {
+    if (to - from >= 64) {
+        return ALL_BITS;
+    }
+    return (((uint64_t)1 << (to - from)) - 1) << from;
+}
+
+/** @brief Anzahl gesetzter Bits in `[start, end)`. */
+static size_t count_range(const ChangeBitmap *self, size_t start, size_t end) {
+    size_t first = start / 64;
+    size_t last = (end - 1) / 64;
+    size_t count = 0;
+    for (size_t word = first; word <= last; word++) {
+        size_t from = (word == first) ? start % 64 : 0;
+        size_t to = (word == last) ? (end - 1) % 64 + 1 : 64;
+        count += (size_t)__builtin_popcountll(self->bits[word] & range_mask(from, to));
+    }
+    return count;
+}
+
+/** @brief Gibt die Zusammenfassungen ab Stufe 1 frei. */
+static void free_levels(ChangeBitmap *self) {
+    for (int level = 1; level < CHANGE_BITMAP_LEVELS; level++) {
+        free(self->any[level]);
+        free(self->all[level]);
+        self->any[level] = NULL;
+        self->all[level] = NULL;
+        self->words[level] = 0;
+    }
+}
+
+//* ----------------------------------- Init und Deinit -----------------------------------
+/**
+ * @brief Initialisiert eine leere Bitmap über `size` Bytes.
+ */
+int change_bitmap_init(ChangeBitmap *self, size_t size) {
+    memset(self, 0, sizeof(*self));
+    self->size = size;
+    return 0;
+}
+
+/**
+ * @brief Gibt alle Stufen frei.
+ */
+int change_bitmap_deinit(ChangeBitmap *self) {
+    change_bitmap_clear(self);
+    memset(self, 0, sizeof(*self));
+    return 0;
+}
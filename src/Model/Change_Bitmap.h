@@ -0,0 +1,116 @@
+#ifndef CHANGE_BITMAP_H
+#define CHANGE_BITMAP_H
+
+/**
+ * @file Change_Bitmap.h
+ * @brief Schnittstelle der Bitmap geänderter Bytes.
+ *
+ * Stufe 0 hält ein Bit je Byte des Inhalts. Darüber fassen Stufen je
+ * 64 Wörter der Stufe darunter zusammen, getrennt danach, ob ein Wort
+ * mindestens ein gesetztes Bit enthält und ob alle Bits gesetzt sind.
+ * Ob ein Byte geändert ist, kostet so einen Wortzugriff; das nächste
+ * gesetzte oder freie Bit wird über höchstens eine Wortsuche je Stufe
+ * gefunden, also in O(log n) auch bei Millionen verstreuter Änderungen.
+ * Die Anzahl gesetzter Bits wird laufend mitgezählt.
+ */
+
+#include <stddef.h> // stellt den Typ size_t bereit
+#include <stdint.h> // feste Breiten für die Bitwörter
+
+//* ---------------------------- Globale Konstanten oder Defines --------------------------
+#define CHANGE_BITMAP_LEVELS 12         /**< genügt für jede Größe, die in size_t passt */
+#define CHANGE_BITMAP_NONE ((size_t)-1) /**< kein passendes Bit gefunden */
+
+//* ------------------------------------- Strukturen --------------------------------------
+/**
+ * @brief Bits je Byte mit Zusammenfassungen.
+ *
+ * Stufe 0 wird erst beim ersten gesetzten Bit angelegt; bis dahin
+ * zählt nur die Größe. Hinter `size` sind alle Bits frei.
+ */
+typedef struct {
+    uint64_t *bits;                        /**< Stufe 0: ein Bit je Byte */
+    uint64_t *any[CHANGE_BITMAP_LEVELS];   /**< ab Stufe 1: Wort darunter enthält ein gesetztes Bit */
+    uint64_t *all[CHANGE_BITMAP_LEVELS];   /**< ab Stufe 1: Wort darunter ist vollständig gesetzt */
+    size_t words[CHANGE_BITMAP_LEVELS];    /**< angelegte Wörter je Stufe */
+    int level_count;                       /**< belegte Stufen einschließlich Stufe 0 */
+    size_t size;                           /**< abgedeckte Bytes */
+    size_t count;                          /**< gesetzte Bits */
+} ChangeBitmap;
+
+//* ------------------------------------- Funktionen --------------------------------------
+/**
+ * @brief Prüft, ob das Bit eines Bytes gesetzt ist.
+ */
+static inline int change_bitmap_test(const ChangeBitmap *self, size_t index) {
+    return self->bits && index < self->size && ((self->bits[index / 64] >> (index % 64)) & 1u);
+}
+
+/**
+ * @brief Anzahl gesetzter Bits.
+ */
+static inline size_t change_bitmap_count(const ChangeBitmap *self) {
+    return self->count;
+}
+
+/**
+ * @brief Setzt oder löscht die Bits von `[start, end)`.
+ * @param self  Zeiger auf die Bitmap
+ * @param start erstes Byte
+ * @param end   hinter dem letzten Byte, höchstens `size`
+ * @param value 1 = setzen, 0 = löschen
+ */
+void change_bitmap_set(ChangeBitmap *self, size_t start, size_t end, int value);
+
+/**
+ * @brief Fügt `length` Bits bei `offset` ein; alle Bits dahinter rücken auf.
+ *
+ * Kostet O(n / 64) für das Verschieben der Bits hinter `offset`.
+ *
+ * @param self   Zeiger auf die Bitmap
+ * @param offset Einfügeposition (0 bis `size`)
+ * @param length Anzahl neuer Bits
+ * @param value  Wert der neuen Bits
+ */
+void change_bitmap_insert(ChangeBitmap *self, size_t offset, size_t length, int value);
+
+/**
+ * @brief Entfernt die Bits von `[offset, offset + length)`; alle Bits dahinter rücken nach.
+ */
+void change_bitmap_erase(ChangeBitmap *self, size_t offset, size_t length);
+
+/**
+ * @brief Löscht alle Bits, die Größe bleibt.
+ */
+void change_bitmap_clear(ChangeBitmap *self);
+
+/**
+ * @brief Sucht das erste Bit ab `from` mit dem gewünschten Wert.
+ * @param self  Zeiger auf die Bitmap
+ * @param from  erste zu prüfende Position
+ * @param value 1 = gesetztes, 0 = freies Bit suchen
+ * @return Position oder `CHANGE_BITMAP_NONE`
+ */
+size_t change_bitmap_next(const ChangeBitmap *self, size_t from, int value);
+
+/**
+ * @brief Sucht das letzte Bit vor `before` mit dem gewünschten Wert.
+ * @param self   Zeiger auf die Bitmap
+ * @param before hinter der letzten zu prüfenden Position
+ * @param value  1 = gesetztes, 0 = freies Bit suchen
+ * @return Position oder `CHANGE_BITMAP_NONE`
+ */
+size_t change_bitmap_prev(const ChangeBitmap *self, size_t before, int value);
+
+//* ----------------------------------- Init und Deinit -----------------------------------
+/**
+ * @brief Initialisiert eine leere Bitmap über `size` Bytes.
+ */
+int change_bitmap_init(ChangeBitmap *self, size_t size);
+
+/**
+ * @brief Gibt alle Stufen frei.
+ */
+int change_bitmap_deinit(ChangeBitmap *self);
+
+#endif // CHANGE_BITMAP_H
@@ -15,9 +15,37 @@
 #include <stdlib.h>         // Speicherfunktionen wie malloc und free
 #include <string.h>         // Funktionen für Speicheroperationen
 #include "File_Manager.h"  // Lesen und Schreiben von Dateien
+#include "Byte_Scan.h"     // Vergleich mit den Originalbytes
 #include "Err_Log.h"       // Protokollierung von Fehlern
 
 //* ---------------------------- Globale Konstanten oder Defines --------------------------
+/** Zustand beim Schreiben der Stücke in eine temporäre Datei */
+typedef struct {
+    const DataBuffer *buffer; /**< zu speichernder Buffer */
+    FileSink *sink;           /**< Ziel der Bytes */
+} SaveContext;
+
+// Vorwärtsdeklarationen der Helferfunktionen
+static void mark_changed(DataBuffer *self, size_t start, size_t removed, size_t added);
+static void record_change(DataBuffer *self, size_t start, size_t removed, size_t added);
+static void track_modified(DataBuffer *self, size_t start, size_t removed,
+                           const unsigned char *bytes, size_t added);
+static void overwrite_bytes(DataBuffer *self, size_t index, const unsigned char *bytes,
+                            size_t length, int typed);
+static void insert_bytes(DataBuffer *self, size_t index, const unsigned char *bytes,
+                         size_t length, int typed);
+static void apply_change(DataBuffer *self, size_t offset, size_t remove,
+                         const unsigned char *bytes, size_t length);
+static void mark_dirty(DataBuffer *self, size_t start, size_t end);
+static void clear_dirty(DataBuffer *self);
+static uint64_t hash_tail(const DataSource *source, size_t end);
+static size_t find_page(const DataBuffer *self, size_t from, int dirty);
+static size_t collect_dirty_runs(const DataBuffer *self, size_t **outRanges);
+static void read_chunk(void *context, size_t offset, unsigned char *dest, size_t length);
+static int write_piece(void *context, const PieceNode *piece);
+static int prefetch_piece(void *context, const PieceNode *piece, size_t skip, size_t length);
+static int write_source_range(FileSink *sink, const DataSource *source, size_t offset,
+                              size_t length);
 
 //* ------------------------------------- Funktionen --------------------------------------
 /**
@@ -27,21 +55,36 @@
  * @return 0 bei Erfolg
  */
 int data_buffer_load_file(DataBuffer *self, const char *path) { // Datei in Buffer laden
-    unsigned char *temp_bytes = NULL; // temporärer Zeiger für gelesene Daten
-    size_t temp_size = 0;             // Größe der gelesenen Datei
+    DataSource temp_source; // neue Quelle, bevor die alte verworfen wird
+    DataSourceOptions options = self->options; // Einstellungen über das Neuladen retten
+    unsigned long revision = self->revision;   // Zählung läuft über das Neuladen weiter
+    FileSignature disk;                        // vor dem Öffnen: spätere Änderungen fallen auf
+    file_watch_read_signature(path, &disk);
 
-    // Datei über den File Manager laden
-    if (readFileToBuffer(path, &temp_bytes, &temp_size) != 0) { // Prüfen, ob Lesen klappt
+    // Datei einblenden, blockweise cachen, als Strom empfangen oder komplett laden
+    if (data_source_open(&temp_source, path, &options) != 0) { // Prüfen, ob Öffnen klappt
         // Bei Fehler Programmabbruch und Logeintrag
         fatal_error("data_buffer_load_file", path); // Fehler melden und Programm beenden
     }
 
-    // Vorherigen Inhalt freigeben und neue Daten übernehmen
-    data_buffer_deinit(self); // alten Buffer leeren
-    self->bytes = temp_bytes; // neuen Zeiger übernehmen
-    self->size = temp_size;   // neue Größe setzen
-    self->edited = 0;         // Bearbeitungsstatus zurücksetzen
-    self->ever_changed = 0;   // bisherige Änderungen zurücksetzen
+    // Vorherigen Inhalt freigeben und neue Quelle übernehmen
+    data_buffer_deinit(self);                         // alten Buffer leeren
+    self->source = temp_source;                       // neue Quelle übernehmen
+    self->options = options;                          // Einstellungen wiederherstellen
+    self->revision = revision + 1;                    // Inhalt ist ein anderer
+    self->log_start = self->revision;                 // frühere Änderungen gelten nicht mehr
+    piece_table_init(&self->pieces, &self->source);   // ein Stück über die ganze Datei
+    undo_journal_init(&self->journal, options.undo_budget); // Journal beginnt leer
+    self->size = temp_source.size;                    // neue Größe setzen
+    self->edited = 0;                                 // Bearbeitungsstatus zurücksetzen
+    self->ever_changed = 0;                           // bisherige Änderungen zurücksetzen
+    self->layout_changed = 0;                         // Bytes liegen an ihren Dateipositionen
+    change_bitmap_init(&self->modified, self->size);  // noch kein Byte geändert
+    self->source_aligned = 1;                         // Quelle hält die Originalbytes
+    self->source_on_disk = 1;                         // Datei und Quelle stimmen überein
+    self->disk = disk;                                // Stand der Datei beim Laden
+    self->source_stale = 0;                           // Quelle zeigt den geladenen Stand
+    self->tail_hash = hash_tail(&self->source, self->source.size); // Dateiende merken
     return 0; // Erfolg melden
 }
 
@@ -52,10 +95,10 @@ int data_buffer_load_file(DataBuffer *self, const char *path) { // Datei in Buff
  * @return Wert des Bytes oder 0 bei Fehler
  */
 unsigned char data_buffer_get_byte(const DataBuffer *self, size_t index) {
-    if (!self->bytes || index >= self->size) { // ungültigen Zugriff erkennen
-        return 0;                              // Fehlerfall liefert 0
+    if (index >= self->size) { // ungültigen Zugriff erkennen
+        return 0;              // Fehlerfall liefert 0
     }
-    return self->bytes[index]; // angefordertes Byte zurückgeben
+    return piece_table_get_byte(&self->pieces, index); // Byte über den Stückbaum suchen
 }
 
 /**
@@ -65,16 +108,14 @@ unsigned char data_buffer_get_byte(const DataBuffer *self, size_t index) {
  * @param value neuer Wert
  */
 void data_buffer_set_byte(DataBuffer *self, size_t index, unsigned char value) {
-    if (!self->bytes || index >= self->size) { // prüfen, ob der Zugriff zulässig ist
-        return;                               // bei Fehler früh beenden
+    if (index >= self->size) { // prüfen, ob der Zugriff zulässig ist
+        return;                // bei Fehler früh beenden
     }
     // Nur reagieren, wenn sich der Wert wirklich ändert
-    if (self->bytes[index] == value) { // prüfen, ob neuer Wert identisch ist
-        return;                        // keine Änderung nötig
+    if (data_buffer_get_byte(self, index) == value) { // prüfen, ob neuer Wert identisch ist
+        return;                                      // keine Änderung nötig
     }
-    self->bytes[index] = value; // neues Byte schreiben
-    self->edited = 1;           // Buffer als geändert markieren
-    self->ever_changed = 1;     // Merken, dass jemals etwas geändert wurde
+    data_buffer_overwrite(self, index, &value, 1); // neues Byte schreiben
 }
 
 /**
@@ -86,33 +127,735 @@ void data_buffer_set_byte(DataBuffer *self, size_t index, unsigned char value) {
  */
 void data_buffer_get_range(const DataBuffer *self, size_t start, size_t end,
                            unsigned char *dest) {
-    if (!self->bytes || start >= self->size || end > self->size || start >= end) { // Bereichsgrenzen prüfen
+    if (start >= self->size || end > self->size || start >= end) { // Bereichsgrenzen prüfen
         return; // ungültiger Bereich
     }
-    memcpy(dest, self->bytes + start, end - start); // Bereich kopieren
+    piece_table_read(&self->pieces, start, dest, end - start); // Bereich kopieren
+}
+
+/**
+ * @brief Übernimmt neue Bytes eines Datenstroms oder den Ladefortschritt.
+ *
+ * Neue Bytes werden hinten an den Inhalt gehängt, auch wenn zuvor
+ * bearbeitet wurde. Verwirft die Quelle im Ringmodus ihre ältesten
+ * Bytes, wird ebenso viel vom Anfang des Inhalts entfernt; dort liegende
+ * Bearbeitungen gehen dabei mit verloren.
+ *
+ * @param self    Zeiger auf den Buffer
+ * @param dropped erhält die Anzahl am Anfang entfernter Bytes
+ * @return 1 bei Änderungen, 0 ohne, -1 wenn kein Zuwachs mehr möglich ist
+ */
+int data_buffer_poll(DataBuffer *self, size_t *dropped) {
+    size_t oldEnd = self->source.size;                 // bisheriges Ende der Quelle
+    int result = data_source_poll(&self->source, dropped);
+    if (result <= 0 && *dropped == 0) {
+        return result;
+    }
+
+    size_t added = self->source.size - oldEnd;
+    size_t oldSize = self->size;
+    piece_table_append_original(&self->pieces, oldEnd, added); // neue Bytes anhängen
+    change_bitmap_insert(&self->modified, oldSize, added, 0);  // empfangen, nicht geändert
+    self->size += added;
+
+    if (*dropped > 0) {
+        size_t removed = (*dropped < self->size) ? *dropped : self->size;
+        piece_table_erase(&self->pieces, 0, removed); // älteste Bytes verwerfen
+        change_bitmap_erase(&self->modified, 0, removed);
+        self->size -= removed;
+        *dropped = removed;
+        self->layout_changed = 1;                      // Positionen haben sich verschoben
+        self->source_aligned = 0;
+        clear_dirty(self);
+        undo_journal_clear(&self->journal);            // Positionen im Journal passen nicht mehr
+        record_change(self, 0, oldSize, self->size);   // alle Bytes haben sich verschoben
+    } else {
+        record_change(self, oldSize, 0, added);
+    }
+    return 1;
+}
+
+/**
+ * @brief Liefert die Änderung, die zur angegebenen Revision geführt hat.
+ * @param self     Zeiger auf den Buffer
+ * @param revision Revision nach der gesuchten Änderung
+ * @param out      erhält die Änderung
+ * @return 0 bei Erfolg, -1 wenn die Änderung nicht mehr bekannt ist
+ */
+int data_buffer_get_change(const DataBuffer *self, unsigned long revision,
+                           DataBufferChange *out) {
+    if (revision <= self->log_start || revision > self->revision ||
+        self->revision - revision >= DATA_BUFFER_CHANGE_LOG) {
+        return -1; // vor dem Laden oder bereits überschrieben
+    }
+    *out = self->changes[revision % DATA_BUFFER_CHANGE_LOG];
+    return 0;
+}
+
+/**
+ * @brief Hängt Bytes an, die eine andere Anwendung an die Datei angefügt hat.
+ *
+ * Die Quelle übernimmt die neue Dateigröße, ohne bereits gelesene
+ * Bereiche zu verwerfen. Stimmt die Prüfsumme der letzten bisherigen
+ * Bytes noch, wurde nur angehängt, und die neuen Bytes werden wie bei
+ * einem Datenstrom hinten an den Inhalt gehängt. Andernfalls wurde die
+ * Datei umgeschrieben und muss neu geladen werden.
+ *
+ * @param self Zeiger auf den Buffer
+ * @return 1 bei Zuwachs, 0 ohne, -1 wenn neu geladen werden muss
+ */
+int data_buffer_follow(DataBuffer *self) {
+    size_t oldEnd = self->source.size;                 // bisheriges Ende der Quelle
+    int result = data_source_grow(&self->source);
+    if (result <= 0) {
+        return result;
+    }
+    if (hash_tail(&self->source, oldEnd) != self->tail_hash) {
+        return -1; // Bytes vor dem alten Ende haben sich geändert
+    }
+
+    size_t added = self->source.size - oldEnd;
+    piece_table_append_original(&self->pieces, oldEnd, added); // neue Bytes anhängen
+    change_bitmap_insert(&self->modified, self->size, added, 0);
+    record_change(self, self->size, 0, added);
+    self->size += added;
+    self->tail_hash = hash_tail(&self->source, self->source.size);
+    return 1;
+}
+
+/**
+ * @brief Liest nach einer fremden Änderung der Datei nicht mehr aus einer Einblendung.
+ *
+ * Eingeblendete Seiten hinter einem gekürzten Dateiende würden beim
+ * nächsten Zugriff `SIGBUS` auslösen; die Quelle liest deshalb ab jetzt
+ * per `pread`. Die Quelle entspricht weder dem geladenen noch einem
+ * gespeicherten Stand mehr, geänderte Bytes werden daher nur noch als
+ * berührt verfolgt. Das gilt auch für den Block-Cache, der schon per
+ * `pread` liest: Gehaltene Blöcke zeigen den alten, alle übrigen den
+ * neuen Stand, der Inhalt ist also ein Gemisch aus beiden.
+ *
+ * @param self Zeiger auf den Buffer
+ * @return 0 bei Erfolg, sonst -1
+ */
+int data_buffer_detach(DataBuffer *self) {
+    int result = data_source_detach(&self->source); // Block-Cache: nichts zu lösen
+    self->source_aligned = 0; // Originalbytes sind nicht mehr bekannt
+    self->source_on_disk = 0;
+    self->source_stale = 1;   // Speichern unter neuem Namen fragt nach
+    return result;
+}
+
+/**
+ * @brief Kündigt an, dass ein Bereich bald angezeigt wird.
+ *
+ * Für jeden Abschnitt, der noch aus der Originalquelle stammt, wird die
+ * Quelle gebeten, die Bytes vorab zu laden. Eingefügte Bytes liegen
+ * ohnehin im Speicher.
+ *
+ * @param self  Zeiger auf den Buffer
+ * @param start Startindex
+ * @param end   Endindex (exklusiv)
+ */
+void data_buffer_prefetch(const DataBuffer *self, size_t start, size_t end) {
+    if (start >= self->size || start >= end) {
+        return; // nichts vorzuladen
+    }
+    piece_table_for_range(&self->pieces, start, end - start, prefetch_piece,
+                          (void *)&self->source);
+}
+
+/**
+ * @brief Überschreibt einen Bereich mit neuen Bytes.
+ *
+ * Bytes hinter dem Dateiende werden ignoriert, die Größe bleibt gleich.
+ *
+ * @param self   Zeiger auf den Buffer
+ * @param index  Startposition
+ * @param bytes  neue Bytes
+ * @param length Anzahl der Bytes
+ */
+void data_buffer_overwrite(DataBuffer *self, size_t index, const unsigned char *bytes,
+                           size_t length) {
+    overwrite_bytes(self, index, bytes, length, 0);
+}
+
+/**
+ * @brief Schreibt ein getipptes Byte.
+ *
+ * Direkt aufeinanderfolgend getippte Bytes werden im Journal zu einem
+ * Eintrag zusammengefasst und mit einem Schritt zurückgenommen. Ein
+ * überschriebenes Byte mit unverändertem Wert zählt nur innerhalb eines
+ * laufenden Eintrags mit, damit dieser nicht abreißt.
+ *
+ * @param self   Zeiger auf den Buffer
+ * @param index  Position des Bytes
+ * @param value  neuer Wert
+ * @param insert 1 = einfügen, 0 = überschreiben
+ */
+void data_buffer_type_byte(DataBuffer *self, size_t index, unsigned char value, int insert) {
+    if (insert) {
+        insert_bytes(self, index, &value, 1, 1);
+    } else if (index < self->size && (data_buffer_get_byte(self, index) != value ||
+                                      undo_journal_continues_run(&self->journal, index))) {
+        overwrite_bytes(self, index, &value, 1, 1); // gleiche Werte nur im laufenden Eintrag
+    }
+}
+
+/**
+ * @brief Fügt Bytes an einer Position ein.
+ * @param self   Zeiger auf den Buffer
+ * @param index  Einfügeposition (0 bis Größe)
+ * @param bytes  einzufügende Bytes
+ * @param length Anzahl der Bytes
+ */
+void data_buffer_insert(DataBuffer *self, size_t index, const unsigned char *bytes,
+                        size_t length) {
+    insert_bytes(self, index, bytes, length, 0);
+}
+
+/**
+ * @brief Löscht einen Bereich.
+ * @param self  Zeiger auf den Buffer
+ * @param start Startindex
+ * @param end   Endindex (exklusiv)
+ */
+void data_buffer_delete(DataBuffer *self, size_t start, size_t end) {
+    if (end > self->size) {
+        end = self->size; // auf Dateiende begrenzen
+    }
+    if (start >= end) {
+        return; // leerer Bereich
+    }
+    unsigned char *saved;
+    unsigned char *unused;
+    if (undo_journal_record(&self->journal, start, end - start, 0, 0, &saved, &unused) == 0) {
+        piece_table_read(&self->pieces, start, saved, end - start); // gelöschte Bytes merken
+    }
+    piece_table_erase(&self->pieces, start, end - start);
+    track_modified(self, start, end - start, NULL, 0);
+    self->size -= end - start;  // Inhalt ist geschrumpft
+    self->layout_changed = 1;   // nachfolgende Bytes haben sich verschoben
+    clear_dirty(self);          // Seiten sind nicht mehr einzeln speicherbar
+    mark_changed(self, start, end - start, 0);
+}
+
+/**
+ * @brief Kopiert einen Bereich in die Zwischenablage.
+ *
+ * Es werden nur Stückreferenzen kopiert, unabhängig von der Größe
+ * des Bereichs.
+ *
+ * @param self  Zeiger auf den Buffer
+ * @param start Startindex
+ * @param end   Endindex (exklusiv)
+ */
+void data_buffer_copy(DataBuffer *self, size_t start, size_t end) {
+    if (end > self->size) {
+        end = self->size; // auf Dateiende begrenzen
+    }
+    if (start >= end) {
+        return; // leerer Bereich, Zwischenablage bleibt erhalten
+    }
+    piece_clip_free(&self->clipboard); // alten Inhalt verwerfen
+    piece_table_copy(&self->pieces, start, end - start, &self->clipboard);
+}
+
+/**
+ * @brief Schneidet einen Bereich in die Zwischenablage aus.
+ * @param self  Zeiger auf den Buffer
+ * @param start Startindex
+ * @param end   Endindex (exklusiv)
+ */
+void data_buffer_cut(DataBuffer *self, size_t start, size_t end) {
+    if (end > self->size) {
+        end = self->size; // auf Dateiende begrenzen
+    }
+    if (start >= end) {
+        return; // leerer Bereich
+    }
+    unsigned char *saved;
+    unsigned char *unused;
+    if (undo_journal_record(&self->journal, start, end - start, 0, 0, &saved, &unused) == 0) {
+        piece_table_read(&self->pieces, start, saved, end - start); // ausgeschnittene Bytes merken
+    }
+    piece_clip_free(&self->clipboard); // alten Inhalt verwerfen
+    piece_table_cut(&self->pieces, start, end - start, &self->clipboard);
+    track_modified(self, start, self->clipboard.length, NULL, 0);
+    self->size -= self->clipboard.length;
+    self->layout_changed = 1;
+    clear_dirty(self);
+    mark_changed(self, start, self->clipboard.length, 0);
+}
+
+/**
+ * @brief Fügt die Zwischenablage an einer Position ein.
+ * @param self  Zeiger auf den Buffer
+ * @param index Einfügeposition (0 bis Größe)
+ */
+void data_buffer_paste(DataBuffer *self, size_t index) {
+    if (index > self->size || self->clipboard.length == 0) {
+        return; // ungültige Position oder leere Zwischenablage
+    }
+    piece_table_paste(&self->pieces, index, &self->clipboard);
+    unsigned char *unused;
+    unsigned char *saved;
+    if (undo_journal_record(&self->journal, index, 0, self->clipboard.length, 0, &unused,
+                            &saved) == 0) {
+        piece_table_read(&self->pieces, index, saved, self->clipboard.length); // eingefügte Bytes merken
+    }
+    track_modified(self, index, 0, NULL, self->clipboard.length);
+    self->size += self->clipboard.length;
+    self->layout_changed = 1;
+    clear_dirty(self);
+    mark_changed(self, index, 0, self->clipboard.length);
+}
+
+/**
+ * @brief Nimmt den letzten Bearbeitungsschritt zurück.
+ *
+ * Alle Einträge des Schritts werden von neu nach alt umgekehrt, indem
+ * die neuen Bytes wieder durch die alten ersetzt werden. Auch große
+ * Bereiche kosten dabei nur ein Kopieren am Stück.
+ *
+ * @param self     Zeiger auf den Buffer
+ * @param position erhält die Position der zurückgenommenen Bearbeitung
+ * @return 0 bei Erfolg, -1 wenn nichts zurückzunehmen ist
+ */
+int data_buffer_undo(DataBuffer *self, size_t *position) {
+    const UndoRecord *records;
+    size_t count = undo_journal_undo(&self->journal, &records);
+    if (count == 0) {
+        return -1; // nichts zurückzunehmen
+    }
+    for (size_t i = count; i-- > 0;) { // jüngsten Eintrag zuerst umkehren
+        const UndoRecord *record = &records[i];
+        apply_change(self, record->offset, record->new_length,
+                     undo_journal_old_bytes(&self->journal, record), record->old_length);
+    }
+    *position = records[0].offset;
+    return 0;
+}
+
+/**
+ * @brief Wiederholt den zuletzt zurückgenommenen Bearbeitungsschritt.
+ * @param self     Zeiger auf den Buffer
+ * @param position erhält die Position der wiederholten Bearbeitung
+ * @return 0 bei Erfolg, -1 wenn nichts zu wiederholen ist
+ */
+int data_buffer_redo(DataBuffer *self, size_t *position) {
+    const UndoRecord *records;
+    size_t count = undo_journal_redo(&self->journal, &records);
+    if (count == 0) {
+        return -1; // nichts zu wiederholen
+    }
+    for (size_t i = 0; i < count; i++) { // in ursprünglicher Reihenfolge anwenden
+        const UndoRecord *record = &records[i];
+        apply_change(self, record->offset, record->old_length,
+                     undo_journal_new_bytes(&self->journal, record), record->new_length);
+    }
+    *position = records[count - 1].offset;
+    return 0;
 }
 
 /**
  * @brief Speichert den Buffer in eine Datei.
+ *
+ * Solange keine Bytes eingefügt oder gelöscht wurden, liegen alle
+ * Bytes an ihrer ursprünglichen Position. Dann werden nur die seit dem
+ * letzten Speichern überschriebenen Seiten geschrieben, wobei
+ * benachbarte Seiten zu einem Lauf zusammengefasst werden. Hat sich
+ * die Größe geändert oder passt die Datei nicht, wird über eine
+ * temporäre Datei komplett neu geschrieben.
+ *
+ * Vorher wird das Kennzeichen der Datei mit dem beim Laden oder letzten
+ * Speichern verglichen. Hat eine andere Anwendung dieselbe Datei
+ * inzwischen verändert, würden unveränderte Bytes aus ihrem neuen Inhalt
+ * stammen; gespeichert wird dann nicht. Wurde die Datei dagegen durch
+ * eine neue ersetzt, liefert die Quelle weiter den geladenen Stand und
+ * die Datei wird komplett neu geschrieben.
+ *
  * @param self Zeiger auf den Buffer
  * @param path Dateipfad
- * @return 0 bei Erfolg
+ * @return 0 bei Erfolg, -1 wenn die Datei inzwischen von außen geändert wurde
  */
 int data_buffer_save_file(DataBuffer *self, const char *path) { // Buffer auf Platte sichern
-    if (!self->bytes) { // prüfen, ob überhaupt Daten vorhanden sind
+    if (!self->source.ops) { // prüfen, ob überhaupt Daten vorhanden sind
         // Kein Inhalt vorhanden, wird als schwerwiegender Fehler behandelt
         fatal_error("data_buffer_save_file", "no bytes"); // Hinweis auf fehlenden Inhalt
     }
-    int result = writeBufferToFile(path, self->bytes, self->size); // auf Platte schreiben
+    FileSignature current;
+    file_watch_read_signature(path, &current);
+    int sameFile = current.exists && self->disk.exists && current.device == self->disk.device &&
+                   current.inode == self->disk.inode;
+    if (sameFile && (current.size != self->disk.size || current.mtime_ns != self->disk.mtime_ns)) {
+        return -1; // fremde Änderung nicht mit eigenen Bytes vermischen
+    }
+    int result = -2; // -2: vollständiges Neuschreiben nötig
+    if (!self->layout_changed && sameFile) { // Bytes an Ort und Stelle: nur geänderte Seiten schreiben
+        size_t *ranges = NULL;
+        size_t rangeCount = collect_dirty_runs(self, &ranges);
+        result = writeRangesInPlace(path, self->size, ranges, rangeCount, read_chunk, self);
+        free(ranges);
+    }
+    if (result == -2) { // Größe geändert oder Datei fehlt: Datei komplett ersetzen
+        result = data_buffer_save_as(self, path);
+    }
     if (result != 0) { // prüfen, ob Schreiben fehlgeschlagen ist
         // Fehler protokollieren und Programm beenden
         fatal_error("data_buffer_save_file", path); // Fehler beim Schreiben
     }
-    self->edited = 0; // Änderungen als gespeichert markieren
-    return 0;         // Erfolg melden
+    self->edited = 0;         // Änderungen als gespeichert markieren
+    self->layout_changed = 0; // Datei entspricht jetzt dem Inhalt
+    clear_dirty(self);        // keine ungespeicherten Seiten mehr
+    change_bitmap_clear(&self->modified); // ab jetzt zählt der gespeicherte Stand
+    self->source_aligned = 0; // Quelle kann noch den alten Stand liefern
+    self->source_on_disk = 0; // Datei hält jetzt den gespeicherten Inhalt
+    self->tail_hash = hash_tail(&self->source, self->source.size); // evtl. selbst überschrieben
+    file_watch_read_signature(path, &self->disk); // eigener Stand gilt als bekannt
+    return 0;                 // Erfolg melden
+}
+
+/**
+ * @brief Schreibt den Buffer absturzsicher in eine (neue) Datei.
+ *
+ * Der Inhalt wird in eine temporäre Datei neben dem Ziel geschrieben,
+ * die erst nach `fsync` per `rename` an die Stelle des Ziels tritt. Die
+ * Stücke der Piece-Table bestimmen, wie geschrieben wird: Unveränderte
+ * Originalbereiche werden per `copy_file_range` direkt aus der
+ * Quelldatei kopiert, nur bearbeitete Bereiche kommen aus dem Speicher.
+ *
+ * @param self Zeiger auf den Buffer
+ * @param path Dateipfad
+ * @return 0 bei Erfolg, sonst -1
+ */
+int data_buffer_save_as(DataBuffer *self, const char *path) {
+    FileSink sink;
+    if (fileSinkOpen(&sink, path) != 0) { // temporäre Datei neben dem Ziel anlegen
+        return -1;
+    }
+    SaveContext context = { self, &sink };
+    if (piece_table_for_each(&self->pieces, write_piece, &context) != 0) {
+        fileSinkAbort(&sink); // Ziel bleibt unverändert
+        return -1;
+    }
+    if (fileSinkCommit(&sink) != 0) { // dauerhaft machen und atomar ersetzen
+        return -1;
+    }
+    self->edited = 0;         // Inhalt entspricht jetzt der Zieldatei
+    self->layout_changed = 0; // alle Bytes liegen an ihrer Dateiposition
+    clear_dirty(self);        // keine ungespeicherten Seiten mehr
+    change_bitmap_clear(&self->modified); // ab jetzt zählt der gespeicherte Stand
+    self->source_aligned = 0; // Quelle hält weiter die alte Datei
+    self->source_on_disk = 0;
+    file_watch_read_signature(path, &self->disk); // Ziel ist ab jetzt die gespeicherte Datei
+    return 0;
 }
 
 //* ---------------------------------- Helfer Funktionen ----------------------------------
+/**
+ * @brief Markiert den Buffer als geändert.
+ */
+static void mark_changed(DataBuffer *self, size_t start, size_t removed, size_t added) {
+    self->edited = 1;       // Buffer als geändert markieren
+    self->ever_changed = 1; // Merken, dass jemals etwas geändert wurde
+    record_change(self, start, removed, added); // Inhalt hat sich geändert
+}
+
+/**
+ * @brief Erhöht die Revision und hält fest, welcher Bereich sich geändert hat.
+ */
+static void record_change(DataBuffer *self, size_t start, size_t removed, size_t added) {
+    self->revision++;
+    DataBufferChange *change = &self->changes[self->revision % DATA_BUFFER_CHANGE_LOG];
+    change->start = start;
+    change->removed = removed;
+    change->added = added;
+}
+
+/**
+ * @brief Hält fest, welche Bytes sich seit dem Laden oder Speichern geändert haben.
+ *
+ * Beim Überschreiben wird, solange die Positionen noch denen der Quelle
+ * entsprechen, mit den Originalbytes verglichen: Ein zurückgenommenes
+ * oder wieder auf den alten Wert gesetztes Byte gilt dann als
+ * unverändert. Danach ist nur noch bekannt, welche Bytes berührt wurden.
+ * Eingefügte Bytes gelten immer als geändert.
+ *
+ * @param self    Zeiger auf den Buffer
+ * @param start   erstes betroffene Byte
+ * @param removed Anzahl ersetzter Bytes
+ * @param bytes   neue Bytes, nur beim Überschreiben benötigt
+ * @param added   Anzahl neuer Bytes
+ */
+static void track_modified(DataBuffer *self, size_t start, size_t removed,
+                           const unsigned char *bytes, size_t added) {
+    if (removed != added) {
+        self->source_aligned = 0; // Positionen haben sich verschoben
+        change_bitmap_erase(&self->modified, start, removed);
+        change_bitmap_insert(&self->modified, start, added, 1);
+        return;
+    }
+    if (!self->source_aligned) {
+        change_bitmap_set(&self->modified, start, start + added, 1);
+        return;
+    }
+    unsigned char original[DATA_BUFFER_PAGE_SIZE];
+    for (size_t done = 0; done < added;) {
+        size_t length = (added - done < sizeof(original)) ? added - done : sizeof(original);
+        data_source_read(&self->source, start + done, original, length);
+        int equal = 1;
+        for (size_t pos = 0; pos < length; equal = !equal) { // abwechselnd gleiche und neue Bytes
+            size_t run = byte_scan_run(bytes + done + pos, original + pos, length - pos, equal);
+            change_bitmap_set(&self->modified, start + done + pos, start + done + pos + run, !equal);
+            pos += run;
+        }
+        done += length;
+    }
+}
+
+/**
+ * @brief Überschreibt einen Bereich und hält alte und neue Bytes im Journal fest.
+ * @param typed 1 = getipptes Byte, darf an den laufenden Journal-Eintrag angehängt werden
+ */
+static void overwrite_bytes(DataBuffer *self, size_t index, const unsigned char *bytes,
+                            size_t length, int typed) {
+    if (index >= self->size || length == 0) { // prüfen, ob der Zugriff zulässig ist
+        return;
+    }
+    if (length > self->size - index) {
+        length = self->size - index; // nicht über das Dateiende hinaus schreiben
+    }
+    unsigned char *oldBytes;
+    unsigned char *newBytes;
+    if (undo_journal_record(&self->journal, index, length, length, typed, &oldBytes,
+                            &newBytes) == 0) {
+        piece_table_read(&self->pieces, index, oldBytes, length); // bisherige Bytes merken
+        memcpy(newBytes, bytes, length);
+    }
+    piece_table_replace(&self->pieces, index, bytes, length); // Stücke ersetzen
+    track_modified(self, index, length, bytes, length);       // geänderte Bytes markieren
+    mark_dirty(self, index, index + length);                  // betroffene Seiten merken
+    mark_changed(self, index, length, length);
+}
+
+/**
+ * @brief Fügt Bytes ein und hält sie im Journal fest.
+ * @param typed 1 = getipptes Byte, darf an den laufenden Journal-Eintrag angehängt werden
+ */
+static void insert_bytes(DataBuffer *self, size_t index, const unsigned char *bytes,
+                         size_t length, int typed) {
+    if (index > self->size || length == 0) { // Einfügen direkt am Ende ist erlaubt
+        return;
+    }
+    unsigned char *unused;
+    unsigned char *newBytes;
+    if (undo_journal_record(&self->journal, index, 0, length, typed, &unused, &newBytes) == 0) {
+        memcpy(newBytes, bytes, length);
+    }
+    piece_table_insert(&self->pieces, index, bytes, length);
+    track_modified(self, index, 0, bytes, length);
+    self->size += length;       // Inhalt ist gewachsen
+    self->layout_changed = 1;   // nachfolgende Bytes haben sich verschoben
+    clear_dirty(self);          // Seiten sind nicht mehr einzeln speicherbar
+    mark_changed(self, index, 0, length);
+}
+
+/**
+ * @brief Ersetzt `remove` Bytes ab `offset` durch `length` Bytes, ohne Journal.
+ *
+ * Wird beim Zurücknehmen und Wiederholen genutzt. Bei gleicher Länge
+ * bleiben die Bytes an ihrer Position, sodass weiterhin nur geänderte
+ * Seiten gespeichert werden müssen.
+ */
+static void apply_change(DataBuffer *self, size_t offset, size_t remove,
+                         const unsigned char *bytes, size_t length) {
+    piece_table_erase(&self->pieces, offset, remove);
+    piece_table_insert(&self->pieces, offset, bytes, length);
+    track_modified(self, offset, remove, bytes, length);
+    if (remove == length) {
+        mark_dirty(self, offset, offset + length);
+    } else {
+        self->size = self->size - remove + length;
+        self->layout_changed = 1;
+        clear_dirty(self);
+    }
+    mark_changed(self, offset, remove, length);
+}
+
+/**
+ * @brief Merkt die Seiten eines überschriebenen Bereichs als geändert.
+ *
+ * Nach dem Einfügen oder Löschen werden keine Seiten mehr verfolgt,
+ * da ohnehin komplett neu geschrieben werden muss.
+ */
+static void mark_dirty(DataBuffer *self, size_t start, size_t end) {
+    if (self->layout_changed || start >= end) {
+        return;
+    }
+    size_t lastPage = (end - 1) / DATA_BUFFER_PAGE_SIZE;
+    if (lastPage / 64 >= self->dirty_words) { // beim ersten Überschreiben oder nach Zuwachs
+        size_t pageCount = (self->size + DATA_BUFFER_PAGE_SIZE - 1) / DATA_BUFFER_PAGE_SIZE;
+        size_t words = (pageCount + 63) / 64;
+        uint64_t *pages = (uint64_t *)realloc(self->dirty_pages, words * sizeof(uint64_t));
+        if (!pages) {
+            fatal_error("data_buffer_overwrite", "out of memory");
+        }
+        memset(pages + self->dirty_words, 0, (words - self->dirty_words) * sizeof(uint64_t));
+        self->dirty_pages = pages;
+        self->dirty_words = words;
+    }
+    for (size_t page = start / DATA_BUFFER_PAGE_SIZE; page <= lastPage; page++) {
+        self->dirty_pages[page / 64] |= (uint64_t)1 << (page % 64);
+    }
+}
+
+/**
+ * @brief Prüfsumme (FNV-1a) der letzten Seite vor `end` in der Quelle.
+ *
+ * Quellen, die nicht wachsen können, werden nicht gelesen; ein noch
+ * ladendes Backend würde sonst auf seine Bytes warten.
+ */
+static uint64_t hash_tail(const DataSource *source, size_t end) {
+    if (!source->ops || !source->ops->grow || source->loading || end == 0) {
+        return 0;
+    }
+    unsigned char page[DATA_BUFFER_PAGE_SIZE];
+    size_t length = (end < sizeof(page)) ? end : sizeof(page);
+    data_source_read(source, end - length, page, length);
+    uint64_t hash = 0xcbf29ce484222325ull;
+    for (size_t i = 0; i < length; i++) {
+        hash = (hash ^ page[i]) * 0x100000001b3ull;
+    }
+    return hash;
+}
+
+/** @brief Verwirft die Seiten-Bitmap. */
+static void clear_dirty(DataBuffer *self) {
+    free(self->dirty_pages);
+    self->dirty_pages = NULL;
+    self->dirty_words = 0;
+}
+
+/**
+ * @brief Sucht ab `from` die erste geänderte bzw. unveränderte Seite.
+ *
+ * Ganze 64-Bit-Wörter ohne Treffer werden übersprungen.
+ *
+ * @param self  Zeiger auf den Buffer
+ * @param from  erste zu prüfende Seite
+ * @param dirty 1 = geänderte Seite suchen, 0 = unveränderte Seite suchen
+ * @return Seitennummer oder `dirty_words * 64`, falls keine gefunden
+ */
+static size_t find_page(const DataBuffer *self, size_t from, int dirty) {
+    size_t word = from / 64;
+    if (word >= self->dirty_words) {
+        return self->dirty_words * 64;
+    }
+    uint64_t bits = dirty ? self->dirty_pages[word] : ~self->dirty_pages[word];
+    bits &= ~(uint64_t)0 << (from % 64); // Bits vor `from` ausblenden
+    while (bits == 0) {
+        if (++word >= self->dirty_words) {
+            return self->dirty_words * 64;
+        }
+        bits = dirty ? self->dirty_pages[word] : ~self->dirty_pages[word];
+    }
+    return word * 64 + (size_t)__builtin_ctzll(bits);
+}
+
+/**
+ * @brief Fasst benachbarte geänderte Seiten zu Byte-Bereichen zusammen.
+ * @param self      Zeiger auf den Buffer
+ * @param outRanges Paare aus Start und Ende, vom Aufrufer freizugeben
+ * @return Anzahl der Bereiche
+ */
+static size_t collect_dirty_runs(const DataBuffer *self, size_t **outRanges) {
+    size_t count = 0;
+    size_t capacity = 0;
+    size_t *ranges = NULL;
+    size_t pageCount = (self->size + DATA_BUFFER_PAGE_SIZE - 1) / DATA_BUFFER_PAGE_SIZE;
+    size_t page = self->dirty_pages ? find_page(self, 0, 1) : pageCount;
+
+    while (page < pageCount) {
+        size_t endPage = find_page(self, page, 0); // erste unveränderte Seite danach
+        if (count == capacity) {
+            capacity = capacity ? capacity * 2 : 16;
+            size_t *grown = (size_t *)realloc(ranges, capacity * 2 * sizeof(size_t));
+            if (!grown) {
+                fatal_error("data_buffer_save_file", "out of memory");
+            }
+            ranges = grown;
+        }
+        size_t end = endPage * DATA_BUFFER_PAGE_SIZE;
+        ranges[2 * count] = page * DATA_BUFFER_PAGE_SIZE;
+        ranges[2 * count + 1] = (end < self->size) ? end : self->size; // letzte Seite kürzen
+        count++;
+        page = (endPage < pageCount) ? find_page(self, endPage, 1) : pageCount;
+    }
+    *outRanges = ranges;
+    return count;
+}
+
+/**
+ * @brief Schreibt ein Stück in die temporäre Datei.
+ *
+ * Originalstücke werden, sofern die Quelle einen Deskriptor besitzt,
+ * im Kernel kopiert. Alle anderen Stücke werden direkt aus dem
+ * Speicher geschrieben.
+ */
+static int write_piece(void *context, const PieceNode *piece) {
+    SaveContext *save = (SaveContext *)context;
+    const DataBuffer *self = save->buffer;
+    if (piece->kind == PIECE_ORIGINAL) {
+        if (self->source.fd >= 0) { // unveränderten Bereich im Kernel kopieren
+            return fileSinkCopy(save->sink, self->source.fd, piece->start, piece->length);
+        }
+        if (self->source.bytes) {   // Quelle liegt vollständig im Speicher
+            return fileSinkWrite(save->sink, self->source.bytes + piece->start, piece->length);
+        }
+        return write_source_range(save->sink, &self->source, piece->start, piece->length);
+    }
+    return fileSinkWrite(save->sink, self->pieces.add + piece->start, piece->length);
+}
+
+/**
+ * @brief Schreibt einen Quellbereich blockweise über die Lese-Funktion der Quelle.
+ *
+ * Wird für Quellen ohne Deskriptor und ohne direkten Zugriff genutzt,
+ * etwa für Datenströme.
+ *
+ * @return 0 bei Erfolg, sonst -1
+ */
+static int write_source_range(FileSink *sink, const DataSource *source, size_t offset,
+                              size_t length) {
+    unsigned char chunk[DATA_BUFFER_PAGE_SIZE * 16];
+    while (length > 0) {
+        size_t part = (length < sizeof(chunk)) ? length : sizeof(chunk);
+        data_source_read(source, offset, chunk, part);
+        if (fileSinkWrite(sink, chunk, part) != 0) {
+            return -1;
+        }
+        offset += part;
+        length -= part;
+    }
+    return 0;
+}
+
+/**
+ * @brief Leitet den Vorlade-Hinweis für Originalstücke an die Quelle weiter.
+ */
+static int prefetch_piece(void *context, const PieceNode *piece, size_t skip, size_t length) {
+    if (piece->kind == PIECE_ORIGINAL) {
+        data_source_prefetch((const DataSource *)context, piece->start + skip, length);
+    }
+    return 0;
+}
+
+/**
+ * @brief Callback für das blockweise Speichern.
+ */
+static void read_chunk(void *context, size_t offset, unsigned char *dest, size_t length) {
+    data_buffer_get_range((const DataBuffer *)context, offset, offset + length, dest);
+}
 
 //* ----------------------------------- Init und Deinit -----------------------------------
 /**
@@ -122,6 +865,7 @@ int data_buffer_save_file(DataBuffer *self, const char *path) { // Buffer auf Pl
  */
 int data_buffer_init(DataBuffer *self) { // Struktur vorbereiten
     memset(self, 0, sizeof(*self)); // Struktur auf Null setzen
+    undo_journal_init(&self->journal, 0); // leeres Journal mit Vorgabebudget
     self->edited = 0;               // keine Änderungen
     self->ever_changed = 0;         // bisher nichts verändert
     return 0;                       // Erfolg melden
@@ -133,9 +877,12 @@ int data_buffer_init(DataBuffer *self) { // Struktur vorbereiten
  * @return 0 bei Erfolg
  */
 int data_buffer_deinit(DataBuffer *self) { // Ressourcen freigeben
-    free(self->bytes);              // gespeicherte Bytes freigeben
-    memset(self, 0, sizeof(*self)); // Struktur zurücksetzen
-    return 0;                      // Erfolg melden
+    clear_dirty(self);                  // Seiten-Bitmap freigeben
+    change_bitmap_deinit(&self->modified); // Bitmap geänderter Bytes freigeben
+    piece_clip_free(&self->clipboard);  // Zwischenablage verwerfen
+    undo_journal_deinit(&self->journal); // Journal freigeben
+    piece_table_deinit(&self->pieces);  // Stückbaum freigeben
+    data_source_close(&self->source);   // Quelle schließen
+    memset(self, 0, sizeof(*self));     // Struktur zurücksetzen
+    return 0;                           // Erfolg melden
 }
-
-
@@ -15,18 +15,60 @@
  */
 
 #include <stddef.h> // stellt den Typ size_t bereit
+#include <stdint.h> // feste Breiten für die Seiten-Bitmap
+#include "Data_Source.h" // Quelle der Originaldaten
+#include "Piece_Table.h" // Stückbaum für Einfügen und Löschen
+#include "Undo_Journal.h" // Rückgängig und Wiederholen
+#include "Change_Bitmap.h" // seit Laden oder Speichern geänderte Bytes
+#include "File_Watch.h" // Kennzeichen der Datei auf dem Datenträger
 
 //* ---------------------------- Globale Konstanten oder Defines --------------------------
+#define DATA_BUFFER_PAGE_SIZE 4096 /**< Granularität der Änderungsverfolgung in Bytes */
+#define DATA_BUFFER_CHANGE_LOG 64  /**< so viele letzte Änderungen bleiben nachvollziehbar */
 
 //* ------------------------------------- Strukturen --------------------------------------
+/**
+ * @brief Eine Änderung des Inhalts: `removed` Bytes ab `start` wurden durch `added` ersetzt.
+ *
+ * Sind beide gleich, wurde nur überschrieben und alle übrigen Bytes
+ * stehen an ihrer bisherigen Position.
+ */
+typedef struct {
+    size_t start;   /**< erstes geänderte Byte */
+    size_t removed; /**< Anzahl ersetzter Bytes */
+    size_t added;   /**< Anzahl neuer Bytes an ihrer Stelle */
+} DataBufferChange;
+
 /**
  * @brief Enthält geladene Datei und Bearbeitungsstatus.
+ *
+ * Die Originalbytes stammen aus einer `DataSource` und werden nie
+ * verändert. Alle Bearbeitungen werden in einer Piece-Table
+ * festgehalten, die den aktuellen Inhalt als Folge von Verweisen auf
+ * Quelle und Anhang-Buffer beschreibt. Jede Bearbeitung wird zusätzlich
+ * im Undo-Journal festgehalten.
  */
 typedef struct {                                   // Struktur für den Daten-Buffer
-    unsigned char *bytes; /**< Zeiger auf die gelesenen Bytes */
-    size_t size;          /**< Größe der Datei in Bytes */
-    int edited;           /**< Flag für ungespeicherte Änderungen */
-    int ever_changed;     /**< Flag, ob die Datei jemals bearbeitet wurde */
+    DataSource source;       /**< Quelle der unveränderten Originalbytes */
+    PieceTable pieces;       /**< aktueller Inhalt als Stückfolge */
+    PieceClip clipboard;     /**< zuletzt kopierter oder ausgeschnittener Bereich */
+    UndoJournal journal;     /**< Bearbeitungen für Rückgängig und Wiederholen */
+    size_t size;             /**< aktuelle Größe des Inhalts in Bytes */
+    int edited;              /**< Flag für ungespeicherte Änderungen */
+    int ever_changed;        /**< Flag, ob die Datei jemals bearbeitet wurde */
+    int layout_changed;      /**< Flag, ob seit dem Speichern Bytes eingefügt/gelöscht wurden */
+    uint64_t *dirty_pages;   /**< Bitmap der seit dem Speichern überschriebenen Seiten */
+    size_t dirty_words;      /**< Anzahl der 64-Bit-Wörter in `dirty_pages` */
+    DataSourceOptions options; /**< Wahl und Budgets des Backends für jedes Laden */
+    uint64_t tail_hash;      /**< Prüfsumme der letzten Quellbytes, erkennt reines Anhängen */
+    unsigned long revision;  /**< wird bei jeder Änderung des Inhalts erhöht */
+    DataBufferChange changes[DATA_BUFFER_CHANGE_LOG]; /**< letzte Änderungen, Index `revision % DATA_BUFFER_CHANGE_LOG` */
+    unsigned long log_start; /**< Änderungen bis einschließlich dieser Revision sind unbekannt */
+    ChangeBitmap modified;   /**< je Byte 1, wenn seit dem Laden oder Speichern geändert */
+    int source_aligned;      /**< 1, solange jede Position ihrem Byte in der Quelle entspricht */
+    int source_on_disk;      /**< 1, solange die Quelle dem gespeicherten Stand der Datei entspricht */
+    FileSignature disk;      /**< Kennzeichen der Datei beim Laden oder letzten Speichern */
+    int source_stale;        /**< 1, wenn unveränderte Bytes schon den fremd geänderten Stand zeigen können */
 } DataBuffer;                                      // Typname der Struktur
 
 //* ------------------------------------- Funktionen --------------------------------------
@@ -51,14 +93,175 @@ void data_buffer_set_byte(DataBuffer *self, size_t index, unsigned char value);
 void data_buffer_get_range(const DataBuffer *self, size_t start, size_t end,
                            unsigned char *dest); // Bereich kopieren
 
+/**
+ * @brief Übernimmt neue Bytes eines Datenstroms oder den Ladefortschritt.
+ */
+int data_buffer_poll(DataBuffer *self, size_t *dropped); // Datenstrom abfragen
+
+/**
+ * @brief Prüft, ob die Quelle noch wächst oder im Hintergrund geladen wird.
+ */
+static inline int data_buffer_needs_poll(const DataBuffer *self) {
+    return self->source.growing || self->source.loading;
+}
+
+/**
+ * @brief Prüft, ob der Inhalt aus einem Datenstrom stammt.
+ *
+ * Eine im Hintergrund geladene Datei wird zwar ebenfalls abgefragt,
+ * bleibt aber eine Datei, die gespeichert und überwacht werden kann.
+ */
+static inline int data_buffer_is_stream(const DataBuffer *self) {
+    return self->source.ops && self->source.ops->stream;
+}
+
+/**
+ * @brief Prüft, ob `data_buffer_get_range` aus mehreren Threads zugleich aufgerufen werden darf.
+ *
+ * Gilt nur, solange der Buffer währenddessen nicht verändert wird.
+ */
+static inline int data_buffer_reads_concurrently(const DataBuffer *self) {
+    return self->source.ops && self->source.ops->concurrent;
+}
+
+/**
+ * @brief Liefert die Änderung, die zur angegebenen Revision geführt hat.
+ *
+ * So können abgeleitete Daten wie Prüfsummen nur die betroffenen
+ * Bereiche neu berechnen. Nach dem Laden und für Änderungen, die
+ * länger als `DATA_BUFFER_CHANGE_LOG` Schritte zurückliegen, ist nichts
+ * bekannt.
+ *
+ * @param self     Zeiger auf den Buffer
+ * @param revision Revision nach der gesuchten Änderung
+ * @param out      erhält die Änderung
+ * @return 0 bei Erfolg, -1 wenn die Änderung nicht mehr bekannt ist
+ */
+int data_buffer_get_change(const DataBuffer *self, unsigned long revision,
+                           DataBufferChange *out); // Änderung nachschlagen
+
+/**
+ * @brief Hängt Bytes an, die eine andere Anwendung an die Datei angefügt hat.
+ *
+ * Nur wenn die letzten bisherigen Bytes der Datei unverändert sind,
+ * wurde wirklich nur angehängt; dann werden allein die neuen Bytes
+ * übernommen.
+ *
+ * @param self Zeiger auf den Buffer
+ * @return 1 bei Zuwachs, 0 ohne, -1 wenn neu geladen werden muss
+ */
+int data_buffer_follow(DataBuffer *self); // angehängte Bytes übernehmen
+
+/**
+ * @brief Liest nach einer fremden Änderung der Datei nicht mehr aus einer Einblendung.
+ *
+ * Für ungespeicherte Bearbeitungen, die nach einer Änderung an Ort und
+ * Stelle erhalten bleiben sollen. Unveränderte Bytes zeigen danach den
+ * neuen Stand der Datei, hinter einem gekürzten Ende Nullbytes; beim
+ * Block-Cache gilt das nur für Blöcke, die er noch nicht hält. Der Buffer
+ * merkt sich das in `source_stale`.
+ *
+ * @param self Zeiger auf den Buffer
+ * @return 0 bei Erfolg, sonst -1
+ */
+int data_buffer_detach(DataBuffer *self); // Quelle von der Einblendung lösen
+
+/**
+ * @brief Kündigt an, dass ein Bereich bald angezeigt wird.
+ */
+void data_buffer_prefetch(const DataBuffer *self, size_t start, size_t end); // Bereich vorladen
+
+/**
+ * @brief Überschreibt einen Bereich mit neuen Bytes.
+ */
+void data_buffer_overwrite(DataBuffer *self, size_t index, const unsigned char *bytes,
+                           size_t length); // Bereich überschreiben
+
+/**
+ * @brief Schreibt ein getipptes Byte, aufeinanderfolgende Bytes werden ein Undo-Schritt.
+ */
+void data_buffer_type_byte(DataBuffer *self, size_t index, unsigned char value,
+                           int insert); // getipptes Byte schreiben
+
+/**
+ * @brief Fügt Bytes an einer Position ein.
+ */
+void data_buffer_insert(DataBuffer *self, size_t index, const unsigned char *bytes,
+                        size_t length); // Bytes einfügen
+
+/**
+ * @brief Löscht einen Bereich.
+ */
+void data_buffer_delete(DataBuffer *self, size_t start, size_t end); // Bereich löschen
+
+/**
+ * @brief Kopiert einen Bereich in die Zwischenablage.
+ */
+void data_buffer_copy(DataBuffer *self, size_t start, size_t end); // Bereich kopieren
+
+/**
+ * @brief Schneidet einen Bereich in die Zwischenablage aus.
+ */
+void data_buffer_cut(DataBuffer *self, size_t start, size_t end); // Bereich ausschneiden
+
+/**
+ * @brief Fügt die Zwischenablage an einer Position ein.
+ */
+void data_buffer_paste(DataBuffer *self, size_t index); // Zwischenablage einfügen
+
+/**
+ * @brief Nimmt den letzten Bearbeitungsschritt zurück.
+ * @param self     Zeiger auf den Buffer
+ * @param position erhält die Position der zurückgenommenen Bearbeitung
+ * @return 0 bei Erfolg, -1 wenn nichts zurückzunehmen ist
+ */
+int data_buffer_undo(DataBuffer *self, size_t *position); // Rückgängig
+
+/**
+ * @brief Wiederholt den zuletzt zurückgenommenen Bearbeitungsschritt.
+ * @param self     Zeiger auf den Buffer
+ * @param position erhält die Position der wiederholten Bearbeitung
+ * @return 0 bei Erfolg, -1 wenn nichts zu wiederholen ist
+ */
+int data_buffer_redo(DataBuffer *self, size_t *position); // Wiederholen
+
+/**
+ * @brief Prüft, ob es einen Schritt für `data_buffer_undo` gibt.
+ */
+static inline int data_buffer_can_undo(const DataBuffer *self) {
+    return undo_journal_can_undo(&self->journal);
+}
+
+/**
+ * @brief Fasst alle folgenden Bearbeitungen bis `data_buffer_end_group` zu einem Schritt zusammen.
+ */
+static inline void data_buffer_begin_group(DataBuffer *self) {
+    undo_journal_begin_group(&self->journal);
+}
+
+/**
+ * @brief Beendet den mit `data_buffer_begin_group` begonnenen Schritt.
+ */
+static inline void data_buffer_end_group(DataBuffer *self) {
+    undo_journal_end_group(&self->journal);
+}
+
 /**
  * @brief Speichert den Buffer in eine Datei.
  * @param self Zeiger auf den Buffer
  * @param path Dateipfad
- * @return 0 bei Erfolg
+ * @return 0 bei Erfolg, -1 wenn die Datei inzwischen von außen geändert wurde
  */
 int data_buffer_save_file(DataBuffer *self, const char *path); // Buffer speichern
 
+/**
+ * @brief Schreibt den Buffer absturzsicher in eine (neue) Datei.
+ * @param self Zeiger auf den Buffer
+ * @param path Dateipfad
+ * @return 0 bei Erfolg, sonst -1
+ */
+int data_buffer_save_as(DataBuffer *self, const char *path); // unter neuem Namen speichern
+
 //* ----------------------------------- Init und Deinit -----------------------------------
 /**
  * @brief Initialisiert den Buffer.
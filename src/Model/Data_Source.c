@@ -0,0 +1,385 @@
+/**
+ * @file Data_Source.c
+ * @brief Backends für die Originaldaten des Daten-Buffers.
+ *
+ * Dieses Modul stellt die konkreten Datenquellen bereit. Die Cache-Quelle
+ * liest Blöcke per `pread` in einen LRU-Cache mit festem Speicherbudget;
+ * sie ist die Vorgabe für reguläre Dateien, weil ein Kürzen durch eine
+ * andere Anwendung dort nur Nullbytes statt `SIGBUS` liefert. Die
+ * `mmap`-Quelle blendet reguläre Dateien auf Wunsch ein, sodass Seiten
+ * ohne Kopie direkt aus dem Seitencache gelesen werden; sie löst sich
+ * erst bei einer erkannten fremden Änderung von der Einblendung. Die
+ * Strom-Quelle sammelt Standardeingabe, Pipes und Zeichengeräte in einer
+ * wachsenden Arena. Die Lade-Quelle liest die Datei mit mehreren
+ * Threads im Hintergrund vollständig in den Speicher. Die
+ * Speicher-Quelle liest die
+ * Datei wie bisher vollständig über den `File_Manager` ein und dient
+ * als Rückfallebene, etwa für leere Dateien oder Plattformen ohne
+ * `mmap`.
+ */
+
+//* -------------------------------------- Includes ---------------------------------------
+#include "Data_Source.h"   // Schnittstelle dieses Moduls
+#include <stdlib.h>         // free
+#include <string.h>         // memcpy und memset
+#include "Async_Loader.h"  // Einlesen im Hintergrund
+#include "Block_Cache.h"   // blockweiser Lese-Cache
+#include "Stream_Arena.h"  // Speicher für Datenströme
+#include "File_Manager.h"  // Einlesen und Einblenden von Dateien
+
+//* ---------------------------- Globale Konstanten oder Defines --------------------------
+// Vorwärtsdeklarationen der Helferfunktionen
+static void direct_read(const DataSource *self, size_t offset, unsigned char *dest,
+                        size_t length);
+static void memory_close(DataSource *self);
+static void mmap_prefetch(const DataSource *self, size_t offset, size_t length);
+static int mmap_grow(DataSource *self);
+static int mmap_detach(DataSource *self);
+static void mmap_close(DataSource *self);
+static void cache_read(const DataSource *self, size_t offset, unsigned char *dest,
+                       size_t length);
+static void cache_prefetch(const DataSource *self, size_t offset, size_t length);
+static int cache_grow(DataSource *self);
+static void cache_close(DataSource *self);
+static int open_cache(DataSource *self, const char *path, size_t budget);
+static void stream_read(const DataSource *self, size_t offset, unsigned char *dest,
+                        size_t length);
+static int stream_poll(DataSource *self, size_t *dropped);
+static void stream_close(DataSource *self);
+static int open_stream(DataSource *self, const char *path, size_t ring_budget);
+static void preload_read(const DataSource *self, size_t offset, unsigned char *dest,
+                         size_t length);
+static int preload_poll(DataSource *self, size_t *dropped);
+static void preload_close(DataSource *self);
+static int open_preload(DataSource *self, const char *path);
+
+/** Quelle, deren Bytes vollständig im Speicher liegen. */
+static const DataSourceOps MEMORY_SOURCE = {
+    .name = "memory",
+    .read = direct_read,
+    .prefetch = NULL,
+    .poll = NULL,
+    .grow = NULL,
+    .detach = NULL,
+    .close = memory_close,
+    .concurrent = 1,
+    .stream = 0
+};
+
+/** Quelle, deren Bytes per mmap eingeblendet sind. */
+static const DataSourceOps MMAP_SOURCE = {
+    .name = "mmap",
+    .read = direct_read,
+    .prefetch = mmap_prefetch,
+    .poll = NULL,
+    .grow = mmap_grow,
+    .detach = mmap_detach,
+    .close = mmap_close,
+    .concurrent = 1,
+    .stream = 0
+};
+
+/** Quelle, die Blöcke per pread in einen LRU-Cache liest; Lesen verändert den Cache. */
+static const DataSourceOps CACHE_SOURCE = {
+    .name = "pread cache",
+    .read = cache_read,
+    .prefetch = cache_prefetch,
+    .poll = NULL,
+    .grow = cache_grow,
+    .detach = NULL,
+    .close = cache_close,
+    .concurrent = 0,
+    .stream = 0
+};
+
+/** Quelle, die einen Datenstrom nach und nach in einer Arena sammelt. */
+static const DataSourceOps STREAM_SOURCE = {
+    .name = "stream",
+    .read = stream_read,
+    .prefetch = NULL,
+    .poll = stream_poll,
+    .grow = NULL,
+    .detach = NULL,
+    .close = stream_close,
+    .concurrent = 1,
+    .stream = 1
+};
+
+/** Quelle, die im Hintergrund vollständig in den Speicher gelesen wird. */
+static const DataSourceOps PRELOAD_SOURCE = {
+    .name = "preload",
+    .read = preload_read,
+    .prefetch = NULL,
+    .poll = preload_poll,
+    .grow = NULL,
+    .detach = NULL,
+    .close = preload_close,
+    .concurrent = 1,
+    .stream = 0
+};
+
+//* ------------------------------------- Funktionen --------------------------------------
+
+//* ---------------------------------- Helfer Funktionen ----------------------------------
+/** @brief Kopiert einen Bereich aus dem direkt adressierbaren Speicher. */
+static void direct_read(const DataSource *self, size_t offset, unsigned char *dest,
+                        size_t length) {
+    memcpy(dest, self->bytes + offset, length); // Bereich kopieren
+}
+
+/** @brief Gibt den eingelesenen Speicher frei. */
+static void memory_close(DataSource *self) {
+    free((void *)self->bytes); // gelesene Bytes freigeben
+}
+
+/** @brief Lässt den Kernel eingeblendete Seiten im Voraus lesen. */
+static void mmap_prefetch(const DataSource *self, size_t offset, size_t length) {
+    adviseWillNeed(self->bytes, offset, length); // nur ein Hinweis an den Kernel
+}
+
+/** @brief Blendet die gewachsene Datei mit neuer Größe ein. */
+static int mmap_grow(DataSource *self) {
+    return remapFileGrown(self->fd, &self->bytes, &self->size);
+}
+
+/**
+ * @brief Wechselt von der Einblendung zum Block-Cache über demselben Deskriptor.
+ *
+ * Die Quelle behält ihre Größe, damit alle Offsets gültig bleiben;
+ * inzwischen gekürzte Bereiche liest der Cache als Nullbytes.
+ */
+static int mmap_detach(DataSource *self) {
+    BlockCache *cache = malloc(sizeof(*cache));
+    if (!cache) {
+        return -1;
+    }
+    if (block_cache_attach(cache, self->fd, self->size, BLOCK_CACHE_DEFAULT_BUDGET) != 0) {
+        free(cache);
+        return -1; // Einblendung bleibt bestehen
+    }
+    unmapFile(self->bytes, self->size, -1); // Deskriptor gehört jetzt dem Cache
+    self->ops = &CACHE_SOURCE;
+    self->bytes = NULL;
+    self->state = cache;
+    return 0;
+}
+
+/** @brief Hebt die Einblendung der Datei auf. */
+static void mmap_close(DataSource *self) {
+    unmapFile(self->bytes, self->size, self->fd); // Einblendung aufheben
+}
+
+/** @brief Liest einen Bereich über den Block-Cache. */
+static void cache_read(const DataSource *self, size_t offset, unsigned char *dest,
+                       size_t length) {
+    block_cache_read((BlockCache *)self->state, offset, dest, length);
+}
+
+/** @brief Lädt Blöcke eines Bereichs vorab in den Cache. */
+static void cache_prefetch(const DataSource *self, size_t offset, size_t length) {
+    block_cache_prefetch((BlockCache *)self->state, offset, length);
+}
+
+/** @brief Übernimmt die neue Dateigröße in den Cache. */
+static int cache_grow(DataSource *self) {
+    BlockCache *cache = (BlockCache *)self->state;
+    int result = block_cache_grow(cache);
+    self->size = cache->size;
+    return result;
+}
+
+/** @brief Gibt den Block-Cache frei und schließt die Datei. */
+static void cache_close(DataSource *self) {
+    block_cache_deinit((BlockCache *)self->state);
+    free(self->state);
+}
+
+/**
+ * @brief Öffnet die Datei über einen Block-Cache.
+ * @return 0 bei Erfolg, sonst -1
+ */
+static int open_cache(DataSource *self, const char *path, size_t budget) {
+    BlockCache *cache = malloc(sizeof(*cache));
+    if (!cache) {
+        return -1;
+    }
+    if (block_cache_init(cache, path, budget) != 0) {
+        free(cache);
+        return -1;
+    }
+    self->ops = &CACHE_SOURCE;
+    self->state = cache;
+    self->size = cache->size;
+    self->fd = cache->fd; // Deskriptor gehört dem Cache, erlaubt aber Kernel-Kopien
+    return 0;
+}
+
+/** @brief Liest einen Bereich aus der Arena. */
+static void stream_read(const DataSource *self, size_t offset, unsigned char *dest,
+                        size_t length) {
+    stream_arena_read((const StreamArena *)self->state, offset, dest, length);
+}
+
+/** @brief Übernimmt neue Bytes und meldet verworfene. */
+static int stream_poll(DataSource *self, size_t *dropped) {
+    StreamArena *arena = (StreamArena *)self->state;
+    size_t base = arena->base;
+    int result = stream_arena_fill(arena);
+    *dropped = arena->base - base;
+    self->size = arena->end;
+    if (result < 0) {
+        self->growing = 0; // Strom beendet, Inhalt steht fest
+    }
+    return (result > 0 || *dropped > 0) ? 1 : result;
+}
+
+/** @brief Gibt die Arena frei und schließt den Strom. */
+static void stream_close(DataSource *self) {
+    stream_arena_deinit((StreamArena *)self->state);
+    free(self->state);
+}
+
+/**
+ * @brief Öffnet einen Datenstrom über eine Arena.
+ * @return 0 bei Erfolg, sonst -1
+ */
+static int open_stream(DataSource *self, const char *path, size_t ring_budget) {
+    StreamArena *arena = malloc(sizeof(*arena));
+    if (!arena) {
+        return -1;
+    }
+    if (stream_arena_init(arena, path, ring_budget) != 0) {
+        free(arena);
+        return -1;
+    }
+    self->ops = &STREAM_SOURCE;
+    self->state = arena;
+    self->size = 0;       // Bytes kommen erst über data_source_poll hinzu
+    self->growing = 1;
+    return 0; // fd bleibt -1: ein Strom lässt sich nicht erneut lesen
+}
+
+/** @brief Liest einen Bereich und wartet nur auf dessen Abschnitte. */
+static void preload_read(const DataSource *self, size_t offset, unsigned char *dest,
+                         size_t length) {
+    async_loader_read((AsyncLoader *)self->state, offset, dest, length);
+}
+
+/**
+ * @brief Aktualisiert den Ladefortschritt.
+ *
+ * Ist alles eingelesen, werden die Threads beendet und der direkte
+ * Zugriff über `bytes` freigeschaltet. Abschnitte mit Lesefehler zählen
+ * als eingelesen; das Laden endet dann ebenso, `incomplete` meldet es.
+ */
+static int preload_poll(DataSource *self, size_t *dropped) {
+    AsyncLoader *loader = (AsyncLoader *)self->state;
+    size_t loaded = async_loader_progress(loader);
+    *dropped = 0;
+    if (loaded == self->loaded) {
+        return 0;
+    }
+    self->loaded = loaded;
+    if (loaded == self->size) {
+        self->incomplete = (async_loader_finish(loader) != 0);
+        self->bytes = loader->bytes; // ab jetzt ohne Sperre lesen
+        self->loading = 0;
+    }
+    return 1;
+}
+
+/** @brief Beendet das Einlesen und gibt den Speicher frei. */
+static void preload_close(DataSource *self) {
+    async_loader_deinit((AsyncLoader *)self->state);
+    free(self->state);
+}
+
+/**
+ * @brief Startet das Einlesen der Datei im Hintergrund.
+ * @return 0 bei Erfolg, sonst -1
+ */
+static int open_preload(DataSource *self, const char *path) {
+    AsyncLoader *loader = malloc(sizeof(*loader));
+    if (!loader) {
+        return -1;
+    }
+    if (async_loader_init(loader, path) != 0) {
+        free(loader);
+        return -1;
+    }
+    self->ops = &PRELOAD_SOURCE;
+    self->state = loader;
+    self->size = loader->size;
+    self->fd = loader->fd;  // Deskriptor gehört dem Loader, erlaubt aber Kernel-Kopien
+    if (loader->size == 0) {
+        async_loader_finish(loader); // nichts zu lesen: sofort fertig
+        self->bytes = loader->bytes;
+        return 0;
+    }
+    self->loading = 1;      // Fortschritt über data_source_poll
+    return 0;
+}
+
+//* ----------------------------------- Init und Deinit -----------------------------------
+/**
+ * @brief Öffnet eine Datei als Datenquelle.
+ * @param self    Zeiger auf die Quelle
+ * @param path    Dateipfad
+ * @param options Backend-Wahl und Budgets, NULL = Vorgaben
+ * @return 0 bei Erfolg, sonst -1
+ */
+int data_source_open(DataSource *self, const char *path, const DataSourceOptions *options) {
+    memset(self, 0, sizeof(*self)); // Struktur leeren
+    self->fd = -1;                  // noch kein Deskriptor
+    size_t cache_budget = options ? options->cache_budget : 0;
+    size_t ring_budget = options ? options->ring_budget : 0;
+    int preload = options ? options->preload : 0;
+    int mapped_wanted = options ? options->mmap : 0;
+
+    if (isStreamPath(path)) {       // nicht adressierbar: als Strom empfangen
+        return open_stream(self, path, ring_budget);
+    }
+
+    if (preload && open_preload(self, path) == 0) { // ausdrücklich gewünscht
+        return 0;
+    }
+
+    const unsigned char *mapped = NULL;
+    size_t mappedSize = 0;
+    int mappedFd = -1;
+    if (mapped_wanted && mapFileReadOnly(path, &mapped, &mappedSize, &mappedFd) == 0) { // ausdrücklich gewünscht
+        self->ops = &MMAP_SOURCE;
+        self->bytes = mapped;
+        self->size = mappedSize;
+        self->fd = mappedFd;
+        return 0;
+    }
+
+    if (open_cache(self, path, cache_budget ? cache_budget : BLOCK_CACHE_DEFAULT_BUDGET) == 0) { // auch Geräte und leere Dateien
+        return 0;
+    }
+
+    unsigned char *loaded = NULL;
+    size_t loadedSize = 0;
+    if (readFileToBuffer(path, &loaded, &loadedSize) != 0) { // Rückfall: komplett lesen
+        return -1;
+    }
+    self->ops = &MEMORY_SOURCE;
+    self->bytes = loaded;
+    self->size = loadedSize;
+    return 0;
+}
+
+/**
+ * @brief Schließt die Quelle und gibt Ressourcen frei.
+ * @param self Zeiger auf die Quelle
+ * @return 0 bei Erfolg
+ */
+int data_source_close(DataSource *self) {
+    if (self->ops) {            // nur geöffnete Quellen schließen
+        self->ops->close(self);
+    }
+    memset(self, 0, sizeof(*self)); // Struktur zurücksetzen
+    self->fd = -1;
+    return 0;
+}
@@ -0,0 +1,183 @@
+#ifndef DATA_SOURCE_H
+#define DATA_SOURCE_H
+
+/**
+ * @file Data_Source.h
+ * @brief Schnittstelle der Datenquellen für den Daten-Buffer.
+ *
+ * Eine Datenquelle liefert die unveränderten Originalbytes einer
+ * Datei. Wie bei den Anzeige-Strategien wird das konkrete Verhalten
+ * über einen Satz von Funktionszeigern gekapselt, sodass der
+ * `DataBuffer` nicht wissen muss, ob die Daten komplett im Speicher
+ * liegen, per `mmap` eingeblendet, blockweise über einen Cache
+ * gelesen oder als Datenstrom nach und nach empfangen werden. Quellen
+ * mit direktem
+ * Speicherzugriff stellen zusätzlich einen Zeiger bereit, über den
+ * einzelne Bytes ohne Funktionsaufruf gelesen werden können.
+ */
+
+#include <stddef.h> // stellt den Typ size_t bereit
+
+//* ---------------------------- Globale Konstanten oder Defines --------------------------
+
+//* ------------------------------------- Strukturen --------------------------------------
+struct DataSource; /**< Vorwärtsdeklaration */
+
+/**
+ * @brief Einstellungen für die Wahl und Größe des Backends.
+ *
+ * Die Optionen werden bei jedem Laden neu angewendet und enthalten daher
+ * auch das Budget des Undo-Journals, das mit der Quelle neu beginnt.
+ */
+typedef struct {
+    size_t cache_budget; /**< Budget des Block-Caches in Bytes, 0 = Vorgabe */
+    size_t ring_budget;  /**< Datenströme: nur die letzten Bytes behalten, 0 = alle */
+    size_t undo_budget;  /**< Budget des Undo-Journals in Bytes, 0 = Vorgabe */
+    int preload;         /**< 1 = Datei im Hintergrund vollständig in den Speicher lesen */
+    int mmap;            /**< 1 = reguläre Dateien per `mmap` einblenden statt über den Block-Cache */
+} DataSourceOptions;
+
+/**
+ * @brief Funktionszeiger einer konkreten Datenquelle.
+ */
+typedef struct DataSourceOps {
+    const char *name;                                          /**< Name des Backends */
+    void (*read)(const struct DataSource *self, size_t offset,
+                 unsigned char *dest, size_t length);          /**< Bereich lesen */
+    void (*prefetch)(const struct DataSource *self, size_t offset,
+                     size_t length);                           /**< Vorladen, optional */
+    int (*poll)(struct DataSource *self, size_t *dropped);    /**< Zuwachs abholen, optional */
+    int (*grow)(struct DataSource *self);                      /**< angehängte Dateibytes übernehmen, optional */
+    int (*detach)(struct DataSource *self);                    /**< nicht mehr direkt aus der Datei lesen, optional */
+    void (*close)(struct DataSource *self);                    /**< Ressourcen freigeben */
+    int concurrent;                                            /**< 1, wenn `read` aus mehreren Threads zugleich erlaubt ist */
+    int stream;                                                /**< 1, wenn die Bytes aus einem Datenstrom ohne Datei stammen */
+} DataSourceOps;
+
+/**
+ * @brief Beschreibt eine geöffnete Datenquelle.
+ */
+typedef struct DataSource {
+    const DataSourceOps *ops;   /**< Backend-Funktionen */
+    const unsigned char *bytes; /**< direkter Zugriff (Speicher oder mmap), sonst NULL */
+    size_t size;                /**< Größe der Quelle in Bytes */
+    int fd;                     /**< Deskriptor der Datei für Kernel-Kopien, sonst -1 */
+    int growing;                /**< 1, solange ein Datenstrom noch Bytes liefern kann */
+    int loading;                /**< 1, solange die Quelle im Hintergrund eingelesen wird */
+    size_t loaded;              /**< bereits eingelesene Bytes während `loading` */
+    int incomplete;             /**< 1, wenn beim Einlesen Bytes fehlten; sie gelten als Nullbytes */
+    void *state;                /**< backendspezifische Zusatzdaten */
+} DataSource;
+
+//* ------------------------------------- Funktionen --------------------------------------
+/**
+ * @brief Liest einen Bereich aus der Quelle.
+ *
+ * Der Bereich muss vollständig innerhalb der Quelle liegen.
+ */
+static inline void data_source_read(const DataSource *self, size_t offset,
+                                    unsigned char *dest, size_t length) {
+    self->ops->read(self, offset, dest, length);
+}
+
+/**
+ * @brief Liest ein einzelnes Byte aus der Quelle.
+ */
+static inline unsigned char data_source_get_byte(const DataSource *self, size_t offset) {
+    if (self->bytes) {               // schneller Pfad ohne Funktionsaufruf
+        return self->bytes[offset];
+    }
+    unsigned char value = 0;
+    self->ops->read(self, offset, &value, 1);
+    return value;
+}
+
+/**
+ * @brief Kündigt an, dass ein Bereich bald gelesen wird.
+ *
+ * Backends ohne Vorladen ignorieren den Hinweis.
+ */
+static inline void data_source_prefetch(const DataSource *self, size_t offset, size_t length) {
+    if (self->ops && self->ops->prefetch) {
+        self->ops->prefetch(self, offset, length);
+    }
+}
+
+/**
+ * @brief Holt neu eingetroffene Bytes oder den Ladefortschritt ab.
+ *
+ * Bei Datenströmen beschreibt `size` danach das absolute Ende der
+ * Quelle. Im Ringmodus erhält `dropped` die Anzahl der seit dem letzten
+ * Aufruf am Anfang verworfenen Bytes. Bei im Hintergrund geladenen
+ * Quellen wird `loaded` aktualisiert.
+ *
+ * @return 1 bei Änderungen, 0 ohne, -1 wenn sich die Quelle nicht mehr ändert
+ */
+static inline int data_source_poll(DataSource *self, size_t *dropped) {
+    *dropped = 0;
+    if ((!self->growing && !self->loading) || !self->ops->poll) {
+        return -1;
+    }
+    return self->ops->poll(self, dropped);
+}
+
+/**
+ * @brief Übernimmt Bytes, die eine andere Anwendung an die Datei angehängt hat.
+ *
+ * Danach beschreibt `size` die neue Dateigröße; bisherige Offsets
+ * bleiben gültig.
+ *
+ * @return 1 bei Zuwachs, 0 ohne, -1 wenn die Quelle nicht wachsen kann
+ */
+static inline int data_source_grow(DataSource *self) {
+    if (!self->ops || !self->ops->grow || self->loading) {
+        return -1;
+    }
+    return self->ops->grow(self);
+}
+
+/**
+ * @brief Löst die Quelle von einer Einblendung der Datei.
+ *
+ * Nötig, sobald eine andere Anwendung die Datei an Ort und Stelle
+ * ändert oder kürzt: Ein Zugriff auf eingeblendete Seiten hinter dem
+ * neuen Dateiende würde das Programm mit `SIGBUS` beenden. Danach wird
+ * per `pread` gelesen, fehlende Bytes hinter dem neuen Ende als
+ * Nullbytes. Quellen ohne Einblendung bleiben unverändert.
+ *
+ * @return 0 bei Erfolg, -1 wenn die Quelle weiter eingeblendet bleibt
+ */
+static inline int data_source_detach(DataSource *self) {
+    if (!self->ops || !self->ops->detach) {
+        return 0;
+    }
+    return self->ops->detach(self);
+}
+
+//* ----------------------------------- Init und Deinit -----------------------------------
+/**
+ * @brief Öffnet eine Datei als Datenquelle.
+ *
+ * Standardeingabe (`-`), Pipes und Zeichengeräte werden als wachsender
+ * Datenstrom geöffnet. Mit `preload` wird die Datei im Hintergrund
+ * vollständig eingelesen, mit `mmap` eingeblendet. Sonst, und wenn sich
+ * die Datei nicht einblenden lässt, liest ein Block-Cache per
+ * `pread`; wird die Datei von außen gekürzt, liefert er Nullbytes statt
+ * `SIGBUS`. Beide öffnen unabhängig von der Dateigröße sofort. Als letzte Rückfallebene wird die Datei vollständig in den
+ * Speicher gelesen.
+ *
+ * @param self    Zeiger auf die Quelle
+ * @param path    Dateipfad
+ * @param options Backend-Wahl und Budgets, NULL = Vorgaben
+ * @return 0 bei Erfolg, sonst -1
+ */
+int data_source_open(DataSource *self, const char *path, const DataSourceOptions *options);
+
+/**
+ * @brief Schließt die Quelle und gibt Ressourcen frei.
+ * @param self Zeiger auf die Quelle
+ * @return 0 bei Erfolg
+ */
+int data_source_close(DataSource *self);
+
+#endif // DATA_SOURCE_H
@@ -0,0 +1,320 @@
+/**
+ * @file Diff_Index.c
+ * @brief Unterschiedsindex zweier Buffer.
+ *
+ * Beide Buffer werden in Abschnitten von `DIFF_INDEX_CHUNK` Bytes
+ * gelesen und mit `Byte_Scan` verglichen. Der Index wird ab dem Anfang
+ * lückenlos aufgebaut: Vor `scanned` ist jeder Unterschied bekannt,
+ * sodass Sprünge dort nur eine binäre Suche kosten. Liegt die Position
+ * weit dahinter, wird ohne Eintragen direkt ab der Position gesucht,
+ * statt erst alle Bytes davor zu vergleichen.
+ */
+
+//* -------------------------------------- Includes ---------------------------------------
+#include "Diff_Index.h" // Schnittstelle dieses Moduls
+#include <stdlib.h>      // malloc, realloc und free
+#include <string.h>      // memset
+#include "Byte_Scan.h"  // vektorisierter Vergleich
+#include "Err_Log.h"    // Protokollierung von Fehlern
+
+//* ---------------------------- Globale Konstanten oder Defines --------------------------
+#define DIFF_INDEX_INITIAL_RANGES 64 /**< erste Größe des Bereichsfelds */
+
+// Vorwärtsdeklarationen der Helferfunktionen
+static void sync_revisions(DiffIndex *self);
+static size_t common_size(const DiffIndex *self);
+static size_t total_size(const DiffIndex *self);
+static size_t run_forward(DiffIndex *self, size_t pos, size_t limit, int equal);
+static size_t run_backward(DiffIndex *self, size_t pos, size_t floor, int equal);
+static int scan_range(DiffIndex *self, size_t pos, DiffRange *out);
+static int extend_once(DiffIndex *self);
+static size_t first_start_after(const DiffIndex *self, size_t pos);
+static int find_next_direct(DiffIndex *self, size_t from, DiffRange *out);
+static int find_prev_direct(DiffIndex *self, size_t from, DiffRange *out);
+
+//* ------------------------------------- Funktionen --------------------------------------
+/**
+ * @brief Sucht den ersten Unterschied, der hinter `from` beginnt.
+ *
+ * Liegt `from` im bekannten Bereich oder kurz dahinter, wird der Index
+ * ergänzt, bis ein passender Bereich eingetragen ist. Wiederholte
+ * Sprünge kosten dann nur noch eine binäre Suche.
+ *
+ * @param self Zeiger auf den Index
+ * @param from aktuelle Position
+ * @param out  erhält den gefundenen Bereich
+ * @return 0 bei Erfolg, -1 wenn es keinen weiteren Unterschied gibt
+ */
+int diff_index_next(DiffIndex *self, size_t from, DiffRange *out) {
+    sync_revisions(self);
+    if (from <= self->scanned) {
+        size_t i = first_start_after(self, from);
+        if (i < self->count) {
+            *out = self->ranges[i];
+            return 0;
+        }
+    }
+    if (from <= self->scanned || from - self->scanned <= DIFF_INDEX_CATCH_UP) {
+        int state;
+        while ((state = extend_once(self)) == 0) {
+            if (self->ranges[self->count - 1].start > from) {
+                *out = self->ranges[self->count - 1];
+                return 0;
+            }
+        }
+        if (state > 0) {
+            return -1; // bis zum Ende verglichen, kein weiterer Unterschied
+        }
+        if (from < self->scanned) {
+            return scan_range(self, self->scanned, out); // Index voll: direkt weitersuchen
+        }
+    }
+    return find_next_direct(self, from, out);
+}
+
+/**
+ * @brief Sucht den letzten Unterschied, der vor `from` beginnt.
+ *
+ * Hinter dem bekannten Bereich wird rückwärts nur bis `scanned`
+ * verglichen; davor genügt der Index.
+ *
+ * @param self Zeiger auf den Index
+ * @param from aktuelle Position
+ * @param out  erhält den gefundenen Bereich
+ * @return 0 bei Erfolg, -1 wenn es keinen vorherigen Unterschied gibt
+ */
+int diff_index_prev(DiffIndex *self, size_t from, DiffRange *out) {
+    sync_revisions(self);
+    size_t total = total_size(self);
+    if (from > total) {
+        from = total; // hinter dem Ende wie am Ende
+    }
+    if (from > self->scanned && from - self->scanned <= DIFF_INDEX_CATCH_UP) {
+        while (self->scanned < from && extend_once(self) == 0) {
+            // Index bis zur Position ergänzen
+        }
+    }
+    if (from > self->scanned && find_prev_direct(self, from, out) == 0) {
+        return 0;
+    }
+    size_t i = (from > 0) ? first_start_after(self, from - 1) : 0; // erster Start >= from
+    if (i == 0) {
+        return -1;
+    }
+    *out = self->ranges[i - 1];
+    return 0;
+}
+
+//* ---------------------------------- Helfer Funktionen ----------------------------------
+/** @brief Verwirft den Index, wenn sich einer der Buffer geändert hat. */
+static void sync_revisions(DiffIndex *self) {
+    if (self->left_revision == self->left->revision &&
+        self->right_revision == self->right->revision) {
+        return;
+    }
+    self->count = 0;
+    self->scanned = 0;
+    self->left_revision = self->left->revision;
+    self->right_revision = self->right->revision;
+}
+
+/** @brief Größe, bis zu der beide Buffer Bytes haben. */
+static size_t common_size(const DiffIndex *self) {
+    return (self->left->size < self->right->size) ? self->left->size : self->right->size;
+}
+
+/** @brief Größe des längeren Buffers. */
+static size_t total_size(const DiffIndex *self) {
+    return (self->left->size > self->right->size) ? self->left->size : self->right->size;
+}
+
+/**
+ * @brief Erste Position ab `pos`, an der die Bytes nicht mehr gleich bzw. verschieden sind.
+ * @return Position oder `limit`
+ */
+static size_t run_forward(DiffIndex *self, size_t pos, size_t limit, int equal) {
+    while (pos < limit) {
+        size_t length = limit - pos;
+        if (length > DIFF_INDEX_CHUNK) {
+            length = DIFF_INDEX_CHUNK;
+        }
+        data_buffer_get_range(self->left, pos, pos + length, self->chunk_left);
+        data_buffer_get_range(self->right, pos, pos + length, self->chunk_right);
+        size_t run = byte_scan_run(self->chunk_left, self->chunk_right, length, equal);
+        if (run < length) {
+            return pos + run;
+        }
+        pos += length;
+    }
+    return limit;
+}
+
+/**
+ * @brief Kleinste Position, ab der bis `pos` alle Bytes gleich bzw. verschieden sind.
+ * @return Position oder `floor`
+ */
+static size_t run_backward(DiffIndex *self, size_t pos, size_t floor, int equal) {
+    while (pos > floor) {
+        size_t length = pos - floor;
+        if (length > DIFF_INDEX_CHUNK) {
+            length = DIFF_INDEX_CHUNK;
+        }
+        size_t start = pos - length;
+        data_buffer_get_range(self->left, start, pos, self->chunk_left);
+        data_buffer_get_range(self->right, start, pos, self->chunk_right);
+        size_t run = byte_scan_run_back(self->chunk_left, self->chunk_right, length, equal);
+        if (run < length) {
+            return pos - run;
+        }
+        pos = start;
+    }
+    return floor;
+}
+
+/**
+ * @brief Sucht den ersten Unterschied ab `pos`.
+ *
+ * `pos` darf nicht mitten in einem Unterschied liegen, sonst würde
+ * dessen Rest als eigener Bereich gemeldet.
+ */
+static int scan_range(DiffIndex *self, size_t pos, DiffRange *out) {
+    size_t common = common_size(self);
+    size_t total = total_size(self);
+    if (pos >= total) {
+        return -1;
+    }
+    size_t start = (pos < common) ? run_forward(self, pos, common, 1) : pos; // Gleiches überspringen
+    if (start >= total) {
+        return -1; // gleich lang und bis zum Ende gleich
+    }
+    size_t end = (start < common) ? run_forward(self, start, common, 0) : total;
+    if (end == common) {
+        end = total; // Überhang des längeren Buffers gehört dazu
+    }
+    out->start = start;
+    out->end = end;
+    return 0;
+}
+
+/**
+ * @brief Trägt den nächsten Unterschied hinter `scanned` ein.
+ * @return 0 wenn eingetragen, 1 wenn bis zum Ende verglichen, -1 wenn der Index voll ist
+ */
+static int extend_once(DiffIndex *self) {
+    size_t total = total_size(self);
+    if (self->scanned >= total) {
+        return 1;
+    }
+    if (self->count >= DIFF_INDEX_MAX_RANGES) {
+        return -1;
+    }
+    DiffRange range;
+    if (scan_range(self, self->scanned, &range) != 0) {
+        self->scanned = total;
+        return 1;
+    }
+    if (self->count == self->capacity) {
+        size_t capacity = self->capacity ? self->capacity * 2 : DIFF_INDEX_INITIAL_RANGES;
+        DiffRange *ranges = (DiffRange *)realloc(self->ranges, capacity * sizeof(DiffRange));
+        if (!ranges) {
+            fatal_error("diff_index", "out of memory");
+        }
+        self->ranges = ranges;
+        self->capacity = capacity;
+    }
+    self->ranges[self->count++] = range;
+    self->scanned = range.end; // dort beginnt ein gleiches Byte oder das Ende
+    return 0;
+}
+
+/** @brief Index des ersten Bereichs, der hinter `pos` beginnt (binäre Suche). */
+static size_t first_start_after(const DiffIndex *self, size_t pos) {
+    size_t low = 0;
+    size_t high = self->count;
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        if (self->ranges[middle].start > pos) {
+            high = middle;
+        } else {
+            low = middle + 1;
+        }
+    }
+    return low;
+}
+
+/**
+ * @brief Sucht den nächsten Unterschied direkt ab `from`, ohne ihn einzutragen.
+ */
+static int find_next_direct(DiffIndex *self, size_t from, DiffRange *out) {
+    size_t common = common_size(self);
+    if (from >= common) {
+        return -1; // im Überhang gibt es nichts Weiteres
+    }
+    size_t pos = run_forward(self, from, common, 0); // aktuellen Unterschied überspringen
+    if (pos > from && pos == common) {
+        return -1; // er reicht bis zum Ende
+    }
+    return scan_range(self, pos, out);
+}
+
+/**
+ * @brief Sucht rückwärts zwischen `scanned` und `from`, ohne einzutragen.
+ */
+static int find_prev_direct(DiffIndex *self, size_t from, DiffRange *out) {
+    size_t common = common_size(self);
+    size_t total = total_size(self);
+    size_t floor = self->scanned;
+    if (from > common && total > common) { // Position im Überhang
+        out->start = (common > floor) ? run_backward(self, common, floor, 0) : common;
+        out->end = total;
+        return 0;
+    }
+    size_t limit = (from < common) ? from : common;
+    size_t last = run_backward(self, limit, floor, 1); // gleiche Bytes überspringen
+    if (last <= floor) {
+        return -1; // zwischen `scanned` und `from` ist alles gleich
+    }
+    out->start = run_backward(self, last, floor, 0);
+    out->end = run_forward(self, last, common, 0);
+    if (out->end == common) {
+        out->end = total;
+    }
+    return 0;
+}
+
+//* ----------------------------------- Init und Deinit -----------------------------------
+/**
+ * @brief Initialisiert einen leeren Index über zwei Buffern.
+ *
+ * @param self  Zeiger auf den Index
+ * @param left  erster Buffer
+ * @param right zweiter Buffer
+ * @return 0 bei Erfolg
+ */
+int diff_index_init(DiffIndex *self, const DataBuffer *left, const DataBuffer *right) {
+    memset(self, 0, sizeof(*self));
+    self->left = left;
+    self->right = right;
+    self->left_revision = left->revision;
+    self->right_revision = right->revision;
+    self->chunk_left = (unsigned char *)malloc(DIFF_INDEX_CHUNK);
+    self->chunk_right = (unsigned char *)malloc(DIFF_INDEX_CHUNK);
+    if (!self->chunk_left || !self->chunk_right) {
+        fatal_error("diff_index_init", "out of memory");
+    }
+    return 0;
+}
+
+/**
+ * @brief Gibt Bereiche und Abschnittspuffer frei.
+ *
+ * @param self Zeiger auf den Index
+ * @return 0 bei Erfolg
+ */
+int diff_index_deinit(DiffIndex *self) {
+    free(self->ranges);
+    free(self->chunk_left);
+    free(self->chunk_right);
+    memset(self, 0, sizeof(*self));
+    return 0;
+}
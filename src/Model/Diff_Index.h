@@ -0,0 +1,92 @@
+#ifndef DIFF_INDEX_H
+#define DIFF_INDEX_H
+
+/**
+ * @file Diff_Index.h
+ * @brief Schnittstelle des Unterschiedsindex zweier Buffer.
+ *
+ * Der Index vergleicht zwei Buffer abschnittsweise und merkt sich alle
+ * gefundenen Bereiche unterschiedlicher Bytes in einem sortierten Feld.
+ * Er wächst nur so weit, wie tatsächlich navigiert wird; bereits
+ * verglichene Abschnitte werden beim nächsten Sprung per binärer Suche
+ * beantwortet. Gelesen wird immer nur ein Abschnitt je Buffer, sodass
+ * auch Dateien mit vielen Gigabyte nicht vollständig in den Speicher
+ * müssen. Ändert sich einer der Buffer, wird der Index verworfen.
+ */
+
+#include <stddef.h>       // stellt den Typ size_t bereit
+#include "Data_Buffer.h" // verglichene Inhalte
+
+//* ---------------------------- Globale Konstanten oder Defines --------------------------
+#define DIFF_INDEX_CHUNK (256 * 1024)     /**< Bytes je Buffer und Vergleichsschritt */
+#define DIFF_INDEX_MAX_RANGES (1u << 20)  /**< höchstens so viele Bereiche merken */
+#define DIFF_INDEX_CATCH_UP (64u * 1024u * 1024u) /**< so weit wird der Index vor einem Sprung ergänzt */
+
+//* ------------------------------------- Strukturen --------------------------------------
+/**
+ * @brief Bereich unterschiedlicher Bytes `[start, end)`.
+ *
+ * Ist ein Buffer länger, zählt sein Überhang als Unterschied.
+ */
+typedef struct {
+    size_t start; /**< erstes unterschiedliches Byte */
+    size_t end;   /**< erstes gleiches Byte danach */
+} DiffRange;
+
+/**
+ * @brief Zwischengespeicherte Unterschiede zweier Buffer.
+ *
+ * Alle Bereiche, die vor `scanned` beginnen, stehen in `ranges`;
+ * dahinter wird bei Bedarf direkt verglichen.
+ */
+typedef struct {
+    const DataBuffer *left;       /**< erster Buffer */
+    const DataBuffer *right;      /**< zweiter Buffer */
+    DiffRange *ranges;            /**< gefundene Bereiche, aufsteigend */
+    size_t count;                 /**< Anzahl der Bereiche */
+    size_t capacity;              /**< Plätze in `ranges` */
+    size_t scanned;               /**< bis hierhin vollständig verglichen */
+    unsigned long left_revision;  /**< Stand von `left` beim Vergleich */
+    unsigned long right_revision; /**< Stand von `right` beim Vergleich */
+    unsigned char *chunk_left;    /**< Abschnitt aus `left` */
+    unsigned char *chunk_right;   /**< Abschnitt aus `right` */
+} DiffIndex;
+
+//* ------------------------------------- Funktionen --------------------------------------
+/**
+ * @brief Sucht den ersten Unterschied, der hinter `from` beginnt.
+ *
+ * Steht `from` in einem Unterschied, wird dieser übersprungen.
+ *
+ * @param self Zeiger auf den Index
+ * @param from aktuelle Position
+ * @param out  erhält den gefundenen Bereich
+ * @return 0 bei Erfolg, -1 wenn es keinen weiteren Unterschied gibt
+ */
+int diff_index_next(DiffIndex *self, size_t from, DiffRange *out);
+
+/**
+ * @brief Sucht den letzten Unterschied, der vor `from` beginnt.
+ * @param self Zeiger auf den Index
+ * @param from aktuelle Position
+ * @param out  erhält den gefundenen Bereich
+ * @return 0 bei Erfolg, -1 wenn es keinen vorherigen Unterschied gibt
+ */
+int diff_index_prev(DiffIndex *self, size_t from, DiffRange *out);
+
+//* ----------------------------------- Init und Deinit -----------------------------------
+/**
+ * @brief Initialisiert einen leeren Index über zwei Buffern.
+ * @param self  Zeiger auf den Index
+ * @param left  erster Buffer
+ * @param right zweiter Buffer
+ * @return 0 bei Erfolg
+ */
+int diff_index_init(DiffIndex *self, const DataBuffer *left, const DataBuffer *right);
+
+/**
+ * @brief Gibt Bereiche und Abschnittspuffer frei.
+ */
+int diff_index_deinit(DiffIndex *self);
+
+#endif // DIFF_INDEX_H
@@ -0,0 +1,635 @@
+/**
+ * @file Dump_Export.c
+ * @brief Textausgabe eines Dateibereichs ohne Oberfläche.
+ *
+ * Jeder Block wird zuerst mit einem Vektorkern vollständig in
+ * Hex-Ziffern (oder Base64) umgewandelt; die Zeilen des Formats werden
+ * danach nur noch aus diesen Zeichen zusammenkopiert. Hex-Ziffern
+ * entstehen per Byte-Shuffle aus einer 16-Zeichen-Tabelle, Base64 nach
+ * dem Verfahren von Muła mit Multiplikationen zum Verteilen der 6-Bit-
+ * Gruppen und einem Shuffle für die Zeichenbereiche. Auf x86 wird die
+ * passende Variante (AVX2, SSSE3) beim ersten Aufruf einmalig gewählt.
+ * Jeder Block ergibt einen einzigen Schreibaufruf.
+ */
+
+//* -------------------------------------- Includes ---------------------------------------
+#include "Dump_Export.h"   // Schnittstelle dieses Moduls
+#include <stdint.h>         // feste Breiten für Adressen
+#include <stdlib.h>         // malloc und free
+#include <string.h>         // memcpy, strcmp und strrchr
+#include "Err_Log.h"       // Fehlerbehandlung
+#include "File_Manager.h"  // Lesen und Schreiben über Deskriptoren
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define DUMP_EXPORT_X86 1
+#include <immintrin.h>     // SSSE3- und AVX2-Intrinsics
+#endif
+
+//* ---------------------------- Globale Konstanten oder Defines --------------------------
+#define BYTES_PER_LINE 16      /**< Bytes je Zeile bei `xxd`, Intel HEX und S-Record */
+#define C_BYTES_PER_LINE 12    /**< Bytes je Zeile beim C-Array, wie `xxd -i` */
+#define BASE64_LINE_BYTES 57   /**< Bytes je Base64-Zeile, ergibt 76 Zeichen */
+#define OUTPUT_PER_BYTE 7      /**< großzügige Obergrenze an Zeichen je Eingabebyte */
+#define OUTPUT_SLACK 4096      /**< Platz für Kopf, Abschluss und eine angefangene Zeile */
+#define NAME_MAX_LENGTH 256    /**< Länge des Array-Namens beim C-Format */
+#define SREC_NAME_MAX 32       /**< höchstens so viele Zeichen des Dateinamens im S0-Satz */
+
+/** Namen in der Reihenfolge von `DumpFormat` */
+static const char *const FORMAT_NAMES[DUMP_FORMAT_COUNT] = {"xxd", "c", "base64", "ihex", "srec"};
+static const char LOWER_DIGITS[16] = "0123456789abcdef"; /**< Ziffern wie in der Editoransicht */
+static const char UPPER_DIGITS[16] = "0123456789ABCDEF"; /**< Ziffern für Intel HEX und S-Record */
+static const char BASE64_DIGITS[64] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+/** Signatur einer Variante für Hex-Ziffern */
+typedef void (*HexKernel)(const unsigned char *in, size_t length, char *out, const char *digits);
+/** Signatur einer Variante für Base64, liefert die Anzahl verarbeiteter Eingabebytes */
+typedef size_t (*Base64Kernel)(const unsigned char *in, size_t length, char *out);
+
+/**
+ * @brief Zustand einer laufenden Ausgabe.
+ */
+typedef struct {
+    DumpFormat format;     /**< Ausgabeformat */
+    int fd;                /**< Ziel */
+    char *out;             /**< Ausgabepuffer eines Blocks */
+    size_t used;           /**< belegte Zeichen in `out` */
+    char *scratch;         /**< Hex-Ziffern oder Base64-Zeichen eines Blocks */
+    size_t count;          /**< bisher ausgegebene Bytes */
+    unsigned int segment;  /**< Intel HEX: zuletzt gesetzte obere 16 Adressbits */
+    int address_bytes;     /**< S-Record: Adressbreite 2, 3 oder 4 */
+    char name[NAME_MAX_LENGTH]; /**< C-Format: Name des Arrays */
+} DumpWriter;
+
+// Vorwärtsdeklarationen der Helferfunktionen
+static void format_block(DumpWriter *self, const unsigned char *data, size_t length, size_t address);
+static void format_xxd(DumpWriter *self, const unsigned char *data, size_t length, size_t address);
+static void format_c(DumpWriter *self, const unsigned char *data, size_t length);
+static void format_base64(DumpWriter *self, const unsigned char *data, size_t length);
+static void format_records(DumpWriter *self, const unsigned char *data, size_t length, size_t address);
+static char *put_offset(char *out, unsigned long long value);
+static char *put_text(char *out, const char *text);
+static char *put_ihex(char *out, unsigned int type, unsigned int address, const unsigned char *data,
+                      size_t length);
+static char *put_srec(char *out, int type, int addressBytes, unsigned long long address,
+                      const unsigned char *data, size_t length);
+static void write_header(DumpWriter *self, const char *path, size_t start, size_t end);
+static void write_footer(DumpWriter *self);
+static int flush_output(DumpWriter *self);
+static void array_name(char *out, const char *path);
+static void hex_bytes(const unsigned char *in, size_t length, char *out, const char *digits);
+static size_t base64_groups(const unsigned char *in, size_t length, char *out);
+static size_t base64_tail(const unsigned char *in, size_t length, char *out);
+static void select_kernels(void);
+
+static HexKernel hexKernel = NULL;       /**< gewählte Variante für Hex-Ziffern */
+static Base64Kernel base64Kernel = NULL; /**< gewählte Variante für Base64 */
+
+//* ------------------------------------- Funktionen --------------------------------------
+/**
+ * @brief Übersetzt einen Formatnamen.
+ */
+int dump_format_parse(const char *name, DumpFormat *out) {
+    for (int format = 0; format < DUMP_FORMAT_COUNT; format++) {
+        if (strcmp(name, FORMAT_NAMES[format]) == 0) {
+            *out = (DumpFormat)format;
+            return 0;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Schreibt je Byte zwei Hex-Ziffern.
+ */
+void dump_hex(const unsigned char *in, size_t length, char *out, int upper) {
+    if (!hexKernel) {
+        select_kernels(); // einmalig, das Ergebnis ist bei jedem Aufruf gleich
+    }
+    hexKernel(in, length, out, upper ? UPPER_DIGITS : LOWER_DIGITS);
+}
+
+/**
+ * @brief Schreibt je Byte das ASCII-Zeichen, nicht druckbare als Punkt.
+ */
+void dump_ascii(const unsigned char *in, size_t length, char *out) {
+    for (size_t i = 0; i < length; i++) {
+        out[i] = (in[i] >= 0x20 && in[i] < 0x7F) ? (char)in[i] : '.';
+    }
+}
+
+/**
+ * @brief Kodiert Bytes als Base64 ohne Zeilenumbrüche.
+ */
+size_t dump_base64(const unsigned char *in, size_t length, char *out) {
+    if (!base64Kernel) {
+        select_kernels();
+    }
+    size_t done = base64Kernel(in, length, out); // ganze Dreiergruppen, die der Kern schafft
+    return done / 3 * 4 + base64_tail(in + done, length - done, out + done / 3 * 4);
+}
+
+/**
+ * @brief Gibt `[start, end)` einer Datei oder eines Datenstroms formatiert aus.
+ *
+ * Dateien und Blockgeräte werden per `pread` ab `start` gelesen,
+ * Datenströme fortlaufend, wobei die Bytes vor `start` verworfen werden.
+ */
+int dump_export(const char *path, size_t start, size_t end, DumpFormat format, int outFd) {
+    int records = (format == DUMP_IHEX || format == DUMP_SREC); // Adressen höchstens 32 Bit
+    int stream = isStreamPath(path);
+    int fd = -1;
+    size_t size = DUMP_RANGE_END;
+    if (stream ? openSequential(path, &fd) != 0 : openFileForRead(path, &fd, &size) != 0) {
+        return -1;
+    }
+    if (end > size) {
+        end = size;
+    }
+    if (records && end != DUMP_RANGE_END && end > start && (unsigned long long)end - 1 > 0xFFFFFFFFull) {
+        closeFile(fd);
+        return -1;
+    }
+
+    DumpWriter writer;
+    memset(&writer, 0, sizeof(writer));
+    writer.format = format;
+    writer.fd = outFd;
+    unsigned char *block = (unsigned char *)malloc(DUMP_BLOCK);
+    writer.out = (char *)malloc((size_t)DUMP_BLOCK * OUTPUT_PER_BYTE + OUTPUT_SLACK);
+    writer.scratch = (char *)malloc((size_t)DUMP_BLOCK * 2);
+    if (!block || !writer.out || !writer.scratch) {
+        fatal_error("dump_export", "out of memory");
+    }
+
+    int result = 0;
+    size_t position = 0;                                      // Datenströme: bereits gelesene Bytes
+    while (stream && position < start) {                      // Anfang überspringen
+        size_t want = (start - position < DUMP_BLOCK) ? start - position : DUMP_BLOCK;
+        long long got = readFull(fd, block, want);
+        if (got <= 0) {
+            result = (got < 0) ? -1 : 0;
+            start = position;                                 // Strom endet vor dem Bereich
+            end = position;
+            break;
+        }
+        position += (size_t)got;
+    }
+    write_header(&writer, path, start, end);
+    size_t address = start;
+    while (result == 0 && address < end) {
+        size_t want = (end - address < DUMP_BLOCK) ? end - address : DUMP_BLOCK;
+        long long got = stream ? readFull(fd, block, want) : readFileAt(fd, address, block, want);
+        if (got < 0) {
+            result = -1;
+            break;
+        }
+        if (got > 0) {
+            if (records && (unsigned long long)address + (size_t)got - 1 > 0xFFFFFFFFull) {
+                result = -1;                                  // Datenstrom über 4 GiB hinaus
+                break;
+            }
+            format_block(&writer, block, (size_t)got, address);
+            address += (size_t)got;
+            result = flush_output(&writer);                   // ein Schreibaufruf je Block
+        }
+        if ((size_t)got < want) {
+            break;                                            // Dateiende
+        }
+    }
+    if (result == 0) {
+        write_footer(&writer);
+        result = flush_output(&writer);
+    }
+    free(writer.scratch);
+    free(writer.out);
+    free(block);
+    closeFile(fd);
+    return result;
+}
+
+//* ---------------------------------- Helfer Funktionen ----------------------------------
+/**
+ * @brief Formatiert einen Block in den Ausgabepuffer.
+ *
+ * Blöcke sind bis auf den letzten Vielfache von `DUMP_BLOCK` und damit
+ * von jeder Zeilenlänge; Zeilen beginnen deshalb stets am Blockanfang.
+ */
+static void format_block(DumpWriter *self, const unsigned char *data, size_t length, size_t address) {
+    switch (self->format) {
+    case DUMP_XXD: format_xxd(self, data, length, address); break;
+    case DUMP_C: format_c(self, data, length); break;
+    case DUMP_BASE64: format_base64(self, data, length); break;
+    default: format_records(self, data, length, address); break;
+    }
+    self->count += length;
+}
+
+// Zeilen wie `xxd`: Offset, 8 Gruppen zu 2 Bytes, ASCII
+static void format_xxd(DumpWriter *self, const unsigned char *data, size_t length, size_t address) {
+    dump_hex(data, length, self->scratch, 0);
+    char *out = self->out + self->used;
+    for (size_t line = 0; line < length; line += BYTES_PER_LINE) {
+        size_t count = (length - line < BYTES_PER_LINE) ? length - line : BYTES_PER_LINE;
+        const char *hex = self->scratch + 2 * line;
+        out = put_offset(out, (unsigned long long)(address + line));
+        *out++ = ':';
+        *out++ = ' ';
+        if (count == BYTES_PER_LINE) {
+            for (int group = 0; group < BYTES_PER_LINE / 2; group++) {
+                memcpy(out, hex + 4 * group, 4);
+                out[4] = ' ';
+                out += 5;
+            }
+        } else { // letzte Zeile: fehlende Bytes als Leerzeichen
+            for (size_t i = 0; i < BYTES_PER_LINE; i++) {
+                out[0] = (i < count) ? hex[2 * i] : ' ';
+                out[1] = (i < count) ? hex[2 * i + 1] : ' ';
+                out += 2;
+                if (i & 1u) {
+                    *out++ = ' ';
+                }
+            }
+        }
+        *out++ = ' ';
+        dump_ascii(data + line, count, out);
+        out += count;
+        *out++ = '\n';
+    }
+    self->used = (size_t)(out - self->out);
+}
+
+// Einträge `0xhh` wie `xxd -i`, 12 je Zeile, Komma nur zwischen Einträgen
+static void format_c(DumpWriter *self, const unsigned char *data, size_t length) {
+    dump_hex(data, length, self->scratch, 0);
+    char *out = self->out + self->used;
+    size_t count = self->count;
+    for (size_t i = 0; i < length; i++, count++) {
+        if (count == 0) {
+            out = put_text(out, "  ");
+        } else if (count % C_BYTES_PER_LINE == 0) {
+            out = put_text(out, ",\n  ");
+        } else {
+            out = put_text(out, ", ");
+        }
+        out[0] = '0';
+        out[1] = 'x';
+        out[2] = self->scratch[2 * i];
+        out[3] = self->scratch[2 * i + 1];
+        out += 4;
+    }
+    self->used = (size_t)(out - self->out);
+}
+
+// Base64 in Zeilen zu 76 Zeichen
+static void format_base64(DumpWriter *self, const unsigned char *data, size_t length) {
+    size_t chars = dump_base64(data, length, self->scratch);
+    char *out = self->out + self->used;
+    size_t lineChars = BASE64_LINE_BYTES / 3 * 4;
+    for (size_t i = 0; i < chars; i += lineChars) {
+        size_t count = (chars - i < lineChars) ? chars - i : lineChars;
+        memcpy(out, self->scratch + i, count);
+        out += count;
+        *out++ = '\n';
+    }
+    self->used = (size_t)(out - self->out);
+}
+
+/**
+ * @brief Datensätze für Intel HEX oder S-Record, höchstens 16 Bytes je Satz.
+ *
+ * Bei Intel HEX endet ein Satz an jeder 64-KiB-Grenze; davor wird bei
+ * Bedarf ein Satz vom Typ 04 mit den oberen 16 Adressbits eingefügt.
+ */
+static void format_records(DumpWriter *self, const unsigned char *data, size_t length, size_t address) {
+    char *out = self->out + self->used;
+    size_t done = 0;
+    while (done < length) {
+        unsigned long long at = (unsigned long long)address + done;
+        size_t count = (length - done < BYTES_PER_LINE) ? length - done : BYTES_PER_LINE;
+        if (self->format == DUMP_IHEX) {
+            size_t room = 0x10000u - (size_t)(at & 0xFFFFu);  // bis zur nächsten 64-KiB-Grenze
+            count = (count < room) ? count : room;
+            unsigned int segment = (unsigned int)(at >> 16);
+            if (segment != self->segment) {
+                unsigned char upper[2] = {(unsigned char)(segment >> 8), (unsigned char)segment};
+                out = put_ihex(out, 4, 0, upper, 2);
+                self->segment = segment;
+            }
+            out = put_ihex(out, 0, (unsigned int)(at & 0xFFFFu), data + done, count);
+        } else {
+            out = put_srec(out, self->address_bytes - 1, self->address_bytes, at, data + done, count);
+        }
+        done += count;
+    }
+    self->used = (size_t)(out - self->out);
+}
+
+// Offset mit mindestens acht Hex-Ziffern wie `xxd`
+static char *put_offset(char *out, unsigned long long value) {
+    int digits = 8;
+    while (digits < 16 && (value >> (4 * digits)) != 0) {
+        digits++;
+    }
+    for (int i = digits - 1; i >= 0; i--) {
+        *out++ = LOWER_DIGITS[(value >> (4 * i)) & 0xFu];
+    }
+    return out;
+}
+
+// Kopiert Text ohne Abschluss und liefert das neue Ende
+static char *put_text(char *out, const char *text) {
+    size_t length = strlen(text);
+    memcpy(out, text, length);
+    return out + length;
+}
+
+// Intel-HEX-Satz: Länge, Adresse, Typ, Daten, Prüfsumme als Zweierkomplement der Summe
+static char *put_ihex(char *out, unsigned int type, unsigned int address, const unsigned char *data,
+                      size_t length) {
+    unsigned char record[5 + BYTES_PER_LINE];
+    record[0] = (unsigned char)length;
+    record[1] = (unsigned char)(address >> 8);
+    record[2] = (unsigned char)address;
+    record[3] = (unsigned char)type;
+    memcpy(record + 4, data, length);
+    unsigned int sum = 0;
+    for (size_t i = 0; i < 4 + length; i++) {
+        sum += record[i];
+    }
+    record[4 + length] = (unsigned char)(0x100u - (sum & 0xFFu));
+    *out++ = ':';
+    dump_hex(record, 5 + length, out, 1);
+    out += 2 * (5 + length);
+    *out++ = '\n';
+    return out;
+}
+
+// S-Record: Typ, Anzahl, Adresse, Daten, Prüfsumme als Einerkomplement der Summe
+static char *put_srec(char *out, int type, int addressBytes, unsigned long long address,
+                      const unsigned char *data, size_t length) {
+    unsigned char record[1 + 4 + SREC_NAME_MAX + 1];
+    size_t size = 0;
+    record[size++] = (unsigned char)(addressBytes + length + 1);
+    for (int i = addressBytes - 1; i >= 0; i--) {
+        record[size++] = (unsigned char)(address >> (8 * i));
+    }
+    memcpy(record + size, data, length);
+    size += length;
+    unsigned int sum = 0;
+    for (size_t i = 0; i < size; i++) {
+        sum += record[i];
+    }
+    record[size++] = (unsigned char)(~sum & 0xFFu);
+    *out++ = 'S';
+    *out++ = (char)('0' + type);
+    dump_hex(record, size, out, 1);
+    out += 2 * size;
+    *out++ = '\n';
+    return out;
+}
+
+// Kopf des Formats: Array-Deklaration oder S0-Satz
+static void write_header(DumpWriter *self, const char *path, size_t start, size_t end) {
+    char *out = self->out + self->used;
+    if (self->format == DUMP_C) {
+        array_name(self->name, path);
+        out = put_text(out, "unsigned char ");
+        out = put_text(out, self->name);
+        out = put_text(out, "[] = {\n");
+    } else if (self->format == DUMP_SREC) {
+        unsigned long long last = (end > start) ? (unsigned long long)end - 1 : 0; // Datenströme: 32 Bit
+        self->address_bytes = (last <= 0xFFFFu) ? 2 : (last <= 0xFFFFFFu) ? 3 : 4;
+        const char *name = strrchr(path, '/');
+        name = name ? name + 1 : path;
+        size_t length = strlen(name);
+        length = (length > SREC_NAME_MAX) ? SREC_NAME_MAX : length; // Kopfsatz bleibt kurz
+        out = put_srec(out, 0, 2, 0, (const unsigned char *)name, length);
+    }
+    self->used = (size_t)(out - self->out);
+}
+
+// Abschluss des Formats
+static void write_footer(DumpWriter *self) {
+    char *out = self->out + self->used;
+    if (self->format == DUMP_C) {
+        out = put_text(out, (self->count > 0) ? "\n};\nunsigned int " : "};\nunsigned int ");
+        out = put_text(out, self->name);
+        out = put_text(out, "_len = ");
+        char digits[24];
+        int length = 0;
+        unsigned long long count = (unsigned long long)self->count;
+        do {
+            digits[length++] = (char)('0' + count % 10u);
+            count /= 10u;
+        } while (count > 0);
+        while (length > 0) {
+            *out++ = digits[--length];
+        }
+        out = put_text(out, ";\n");
+    } else if (self->format == DUMP_IHEX) {
+        out = put_text(out, ":00000001FF\n");
+    } else if (self->format == DUMP_SREC) {
+        out = put_srec(out, 11 - self->address_bytes, self->address_bytes, 0, NULL, 0); // S9, S8 oder S7
+    }
+    self->used = (size_t)(out - self->out);
+}
+
+// Schreibt den Ausgabepuffer mit einem Aufruf
+static int flush_output(DumpWriter *self) {
+    int result = (self->used > 0) ? writeFull(self->fd, (const unsigned char *)self->out, self->used) : 0;
+    self->used = 0;
+    return result;
+}
+
+// Name des C-Arrays aus dem Dateinamen, andere Zeichen als Buchstaben und Ziffern werden zu `_`
+static void array_name(char *out, const char *path) {
+    if (strcmp(path, STDIN_PATH) == 0) {
+        path = "stdin";
+    }
+    size_t length = 0;
+    if (*path >= '0' && *path <= '9') {
+        out[length++] = '_'; // Bezeichner dürfen nicht mit einer Ziffer beginnen
+    }
+    for (; *path && length + 1 < NAME_MAX_LENGTH; path++) {
+        char ch = *path;
+        int alnum = (ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z') || (ch >= '0' && ch <= '9');
+        out[length++] = alnum ? ch : '_';
+    }
+    out[length] = '\0';
+}
+
+// Hex-Ziffern Byte für Byte, auch für Reste der Vektorkerne
+static void hex_bytes(const unsigned char *in, size_t length, char *out, const char *digits) {
+    for (size_t i = 0; i < length; i++) {
+        out[2 * i] = digits[in[i] >> 4];
+        out[2 * i + 1] = digits[in[i] & 0xFu];
+    }
+}
+
+// Base64 für ganze Dreiergruppen ohne Vektoren; liefert die verarbeiteten Bytes
+static size_t base64_groups(const unsigned char *in, size_t length, char *out) {
+    size_t i = 0;
+    for (; i + 3 <= length; i += 3, out += 4) {
+        uint32_t value = ((uint32_t)in[i] << 16) | ((uint32_t)in[i + 1] << 8) | in[i + 2];
+        out[0] = BASE64_DIGITS[value >> 18];
+        out[1] = BASE64_DIGITS[(value >> 12) & 0x3Fu];
+        out[2] = BASE64_DIGITS[(value >> 6) & 0x3Fu];
+        out[3] = BASE64_DIGITS[value & 0x3Fu];
+    }
+    return i;
+}
+
+// Base64 für den Rest nach den Vektorkernen, mit `=` aufgefüllt
+static size_t base64_tail(const unsigned char *in, size_t length, char *out) {
+    size_t done = base64_groups(in, length, out);
+    size_t chars = done / 3 * 4;
+    size_t rest = length - done;
+    if (rest > 0) {
+        uint32_t value = (uint32_t)in[done] << 16;
+        if (rest == 2) {
+            value |= (uint32_t)in[done + 1] << 8;
+        }
+        out[chars] = BASE64_DIGITS[value >> 18];
+        out[chars + 1] = BASE64_DIGITS[(value >> 12) & 0x3Fu];
+        out[chars + 2] = (rest == 2) ? BASE64_DIGITS[(value >> 6) & 0x3Fu] : '=';
+        out[chars + 3] = '=';
+        chars += 4;
+    }
+    return chars;
+}
+
+#ifdef DUMP_EXPORT_X86
+/** @brief Hex-Ziffern für 16 Bytes je Schritt per Shuffle aus der Zifferntabelle (SSSE3). */
+__attribute__((target("ssse3")))
+static void hex_ssse3(const unsigned char *in, size_t length, char *out, const char *digits) {
+    const __m128i table = _mm_loadu_si128((const __m128i *)digits);
+    const __m128i nibble = _mm_set1_epi8(0x0F);
+    size_t i = 0;
+    for (; i + 16 <= length; i += 16) {
+        __m128i value = _mm_loadu_si128((const __m128i *)(in + i));
+        __m128i high = _mm_shuffle_epi8(table, _mm_and_si128(_mm_srli_epi16(value, 4), nibble));
+        __m128i low = _mm_shuffle_epi8(table, _mm_and_si128(value, nibble));
+        _mm_storeu_si128((__m128i *)(out + 2 * i), _mm_unpacklo_epi8(high, low));
+        _mm_storeu_si128((__m128i *)(out + 2 * i + 16), _mm_unpackhi_epi8(high, low));
+    }
+    hex_bytes(in + i, length - i, out + 2 * i, digits);
+}
+
+/** @brief Hex-Ziffern für 32 Bytes je Schritt (AVX2). */
+__attribute__((target("avx2")))
+static void hex_avx2(const unsigned char *in, size_t length, char *out, const char *digits) {
+    const __m256i table = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)digits));
+    const __m256i nibble = _mm256_set1_epi8(0x0F);
+    size_t i = 0;
+    for (; i + 32 <= length; i += 32) {
+        __m256i value = _mm256_loadu_si256((const __m256i *)(in + i));
+        __m256i high = _mm256_shuffle_epi8(table, _mm256_and_si256(_mm256_srli_epi16(value, 4), nibble));
+        __m256i low = _mm256_shuffle_epi8(table, _mm256_and_si256(value, nibble));
+        __m256i first = _mm256_unpacklo_epi8(high, low);  // Bytes 0-7 und 16-23
+        __m256i second = _mm256_unpackhi_epi8(high, low); // Bytes 8-15 und 24-31
+        _mm256_storeu_si256((__m256i *)(out + 2 * i), _mm256_permute2x128_si256(first, second, 0x20));
+        _mm256_storeu_si256((__m256i *)(out + 2 * i + 32), _mm256_permute2x128_si256(first, second, 0x31));
+    }
+    hex_bytes(in + i, length - i, out + 2 * i, digits);
+}
+
+/**
+ * @brief Verteilt je drei Bytes auf vier 6-Bit-Indizes (SSSE3).
+ *
+ * Erwartet die Bytes einer Gruppe bereits so umsortiert, dass jedes
+ * 32-Bit-Wort die Bytes 1, 0, 2, 1 enthält.
+ */
+__attribute__((target("ssse3")))
+static inline __m128i base64_split_ssse3(__m128i value) {
+    __m128i first = _mm_mulhi_epu16(_mm_and_si128(value, _mm_set1_epi32(0x0FC0FC00)),
+                                    _mm_set1_epi32(0x04000040));
+    __m128i second = _mm_mullo_epi16(_mm_and_si128(value, _mm_set1_epi32(0x003F03F0)),
+                                     _mm_set1_epi32(0x01000010));
+    return _mm_or_si128(first, second);
+}
+
+/** @brief Wandelt 6-Bit-Indizes über den Abstand ihres Zeichenbereichs in Zeichen (SSSE3). */
+__attribute__((target("ssse3")))
+static inline __m128i base64_lookup_ssse3(__m128i indices) {
+    const __m128i shifts = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                         '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62,
+                                         '/' - 63, 'A', 0, 0);
+    __m128i range = _mm_subs_epu8(indices, _mm_set1_epi8(51));                // 52..63 -> 1..12
+    __m128i upper = _mm_cmpgt_epi8(_mm_set1_epi8(26), indices);              // 0..25 -> 13
+    range = _mm_or_si128(range, _mm_and_si128(upper, _mm_set1_epi8(13)));
+    return _mm_add_epi8(indices, _mm_shuffle_epi8(shifts, range));
+}
+
+/** @brief Base64 für 12 Bytes je Schritt, liest dabei 16 Bytes (SSSE3). */
+__attribute__((target("ssse3")))
+static size_t base64_ssse3(const unsigned char *in, size_t length, char *out) {
+    const __m128i order = _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1);
+    size_t i = 0;
+    for (; i + 16 <= length; i += 12, out += 16) {
+        __m128i value = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(in + i)), order);
+        _mm_storeu_si128((__m128i *)out, base64_lookup_ssse3(base64_split_ssse3(value)));
+    }
+    return i + base64_groups(in + i, length - i, out);
+}
+
+/**
+ * @brief Base64 für 24 Bytes je Schritt (AVX2).
+ *
+ * Jede 128-Bit-Hälfte braucht ihre zwölf Bytes an einer festen Stelle;
+ * dazu wird vier Bytes vor der Gruppe geladen. Die erste Gruppe
+ * übernimmt deshalb der SSSE3-Schritt.
+ */
+__attribute__((target("avx2")))
+static size_t base64_avx2(const unsigned char *in, size_t length, char *out) {
+    const __m256i order = _mm256_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1,
+                                          14, 15, 13, 14, 11, 12, 10, 11, 8, 9, 7, 8, 5, 6, 4, 5);
+    const __m256i shifts = _mm256_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                            '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62,
+                                            '/' - 63, 'A', 0, 0,
+                                            'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                            '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62,
+                                            '/' - 63, 'A', 0, 0);
+    if (length < 16) {
+        return base64_groups(in, length, out);
+    }
+    const __m128i firstOrder = _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1);
+    __m128i head = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)in), firstOrder);
+    _mm_storeu_si128((__m128i *)out, base64_lookup_ssse3(base64_split_ssse3(head)));
+    size_t i = 12;
+    out += 16;
+    for (; i + 28 <= length; i += 24, out += 32) {
+        __m256i value = _mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i *)(in + i - 4)), order);
+        __m256i first = _mm256_mulhi_epu16(_mm256_and_si256(value, _mm256_set1_epi32(0x0FC0FC00)),
+                                           _mm256_set1_epi32(0x04000040));
+        __m256i second = _mm256_mullo_epi16(_mm256_and_si256(value, _mm256_set1_epi32(0x003F03F0)),
+                                            _mm256_set1_epi32(0x01000010));
+        __m256i indices = _mm256_or_si256(first, second);
+        __m256i range = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+        __m256i upper = _mm256_cmpgt_epi8(_mm256_set1_epi8(26), indices);
+        range = _mm256_or_si256(range, _mm256_and_si256(upper, _mm256_set1_epi8(13)));
+        _mm256_storeu_si256((__m256i *)out, _mm256_add_epi8(indices, _mm256_shuffle_epi8(shifts, range)));
+    }
+    return i + base64_ssse3(in + i, length - i, out);
+}
+#endif
+
+/**
+ * @brief Wählt die schnellsten Varianten, die der Prozessor unterstützt.
+ */
+static void select_kernels(void) {
+    hexKernel = hex_bytes;
+    base64Kernel = base64_groups;
+#ifdef DUMP_EXPORT_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        hexKernel = hex_avx2;
+        base64Kernel = base64_avx2;
+        return;
+    }
+    if (__builtin_cpu_supports("ssse3")) {
+        hexKernel = hex_ssse3;
+        base64Kernel = base64_ssse3;
+    }
+#endif
+}
@@ -0,0 +1,82 @@
+#ifndef DUMP_EXPORT_H
+#define DUMP_EXPORT_H
+
+/**
+ * @file Dump_Export.h
+ * @brief Schnittstelle der Textausgabe eines Dateibereichs ohne Oberfläche.
+ *
+ * Ein Bereich wird in großen Blöcken gelesen und als Hexdump im Stil
+ * von `xxd`, als C-Array, Base64, Intel HEX oder Motorola S-Record in
+ * einen großen Ausgabepuffer formatiert, der mit wenigen Aufrufen
+ * geschrieben wird. Die Umwandlung in Hex-Ziffern und Base64 nutzt
+ * SSSE3/AVX2; dieselben Kerne füllen auch die Zeichentabellen der
+ * Editoransicht.
+ */
+
+#include <stddef.h> // stellt den Typ size_t bereit
+
+//* ---------------------------- Globale Konstanten oder Defines --------------------------
+#define DUMP_BLOCK (912u * 2048u) /**< Bytes je gelesenem Block, Vielfaches von 16, 12 und 57 */
+#define DUMP_RANGE_END ((size_t)-1) /**< Bereich reicht bis zum Dateiende */
+
+//* ------------------------------------- Strukturen --------------------------------------
+/**
+ * @brief Ausgabeformat.
+ */
+typedef enum {
+    DUMP_XXD,          /**< Offset, 16 Bytes in Zweiergruppen, ASCII wie `xxd` */
+    DUMP_C,            /**< C-Array wie `xxd -i` */
+    DUMP_BASE64,       /**< Base64 mit 76 Zeichen je Zeile */
+    DUMP_IHEX,         /**< Intel HEX mit erweiterten linearen Adressen */
+    DUMP_SREC,         /**< Motorola S-Record, Adressbreite nach Bereichsende */
+    DUMP_FORMAT_COUNT  /**< Anzahl der Formate */
+} DumpFormat;
+
+//* ------------------------------------- Funktionen --------------------------------------
+/**
+ * @brief Übersetzt einen Formatnamen (`xxd`, `c`, `base64`, `ihex`, `srec`).
+ * @return 0 bei Erfolg, -1 bei unbekanntem Namen
+ */
+int dump_format_parse(const char *name, DumpFormat *out);
+
+/**
+ * @brief Schreibt je Byte zwei Hex-Ziffern, höherwertiges Nibble zuerst.
+ * @param in     Eingabebytes
+ * @param length Anzahl der Bytes
+ * @param out    erhält `2 * length` Zeichen, ohne Abschluss
+ * @param upper  1 = Großbuchstaben
+ */
+void dump_hex(const unsigned char *in, size_t length, char *out, int upper);
+
+/**
+ * @brief Schreibt je Byte das ASCII-Zeichen, nicht druckbare als Punkt.
+ *
+ * Druckbar sind unabhängig von der Locale genau 0x20 bis 0x7E.
+ */
+void dump_ascii(const unsigned char *in, size_t length, char *out);
+
+/**
+ * @brief Kodiert Bytes als Base64 ohne Zeilenumbrüche.
+ * @param in     Eingabebytes
+ * @param length Anzahl der Bytes
+ * @param out    erhält `4 * ceil(length / 3)` Zeichen, ohne Abschluss
+ * @return Anzahl der geschriebenen Zeichen
+ */
+size_t dump_base64(const unsigned char *in, size_t length, char *out);
+
+/**
+ * @brief Gibt `[start, end)` einer Datei oder eines Datenstroms formatiert aus.
+ *
+ * Läuft ohne ncurses. Reicht die Datei nicht bis `end`, endet die
+ * Ausgabe am Dateiende.
+ *
+ * @param path   Dateipfad oder `-` für die Standardeingabe
+ * @param start  erstes Byte
+ * @param end    hinter dem letzten Byte oder `DUMP_RANGE_END`
+ * @param format Ausgabeformat
+ * @param outFd  Ziel, etwa die Standardausgabe
+ * @return 0 bei Erfolg, -1 bei Lese- oder Schreibfehlern oder zu großen Adressen
+ */
+int dump_export(const char *path, size_t start, size_t end, DumpFormat format, int outFd);
+
+#endif // DUMP_EXPORT_H
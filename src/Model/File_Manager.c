@@ -9,11 +9,25 @@
  * einheitliche Rückgabewerte zur Fehlerbehandlung.
  */
 //* -------------------------------------- Includes ---------------------------------------
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE // copy_file_range ist eine Linux-Erweiterung
+#endif
 #include "File_Manager.h"
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#ifndef _WIN32
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 //* ---------------------------- Globale Konstanten oder Defines --------------------------
+#define FILE_CHUNK_SIZE (1024 * 1024)   // Blockgröße für das blockweise Schreiben
+#define TEMP_FILE_SUFFIX ".tinyhexa~"   // Endung der temporären Datei beim Ersetzen
 
 //* ------------------------------------- Funktionen --------------------------------------
 /**
@@ -22,12 +36,17 @@
  * @return 1 wenn vorhanden, sonst 0
  */
 int file_exists(const char *path) {
+#ifndef _WIN32
+    struct stat info;
+    return stat(path, &info) == 0; // öffnet nicht, blockiert also auch bei FIFOs nicht
+#else
     FILE *file = fopen(path, "r");
     if (file) {
         fclose(file);
         return 1;
     }
     return 0;
+#endif
 }
 
 /**
@@ -62,25 +81,34 @@ int readFileToBuffer(const char *path, unsigned char **outBytes, size_t *outSize
         return -1; // Datei konnte nicht geöffnet werden
     }
 
-    // Dateigröße ermitteln
-    if (fseek(file, 0, SEEK_END) != 0) {
+    // Dateigröße mit 64-Bit-Positionen ermitteln
+#ifdef _WIN32
+    if (_fseeki64(file, 0, SEEK_END) != 0) {
         fclose(file);
         return -1; // Fehler beim Positionieren
     }
-    long fileSize = ftell(file); // aktuelle Position entspricht Größe
-    if (fileSize < 0) {
+    long long fileSize = _ftelli64(file); // aktuelle Position entspricht Größe
+#else
+    if (fseeko(file, 0, SEEK_END) != 0) {
+        fclose(file);
+        return -1; // Fehler beim Positionieren
+    }
+    long long fileSize = (long long)ftello(file); // aktuelle Position entspricht Größe
+#endif
+    if (fileSize < 0 || (unsigned long long)fileSize > (unsigned long long)SIZE_MAX) {
         fclose(file);
         return -1; // Größe konnte nicht bestimmt werden
     }
     rewind(file); // wieder an den Anfang setzen
 
-    unsigned char *buffer = (unsigned char *)malloc(fileSize); // Speicher anfordern
+    // mindestens ein Byte anfordern, damit auch leere Dateien einen Buffer erhalten
+    unsigned char *buffer = (unsigned char *)malloc(fileSize > 0 ? (size_t)fileSize : 1);
     if (!buffer) {
         fclose(file);
         return -1; // kein Speicher
     }
 
-    size_t readBytes = fread(buffer, 1, fileSize, file); // Datei lesen
+    size_t readBytes = fread(buffer, 1, (size_t)fileSize, file); // Datei lesen
     fclose(file);
     if (readBytes != (size_t)fileSize) {
         free(buffer); // unvollständig gelesen, Speicher freigeben
@@ -94,22 +122,860 @@ int readFileToBuffer(const char *path, unsigned char **outBytes, size_t *outSize
 
 /**
  * @brief Schreibt einen Buffer in eine Datei.
+ *
+ * Das Ziel wird erst nach vollständigem Schreiben atomar ersetzt.
+ *
  * @param path  Dateipfad
  * @param bytes Quell-Buffer
  * @param size  Anzahl der Bytes
  * @return 0 bei Erfolg, sonst -1
  */
 int writeBufferToFile(const char *path, const unsigned char *bytes, size_t size) {
-    FILE *file = fopen(path, "wb");
+    FileSink sink;
+    if (fileSinkOpen(&sink, path) != 0) {
+        return -1; // temporäre Datei konnte nicht angelegt werden
+    }
+    if (fileSinkWrite(&sink, bytes, size) != 0) { // Buffer in temporäre Datei schreiben
+        fileSinkAbort(&sink);
+        return -1; // nicht alle Bytes geschrieben
+    }
+    return fileSinkCommit(&sink); // Ziel atomar ersetzen
+}
+
+/**
+ * @brief Überschreibt einzelne Bereiche einer Datei an Ort und Stelle.
+ *
+ * Jeder Bereich wird blockweise über den Callback gelesen und mit
+ * `pwrite` an seine Position geschrieben. Zum Abschluss wird genau
+ * einmal `fdatasync` aufgerufen. Hat die Datei nicht die erwartete
+ * Größe, wird nichts geschrieben und -2 zurückgegeben, damit der
+ * Aufrufer auf ein vollständiges Neuschreiben ausweichen kann.
+ *
+ * @param path         Dateipfad
+ * @param expectedSize erwartete Größe der bestehenden Datei
+ * @param ranges       Paare aus Start und Ende (exklusiv), aufsteigend sortiert
+ * @param rangeCount   Anzahl der Paare
+ * @param reader       Callback, der die Daten eines Blocks liefert
+ * @param context      Zeiger, der unverändert an den Callback geht
+ * @return 0 bei Erfolg, -2 bei abweichender Größe, sonst -1
+ */
+int writeRangesInPlace(const char *path, size_t expectedSize, const size_t *ranges,
+                       size_t rangeCount, FileChunkReader reader, void *context) {
+    unsigned char *chunk = (unsigned char *)malloc(FILE_CHUNK_SIZE); // Zwischenspeicher
+    if (!chunk) {
+        return -1; // kein Speicher
+    }
+    int result = 0;
+#ifdef _WIN32
+    FILE *file = fopen(path, "r+b");
     if (!file) {
+        free(chunk);
+        return -2; // Datei fehlt: komplett neu schreiben
+    }
+    if (_fseeki64(file, 0, SEEK_END) != 0 ||
+        (unsigned long long)_ftelli64(file) != (unsigned long long)expectedSize) {
+        fclose(file);
+        free(chunk);
+        return -2; // Größe weicht ab
+    }
+    for (size_t i = 0; i < rangeCount && result == 0; i++) {
+        for (size_t offset = ranges[2 * i]; offset < ranges[2 * i + 1]; offset += FILE_CHUNK_SIZE) {
+            size_t length = ranges[2 * i + 1] - offset;
+            if (length > FILE_CHUNK_SIZE) {
+                length = FILE_CHUNK_SIZE;
+            }
+            reader(context, offset, chunk, length);
+            if (_fseeki64(file, (long long)offset, SEEK_SET) != 0 ||
+                fwrite(chunk, 1, length, file) != length) {
+                result = -1;
+                break;
+            }
+        }
+    }
+    if (fclose(file) != 0) {
+        result = -1;
+    }
+#else
+    int fd = open(path, O_WRONLY);
+    struct stat info;
+    if (fd < 0) {
+        free(chunk);
+        return -2; // Datei fehlt: komplett neu schreiben
+    }
+    if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode) ||
+        (unsigned long long)info.st_size != (unsigned long long)expectedSize) {
+        close(fd);
+        free(chunk);
+        return -2; // Größe weicht ab
+    }
+    for (size_t i = 0; i < rangeCount && result == 0; i++) {
+        for (size_t offset = ranges[2 * i]; offset < ranges[2 * i + 1]; offset += FILE_CHUNK_SIZE) {
+            size_t length = ranges[2 * i + 1] - offset;
+            if (length > FILE_CHUNK_SIZE) {
+                length = FILE_CHUNK_SIZE; // lange Läufe blockweise schreiben
+            }
+            reader(context, offset, chunk, length);
+            size_t written = 0;
+            while (written < length) { // pwrite darf weniger als angefordert schreiben
+                ssize_t count = pwrite(fd, chunk + written, length - written,
+                                       (off_t)(offset + written));
+                if (count <= 0) {
+                    result = -1;
+                    break;
+                }
+                written += (size_t)count;
+            }
+            if (result != 0) {
+                break;
+            }
+        }
+    }
+    if (result == 0 && fdatasync(fd) != 0) { // einmalig auf den Datenträger bringen
+        result = -1;
+    }
+    if (close(fd) != 0) {
+        result = -1;
+    }
+#endif
+    free(chunk);
+    return result;
+}
+
+/**
+ * @brief Öffnet eine temporäre Datei neben dem Ziel.
+ *
+ * Alle Daten werden zunächst in `<Ziel>.tinyhexa~` geschrieben. Erst
+ * `fileSinkCommit` ersetzt das Ziel, sodass ein Abbruch während des
+ * Schreibens die bestehende Datei nie beschädigt. Existiert das Ziel
+ * bereits, übernimmt die temporäre Datei dessen Zugriffsrechte.
+ *
+ * @param self Zeiger auf den Schreiber
+ * @param path Pfad der Zieldatei
+ * @return 0 bei Erfolg, sonst -1
+ */
+int fileSinkOpen(FileSink *self, const char *path) {
+    memset(self, 0, sizeof(*self));
+#ifndef _WIN32
+    self->fd = -1; // noch keine Datei geöffnet
+#endif
+    int length = snprintf(self->path, sizeof(self->path), "%s", path);
+    int tempLength = snprintf(self->temp_path, sizeof(self->temp_path), "%s%s", path,
+                              TEMP_FILE_SUFFIX);
+    if (length < 0 || (size_t)length >= sizeof(self->path) || tempLength < 0 ||
+        (size_t)tempLength >= sizeof(self->temp_path)) {
+        return -1; // Pfad zu lang
+    }
+    remove(self->temp_path); // Überreste eines früheren Abbruchs entfernen
+#ifdef _WIN32
+    self->file = fopen(self->temp_path, "wb");
+    if (!self->file) {
+        return -1;
+    }
+#else
+    self->fd = open(self->temp_path, O_WRONLY | O_CREAT | O_EXCL, 0666);
+    if (self->fd < 0) {
+        return -1;
+    }
+    struct stat info;
+    if (stat(path, &info) == 0) { // Rechte einer bestehenden Zieldatei übernehmen
+        fchmod(self->fd, info.st_mode & 07777);
+    }
+#endif
+    return 0;
+}
+
+/**
+ * @brief Hängt Bytes an die temporäre Datei an.
+ * @param self   Zeiger auf den Schreiber
+ * @param bytes  Quell-Buffer
+ * @param length Anzahl der Bytes
+ * @return 0 bei Erfolg, sonst -1
+ */
+int fileSinkWrite(FileSink *self, const unsigned char *bytes, size_t length) {
+#ifdef _WIN32
+    if (fwrite(bytes, 1, length, self->file) != length) {
+        return -1;
+    }
+#else
+    while (length > 0) { // write darf weniger als angefordert schreiben
+        ssize_t count = write(self->fd, bytes, length);
+        if (count <= 0) {
+            return -1;
+        }
+        bytes += count;
+        length -= (size_t)count;
+    }
+#endif
+    return 0;
+}
+
+/**
+ * @brief Kopiert einen unveränderten Bereich aus einer anderen Datei.
+ *
+ * Unter Linux wird `copy_file_range` genutzt, das auf geeigneten
+ * Dateisystemen nur Verweise auf die vorhandenen Blöcke anlegt (Reflink)
+ * und die Daten sonst im Kernel kopiert. Steht es nicht zur Verfügung,
+ * wird blockweise über `pread` kopiert.
+ *
+ * @param self     Zeiger auf den Schreiber
+ * @param sourceFd Deskriptor der Quelldatei
+ * @param offset   Startposition in der Quelldatei
+ * @param length   Anzahl der Bytes
+ * @return 0 bei Erfolg, sonst -1
+ */
+int fileSinkCopy(FileSink *self, int sourceFd, size_t offset, size_t length) {
+#ifdef _WIN32
+    (void)self;
+    (void)sourceFd;
+    (void)offset;
+    (void)length;
+    return -1; // unter Windows gibt es keine Deskriptor-Quellen
+#else
+#ifdef __linux__
+    while (length > 0 && !self->no_copy_range) {
+        off_t inOffset = (off_t)offset;
+        ssize_t count = copy_file_range(sourceFd, &inOffset, self->fd, NULL, length, 0);
+        if (count < 0 && (errno == EXDEV || errno == ENOSYS || errno == EINVAL ||
+                          errno == EOPNOTSUPP)) {
+            self->no_copy_range = 1; // Dateisystem unterstützt es nicht: selbst kopieren
+            break;
+        }
+        if (count <= 0) {
+            return -1;
+        }
+        offset += (size_t)count;
+        length -= (size_t)count;
+    }
+#endif
+    if (length == 0) {
+        return 0;
+    }
+    unsigned char *chunk = (unsigned char *)malloc(FILE_CHUNK_SIZE); // Zwischenspeicher
+    if (!chunk) {
+        return -1;
+    }
+    int result = 0;
+    while (length > 0) {
+        size_t part = (length > FILE_CHUNK_SIZE) ? FILE_CHUNK_SIZE : length;
+        ssize_t count = pread(sourceFd, chunk, part, (off_t)offset);
+        if (count <= 0 || fileSinkWrite(self, chunk, (size_t)count) != 0) {
+            result = -1;
+            break;
+        }
+        offset += (size_t)count;
+        length -= (size_t)count;
+    }
+    free(chunk);
+    return result;
+#endif
+}
+
+/**
+ * @brief Schließt die temporäre Datei und ersetzt atomar das Ziel.
+ *
+ * Vor dem `rename` wird die temporäre Datei mit `fsync` dauerhaft
+ * gemacht, danach das Verzeichnis, damit auch der neue Verzeichnis-
+ * eintrag einen Absturz übersteht. Bei einem Fehler bleibt das Ziel
+ * unverändert und die temporäre Datei wird entfernt.
+ *
+ * @param self Zeiger auf den Schreiber
+ * @return 0 bei Erfolg, sonst -1
+ */
+int fileSinkCommit(FileSink *self) {
+#ifdef _WIN32
+    int failed = (fflush(self->file) != 0);
+    failed |= (fclose(self->file) != 0);
+    self->file = NULL;
+    if (!failed) {
+        remove(self->path); // rename ersetzt unter Windows keine bestehende Datei
+        failed = (rename(self->temp_path, self->path) != 0);
+    }
+#else
+    int failed = (fsync(self->fd) != 0);
+    failed |= (close(self->fd) != 0);
+    self->fd = -1;
+    if (!failed) {
+        failed = (rename(self->temp_path, self->path) != 0);
+    }
+    if (!failed) { // Verzeichniseintrag dauerhaft machen
+        char directory[sizeof(self->path)];
+        snprintf(directory, sizeof(directory), "%s", self->path);
+        char *slash = strrchr(directory, '/');
+        if (slash) {
+            *(slash == directory ? slash + 1 : slash) = '\0';
+        } else {
+            snprintf(directory, sizeof(directory), ".");
+        }
+        int dirFd = open(directory, O_RDONLY);
+        if (dirFd >= 0) {
+            fsync(dirFd);
+            close(dirFd);
+        }
+    }
+#endif
+    if (failed) {
+        remove(self->temp_path); // Ziel bleibt unverändert
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Verwirft die temporäre Datei, das Ziel bleibt unverändert.
+ * @param self Zeiger auf den Schreiber
+ */
+void fileSinkAbort(FileSink *self) {
+#ifdef _WIN32
+    if (self->file) {
+        fclose(self->file);
+        self->file = NULL;
+    }
+#else
+    if (self->fd >= 0) {
+        close(self->fd);
+        self->fd = -1;
+    }
+#endif
+    remove(self->temp_path);
+}
+
+/**
+ * @brief Blendet eine Datei schreibgeschützt in den Speicher ein.
+ *
+ * Es werden nur reguläre, nicht leere Dateien eingeblendet. Die Seiten
+ * werden erst beim Zugriff vom Betriebssystem geladen, das Öffnen ist
+ * daher unabhängig von der Dateigröße.
+ *
+ * @param path     Dateipfad
+ * @param outBytes Zeiger auf den eingeblendeten Bereich
+ * @param outSize  Größe der Datei
+ * @param outFd    offener Deskriptor der Datei, vom Aufrufer zu schließen
+ * @return 0 bei Erfolg, sonst -1
+ */
+int mapFileReadOnly(const char *path, const unsigned char **outBytes, size_t *outSize,
+                    int *outFd) {
+#ifdef _WIN32
+    (void)path;
+    (void)outBytes;
+    (void)outSize;
+    (void)outFd;
+    return -1; // unter Windows nicht unterstützt
+#else
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
         return -1; // Datei konnte nicht geöffnet werden
     }
-    size_t written = fwrite(bytes, 1, size, file); // Buffer in Datei schreiben
-    fclose(file);
-    if (written != size) {
-        return -1; // nicht alle Bytes geschrieben
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode) || info.st_size <= 0 ||
+        (unsigned long long)info.st_size > (unsigned long long)SIZE_MAX) {
+        close(fd);
+        return -1; // nur reguläre, nicht leere Dateien einblenden
+    }
+
+    size_t length = (size_t)info.st_size;
+    void *mapping = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapping == MAP_FAILED) {
+        close(fd);
+        return -1; // Einblenden fehlgeschlagen
+    }
+
+    *outBytes = (const unsigned char *)mapping; // eingeblendeten Bereich zurückgeben
+    *outSize = length;                          // Dateigröße setzen
+    *outFd = fd;                                // Deskriptor für Kopien offen halten
+    return 0; // Erfolg
+#endif
+}
+
+/**
+ * @brief Blendet eine gewachsene Datei mit ihrer neuen Größe erneut ein.
+ *
+ * Die neue Einblendung wird angelegt, bevor die alte aufgehoben wird;
+ * schlägt sie fehl, bleibt die alte gültig.
+ *
+ * @param fd    Deskriptor aus `mapFileReadOnly`
+ * @param bytes Anfang der Einblendung, wird ersetzt
+ * @param size  Größe der Einblendung, wird ersetzt
+ * @return 1 wenn neu eingeblendet wurde, 0 ohne Zuwachs, -1 bei Fehler
+ */
+int remapFileGrown(int fd, const unsigned char **bytes, size_t *size) {
+#ifdef _WIN32
+    (void)fd;
+    (void)bytes;
+    (void)size;
+    return -1; // unter Windows nicht unterstützt
+#else
+    size_t length = 0;
+    if (fileSizeOf(fd, &length) != 0) {
+        return -1;
+    }
+    if (length <= *size) {
+        return 0; // nicht gewachsen
+    }
+    void *mapping = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapping == MAP_FAILED) {
+        return -1; // alte Einblendung bleibt bestehen
+    }
+    munmap((void *)*bytes, *size);
+    *bytes = (const unsigned char *)mapping;
+    *size = length;
+    return 1;
+#endif
+}
+
+/**
+ * @brief Hebt eine mit `mapFileReadOnly` erzeugte Einblendung auf.
+ * @param bytes Anfang des eingeblendeten Bereichs
+ * @param size  Größe des Bereichs
+ * @param fd    zugehöriger Deskriptor
+ */
+void unmapFile(const unsigned char *bytes, size_t size, int fd) {
+#ifdef _WIN32
+    (void)bytes;
+    (void)size;
+    (void)fd;
+#else
+    if (bytes) {
+        munmap((void *)bytes, size);
+    }
+    if (fd >= 0) {
+        close(fd);
+    }
+#endif
+}
+
+/**
+ * @brief Kündigt dem Kernel an, dass ein eingeblendeter Bereich bald gelesen wird.
+ *
+ * Der Kernel liest die Seiten daraufhin im Hintergrund ein. Der Aufruf
+ * ist nur ein Hinweis, Fehler werden bewusst ignoriert.
+ *
+ * @param bytes  Anfang der Einblendung
+ * @param offset Beginn des Bereichs relativ zur Einblendung
+ * @param length Länge des Bereichs
+ */
+void adviseWillNeed(const unsigned char *bytes, size_t offset, size_t length) {
+#ifdef _WIN32
+    (void)bytes;
+    (void)offset;
+    (void)length;
+#else
+    if (!bytes || length == 0) {
+        return;
     }
+    long pageSize = sysconf(_SC_PAGESIZE);
+    size_t mask = (pageSize > 0) ? (size_t)pageSize - 1 : 4095;
+    size_t alignedStart = offset & ~mask;               // madvise verlangt Seitenanfang
+    (void)madvise((void *)(bytes + alignedStart), length + (offset - alignedStart),
+                  MADV_WILLNEED);
+#endif
+}
+
+/**
+ * @brief Öffnet eine Datei oder ein Gerät für positionsgenaues Lesen.
+ *
+ * Die Größe wird über `lseek` bestimmt, damit auch Blockgeräte, deren
+ * `st_size` 0 ist, mit ihrer vollen Kapazität erscheinen.
+ *
+ * @param path    Dateipfad
+ * @param outFd   erhält den Deskriptor
+ * @param outSize erhält die Größe in Bytes
+ * @return 0 bei Erfolg, sonst -1
+ */
+int openFileForRead(const char *path, int *outFd, size_t *outSize) {
+#ifdef _WIN32
+    (void)path;
+    (void)outFd;
+    (void)outSize;
+    return -1; // unter Windows nicht unterstützt
+#else
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return -1; // Datei konnte nicht geöffnet werden
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || !(S_ISREG(info.st_mode) || S_ISBLK(info.st_mode))) {
+        close(fd);
+        return -1; // nur Dateien und Blockgeräte sind adressierbar
+    }
+
+    off_t end = lseek(fd, 0, SEEK_END);
+    if (end < 0 || (unsigned long long)end > (unsigned long long)SIZE_MAX) {
+        close(fd);
+        return -1; // Größe nicht bestimmbar
+    }
+
+    *outFd = fd;
+    *outSize = (size_t)end;
     return 0; // Erfolg
+#endif
+}
+
+/**
+ * @brief Ermittelt die aktuelle Größe einer geöffneten Datei.
+ *
+ * Wie bei `openFileForRead` wird `lseek` genutzt, damit auch
+ * Blockgeräte ihre Kapazität melden.
+ *
+ * @param fd      Deskriptor
+ * @param outSize erhält die Größe in Bytes
+ * @return 0 bei Erfolg, sonst -1
+ */
+int fileSizeOf(int fd, size_t *outSize) {
+#ifdef _WIN32
+    (void)fd;
+    (void)outSize;
+    return -1; // unter Windows nicht unterstützt
+#else
+    off_t end = lseek(fd, 0, SEEK_END);
+    if (end < 0 || (unsigned long long)end > (unsigned long long)SIZE_MAX) {
+        return -1; // Größe nicht bestimmbar
+    }
+    *outSize = (size_t)end;
+    return 0;
+#endif
+}
+
+/**
+ * @brief Liest einen Bereich ab einer festen Position.
+ *
+ * Unterbrochene oder verkürzte Lesevorgänge werden fortgesetzt, bis
+ * der Bereich gefüllt oder das Dateiende erreicht ist.
+ *
+ * @param fd     Deskriptor aus `openFileForRead`
+ * @param offset Position in der Datei
+ * @param dest   Ziel-Buffer
+ * @param length Anzahl der Bytes
+ * @return gelesene Bytes oder -1 bei Fehler
+ */
+long long readFileAt(int fd, size_t offset, unsigned char *dest, size_t length) {
+#ifdef _WIN32
+    (void)fd;
+    (void)offset;
+    (void)dest;
+    (void)length;
+    return -1; // unter Windows nicht unterstützt
+#else
+    size_t done = 0;
+    while (done < length) {
+        ssize_t chunk = pread(fd, dest + done, length - done, (off_t)(offset + done));
+        if (chunk < 0) {
+            if (errno == EINTR) {
+                continue; // unterbrochen: erneut versuchen
+            }
+            return -1;
+        }
+        if (chunk == 0) {
+            break; // Dateiende erreicht
+        }
+        done += (size_t)chunk;
+    }
+    return (long long)done;
+#endif
+}
+
+/**
+ * @brief Öffnet eine vorhandene Datei zum Lesen und Schreiben an festen Positionen.
+ *
+ * Die Datei wird weder angelegt noch gekürzt; Blockgeräte sind wie bei
+ * `openFileForRead` erlaubt.
+ *
+ * @param path    Dateipfad
+ * @param outFd   erhält den Deskriptor
+ * @param outSize erhält die Größe in Bytes
+ * @return 0 bei Erfolg, sonst -1
+ */
+int openFileForUpdate(const char *path, int *outFd, size_t *outSize) {
+#ifdef _WIN32
+    (void)path;
+    (void)outFd;
+    (void)outSize;
+    return -1; // unter Windows nicht unterstützt
+#else
+    int fd = open(path, O_RDWR);
+    if (fd < 0) {
+        return -1; // Datei fehlt oder ist schreibgeschützt
+    }
+
+    struct stat info;
+    size_t size;
+    if (fstat(fd, &info) != 0 || !(S_ISREG(info.st_mode) || S_ISBLK(info.st_mode)) ||
+        fileSizeOf(fd, &size) != 0) {
+        close(fd);
+        return -1; // nur Dateien und Blockgeräte sind adressierbar
+    }
+    *outFd = fd;
+    *outSize = size;
+    return 0;
+#endif
+}
+
+/**
+ * @brief Schreibt einen Bereich ab einer festen Position.
+ *
+ * Verkürzte Schreibvorgänge werden fortgesetzt. Hinter dem Dateiende
+ * wächst die Datei.
+ *
+ * @param fd     Deskriptor aus `openFileForUpdate`
+ * @param offset Position in der Datei
+ * @param bytes  Daten
+ * @param length Anzahl der Bytes
+ * @return 0 bei Erfolg, sonst -1
+ */
+int writeFileAt(int fd, size_t offset, const unsigned char *bytes, size_t length) {
+#ifdef _WIN32
+    (void)fd;
+    (void)offset;
+    (void)bytes;
+    (void)length;
+    return -1; // unter Windows nicht unterstützt
+#else
+    size_t done = 0;
+    while (done < length) { // pwrite darf weniger als angefordert schreiben
+        ssize_t count = pwrite(fd, bytes + done, length - done, (off_t)(offset + done));
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+        if (count <= 0) {
+            return -1;
+        }
+        done += (size_t)count;
+    }
+    return 0;
+#endif
+}
+
+/**
+ * @brief Kürzt oder verlängert eine geöffnete Datei.
+ * @param fd   Deskriptor aus `openFileForUpdate`
+ * @param size neue Größe in Bytes
+ * @return 0 bei Erfolg, sonst -1
+ */
+int resizeFile(int fd, size_t size) {
+#ifdef _WIN32
+    (void)fd;
+    (void)size;
+    return -1; // unter Windows nicht unterstützt
+#else
+    return (ftruncate(fd, (off_t)size) == 0) ? 0 : -1;
+#endif
+}
+
+/**
+ * @brief Bringt die geschriebenen Daten einer Datei auf den Datenträger.
+ * @param fd Deskriptor aus `openFileForUpdate`
+ * @return 0 bei Erfolg, sonst -1
+ */
+int syncFile(int fd) {
+#ifdef _WIN32
+    (void)fd;
+    return -1; // unter Windows nicht unterstützt
+#else
+    return (fdatasync(fd) == 0) ? 0 : -1;
+#endif
+}
+
+/**
+ * @brief Prüft, ob ein Pfad eine nicht adressierbare Quelle beschreibt.
+ *
+ * Das sind die Standardeingabe (`-`), Pipes, Sockets und
+ * Zeichengeräte wie serielle Schnittstellen.
+ *
+ * @param path Dateipfad
+ * @return 1 für Datenströme, sonst 0
+ */
+int isStreamPath(const char *path) {
+    if (strcmp(path, STDIN_PATH) == 0) {
+        return 1;
+    }
+#ifdef _WIN32
+    return 0;
+#else
+    struct stat info;
+    if (stat(path, &info) != 0) {
+        return 0;
+    }
+    return S_ISFIFO(info.st_mode) || S_ISCHR(info.st_mode) || S_ISSOCK(info.st_mode);
+#endif
+}
+
+/**
+ * @brief Öffnet Standardeingabe, Pipe oder Gerät zum nicht blockierenden Lesen.
+ *
+ * Für `-` wird die Standardeingabe übernommen und durch das Terminal
+ * ersetzt, damit ncurses weiterhin Tasten lesen kann. Wie `cat` wartet
+ * das Öffnen einer FIFO, bis ein Schreiber verbunden ist; danach wird
+ * nicht blockierend gelesen.
+ *
+ * @param path  Dateipfad oder `-`
+ * @param outFd erhält den Deskriptor
+ * @return 0 bei Erfolg, sonst -1
+ */
+int openInputStream(const char *path, int *outFd) {
+#ifdef _WIN32
+    (void)path;
+    (void)outFd;
+    return -1; // unter Windows nicht unterstützt
+#else
+    int fd;
+    if (strcmp(path, STDIN_PATH) == 0) {
+        if (isatty(STDIN_FILENO)) {
+            return -1;                                // Terminal ist kein Datenstrom
+        }
+        fd = dup(STDIN_FILENO);                       // Datenstrom übernehmen
+        if (fd < 0) {
+            return -1;
+        }
+        if (!freopen("/dev/tty", "r", stdin)) {
+            close(fd);
+            return -1;                                // ohne Terminal keine Bedienung
+        }
+    } else {
+        fd = open(path, O_RDONLY | O_NOCTTY);         // wartet bei FIFOs auf einen Schreiber
+        if (fd < 0) {
+            return -1;
+        }
+    }
+
+    int flags = fcntl(fd, F_GETFL);
+    if (flags < 0 || fcntl(fd, F_SETFL, flags | O_NONBLOCK) != 0) {
+        close(fd);
+        return -1;
+    }
+    *outFd = fd;
+    return 0;
+#endif
+}
+
+/**
+ * @brief Liest die aktuell verfügbaren Bytes eines Datenstroms.
+ * @param fd     nicht blockierender Deskriptor
+ * @param dest   Ziel-Buffer
+ * @param length Größe des Ziel-Buffers
+ * @return gelesene Bytes, 0 am Ende, `READ_WOULD_BLOCK` ohne Daten, -1 bei Fehler
+ */
+long long readAvailable(int fd, unsigned char *dest, size_t length) {
+#ifdef _WIN32
+    (void)fd;
+    (void)dest;
+    (void)length;
+    return -1;
+#else
+    while (1) {
+        ssize_t got = read(fd, dest, length);
+        if (got >= 0) {
+            return (long long)got;
+        }
+        if (errno == EINTR) {
+            continue; // unterbrochen: erneut versuchen
+        }
+        if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            return READ_WOULD_BLOCK;
+        }
+        return -1;
+    }
+#endif
+}
+
+/**
+ * @brief Öffnet Datei, Gerät oder Standardeingabe zum blockierenden, fortlaufenden Lesen.
+ *
+ * Anders als `openInputStream` bleibt die Standardeingabe unverändert;
+ * gedacht für Abläufe ohne Oberfläche.
+ *
+ * @param path  Dateipfad oder `-`
+ * @param outFd erhält den Deskriptor
+ * @return 0 bei Erfolg, sonst -1
+ */
+int openSequential(const char *path, int *outFd) {
+#ifdef _WIN32
+    (void)path;
+    (void)outFd;
+    return -1; // unter Windows nicht unterstützt
+#else
+    int fd = (strcmp(path, STDIN_PATH) == 0) ? dup(STDIN_FILENO) : open(path, O_RDONLY | O_NOCTTY);
+    if (fd < 0) {
+        return -1;
+    }
+    *outFd = fd;
+    return 0;
+#endif
+}
+
+/**
+ * @brief Liest blockierend, bis der Buffer voll oder das Ende erreicht ist.
+ * @param fd     Deskriptor
+ * @param dest   Ziel-Buffer
+ * @param length Anzahl der gewünschten Bytes
+ * @return gelesene Bytes, weniger nur am Ende, oder -1 bei Fehlern
+ */
+long long readFull(int fd, unsigned char *dest, size_t length) {
+#ifdef _WIN32
+    (void)fd;
+    (void)dest;
+    (void)length;
+    return -1;
+#else
+    size_t done = 0;
+    while (done < length) {
+        ssize_t got = read(fd, dest + done, length - done);
+        if (got < 0) {
+            if (errno == EINTR) {
+                continue; // unterbrochen: erneut versuchen
+            }
+            return -1;
+        }
+        if (got == 0) {
+            break; // Ende erreicht
+        }
+        done += (size_t)got;
+    }
+    return (long long)done;
+#endif
+}
+
+/**
+ * @brief Schreibt alle Bytes in einen Deskriptor.
+ * @param fd     Deskriptor, etwa die Standardausgabe
+ * @param bytes  Daten
+ * @param length Anzahl der Bytes
+ * @return 0 bei Erfolg, sonst -1
+ */
+int writeFull(int fd, const unsigned char *bytes, size_t length) {
+#ifdef _WIN32
+    (void)fd;
+    (void)bytes;
+    (void)length;
+    return -1;
+#else
+    while (length > 0) { // write darf weniger als angefordert schreiben
+        ssize_t count = write(fd, bytes, length);
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+        if (count <= 0) {
+            return -1;
+        }
+        bytes += count;
+        length -= (size_t)count;
+    }
+    return 0;
+#endif
+}
+
+/**
+ * @brief Schließt einen mit `openFileForRead` oder `openFileForUpdate` geöffneten Deskriptor.
+ * @param fd Deskriptor
+ */
+void closeFile(int fd) {
+#ifndef _WIN32
+    if (fd >= 0) {
+        close(fd);
+    }
+#else
+    (void)fd;
+#endif
 }
 
 //* ---------------------------------- Helfer Funktionen ----------------------------------
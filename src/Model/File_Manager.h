@@ -14,10 +14,27 @@
  */
 
 #include <stddef.h>
+#include <stdio.h>
 
 //* ---------------------------- Globale Konstanten oder Defines --------------------------
+#define FILE_PATH_MAX 4096 /**< maximale Pfadlänge für temporäre Dateien */
+#define STDIN_PATH "-"      /**< Pfad, unter dem die Standardeingabe gelesen wird */
+#define READ_WOULD_BLOCK -2 /**< `readAvailable`: derzeit keine Daten vorhanden */
 
 //* ------------------------------------- Strukturen --------------------------------------
+/**
+ * @brief Schreibt eine Datei über eine temporäre Datei neben dem Ziel.
+ */
+typedef struct {
+    char path[FILE_PATH_MAX];      /**< Pfad der Zieldatei */
+    char temp_path[FILE_PATH_MAX]; /**< Pfad der temporären Datei */
+#ifdef _WIN32
+    FILE *file;                    /**< geöffnete temporäre Datei */
+#else
+    int fd;                        /**< Deskriptor der temporären Datei */
+#endif
+    int no_copy_range;             /**< 1, wenn copy_file_range nicht nutzbar ist */
+} FileSink;
 
 //* ------------------------------------- Funktionen --------------------------------------
 /**
@@ -40,6 +57,138 @@ int readFileToBuffer(const char *path, unsigned char **outBytes, size_t *outSize
  */
 int writeBufferToFile(const char *path, const unsigned char *bytes, size_t size);
 
+/**
+ * @brief Liefert Daten für das blockweise Schreiben einer Datei.
+ * @param context Zeiger auf die Datenquelle des Aufrufers
+ * @param offset  Position des Blocks in der Datei
+ * @param dest    Ziel-Buffer
+ * @param length  Anzahl der benötigten Bytes
+ */
+typedef void (*FileChunkReader)(void *context, size_t offset, unsigned char *dest,
+                                size_t length);
+
+/**
+ * @brief Überschreibt einzelne Bereiche einer Datei an Ort und Stelle.
+ */
+int writeRangesInPlace(const char *path, size_t expectedSize, const size_t *ranges,
+                       size_t rangeCount, FileChunkReader reader, void *context);
+
+/**
+ * @brief Öffnet eine temporäre Datei neben dem Ziel.
+ */
+int fileSinkOpen(FileSink *self, const char *path);
+
+/**
+ * @brief Hängt Bytes an die temporäre Datei an.
+ */
+int fileSinkWrite(FileSink *self, const unsigned char *bytes, size_t length);
+
+/**
+ * @brief Kopiert einen unveränderten Bereich aus einer anderen Datei.
+ */
+int fileSinkCopy(FileSink *self, int sourceFd, size_t offset, size_t length);
+
+/**
+ * @brief Schließt die temporäre Datei und ersetzt atomar das Ziel.
+ */
+int fileSinkCommit(FileSink *self);
+
+/**
+ * @brief Verwirft die temporäre Datei.
+ */
+void fileSinkAbort(FileSink *self);
+
+/**
+ * @brief Blendet eine Datei schreibgeschützt in den Speicher ein.
+ */
+int mapFileReadOnly(const char *path, const unsigned char **outBytes, size_t *outSize,
+                    int *outFd);
+
+/**
+ * @brief Blendet eine gewachsene Datei mit ihrer neuen Größe erneut ein.
+ */
+int remapFileGrown(int fd, const unsigned char **bytes, size_t *size);
+
+/**
+ * @brief Hebt eine mit `mapFileReadOnly` erzeugte Einblendung auf.
+ */
+void unmapFile(const unsigned char *bytes, size_t size, int fd);
+
+/**
+ * @brief Kündigt dem Kernel an, dass ein eingeblendeter Bereich bald gelesen wird.
+ */
+void adviseWillNeed(const unsigned char *bytes, size_t offset, size_t length);
+
+/**
+ * @brief Öffnet eine Datei oder ein Gerät für positionsgenaues Lesen.
+ */
+int openFileForRead(const char *path, int *outFd, size_t *outSize);
+
+/**
+ * @brief Ermittelt die aktuelle Größe einer geöffneten Datei.
+ */
+int fileSizeOf(int fd, size_t *outSize);
+
+/**
+ * @brief Liest einen Bereich ab einer festen Position.
+ */
+long long readFileAt(int fd, size_t offset, unsigned char *dest, size_t length);
+
+/**
+ * @brief Öffnet eine vorhandene Datei zum Lesen und Schreiben an festen Positionen.
+ */
+int openFileForUpdate(const char *path, int *outFd, size_t *outSize);
+
+/**
+ * @brief Schreibt einen Bereich ab einer festen Position.
+ */
+int writeFileAt(int fd, size_t offset, const unsigned char *bytes, size_t length);
+
+/**
+ * @brief Kürzt oder verlängert eine geöffnete Datei.
+ */
+int resizeFile(int fd, size_t size);
+
+/**
+ * @brief Bringt die geschriebenen Daten einer Datei auf den Datenträger.
+ */
+int syncFile(int fd);
+
+/**
+ * @brief Prüft, ob ein Pfad eine nicht adressierbare Quelle beschreibt.
+ */
+int isStreamPath(const char *path);
+
+/**
+ * @brief Öffnet Standardeingabe, Pipe oder Gerät zum nicht blockierenden Lesen.
+ */
+int openInputStream(const char *path, int *outFd);
+
+/**
+ * @brief Liest die aktuell verfügbaren Bytes eines Datenstroms.
+ */
+long long readAvailable(int fd, unsigned char *dest, size_t length);
+
+/**
+ * @brief Öffnet Datei, Gerät oder Standardeingabe zum blockierenden, fortlaufenden Lesen.
+ */
+int openSequential(const char *path, int *outFd);
+
+/**
+ * @brief Liest blockierend, bis der Buffer voll oder das Ende erreicht ist.
+ */
+long long readFull(int fd, unsigned char *dest, size_t length);
+
+/**
+ * @brief Schreibt alle Bytes in einen Deskriptor.
+ */
+int writeFull(int fd, const unsigned char *bytes, size_t length);
+
+/**
+ * @brief Schließt einen mit `openFileForRead` oder `openFileForUpdate` geöffneten Deskriptor.
+ */
+void closeFile(int fd);
+
 //* ----------------------------------- Init und Deinit -----------------------------------
 
 #endif // FILE_MANAGER_H
@@ -0,0 +1,219 @@
+/**
+ * @file File_Watch.c
+ * @brief Erkennung externer Dateiänderungen.
+ *
+ * Überwacht wird das Verzeichnis der Datei, nicht die Datei selbst:
+ * Programme, die eine Datei über eine temporäre Datei und `rename`
+ * ersetzen, erzeugen sonst kein Ereignis mehr für den Pfad. Ein
+ * Ereignis löst lediglich einen `stat`-Vergleich mit dem zuletzt
+ * bekannten Zustand aus; erst dieser entscheidet über die Art der
+ * Änderung. So werden auch eigene Speichervorgänge erkannt, nachdem
+ * `file_watch_sync` den neuen Zustand übernommen hat.
+ */
+
+//* -------------------------------------- Includes ---------------------------------------
+#include "File_Watch.h"     // Schnittstelle dieses Moduls
+#include <string.h>          // strrchr, strcmp und memset
+#include <sys/stat.h>        // stat und fstat
+#ifdef __linux__
+#include <errno.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+//* ---------------------------- Globale Konstanten oder Defines --------------------------
+#ifdef __linux__
+#define FILE_WATCH_MASK (IN_MODIFY | IN_CLOSE_WRITE | IN_CREATE | IN_DELETE | IN_MOVED_FROM | \
+                         IN_MOVED_TO | IN_ATTRIB) /**< Ereignisse, die den Pfad betreffen können */
+#endif
+
+// Vorwärtsdeklarationen der Helferfunktionen
+static void signature_from_stat(const struct stat *info, FileSignature *out);
+static int drain_events(FileWatch *self);
+
+//* ------------------------------------- Funktionen --------------------------------------
+/**
+ * @brief Prüft ohne zu blockieren, ob sich die Datei geändert hat.
+ *
+ * Der neue Zustand wird als bekannt übernommen, dieselbe Änderung wird
+ * also nur einmal gemeldet.
+ *
+ * @param self Zeiger auf die Überwachung
+ * @return Art der Änderung
+ */
+FileWatchEvent file_watch_poll(FileWatch *self) {
+    if (self->fd >= 0 && !drain_events(self)) {
+        return FILE_WATCH_NONE; // kein Ereignis für diesen Pfad
+    }
+    FileSignature current;
+    file_watch_read_signature(self->path, &current);
+    FileSignature known = self->known;
+    self->known = current;
+
+    if (!current.exists) {
+        return known.exists ? FILE_WATCH_GONE : FILE_WATCH_NONE;
+    }
+    if (!known.exists || current.device != known.device || current.inode != known.inode) {
+        return FILE_WATCH_REPLACED;
+    }
+    if (current.size > known.size) {
+        return FILE_WATCH_GROWN;
+    }
+    if (current.size != known.size || current.mtime_ns != known.mtime_ns) {
+        return FILE_WATCH_CHANGED;
+    }
+    return FILE_WATCH_NONE;
+}
+
+/**
+ * @brief Übernimmt den aktuellen Zustand, etwa nach eigenem Speichern.
+ *
+ * Bereits eingetroffene Ereignisse werden verworfen.
+ *
+ * @param self Zeiger auf die Überwachung
+ */
+void file_watch_sync(FileWatch *self) {
+    if (self->fd >= 0) {
+        drain_events(self);
+    }
+    file_watch_read_signature(self->path, &self->known);
+}
+
+/**
+ * @brief Prüft, ob ein Deskriptor auf die überwachte Datei verweist.
+ *
+ * Nach einem Ersetzen per `rename` verweist der Pfad auf eine neue
+ * Datei, ein früher geöffneter Deskriptor aber weiterhin auf die alte.
+ *
+ * @param self Zeiger auf die Überwachung
+ * @param fd   Deskriptor
+ * @return 1 bei derselben Datei, sonst 0
+ */
+int file_watch_is_file(const FileWatch *self, int fd) {
+    struct stat info;
+    if (fd < 0 || fstat(fd, &info) != 0 || !self->known.exists) {
+        return 0;
+    }
+    FileSignature opened;
+    signature_from_stat(&info, &opened);
+    return opened.device == self->known.device && opened.inode == self->known.inode;
+}
+
+/**
+ * @brief Liest Gerät, Inode, Größe und Änderungszeit eines Pfads.
+ * @param path Dateipfad
+ * @param out  erhält das Kennzeichen, `exists` = 0 wenn der Pfad fehlt
+ */
+void file_watch_read_signature(const char *path, FileSignature *out) {
+    struct stat info;
+    memset(out, 0, sizeof(*out));
+    if (stat(path, &info) == 0) {
+        signature_from_stat(&info, out);
+    }
+}
+
+//* ---------------------------------- Helfer Funktionen ----------------------------------
+/** @brief Überträgt die relevanten Felder aus `stat`. */
+static void signature_from_stat(const struct stat *info, FileSignature *out) {
+    out->device = (unsigned long long)info->st_dev;
+    out->inode = (unsigned long long)info->st_ino;
+    out->size = (unsigned long long)info->st_size;
+#ifdef __linux__
+    out->mtime_ns = (long long)info->st_mtim.tv_sec * 1000000000ll + info->st_mtim.tv_nsec;
+#else
+    out->mtime_ns = (long long)info->st_mtime * 1000000000ll;
+#endif
+    out->exists = 1;
+}
+
+/**
+ * @brief Liest alle wartenden inotify-Ereignisse.
+ * @return 1 wenn ein Ereignis den Dateinamen betraf, sonst 0
+ */
+static int drain_events(FileWatch *self) {
+#ifdef __linux__
+    const char *name = self->path + self->name_offset;
+    int relevant = 0;
+    // Ausrichtung wie von inotify(7) empfohlen
+    char events[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+    while (1) {
+        ssize_t got = read(self->fd, events, sizeof(events));
+        if (got <= 0) {
+            if (got < 0 && errno == EINTR) {
+                continue;
+            }
+            break; // keine weiteren Ereignisse
+        }
+        for (char *at = events; at < events + got;) {
+            const struct inotify_event *event = (const struct inotify_event *)at;
+            if (event->len > 0 && strcmp(event->name, name) == 0) {
+                relevant = 1;
+            }
+            if (event->mask & IN_Q_OVERFLOW) {
+                relevant = 1; // Ereignisse verloren: sicherheitshalber prüfen
+            }
+            at += sizeof(struct inotify_event) + event->len;
+        }
+    }
+    return relevant;
+#else
+    (void)self;
+    return 1;
+#endif
+}
+
+//* ----------------------------------- Init und Deinit -----------------------------------
+/**
+ * @brief Beginnt die Überwachung eines Pfads.
+ *
+ * Schlägt `inotify` fehl, etwa weil das Limit an Überwachungen
+ * erreicht ist, wird auf den `stat`-Vergleich ausgewichen.
+ *
+ * @param self Zeiger auf die Überwachung
+ * @param path Dateipfad
+ * @return 0 bei Erfolg, sonst -1
+ */
+int file_watch_init(FileWatch *self, const char *path) {
+    memset(self, 0, sizeof(*self));
+    self->fd = -1;
+    if (strlen(path) >= sizeof(self->path)) {
+        return -1; // Pfad zu lang
+    }
+    strcpy(self->path, path);
+    const char *slash = strrchr(self->path, '/');
+    self->name_offset = slash ? (size_t)(slash - self->path) + 1 : 0;
+    file_watch_read_signature(self->path, &self->known);
+
+#ifdef __linux__
+    char directory[FILE_PATH_MAX];
+    if (self->name_offset == 0) {
+        strcpy(directory, ".");                           // Datei im Arbeitsverzeichnis
+    } else {
+        memcpy(directory, self->path, self->name_offset);
+        directory[self->name_offset] = '\0';              // Verzeichnis mit Schrägstrich
+    }
+    int fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (fd >= 0 && inotify_add_watch(fd, directory, FILE_WATCH_MASK) >= 0) {
+        self->fd = fd;
+    } else if (fd >= 0) {
+        close(fd);                                        // Rückfall auf stat
+    }
+#endif
+    return 0;
+}
+
+/**
+ * @brief Beendet die Überwachung.
+ * @param self Zeiger auf die Überwachung
+ * @return 0 bei Erfolg
+ */
+int file_watch_deinit(FileWatch *self) {
+#ifdef __linux__
+    if (self->fd >= 0) {
+        close(self->fd);
+    }
+#endif
+    memset(self, 0, sizeof(*self));
+    self->fd = -1;
+    return 0;
+}
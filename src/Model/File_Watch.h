@@ -0,0 +1,87 @@
+#ifndef FILE_WATCH_H
+#define FILE_WATCH_H
+
+/**
+ * @file File_Watch.h
+ * @brief Schnittstelle zur Erkennung externer Dateiänderungen.
+ *
+ * Die Überwachung meldet, wenn eine andere Anwendung die geöffnete
+ * Datei verändert, ersetzt, verlängert oder löscht. Unter Linux wird
+ * dafür `inotify` auf dem Verzeichnis der Datei genutzt, sodass auch
+ * ein atomares Ersetzen per `rename` erkannt wird; ohne Ereignis kostet
+ * eine Abfrage dann nur einen nicht blockierenden Lesezugriff. Auf
+ * anderen Plattformen wird bei jeder Abfrage `stat` verglichen.
+ */
+
+#include <stddef.h>        // stellt den Typ size_t bereit
+#include "File_Manager.h" // FILE_PATH_MAX
+
+//* ---------------------------- Globale Konstanten oder Defines --------------------------
+
+//* ------------------------------------- Strukturen --------------------------------------
+/** Art einer erkannten Änderung */
+typedef enum {
+    FILE_WATCH_NONE,     /**< keine Änderung */
+    FILE_WATCH_GROWN,    /**< Datei ist länger geworden, evtl. nur angehängt */
+    FILE_WATCH_CHANGED,  /**< Inhalt oder Zeitstempel geändert */
+    FILE_WATCH_REPLACED, /**< Pfad verweist auf eine andere Datei */
+    FILE_WATCH_GONE      /**< Datei existiert nicht mehr */
+} FileWatchEvent;
+
+/**
+ * @brief Kennzeichen einer Datei zum Erkennen von Änderungen.
+ */
+typedef struct {
+    unsigned long long device; /**< Gerät der Datei */
+    unsigned long long inode;  /**< Inode der Datei */
+    unsigned long long size;   /**< Größe in Bytes */
+    long long mtime_ns;        /**< letzte Änderung in Nanosekunden */
+    int exists;                /**< 1, wenn die Datei vorhanden ist */
+} FileSignature;
+
+/**
+ * @brief Überwacht eine Datei über ihren Pfad.
+ */
+typedef struct {
+    char path[FILE_PATH_MAX]; /**< überwachter Pfad */
+    size_t name_offset;       /**< Beginn des Dateinamens in `path` */
+    int fd;                   /**< inotify-Deskriptor, -1 = nur `stat` vergleichen */
+    FileSignature known;      /**< zuletzt bekannter Zustand */
+} FileWatch;
+
+//* ------------------------------------- Funktionen --------------------------------------
+/**
+ * @brief Prüft ohne zu blockieren, ob sich die Datei geändert hat.
+ */
+FileWatchEvent file_watch_poll(FileWatch *self);
+
+/**
+ * @brief Übernimmt den aktuellen Zustand, etwa nach eigenem Speichern.
+ */
+void file_watch_sync(FileWatch *self);
+
+/**
+ * @brief Prüft, ob ein Deskriptor auf die überwachte Datei verweist.
+ */
+int file_watch_is_file(const FileWatch *self, int fd);
+
+/**
+ * @brief Liest das Kennzeichen eines Pfads, ohne ihn zu überwachen.
+ */
+void file_watch_read_signature(const char *path, FileSignature *out);
+
+//* ----------------------------------- Init und Deinit -----------------------------------
+/**
+ * @brief Beginnt die Überwachung eines Pfads.
+ * @param self Zeiger auf die Überwachung
+ * @param path Dateipfad
+ * @return 0 bei Erfolg, sonst -1
+ */
+int file_watch_init(FileWatch *self, const char *path);
+
+/**
+ * @brief Beendet die Überwachung.
+ */
+int file_watch_deinit(FileWatch *self);
+
+#endif // FILE_WATCH_H
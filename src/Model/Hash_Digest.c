@@ -0,0 +1,607 @@
+/**
+ * @file Hash_Digest.c
+ * @brief Prüfsummen CRC32, MD5, SHA-1 und SHA-256.
+ *
+ * Die blockbasierten Verfahren teilen sich Pufferung und Abschluss;
+ * nur die Verarbeitung ganzer Blöcke ist je Verfahren verschieden und
+ * wird über eine Tabelle von Varianten aufgerufen. CRC32 faltet auf
+ * x86 je Schritt 64 Bytes mit vier carry-less Multiplikationen
+ * zusammen und reduziert erst am Ende auf 32 Bit; der Rest und andere
+ * Plattformen verarbeiten acht Bytes je Schritt über acht Tabellen.
+ * Zwei CRC32-Werte werden zusammengesetzt, indem der vordere mit
+ * x^(8 * Länge) modulo Polynom multipliziert wird.
+ */
+
+//* -------------------------------------- Includes ---------------------------------------
+#include "Hash_Digest.h" // Schnittstelle dieses Moduls
+#include <string.h>       // memcpy und memset
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define HASH_DIGEST_X86 1
+#include <immintrin.h>   // PCLMUL- und SHA-Intrinsics
+#endif
+
+//* ---------------------------- Globale Konstanten oder Defines --------------------------
+#define CRC32_POLY 0xEDB88320u /**< gespiegeltes Polynom von CRC32 */
+
+/** Signatur einer Variante, die ganze Blöcke verarbeitet */
+typedef void (*BlockKernel)(uint32_t *state, const unsigned char *data, size_t blocks);
+/** Signatur einer CRC32-Variante für Vielfache von 16 Bytes, mindestens 64 */
+typedef uint32_t (*FoldKernel)(uint32_t crc, const unsigned char *data, size_t count);
+
+/** Rundenkonstanten von MD5 */
+static const uint32_t MD5_K[64] = {
+    0xd76aa478, 0xe8c7b756, 0x242070db, 0xc1bdceee, 0xf57c0faf, 0x4787c62a, 0xa8304613, 0xfd469501,
+    0x698098d8, 0x8b44f7af, 0xffff5bb1, 0x895cd7be, 0x6b901122, 0xfd987193, 0xa679438e, 0x49b40821,
+    0xf61e2562, 0xc040b340, 0x265e5a51, 0xe9b6c7aa, 0xd62f105d, 0x02441453, 0xd8a1e681, 0xe7d3fbc8,
+    0x21e1cde6, 0xc33707d6, 0xf4d50d87, 0x455a14ed, 0xa9e3e905, 0xfcefa3f8, 0x676f02d9, 0x8d2a4c8a,
+    0xfffa3942, 0x8771f681, 0x6d9d6122, 0xfde5380c, 0xa4beea44, 0x4bdecfa9, 0xf6bb4b60, 0xbebfbc70,
+    0x289b7ec6, 0xeaa127fa, 0xd4ef3085, 0x04881d05, 0xd9d4d039, 0xe6db99e5, 0x1fa27cf8, 0xc4ac5665,
+    0xf4292244, 0x432aff97, 0xab9423a7, 0xfc93a039, 0x655b59c3, 0x8f0ccc92, 0xffeff47d, 0x85845dd1,
+    0x6fa87e4f, 0xfe2ce6e0, 0xa3014314, 0x4e0811a1, 0xf7537e82, 0xbd3af235, 0x2ad7d2bb, 0xeb86d391,
+};
+
+/** Rotationsweiten von MD5, je Runde vier */
+static const unsigned char MD5_SHIFT[16] = {7, 12, 17, 22, 5, 9, 14, 20, 4, 11, 16, 23, 6, 10, 15, 21};
+
+/** Rundenkonstanten von SHA-256 */
+static const uint32_t SHA256_K[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+/** Anfangswerte je Verfahren */
+static const uint32_t INITIAL_STATE[HASH_KIND_COUNT][8] = {
+    {0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476, 0, 0, 0, 0},
+    {0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476, 0xc3d2e1f0, 0, 0, 0},
+    {0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19},
+};
+
+// Vorwärtsdeklarationen der Helferfunktionen
+static void md5_blocks(uint32_t *state, const unsigned char *data, size_t blocks);
+static void sha1_blocks(uint32_t *state, const unsigned char *data, size_t blocks);
+static void sha256_blocks(uint32_t *state, const unsigned char *data, size_t blocks);
+static uint32_t crc32_slices(uint32_t crc, const unsigned char *data, size_t count);
+static uint32_t multiply_mod(uint32_t a, uint32_t b);
+static uint32_t load_le32(const unsigned char *data);
+static uint32_t load_be32(const unsigned char *data);
+static uint32_t rotate_left(uint32_t value, int bits);
+static void select_kernels(void);
+
+static uint32_t crcTables[8][256];                       /**< Tabellen für slicing-by-8 */
+static uint32_t crcPowers[32];                          /**< x^(2^k) modulo Polynom */
+static FoldKernel foldKernel = NULL;                    /**< PCLMUL-Variante oder NULL */
+static BlockKernel blockKernels[HASH_KIND_COUNT] = {0}; /**< gewählte Varianten je Verfahren */
+static int prepared = 0;                                /**< 1, sobald Tabellen und Varianten stehen */
+
+//* ------------------------------------- Funktionen --------------------------------------
+/**
+ * @brief Setzt CRC32 über weitere Bytes fort.
+ */
+uint32_t hash_crc32(uint32_t crc, const unsigned char *data, size_t count) {
+    if (!prepared) {
+        select_kernels(); // einmalig, das Ergebnis ist bei jedem Aufruf gleich
+    }
+    crc = ~crc;
+    if (foldKernel && count >= 64) {
+        size_t folded = count & ~(size_t)15; // Vielfache von 16 Bytes falten
+        crc = foldKernel(crc, data, folded);
+        data += folded;
+        count -= folded;
+    }
+    return ~crc32_slices(crc, data, count);
+}
+
+/**
+ * @brief CRC32 zweier aufeinanderfolgender Bereiche aus deren einzelnen Werten.
+ *
+ * Der vordere Wert wird um die Länge des hinteren Bereichs
+ * weitergeschoben, also mit x^(8 * Länge) multipliziert. Die Potenz
+ * entsteht aus den vorberechneten Quadraten in `crcPowers`.
+ */
+uint32_t hash_crc32_combine(uint32_t first, uint32_t second, uint64_t second_length) {
+    if (!prepared) {
+        select_kernels();
+    }
+    uint32_t power = 0x80000000u; // x^0
+    unsigned int k = 3;           // Länge in Bytes, gebraucht wird x^(8 * Länge)
+    for (uint64_t n = second_length; n; n >>= 1, k++) {
+        if (n & 1) {
+            power = multiply_mod(crcPowers[k & 31], power);
+        }
+    }
+    return multiply_mod(power, first) ^ second;
+}
+
+/**
+ * @brief Beginnt eine neue Berechnung.
+ */
+void hash_state_init(HashState *self, HashKind kind) {
+    memset(self, 0, sizeof(*self));
+    self->kind = kind;
+    memcpy(self->state, INITIAL_STATE[kind], sizeof(self->state));
+}
+
+/**
+ * @brief Verarbeitet weitere Bytes.
+ *
+ * Ganze Blöcke werden direkt aus `data` verarbeitet, nur Reste
+ * werden in `block` gesammelt.
+ */
+void hash_state_update(HashState *self, const unsigned char *data, size_t count) {
+    if (!prepared) {
+        select_kernels();
+    }
+    BlockKernel kernel = blockKernels[self->kind];
+    self->length += count;
+    if (self->used > 0) {
+        size_t take = HASH_BLOCK_SIZE - self->used;
+        if (take > count) {
+            take = count;
+        }
+        memcpy(self->block + self->used, data, take);
+        self->used += take;
+        data += take;
+        count -= take;
+        if (self->used < HASH_BLOCK_SIZE) {
+            return;
+        }
+        kernel(self->state, self->block, 1);
+        self->used = 0;
+    }
+    size_t blocks = count / HASH_BLOCK_SIZE;
+    if (blocks > 0) {
+        kernel(self->state, data, blocks);
+        data += blocks * HASH_BLOCK_SIZE;
+        count -= blocks * HASH_BLOCK_SIZE;
+    }
+    memcpy(self->block, data, count);
+    self->used = count;
+}
+
+/**
+ * @brief Schließt die Berechnung ab.
+ *
+ * Angehängt werden ein 1-Bit, Nullen und die Länge in Bits als 64-Bit-
+ * Zahl, bei MD5 in Little-Endian, bei SHA in Big-Endian.
+ */
+void hash_state_final(HashState *self, unsigned char *digest) {
+    uint64_t bits = self->length * 8u;
+    unsigned char tail[HASH_BLOCK_SIZE + 8] = {0x80};
+    size_t padding = (self->used < 56) ? 56 - self->used : 120 - self->used;
+    for (int i = 0; i < 8; i++) {
+        int shift = (self->kind == HASH_MD5) ? 8 * i : 56 - 8 * i;
+        tail[padding + (size_t)i] = (unsigned char)(bits >> shift);
+    }
+    uint64_t length = self->length;
+    hash_state_update(self, tail, padding + 8);
+    self->length = length;
+
+    size_t words = hash_digest_size(self->kind) / 4;
+    for (size_t i = 0; i < words; i++) {
+        uint32_t word = self->state[i];
+        for (int b = 0; b < 4; b++) {
+            int shift = (self->kind == HASH_MD5) ? 8 * b : 24 - 8 * b;
+            digest[4 * i + (size_t)b] = (unsigned char)(word >> shift);
+        }
+    }
+}
+
+/**
+ * @brief Länge der Prüfsumme eines Verfahrens in Bytes.
+ */
+size_t hash_digest_size(HashKind kind) {
+    static const size_t sizes[HASH_KIND_COUNT] = {16, 20, 32};
+    return sizes[kind];
+}
+
+/**
+ * @brief Anzeigename eines Verfahrens.
+ */
+const char *hash_kind_name(HashKind kind) {
+    static const char *const names[HASH_KIND_COUNT] = {"MD5", "SHA-1", "SHA-256"};
+    return names[kind];
+}
+
+/**
+ * @brief Schreibt eine Prüfsumme als Hex-Text mit Nullbyte.
+ */
+void hash_digest_hex(const unsigned char *digest, size_t size, char *out) {
+    static const char digits[] = "0123456789abcdef";
+    for (size_t i = 0; i < size; i++) {
+        out[2 * i] = digits[digest[i] >> 4];
+        out[2 * i + 1] = digits[digest[i] & 0x0F];
+    }
+    out[2 * size] = '\0';
+}
+
+/**
+ * @brief Wählt die Varianten, bevor mehrere Threads gleichzeitig rechnen.
+ */
+void hash_digest_prepare(void) {
+    if (!prepared) {
+        select_kernels();
+    }
+}
+
+//* ---------------------------------- Helfer Funktionen ----------------------------------
+/** @brief MD5 über ganze Blöcke. */
+static void md5_blocks(uint32_t *state, const unsigned char *data, size_t blocks) {
+    for (; blocks > 0; blocks--, data += HASH_BLOCK_SIZE) {
+        uint32_t m[16];
+        for (int i = 0; i < 16; i++) {
+            m[i] = load_le32(data + 4 * i);
+        }
+        uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+        for (int i = 0; i < 64; i++) {
+            uint32_t f;
+            int g;
+            if (i < 16) {
+                f = (b & c) | (~b & d);
+                g = i;
+            } else if (i < 32) {
+                f = (d & b) | (~d & c);
+                g = (5 * i + 1) & 15;
+            } else if (i < 48) {
+                f = b ^ c ^ d;
+                g = (3 * i + 5) & 15;
+            } else {
+                f = c ^ (b | ~d);
+                g = (7 * i) & 15;
+            }
+            uint32_t next = d;
+            d = c;
+            c = b;
+            b = b + rotate_left(a + f + MD5_K[i] + m[g], MD5_SHIFT[(i / 16) * 4 + (i & 3)]);
+            a = next;
+        }
+        state[0] += a;
+        state[1] += b;
+        state[2] += c;
+        state[3] += d;
+    }
+}
+
+/** @brief SHA-1 über ganze Blöcke. */
+static void sha1_blocks(uint32_t *state, const unsigned char *data, size_t blocks) {
+    for (; blocks > 0; blocks--, data += HASH_BLOCK_SIZE) {
+        uint32_t w[80];
+        for (int i = 0; i < 16; i++) {
+            w[i] = load_be32(data + 4 * i);
+        }
+        for (int i = 16; i < 80; i++) {
+            w[i] = rotate_left(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+        }
+        uint32_t a = state[0], b = state[1], c = state[2], d = state[3], e = state[4];
+        for (int i = 0; i < 80; i++) {
+            uint32_t f;
+            uint32_t k;
+            if (i < 20) {
+                f = (b & c) | (~b & d);
+                k = 0x5a827999;
+            } else if (i < 40) {
+                f = b ^ c ^ d;
+                k = 0x6ed9eba1;
+            } else if (i < 60) {
+                f = (b & c) | (b & d) | (c & d);
+                k = 0x8f1bbcdc;
+            } else {
+                f = b ^ c ^ d;
+                k = 0xca62c1d6;
+            }
+            uint32_t next = rotate_left(a, 5) + f + e + k + w[i];
+            e = d;
+            d = c;
+            c = rotate_left(b, 30);
+            b = a;
+            a = next;
+        }
+        state[0] += a;
+        state[1] += b;
+        state[2] += c;
+        state[3] += d;
+        state[4] += e;
+    }
+}
+
+/** @brief SHA-256 über ganze Blöcke. */
+static void sha256_blocks(uint32_t *state, const unsigned char *data, size_t blocks) {
+    for (; blocks > 0; blocks--, data += HASH_BLOCK_SIZE) {
+        uint32_t w[64];
+        for (int i = 0; i < 16; i++) {
+            w[i] = load_be32(data + 4 * i);
+        }
+        for (int i = 16; i < 64; i++) {
+            uint32_t s0 = rotate_left(w[i - 15], 25) ^ rotate_left(w[i - 15], 14) ^ (w[i - 15] >> 3);
+            uint32_t s1 = rotate_left(w[i - 2], 15) ^ rotate_left(w[i - 2], 13) ^ (w[i - 2] >> 10);
+            w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+        }
+        uint32_t v[8];
+        memcpy(v, state, sizeof(v));
+        for (int i = 0; i < 64; i++) {
+            uint32_t s1 = rotate_left(v[4], 26) ^ rotate_left(v[4], 21) ^ rotate_left(v[4], 7);
+            uint32_t ch = (v[4] & v[5]) ^ (~v[4] & v[6]);
+            uint32_t t1 = v[7] + s1 + ch + SHA256_K[i] + w[i];
+            uint32_t s0 = rotate_left(v[0], 30) ^ rotate_left(v[0], 19) ^ rotate_left(v[0], 10);
+            uint32_t maj = (v[0] & v[1]) ^ (v[0] & v[2]) ^ (v[1] & v[2]);
+            memmove(v + 1, v, 7 * sizeof(uint32_t));
+            v[4] += t1;
+            v[0] = t1 + s0 + maj;
+        }
+        for (int i = 0; i < 8; i++) {
+            state[i] += v[i];
+        }
+    }
+}
+
+/**
+ * @brief CRC32 mit acht Tabellen, acht Bytes je Schritt.
+ * @param crc Register, bereits invertiert
+ */
+static uint32_t crc32_slices(uint32_t crc, const unsigned char *data, size_t count) {
+    for (; count >= 8; count -= 8, data += 8) {
+        uint32_t low = crc ^ load_le32(data);
+        uint32_t high = load_le32(data + 4);
+        crc = crcTables[7][low & 0xFF] ^ crcTables[6][(low >> 8) & 0xFF] ^
+              crcTables[5][(low >> 16) & 0xFF] ^ crcTables[4][low >> 24] ^
+              crcTables[3][high & 0xFF] ^ crcTables[2][(high >> 8) & 0xFF] ^
+              crcTables[1][(high >> 16) & 0xFF] ^ crcTables[0][high >> 24];
+    }
+    for (; count > 0; count--, data++) {
+        crc = (crc >> 8) ^ crcTables[0][(crc ^ *data) & 0xFF];
+    }
+    return crc;
+}
+
+/**
+ * @brief Multipliziert zwei Polynome modulo CRC32-Polynom (gespiegelte Darstellung).
+ */
+static uint32_t multiply_mod(uint32_t a, uint32_t b) {
+    uint32_t m = 0x80000000u;
+    uint32_t product = 0;
+    for (;;) {
+        if (a & m) {
+            product ^= b;
+            if ((a & (m - 1)) == 0) {
+                break;
+            }
+        }
+        m >>= 1;
+        b = (b & 1) ? (b >> 1) ^ CRC32_POLY : b >> 1;
+    }
+    return product;
+}
+
+/** @brief Liest 32 Bit in Little-Endian. */
+static uint32_t load_le32(const unsigned char *data) {
+    return (uint32_t)data[0] | ((uint32_t)data[1] << 8) | ((uint32_t)data[2] << 16) |
+           ((uint32_t)data[3] << 24);
+}
+
+/** @brief Liest 32 Bit in Big-Endian. */
+static uint32_t load_be32(const unsigned char *data) {
+    return ((uint32_t)data[0] << 24) | ((uint32_t)data[1] << 16) | ((uint32_t)data[2] << 8) |
+           (uint32_t)data[3];
+}
+
+/** @brief Rotiert nach links. */
+static uint32_t rotate_left(uint32_t value, int bits) {
+    return (value << bits) | (value >> (32 - bits));
+}
+
+#ifdef HASH_DIGEST_X86
+/**
+ * @brief CRC32 durch Falten mit carry-less Multiplikation.
+ *
+ * Vier 128-Bit-Register sammeln je 64 Bytes; jedes wird mit x^(512±64)
+ * modulo Polynom multipliziert und mit den nächsten 16 Bytes verknüpft.
+ * Am Ende werden die Register auf 128, dann 64 Bit gefaltet und per
+ * Barrett-Reduktion auf 32 Bit gebracht. Die Konstanten sind die
+ * gespiegelten Werte aus Intels Beschreibung des Verfahrens.
+ *
+ * @param crc   Register, bereits invertiert
+ * @param count Vielfaches von 16, mindestens 64
+ */
+__attribute__((target("pclmul,sse4.1")))
+static uint32_t crc32_fold(uint32_t crc, const unsigned char *data, size_t count) {
+    const __m128i k1k2 = _mm_set_epi64x(0x01c6e41596, 0x0154442bd4);
+    const __m128i k3k4 = _mm_set_epi64x(0x00ccaa009e, 0x01751997d0);
+    const __m128i k5 = _mm_set_epi64x(0, 0x0163cd6124);
+    const __m128i poly = _mm_set_epi64x(0x01f7011641, 0x01db710641);
+    const __m128i low32 = _mm_setr_epi32(~0, 0, ~0, 0);
+
+    __m128i x1 = _mm_loadu_si128((const __m128i *)(data + 0x00));
+    __m128i x2 = _mm_loadu_si128((const __m128i *)(data + 0x10));
+    __m128i x3 = _mm_loadu_si128((const __m128i *)(data + 0x20));
+    __m128i x4 = _mm_loadu_si128((const __m128i *)(data + 0x30));
+    x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128((int)crc));
+    data += 64;
+    count -= 64;
+
+    for (; count >= 64; count -= 64, data += 64) { // vier Register parallel falten
+        __m128i y1 = _mm_clmulepi64_si128(x1, k1k2, 0x00);
+        __m128i y2 = _mm_clmulepi64_si128(x2, k1k2, 0x00);
+        __m128i y3 = _mm_clmulepi64_si128(x3, k1k2, 0x00);
+        __m128i y4 = _mm_clmulepi64_si128(x4, k1k2, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, k1k2, 0x11);
+        x2 = _mm_clmulepi64_si128(x2, k1k2, 0x11);
+        x3 = _mm_clmulepi64_si128(x3, k1k2, 0x11);
+        x4 = _mm_clmulepi64_si128(x4, k1k2, 0x11);
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, y1), _mm_loadu_si128((const __m128i *)(data + 0x00)));
+        x2 = _mm_xor_si128(_mm_xor_si128(x2, y2), _mm_loadu_si128((const __m128i *)(data + 0x10)));
+        x3 = _mm_xor_si128(_mm_xor_si128(x3, y3), _mm_loadu_si128((const __m128i *)(data + 0x20)));
+        x4 = _mm_xor_si128(_mm_xor_si128(x4, y4), _mm_loadu_si128((const __m128i *)(data + 0x30)));
+    }
+
+    // vier Register zu einem falten
+    __m128i y = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+    x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, k3k4, 0x11), x2), y);
+    y = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+    x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, k3k4, 0x11), x3), y);
+    y = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+    x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, k3k4, 0x11), x4), y);
+
+    for (; count >= 16; count -= 16, data += 16) { // restliche 16-Byte-Blöcke
+        y = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+        x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, k3k4, 0x11),
+                                         _mm_loadu_si128((const __m128i *)data)), y);
+    }
+
+    // 128 auf 64 Bit
+    __m128i x2b = _mm_clmulepi64_si128(x1, k3k4, 0x10);
+    x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2b);
+    x2b = _mm_srli_si128(x1, 4);
+    x1 = _mm_and_si128(x1, low32);
+    x1 = _mm_xor_si128(_mm_clmulepi64_si128(x1, k5, 0x00), x2b);
+
+    // Barrett-Reduktion auf 32 Bit
+    x2b = _mm_and_si128(x1, low32);
+    x2b = _mm_clmulepi64_si128(x2b, poly, 0x10);
+    x2b = _mm_and_si128(x2b, low32);
+    x2b = _mm_clmulepi64_si128(x2b, poly, 0x00);
+    x1 = _mm_xor_si128(x1, x2b);
+    return (uint32_t)_mm_extract_epi32(x1, 1);
+}
+
+/**
+ * @brief SHA-1 mit den SHA-Befehlen, vier Runden je Befehl.
+ *
+ * Die Nachrichtenwörter für Gruppe g + 4 entstehen schrittweise in den
+ * drei Gruppen davor (`sha1msg1`, XOR, `sha1msg2`).
+ */
+__attribute__((target("sha,sse4.1,ssse3")))
+static void sha1_blocks_ni(uint32_t *state, const unsigned char *data, size_t blocks) {
+    const __m128i order = _mm_set_epi64x(0x0001020304050607LL, 0x08090a0b0c0d0e0fLL);
+    __m128i abcd = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *)state), 0x1B);
+    __m128i e = _mm_set_epi32((int)state[4], 0, 0, 0);
+    for (; blocks > 0; blocks--, data += HASH_BLOCK_SIZE) {
+        __m128i abcdSave = abcd;
+        __m128i eSave = e;
+        __m128i msg[4];
+        __m128i previous = abcd; // ABCD vor der letzten Vierergruppe
+        for (int g = 0; g < 20; g++) {
+            __m128i *current = &msg[g & 3];
+            if (g < 4) {
+                *current = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(data + 16 * g)), order);
+            }
+            __m128i input = (g == 0) ? _mm_add_epi32(e, *current) : _mm_sha1nexte_epu32(previous, *current);
+            previous = abcd;
+            switch (g / 5) { // Rundenfunktion muss eine Konstante sein
+            case 0:
+                abcd = _mm_sha1rnds4_epu32(abcd, input, 0);
+                break;
+            case 1:
+                abcd = _mm_sha1rnds4_epu32(abcd, input, 1);
+                break;
+            case 2:
+                abcd = _mm_sha1rnds4_epu32(abcd, input, 2);
+                break;
+            default:
+                abcd = _mm_sha1rnds4_epu32(abcd, input, 3);
+                break;
+            }
+            if (g >= 1 && g <= 16) {
+                msg[(g + 3) & 3] = _mm_sha1msg1_epu32(msg[(g + 3) & 3], *current);
+            }
+            if (g >= 2 && g <= 17) {
+                msg[(g + 2) & 3] = _mm_xor_si128(msg[(g + 2) & 3], *current);
+            }
+            if (g >= 3 && g <= 18) {
+                msg[(g + 1) & 3] = _mm_sha1msg2_epu32(msg[(g + 1) & 3], *current);
+            }
+        }
+        e = _mm_sha1nexte_epu32(previous, eSave);
+        abcd = _mm_add_epi32(abcd, abcdSave);
+    }
+    _mm_storeu_si128((__m128i *)state, _mm_shuffle_epi32(abcd, 0x1B));
+    state[4] = (uint32_t)_mm_extract_epi32(e, 3);
+}
+
+/**
+ * @brief SHA-256 mit den SHA-Befehlen, zwei Runden je Befehl.
+ *
+ * Der Zustand liegt dabei als ABEF und CDGH in zwei Registern. Die
+ * Nachrichtenwörter der nächsten Gruppe entstehen, solange die Wörter
+ * der vorletzten Gruppe noch unverändert vorliegen.
+ */
+__attribute__((target("sha,sse4.1,ssse3")))
+static void sha256_blocks_ni(uint32_t *state, const unsigned char *data, size_t blocks) {
+    const __m128i order = _mm_set_epi64x(0x0c0d0e0f08090a0bLL, 0x0405060700010203LL);
+    __m128i dcba = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *)&state[0]), 0xB1);
+    __m128i efgh = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *)&state[4]), 0x1B);
+    __m128i abef = _mm_alignr_epi8(dcba, efgh, 8);
+    __m128i cdgh = _mm_blend_epi16(efgh, dcba, 0xF0);
+    for (; blocks > 0; blocks--, data += HASH_BLOCK_SIZE) {
+        __m128i abefSave = abef;
+        __m128i cdghSave = cdgh;
+        __m128i msg[4];
+        for (int g = 0; g < 16; g++) {
+            __m128i *current = &msg[g & 3];
+            if (g < 4) {
+                *current = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(data + 16 * g)), order);
+            }
+            __m128i input = _mm_add_epi32(*current, _mm_loadu_si128((const __m128i *)&SHA256_K[4 * g]));
+            cdgh = _mm_sha256rnds2_epu32(cdgh, abef, input);
+            abef = _mm_sha256rnds2_epu32(abef, cdgh, _mm_shuffle_epi32(input, 0x0E));
+            if (g >= 3 && g <= 14) { // vor sha256msg1, das Gruppe g - 1 überschreibt
+                __m128i *next = &msg[(g + 1) & 3];
+                __m128i shifted = _mm_alignr_epi8(*current, msg[(g + 3) & 3], 4);
+                *next = _mm_sha256msg2_epu32(_mm_add_epi32(*next, shifted), *current);
+            }
+            if (g >= 1 && g <= 12) {
+                msg[(g + 3) & 3] = _mm_sha256msg1_epu32(msg[(g + 3) & 3], *current);
+            }
+        }
+        abef = _mm_add_epi32(abef, abefSave);
+        cdgh = _mm_add_epi32(cdgh, cdghSave);
+    }
+    __m128i feba = _mm_shuffle_epi32(abef, 0x1B);
+    __m128i dchg = _mm_shuffle_epi32(cdgh, 0xB1);
+    _mm_storeu_si128((__m128i *)&state[0], _mm_blend_epi16(feba, dchg, 0xF0));
+    _mm_storeu_si128((__m128i *)&state[4], _mm_alignr_epi8(dchg, feba, 8));
+}
+#endif // HASH_DIGEST_X86
+
+/** @brief Baut die Tabellen und wählt die schnellste Variante, die der Prozessor unterstützt. */
+static void select_kernels(void) {
+    for (uint32_t n = 0; n < 256; n++) {
+        uint32_t crc = n;
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc & 1) ? (crc >> 1) ^ CRC32_POLY : crc >> 1;
+        }
+        crcTables[0][n] = crc;
+    }
+    for (uint32_t n = 0; n < 256; n++) {
+        for (int k = 1; k < 8; k++) {
+            uint32_t previous = crcTables[k - 1][n];
+            crcTables[k][n] = (previous >> 8) ^ crcTables[0][previous & 0xFF];
+        }
+    }
+    uint32_t power = 0x40000000u; // x^1
+    for (int k = 0; k < 32; k++) {
+        crcPowers[k] = power;
+        power = multiply_mod(power, power);
+    }
+
+    blockKernels[HASH_MD5] = md5_blocks;
+    blockKernels[HASH_SHA1] = sha1_blocks;
+    blockKernels[HASH_SHA256] = sha256_blocks;
+    foldKernel = NULL;
+#ifdef HASH_DIGEST_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("pclmul") && __builtin_cpu_supports("sse4.1")) {
+        foldKernel = crc32_fold;
+    }
+    if (__builtin_cpu_supports("sha") && __builtin_cpu_supports("sse4.1")) {
+        blockKernels[HASH_SHA1] = sha1_blocks_ni;
+        blockKernels[HASH_SHA256] = sha256_blocks_ni;
+    }
+#endif
+    prepared = 1;
+}
@@ -0,0 +1,106 @@
+#ifndef HASH_DIGEST_H
+#define HASH_DIGEST_H
+
+/**
+ * @file Hash_Digest.h
+ * @brief Schnittstelle der Prüfsummen CRC32, MD5, SHA-1 und SHA-256.
+ *
+ * Die Funktionen arbeiten auf Speicherbereichen und lassen sich
+ * beliebig oft fortsetzen, sodass auch große Bereiche abschnittsweise
+ * verarbeitet werden können. Auf x86 nutzt CRC32 die carry-less
+ * Multiplikation (PCLMUL), SHA-1 und SHA-256 die SHA-Befehle des
+ * Prozessors; welche Variante verfügbar ist, wird beim ersten Aufruf
+ * einmalig ermittelt. Sonst rechnet CRC32 mit acht Tabellen
+ * (slicing-by-8) und die übrigen Verfahren blockweise in C.
+ */
+
+#include <stddef.h> // stellt den Typ size_t bereit
+#include <stdint.h> // feste Breiten für Zustände und Längen
+
+//* ---------------------------- Globale Konstanten oder Defines --------------------------
+#define HASH_DIGEST_MAX 32   /**< längste Prüfsumme in Bytes (SHA-256) */
+#define HASH_BLOCK_SIZE 64   /**< Blockgröße von MD5, SHA-1 und SHA-256 */
+
+//* ------------------------------------- Strukturen --------------------------------------
+/** Blockbasierte Verfahren */
+typedef enum {
+    HASH_MD5,       /**< MD5, 16 Bytes */
+    HASH_SHA1,      /**< SHA-1, 20 Bytes */
+    HASH_SHA256,    /**< SHA-256, 32 Bytes */
+    HASH_KIND_COUNT /**< Anzahl der Verfahren */
+} HashKind;
+
+/**
+ * @brief Laufender Zustand eines blockbasierten Verfahrens.
+ */
+typedef struct {
+    HashKind kind;                        /**< Verfahren */
+    uint32_t state[8];                    /**< Kettenwerte */
+    uint64_t length;                      /**< bisher verarbeitete Bytes */
+    unsigned char block[HASH_BLOCK_SIZE]; /**< angefangener Block */
+    size_t used;                          /**< belegte Bytes in `block` */
+} HashState;
+
+//* ------------------------------------- Funktionen --------------------------------------
+/**
+ * @brief Setzt CRC32 (wie zlib und PNG) über weitere Bytes fort.
+ * @param crc   bisheriger Wert, 0 für den Anfang
+ * @param data  Bytes
+ * @param count Anzahl der Bytes
+ * @return neuer Wert
+ */
+uint32_t hash_crc32(uint32_t crc, const unsigned char *data, size_t count);
+
+/**
+ * @brief CRC32 zweier aufeinanderfolgender Bereiche aus deren einzelnen Werten.
+ *
+ * Benötigt O(log n) Multiplikationen, unabhängig vom Inhalt.
+ *
+ * @param first         CRC32 des vorderen Bereichs
+ * @param second        CRC32 des hinteren Bereichs
+ * @param second_length Länge des hinteren Bereichs
+ * @return CRC32 beider Bereiche hintereinander
+ */
+uint32_t hash_crc32_combine(uint32_t first, uint32_t second, uint64_t second_length);
+
+/**
+ * @brief Beginnt eine neue Berechnung.
+ */
+void hash_state_init(HashState *self, HashKind kind);
+
+/**
+ * @brief Verarbeitet weitere Bytes.
+ */
+void hash_state_update(HashState *self, const unsigned char *data, size_t count);
+
+/**
+ * @brief Schließt die Berechnung ab.
+ * @param self   Zeiger auf den Zustand, danach unbrauchbar
+ * @param digest erhält `hash_digest_size(kind)` Bytes
+ */
+void hash_state_final(HashState *self, unsigned char *digest);
+
+/**
+ * @brief Länge der Prüfsumme eines Verfahrens in Bytes.
+ */
+size_t hash_digest_size(HashKind kind);
+
+/**
+ * @brief Anzeigename eines Verfahrens.
+ */
+const char *hash_kind_name(HashKind kind);
+
+/**
+ * @brief Schreibt eine Prüfsumme als Hex-Text mit Nullbyte.
+ * @param digest Prüfsumme
+ * @param size   Länge in Bytes
+ * @param out    Platz für `2 * size + 1` Zeichen
+ */
+void hash_digest_hex(const unsigned char *digest, size_t size, char *out);
+
+/**
+ * @brief Wählt die Varianten, bevor mehrere Threads gleichzeitig rechnen.
+ */
+void hash_digest_prepare(void);
+
+#endif // HASH_DIGEST_H
@@ -0,0 +1,395 @@
+/**
+ * @file Hash_Tree.c
+ * @brief Prüfsummenbaum über dem Buffer.
+ *
+ * Veraltete Knoten werden in `stale` markiert; ist ein Knoten markiert,
+ * sind es auch alle seine Vorfahren. Beim Abgleich werden die Änderungen
+ * aus dem Änderungsprotokoll des Buffers auf Blätter abgebildet und
+ * markiert, die markierten Blätter neu gelesen und anschließend nur die
+ * markierten inneren Knoten von unten nach oben neu zusammengesetzt.
+ * Viele Blätter zugleich, etwa beim ersten Abgleich, werden auf mehrere
+ * Threads verteilt.
+ */
+
+//* -------------------------------------- Includes ---------------------------------------
+#include "Hash_Tree.h"    // Schnittstelle dieses Moduls
+#include <stdlib.h>        // malloc, calloc und free
+#include <string.h>        // memset und memcpy
+#ifndef _WIN32
+#include <pthread.h>       // Threads und Sperre
+#include <unistd.h>        // sysconf für die Anzahl der Prozessoren
+#endif
+#include "Err_Log.h"      // Fehlerbehandlung
+#include "Hash_Digest.h"  // CRC32 und SHA-256
+
+//* ---------------------------- Globale Konstanten oder Defines --------------------------
+#define LEAF_PREFIX 0x00 /**< trennt Blattwerte von Knotenwerten */
+#define NODE_PREFIX 0x01 /**< Präfix beim Zusammensetzen zweier Kinder */
+
+/**
+ * @brief Gemeinsamer Auftrag beim Neuberechnen der Blätter.
+ */
+typedef struct {
+    HashTree *tree;       /**< Baum */
+    const size_t *leaves; /**< Knotenindizes der veralteten Blätter */
+    size_t count;         /**< Anzahl der Blätter */
+#ifndef _WIN32
+    pthread_mutex_t lock; /**< schützt `next` */
+#endif
+    size_t next;          /**< nächstes zu vergebendes Blatt */
+} LeafJob;
+
+// Vorwärtsdeklarationen der Helferfunktionen
+static size_t block_size_for(size_t size);
+static void allocate(HashTree *self, size_t block, size_t leaves);
+static void mark_change(HashTree *self, const DataBufferChange *change);
+static void mark_leaf(HashTree *self, size_t leaf);
+static size_t collect_stale(const HashTree *self, size_t node, size_t *out, size_t count);
+static void hash_leaves(HashTree *self, const size_t *leaves, size_t count);
+static void hash_leaf(HashTree *self, size_t node, unsigned char *data);
+static void combine_stale(HashTree *self, size_t node);
+static uint32_t range_crc(HashTree *self, size_t node, uint64_t nodeStart, uint64_t span,
+                          size_t start, size_t end, uint32_t crc);
+static int claim_leaf(LeafJob *job, size_t *outIndex);
+static void *worker(void *context);
+#ifndef _WIN32
+static int thread_count(const HashTree *self, size_t count);
+#endif
+
+//* ------------------------------------- Funktionen --------------------------------------
+/**
+ * @brief Gleicht den Baum mit dem aktuellen Stand des Buffers ab.
+ * @return Anzahl der neu gelesenen Blöcke
+ */
+size_t hash_tree_update(HashTree *self) {
+    const DataBuffer *buffer = self->buffer;
+    if (self->nodes && self->revision == buffer->revision) {
+        self->rehashed = 0;
+        return 0;
+    }
+    size_t block = block_size_for(buffer->size);
+    size_t leaves = (buffer->size + block - 1) / block;
+    if (leaves == 0) {
+        leaves = 1; // auch ein leerer Inhalt hat einen Baumwert
+    }
+    int rebuild = !self->nodes || block != self->block || leaves > self->capacity;
+    for (unsigned long r = self->revision + 1; !rebuild && r <= buffer->revision; r++) {
+        DataBufferChange change;
+        if (data_buffer_get_change(buffer, r, &change) != 0) {
+            rebuild = 1; // Änderung nicht mehr bekannt
+        } else {
+            mark_change(self, &change);
+        }
+    }
+    if (rebuild) {
+        allocate(self, block, leaves);
+    }
+
+    size_t *stale = (size_t *)malloc(self->capacity * sizeof(size_t));
+    if (!stale) {
+        fatal_error("hash_tree_update", "out of memory");
+    }
+    size_t count = collect_stale(self, 1, stale, 0);
+    hash_leaves(self, stale, count);
+    combine_stale(self, 1);
+    size_t used = 0;
+    for (size_t i = 0; i < count; i++) {
+        used += (size_t)self->nodes[stale[i]].used; // leere Blattplätze nicht mitzählen
+    }
+    free(stale);
+    self->revision = buffer->revision;
+    self->rehashed = used;
+    return used;
+}
+
+/**
+ * @brief CRC32 des Bereichs `[start, end)` aus dem abgeglichenen Baum.
+ */
+uint32_t hash_tree_crc32(HashTree *self, size_t start, size_t end) {
+    if (end > self->buffer->size) {
+        end = self->buffer->size;
+    }
+    if (start >= end || !self->nodes) {
+        return 0;
+    }
+    return range_crc(self, 1, 0, (uint64_t)self->capacity * self->block, start, end, 0);
+}
+
+/**
+ * @brief Baumwert des gesamten Inhalts.
+ */
+void hash_tree_root(const HashTree *self, unsigned char *digest) {
+    if (!self->nodes) {
+        memset(digest, 0, HASH_TREE_DIGEST);
+        return;
+    }
+    memcpy(digest, self->nodes[1].digest, HASH_TREE_DIGEST);
+}
+
+//* ---------------------------------- Helfer Funktionen ----------------------------------
+/** @brief Blockgröße, bei der höchstens `HASH_TREE_MAX_LEAVES` Blätter entstehen. */
+static size_t block_size_for(size_t size) {
+    size_t block = HASH_TREE_BLOCK;
+    while (size / block >= HASH_TREE_MAX_LEAVES) {
+        block *= 2;
+    }
+    return block;
+}
+
+/** @brief Legt Knoten für mindestens `leaves` Blätter an und markiert alle als veraltet. */
+static void allocate(HashTree *self, size_t block, size_t leaves) {
+    size_t capacity = 1;
+    while (capacity < leaves) {
+        capacity *= 2;
+    }
+    free(self->nodes);
+    free(self->stale);
+    free(self->scratch);
+    self->nodes = (HashTreeNode *)calloc(2 * capacity, sizeof(HashTreeNode));
+    self->stale = (unsigned char *)malloc(2 * capacity);
+    self->scratch = (unsigned char *)malloc(block);
+    if (!self->nodes || !self->stale || !self->scratch) {
+        fatal_error("hash_tree", "out of memory");
+    }
+    memset(self->stale, 1, 2 * capacity);
+    self->capacity = capacity;
+    self->block = block;
+}
+
+/**
+ * @brief Markiert die Blätter, die eine Änderung betrifft.
+ *
+ * Beim Überschreiben sind das die Blöcke des Bereichs, sonst alle ab
+ * dem Beginn der Änderung, weil sich die folgenden Bytes verschoben haben.
+ */
+static void mark_change(HashTree *self, const DataBufferChange *change) {
+    size_t first = change->start / self->block;
+    size_t last = self->capacity - 1;
+    if (change->removed == change->added) {
+        if (change->added == 0) {
+            return;
+        }
+        last = (change->start + change->added - 1) / self->block;
+    }
+    if (last >= self->capacity) {
+        last = self->capacity - 1;
+    }
+    for (size_t leaf = first; leaf <= last; leaf++) {
+        mark_leaf(self, leaf);
+    }
+}
+
+/** @brief Markiert ein Blatt und seine Vorfahren bis zum ersten bereits markierten. */
+static void mark_leaf(HashTree *self, size_t leaf) {
+    for (size_t node = self->capacity + leaf; node >= 1 && !self->stale[node]; node /= 2) {
+        self->stale[node] = 1;
+    }
+}
+
+/**
+ * @brief Sammelt die veralteten Blätter unter `node`, nur markierten Pfaden folgend.
+ * @return neue Anzahl in `out`
+ */
+static size_t collect_stale(const HashTree *self, size_t node, size_t *out, size_t count) {
+    if (!self->stale[node]) {
+        return count;
+    }
+    if (node >= self->capacity) {
+        out[count] = node;
+        return count + 1;
+    }
+    count = collect_stale(self, 2 * node, out, count);
+    return collect_stale(self, 2 * node + 1, out, count);
+}
+
+/**
+ * @brief Liest die veralteten Blätter neu, bei vielen Blättern auf mehreren Threads.
+ */
+static void hash_leaves(HashTree *self, const size_t *leaves, size_t count) {
+    LeafJob job;
+    memset(&job, 0, sizeof(job));
+    job.tree = self;
+    job.leaves = leaves;
+    job.count = count;
+    hash_digest_prepare(); // Varianten wählen, bevor die Threads sie lesen
+#ifndef _WIN32
+    pthread_mutex_init(&job.lock, NULL);
+    pthread_t threads[HASH_TREE_THREADS];
+    int started = 0;
+    int wanted = thread_count(self, count);
+    for (int i = 1; i < wanted; i++) { // der aufrufende Thread rechnet mit
+        if (pthread_create(&threads[started], NULL, worker, &job) != 0) {
+            break;
+        }
+        started++;
+    }
+    worker(&job);
+    for (int i = 0; i < started; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    pthread_mutex_destroy(&job.lock);
+#else
+    worker(&job);
+#endif
+}
+
+/**
+ * @brief Berechnet die Werte eines Blatts aus seinem Block.
+ * @param data Platz für einen Block
+ */
+static void hash_leaf(HashTree *self, size_t node, unsigned char *data) {
+    HashTreeNode *leaf = &self->nodes[node];
+    size_t size = self->buffer->size;
+    size_t start = (node - self->capacity) * self->block;
+    memset(leaf, 0, sizeof(*leaf));
+    if (start < size || start == 0) {
+        size_t length = (size - start < self->block) ? size - start : self->block;
+        data_buffer_get_range(self->buffer, start, start + length, data);
+        static const unsigned char prefix = LEAF_PREFIX;
+        HashState state;
+        hash_state_init(&state, HASH_SHA256);
+        hash_state_update(&state, &prefix, 1);
+        hash_state_update(&state, data, length);
+        hash_state_final(&state, leaf->digest);
+        leaf->crc = hash_crc32(0, data, length);
+        leaf->length = length;
+        leaf->used = 1;
+    }
+    self->stale[node] = 0; // jedes Blatt gehört genau einem Thread
+}
+
+/**
+ * @brief Setzt die markierten inneren Knoten unter `node` aus ihren Kindern neu zusammen.
+ */
+static void combine_stale(HashTree *self, size_t node) {
+    if (!self->stale[node]) {
+        return;
+    }
+    combine_stale(self, 2 * node);
+    combine_stale(self, 2 * node + 1);
+    const HashTreeNode *left = &self->nodes[2 * node];
+    const HashTreeNode *right = &self->nodes[2 * node + 1];
+    HashTreeNode *parent = &self->nodes[node];
+    if (!right->used) {
+        *parent = *left; // leerer rechter Teilbaum ändert nichts
+    } else {
+        unsigned char joined[1 + 2 * HASH_TREE_DIGEST];
+        joined[0] = NODE_PREFIX;
+        memcpy(joined + 1, left->digest, HASH_TREE_DIGEST);
+        memcpy(joined + 1 + HASH_TREE_DIGEST, right->digest, HASH_TREE_DIGEST);
+        HashState state;
+        hash_state_init(&state, HASH_SHA256);
+        hash_state_update(&state, joined, sizeof(joined));
+        hash_state_final(&state, parent->digest);
+        parent->crc = hash_crc32_combine(left->crc, right->crc, right->length);
+        parent->length = left->length + right->length;
+        parent->used = 1;
+    }
+    self->stale[node] = 0;
+}
+
+/**
+ * @brief Setzt `crc` über den Teil von `[start, end)` fort, der unter `node` liegt.
+ * @param nodeStart erstes Byte des Knotens
+ * @param span      Bytes, die der Knoten höchstens umfasst
+ */
+static uint32_t range_crc(HashTree *self, size_t node, uint64_t nodeStart, uint64_t span,
+                          size_t start, size_t end, uint32_t crc) {
+    const HashTreeNode *current = &self->nodes[node];
+    uint64_t nodeEnd = nodeStart + current->length;
+    if (!current->used || end <= nodeStart || start >= nodeEnd) {
+        return crc;
+    }
+    if (start <= nodeStart && nodeEnd <= end) {
+        return hash_crc32_combine(crc, current->crc, current->length); // ganz enthalten
+    }
+    if (node >= self->capacity) { // angeschnittener Block
+        size_t from = (start > nodeStart) ? start : (size_t)nodeStart;
+        size_t to = (end < nodeEnd) ? end : (size_t)nodeEnd;
+        data_buffer_get_range(self->buffer, from, to, self->scratch);
+        return hash_crc32(crc, self->scratch, to - from);
+    }
+    crc = range_crc(self, 2 * node, nodeStart, span / 2, start, end, crc);
+    return range_crc(self, 2 * node + 1, nodeStart + span / 2, span / 2, start, end, crc);
+}
+
+/**
+ * @brief Vergibt das nächste Blatt.
+ * @return 1 wenn ein Blatt vergeben wurde, 0 wenn alle vergeben sind
+ */
+static int claim_leaf(LeafJob *job, size_t *outIndex) {
+#ifndef _WIN32
+    pthread_mutex_lock(&job->lock);
+#endif
+    size_t index = job->next;
+    int claimed = index < job->count;
+    if (claimed) {
+        job->next++;
+    }
+#ifndef _WIN32
+    pthread_mutex_unlock(&job->lock);
+#endif
+    *outIndex = index;
+    return claimed;
+}
+
+/**
+ * @brief Berechnet Blätter, bis keines mehr übrig ist.
+ */
+static void *worker(void *context) {
+    LeafJob *job = (LeafJob *)context;
+    unsigned char *data = (unsigned char *)malloc(job->tree->block);
+    if (!data) {
+        fatal_error("hash_tree", "out of memory");
+    }
+    size_t index;
+    while (claim_leaf(job, &index)) {
+        hash_leaf(job->tree, job->leaves[index], data);
+    }
+    free(data);
+    return NULL;
+}
+
+#ifndef _WIN32
+/** @brief Anzahl der Threads für `count` Blätter, den aufrufenden eingeschlossen. */
+static int thread_count(const HashTree *self, size_t count) {
+    if (count < 2 || !data_buffer_reads_concurrently(self->buffer)) {
+        return 1;
+    }
+    long online = 1;
+#ifdef _SC_NPROCESSORS_ONLN
+    online = sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+    if (online < 1) {
+        online = 1;
+    }
+    if (online > HASH_TREE_THREADS) {
+        online = HASH_TREE_THREADS;
+    }
+    if ((size_t)online > count) {
+        online = (long)count;
+    }
+    return (int)online;
+}
+#endif
+
+//* ----------------------------------- Init und Deinit -----------------------------------
+/**
+ * @brief Initialisiert einen leeren Baum.
+ */
+int hash_tree_init(HashTree *self, const DataBuffer *buffer) {
+    memset(self, 0, sizeof(*self));
+    self->buffer = buffer;
+    return 0;
+}
+
+/**
+ * @brief Gibt Knoten und Puffer frei.
+ */
+int hash_tree_deinit(HashTree *self) {
+    free(self->nodes);
+    free(self->stale);
+    free(self->scratch);
+    memset(self, 0, sizeof(*self));
+    return 0;
+}
@@ -0,0 +1,108 @@
+#ifndef HASH_TREE_H
+#define HASH_TREE_H
+
+/**
+ * @file Hash_Tree.h
+ * @brief Schnittstelle des Prüfsummenbaums über dem Buffer.
+ *
+ * Der Inhalt wird in Blöcke fester Größe geteilt. Jedes Blatt hält
+ * CRC32 und SHA-256 seines Blocks, jeder innere Knoten die aus seinen
+ * Kindern zusammengesetzten Werte: CRC32 über `hash_crc32_combine`,
+ * SHA-256 als Merkle-Baum. Nach dem Überschreiben einzelner Bytes
+ * werden nur die betroffenen Blöcke und ihre Vorfahren neu berechnet,
+ * CRC32 und Baumwert der ganzen Datei stehen so nach O(log n) Schritten
+ * wieder bereit. Einfügen und Löschen verschieben alle folgenden
+ * Blöcke; ab der Änderung wird dann neu berechnet.
+ */
+
+#include <stddef.h>       // stellt den Typ size_t bereit
+#include <stdint.h>       // feste Breiten für Längen und CRC32
+#include "Data_Buffer.h" // zugrunde liegender Inhalt
+
+//* ---------------------------- Globale Konstanten oder Defines --------------------------
+#define HASH_TREE_BLOCK (64 * 1024)       /**< kleinste Blockgröße in Bytes */
+#define HASH_TREE_MAX_LEAVES (1u << 20)  /**< größere Inhalte bekommen größere Blöcke */
+#define HASH_TREE_THREADS 8              /**< höchstens so viele Threads beim Neuberechnen */
+#define HASH_TREE_DIGEST 32              /**< Länge des Baumwerts (SHA-256) */
+
+//* ------------------------------------- Strukturen --------------------------------------
+/**
+ * @brief Werte eines Knotens über alle Bytes seines Teilbaums.
+ *
+ * Blätter hinter dem Ende des Inhalts sind leer; ein Knoten mit leerem
+ * rechten Kind übernimmt die Werte des linken.
+ */
+typedef struct {
+    uint64_t length;                         /**< Bytes unter diesem Knoten */
+    uint32_t crc;                            /**< CRC32 dieser Bytes */
+    int used;                                /**< 0 = leerer Knoten */
+    unsigned char digest[HASH_TREE_DIGEST];  /**< SHA-256(0x00 || Block) bzw. SHA-256(0x01 || links || rechts) */
+} HashTreeNode;
+
+/**
+ * @brief Prüfsummenbaum über einem Buffer.
+ *
+ * Die Knoten liegen als vollständiger Binärbaum in einem Feld: Knoten 1
+ * ist die Wurzel, Knoten `i` hat die Kinder `2i` und `2i + 1`, die
+ * Blätter beginnen bei `capacity`.
+ */
+typedef struct {
+    const DataBuffer *buffer; /**< zugrunde liegender Buffer */
+    HashTreeNode *nodes;      /**< `2 * capacity` Knoten, Index 0 ungenutzt */
+    unsigned char *stale;     /**< je Knoten 1 = neu zu berechnen */
+    size_t capacity;          /**< Anzahl der Blattplätze, Zweierpotenz */
+    size_t block;             /**< Bytes je Blatt */
+    unsigned long revision;   /**< Stand des Buffers, für den die Werte gelten */
+    size_t rehashed;          /**< beim letzten Abgleich neu gelesene Blöcke */
+    unsigned char *scratch;   /**< ein Block für Teilbereiche */
+} HashTree;
+
+//* ------------------------------------- Funktionen --------------------------------------
+/**
+ * @brief Gleicht den Baum mit dem aktuellen Stand des Buffers ab.
+ *
+ * Anhand der Änderungen seit dem letzten Abgleich werden nur die
+ * betroffenen Blöcke neu gelesen, bei Bedarf auf mehreren Threads.
+ * Beim ersten Aufruf und wenn Änderungen nicht mehr bekannt sind,
+ * werden alle Blöcke gelesen.
+ *
+ * @param self Zeiger auf den Baum
+ * @return Anzahl der neu gelesenen Blöcke
+ */
+size_t hash_tree_update(HashTree *self);
+
+/**
+ * @brief CRC32 des Bereichs `[start, end)` aus dem abgeglichenen Baum.
+ *
+ * Vollständig enthaltene Teilbäume werden zusammengesetzt, nur die
+ * angeschnittenen Blöcke an den Rändern werden gelesen.
+ *
+ * @param self  Zeiger auf den Baum
+ * @param start erstes Byte
+ * @param end   hinter dem letzten Byte
+ * @return CRC32 des Bereichs
+ */
+uint32_t hash_tree_crc32(HashTree *self, size_t start, size_t end);
+
+/**
+ * @brief Baumwert des gesamten Inhalts.
+ * @param self   Zeiger auf den abgeglichenen Baum
+ * @param digest erhält `HASH_TREE_DIGEST` Bytes
+ */
+void hash_tree_root(const HashTree *self, unsigned char *digest);
+
+//* ----------------------------------- Init und Deinit -----------------------------------
+/**
+ * @brief Initialisiert einen leeren Baum; berechnet wird erst beim ersten Abgleich.
+ * @param self   Zeiger auf den Baum
+ * @param buffer zugrunde liegender Buffer
+ * @return 0 bei Erfolg
+ */
+int hash_tree_init(HashTree *self, const DataBuffer *buffer);
+
+/**
+ * @brief Gibt Knoten und Puffer frei.
+ */
+int hash_tree_deinit(HashTree *self);
+
+#endif // HASH_TREE_H
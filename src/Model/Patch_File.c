@@ -0,0 +1,1031 @@
+/**
+ * @file Patch_File.c
+ * @brief Patches im IPS-, BPS- und Listenformat.
+ *
+ * Für den Export wird der Inhalt zuerst in Abschnitte zerlegt, die
+ * entweder Bytes der Datei übernehmen oder neue Bytes aus dem Buffer
+ * liefern. Ohne Einfügen und Löschen stammen die neuen Abschnitte aus
+ * der Bitmap geänderter Bytes, sonst aus dem Stückbaum. IPS und die
+ * Liste schreiben jeden Abschnitt, dessen Bytes nicht an ihrer Stelle
+ * bleiben, als Datensatz; BPS übernimmt unveränderte und verschobene
+ * Abschnitte als Kopierbefehle.
+ *
+ * Beim Anwenden wird der Patch erst vollständig geprüft und dann
+ * geschrieben. Verschobene Abschnitte eines BPS-Patches werden in einer
+ * Reihenfolge kopiert, in der kein Abschnitt eine noch benötigte Quelle
+ * überschreibt; blockieren sich Abschnitte gegenseitig, wird einer
+ * davon vorher in den Speicher gelesen. Die Prüfsummen über Quelle und
+ * Ziel eines BPS-Patches werden beim Anwenden nicht nachgerechnet, da
+ * das die ganze Datei lesen würde; geprüft werden Patch und Größe.
+ */
+
+//* -------------------------------------- Includes ---------------------------------------
+#include "Patch_File.h"    // Schnittstelle dieses Moduls
+#include <stdint.h>         // feste Breiten für Adressen und Prüfsummen
+#include <stdio.h>          // snprintf
+#include <stdlib.h>         // malloc, realloc und free
+#include <string.h>         // memcpy, memcmp, strcmp und strrchr
+#include "Dump_Export.h"   // Hex-Ziffern der Liste
+#include "Err_Log.h"       // Fehlerbehandlung
+#include "File_Manager.h"  // Lesen und Schreiben an festen Positionen
+#include "Hash_Digest.h"   // CRC32 für BPS
+
+//* ---------------------------- Globale Konstanten oder Defines --------------------------
+#define PATCH_CHUNK (1024u * 1024u)  /**< Bytes je Lese- oder Schreibschritt */
+#define IPS_RECORD_MAX 0xFFFFu        /**< höchstens so viele Bytes je IPS-Satz */
+#define IPS_OFFSET_LIMIT 0x1000000u   /**< IPS-Adressen haben drei Bytes */
+#define IPS_EOF_OFFSET 0x454F46u      /**< Adresse, die sich wie die Endmarke `EOF` liest */
+#define IPS_RLE_MIN 16                /**< gleiche Bytes ab dieser Anzahl als RLE-Satz */
+#define LIST_BYTES_PER_LINE 32        /**< Bytes je Zeile der Liste */
+#define BPS_FOOTER 12                 /**< drei CRC32 am Ende eines BPS-Patches */
+
+/** Namen in der Reihenfolge von `PatchFormat` */
+static const char *const FORMAT_NAMES[PATCH_FORMAT_COUNT] = {"ips", "bps", "list"};
+
+/** Befehle eines BPS-Patches */
+enum { BPS_SOURCE_READ, BPS_TARGET_READ, BPS_SOURCE_COPY, BPS_TARGET_COPY };
+
+/**
+ * @brief Abschnitt des Inhalts.
+ */
+typedef struct {
+    size_t target; /**< Position im Inhalt */
+    size_t source; /**< Position in der Datei, nur bei `copy` */
+    size_t length; /**< Länge in Bytes */
+    int copy;      /**< 1 = Bytes der Datei, 0 = neue Bytes aus dem Buffer */
+} PatchSegment;
+
+/**
+ * @brief Abschnitte des ganzen Inhalts in Reihenfolge.
+ */
+typedef struct {
+    PatchSegment *items; /**< Abschnitte */
+    size_t count;        /**< belegte Einträge */
+    size_t capacity;     /**< reservierte Einträge */
+    size_t target;       /**< Ende des letzten Abschnitts im Inhalt */
+} SegmentList;
+
+/**
+ * @brief Wachsender Speicher für den entstehenden Patch.
+ */
+typedef struct {
+    unsigned char *bytes; /**< Patchbytes */
+    size_t length;        /**< belegte Bytes */
+    size_t capacity;      /**< reservierte Bytes */
+} PatchOutput;
+
+/**
+ * @brief Verschiebung eines BPS-Patches innerhalb der Zieldatei.
+ */
+typedef struct {
+    size_t target;        /**< Zielposition */
+    size_t source;        /**< Quellposition in der ursprünglichen Datei */
+    size_t length;        /**< Länge in Bytes */
+    unsigned char *held;  /**< vorab gelesene Quellbytes oder NULL */
+    int done;             /**< 1, sobald geschrieben */
+} PatchMove;
+
+/**
+ * @brief Zustand beim Anwenden eines BPS-Patches.
+ */
+typedef struct {
+    int fd;               /**< Zieldatei */
+    const unsigned char *patch; /**< Patchbytes */
+    size_t actions;       /**< Beginn der Befehle im Patch */
+    size_t end;           /**< Ende der Befehle vor den Prüfsummen */
+    uint64_t source_size; /**< erwartete Größe der Datei */
+    uint64_t target_size; /**< Größe nach dem Anwenden */
+    PatchMove *moves;     /**< Verschiebungen */
+    size_t move_count;    /**< belegte Einträge in `moves` */
+    unsigned char *chunk; /**< Zwischenspeicher zum Kopieren */
+} BpsApply;
+
+// Vorwärtsdeklarationen der Helferfunktionen
+static int collect_segments(const DataBuffer *buffer, SegmentList *list);
+static int collect_piece(void *context, const PieceNode *piece);
+static void add_segment(SegmentList *list, size_t source, size_t length, int copy);
+static int write_records(const DataBuffer *buffer, const SegmentList *list, size_t baseSize,
+                         PatchFormat format, PatchOutput *out);
+static int put_ips(PatchOutput *out, const DataBuffer *buffer, size_t offset,
+                   const unsigned char *data, size_t length);
+static void put_list(PatchOutput *out, size_t offset, const unsigned char *data, size_t length);
+static int write_bps(const DataBuffer *buffer, const SegmentList *list, int baseFd,
+                     size_t baseSize, PatchOutput *out);
+static void put_bytes(PatchOutput *out, const void *bytes, size_t length);
+static void put_number(PatchOutput *out, size_t value, int width);
+static void put_varint(PatchOutput *out, uint64_t value);
+static int apply_ips(int fd, const unsigned char *patch, size_t length, int write);
+static int apply_list(int fd, const unsigned char *patch, size_t length, unsigned char *scratch,
+                      int write);
+static int apply_bps(int fd, size_t size, const unsigned char *patch, size_t length);
+static int walk_bps(BpsApply *self, int write);
+static int run_moves(BpsApply *self);
+static int copy_within(int fd, size_t target, size_t source, size_t length, unsigned char *chunk);
+static int fill_range(int fd, size_t offset, size_t length, unsigned char value);
+static int read_varint(const unsigned char *patch, size_t end, size_t *pos, uint64_t *out);
+static int read_number(const unsigned char **pos, const unsigned char *end, int base,
+                       uint64_t *out);
+static int hex_value(int ch);
+static int overlaps(size_t a, size_t aLength, size_t b, size_t bLength);
+
+//* ------------------------------------- Funktionen --------------------------------------
+/**
+ * @brief Übersetzt einen Formatnamen.
+ */
+int patch_format_parse(const char *name, PatchFormat *out) {
+    for (int format = 0; format < PATCH_FORMAT_COUNT; format++) {
+        if (strcmp(name, FORMAT_NAMES[format]) == 0) {
+            *out = (PatchFormat)format;
+            return 0;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Wählt das Format nach der Dateiendung.
+ */
+PatchFormat patch_format_for_path(const char *path) {
+    const char *dot = strrchr(path, '.');
+    PatchFormat format = PATCH_LIST;
+    if (dot && patch_format_parse(dot + 1, &format) == 0) {
+        return format;
+    }
+    return PATCH_LIST;
+}
+
+/**
+ * @brief Schreibt die Änderungen seit dem Laden oder Speichern als Patch.
+ */
+int patch_export(const DataBuffer *buffer, const char *basePath, const char *path,
+                 PatchFormat format) {
+    if (!buffer->source.ops || data_buffer_is_stream(buffer)) {
+        return PATCH_UNSUPPORTED; // ein Datenstrom hat keine Datei, auf die ein Patch passt
+    }
+    SegmentList list = {0};
+    int result = collect_segments(buffer, &list);
+    int baseFd = -1;
+    size_t baseSize = 0;
+    if (result == 0 && openFileForRead(basePath, &baseFd, &baseSize) != 0) {
+        result = PATCH_ERROR;
+    }
+    size_t expected = buffer->layout_changed ? buffer->source.size : buffer->size;
+    if (result == 0 && baseSize != expected) {
+        result = PATCH_ERROR; // Datei wurde inzwischen von außen verändert
+    }
+
+    PatchOutput out = {0};
+    if (result == 0) {
+        result = (format == PATCH_BPS) ? write_bps(buffer, &list, baseFd, baseSize, &out)
+                                       : write_records(buffer, &list, baseSize, format, &out);
+    }
+    if (result == 0 && writeBufferToFile(path, out.bytes ? out.bytes : (const unsigned char *)"",
+                                         out.length) != 0) {
+        result = PATCH_ERROR;
+    }
+    closeFile(baseFd);
+    free(out.bytes);
+    free(list.items);
+    return result;
+}
+
+/**
+ * @brief Wendet einen Patch an Ort und Stelle auf eine Datei an.
+ *
+ * `PATCH` am Anfang kennzeichnet IPS, `BPS1` einen BPS-Patch, alles
+ * andere wird als Liste gelesen. Jeder Patch wird in einem ersten
+ * Durchgang ohne Schreiben geprüft, damit ein fehlerhafter Patch die
+ * Datei nicht halb verändert zurücklässt.
+ */
+int patch_apply(const char *patchPath, const char *targetPath) {
+    unsigned char *patch = NULL;
+    size_t length = 0;
+    if (readFileToBuffer(patchPath, &patch, &length) != 0) {
+        return PATCH_ERROR;
+    }
+    int fd;
+    size_t size;
+    if (openFileForUpdate(targetPath, &fd, &size) != 0) {
+        free(patch);
+        return PATCH_ERROR;
+    }
+
+    int result;
+    if (length >= 5 && memcmp(patch, "PATCH", 5) == 0) {
+        result = apply_ips(fd, patch, length, 0);
+        if (result == 0) {
+            result = apply_ips(fd, patch, length, 1);
+        }
+    } else if (length >= 4 && memcmp(patch, "BPS1", 4) == 0) {
+        result = apply_bps(fd, size, patch, length);
+    } else {
+        unsigned char *scratch = (unsigned char *)malloc(length / 2 + 1); // Bytes einer Zeile
+        if (!scratch) {
+            fatal_error("patch_apply", "out of memory");
+        }
+        result = apply_list(fd, patch, length, scratch, 0);
+        if (result == 0) {
+            result = apply_list(fd, patch, length, scratch, 1);
+        }
+        free(scratch);
+    }
+    if (result == 0 && syncFile(fd) != 0) {
+        result = PATCH_ERROR;
+    }
+    closeFile(fd);
+    free(patch);
+    return result;
+}
+
+//* ---------------------------------- Helfer Funktionen ----------------------------------
+/**
+ * @brief Zerlegt den Inhalt in übernommene und neue Abschnitte.
+ * @return 0 bei Erfolg, `PATCH_UNSUPPORTED` nach Einfügen oder Löschen seit dem Speichern
+ */
+static int collect_segments(const DataBuffer *buffer, SegmentList *list) {
+    if (buffer->layout_changed) {
+        if (!buffer->source_on_disk) {
+            return PATCH_UNSUPPORTED; // Stückbaum verweist auf einen älteren Stand der Datei
+        }
+        piece_table_for_each(&buffer->pieces, collect_piece, list);
+        return 0;
+    }
+    // Positionen entsprechen der Datei: geänderte Läufe der Bitmap sind die neuen Abschnitte
+    size_t size = buffer->size;
+    for (size_t pos = 0; pos < size;) {
+        size_t start = change_bitmap_next(&buffer->modified, pos, 1);
+        if (start == CHANGE_BITMAP_NONE || start > size) {
+            start = size;
+        }
+        add_segment(list, pos, start - pos, 1);
+        if (start == size) {
+            break;
+        }
+        size_t end = change_bitmap_next(&buffer->modified, start, 0);
+        if (end == CHANGE_BITMAP_NONE || end > size) {
+            end = size;
+        }
+        add_segment(list, 0, end - start, 0);
+        pos = end;
+    }
+    return 0;
+}
+
+/**
+ * @brief Übernimmt ein Stück als Abschnitt.
+ */
+static int collect_piece(void *context, const PieceNode *piece) {
+    add_segment((SegmentList *)context, piece->start, piece->length, piece->kind == PIECE_ORIGINAL);
+    return 0;
+}
+
+/**
+ * @brief Hängt einen Abschnitt an und verbindet ihn mit einem passenden Vorgänger.
+ */
+static void add_segment(SegmentList *list, size_t source, size_t length, int copy) {
+    if (length == 0) {
+        return;
+    }
+    size_t target = list->target;
+    list->target += length;
+    if (list->count > 0) {
+        PatchSegment *last = &list->items[list->count - 1];
+        if (last->copy == copy && (!copy || last->source + last->length == source)) {
+            last->length += length;
+            return;
+        }
+    }
+    if (list->count == list->capacity) {
+        size_t capacity = list->capacity ? list->capacity * 2 : 64;
+        PatchSegment *items = (PatchSegment *)realloc(list->items, capacity * sizeof(*items));
+        if (!items) {
+            fatal_error("patch_export", "out of memory");
+        }
+        list->items = items;
+        list->capacity = capacity;
+    }
+    list->items[list->count++] = (PatchSegment){target, copy ? source : 0, length, copy};
+}
+
+/**
+ * @brief Schreibt IPS-Sätze oder Zeilen der Liste für alle neuen Bytes.
+ *
+ * Verschobene Abschnitte gelten als neu, da ihre Bytes an anderer
+ * Stelle stehen. Ist der Inhalt kürzer als die Datei, folgt die
+ * Kürzung: bei IPS als drei Bytes hinter `EOF`, bei der Liste als
+ * `size:`-Zeile.
+ */
+static int write_records(const DataBuffer *buffer, const SegmentList *list, size_t baseSize,
+                         PatchFormat format, PatchOutput *out) {
+    unsigned char *chunk = (unsigned char *)malloc(PATCH_CHUNK);
+    if (!chunk) {
+        fatal_error("patch_export", "out of memory");
+    }
+    if (format == PATCH_IPS) {
+        put_bytes(out, "PATCH", 5);
+    }
+    int result = 0;
+    for (size_t i = 0; i < list->count && result == 0; i++) {
+        const PatchSegment *segment = &list->items[i];
+        if (segment->copy && segment->source == segment->target) {
+            continue; // Bytes stehen schon an dieser Stelle
+        }
+        for (size_t done = 0; done < segment->length && result == 0;) {
+            size_t length = segment->length - done;
+            if (length > PATCH_CHUNK) {
+                length = PATCH_CHUNK;
+            }
+            size_t offset = segment->target + done;
+            data_buffer_get_range(buffer, offset, offset + length, chunk);
+            if (format == PATCH_IPS) {
+                result = put_ips(out, buffer, offset, chunk, length);
+            } else {
+                put_list(out, offset, chunk, length);
+            }
+            done += length;
+        }
+    }
+    free(chunk);
+    if (result != 0) {
+        return result;
+    }
+
+    if (format == PATCH_IPS) {
+        put_bytes(out, "EOF", 3);
+        if (buffer->size < baseSize) {
+            if (buffer->size >= IPS_OFFSET_LIMIT) {
+                return PATCH_UNSUPPORTED;
+            }
+            put_number(out, buffer->size, 3);
+        }
+    } else if (buffer->size != baseSize) {
+        char line[40];
+        int count = snprintf(line, sizeof(line), "size: 0x%zx\n", buffer->size);
+        put_bytes(out, line, (size_t)count);
+    }
+    return 0;
+}
+
+/**
+ * @brief Schreibt Bytes als IPS-Sätze, Läufe gleicher Bytes als RLE-Satz.
+ *
+ * Ein Satz darf nicht bei `0x454F46` beginnen, da diese Adresse als
+ * Endmarke gelesen würde; er beginnt dann ein Byte früher.
+ *
+ * @return 0 bei Erfolg, `PATCH_UNSUPPORTED` ab 16 MiB
+ */
+static int put_ips(PatchOutput *out, const DataBuffer *buffer, size_t offset,
+                   const unsigned char *data, size_t length) {
+    for (size_t pos = 0; pos < length;) {
+        size_t at = offset + pos;
+        if (at >= IPS_OFFSET_LIMIT) {
+            return PATCH_UNSUPPORTED;
+        }
+        size_t run = 1;
+        while (pos + run < length && run < IPS_RECORD_MAX && data[pos + run] == data[pos]) {
+            run++;
+        }
+        if (run >= IPS_RLE_MIN && at != IPS_EOF_OFFSET) {
+            put_number(out, at, 3);
+            put_number(out, 0, 2);
+            put_number(out, run, 2);
+            put_bytes(out, &data[pos], 1);
+            pos += run;
+            continue;
+        }
+
+        int shifted = (at == IPS_EOF_OFFSET);
+        size_t limit = IPS_RECORD_MAX - (size_t)shifted;
+        size_t literal = 0;
+        size_t same = 0;
+        while (pos + literal < length && literal < limit) { // bis zum nächsten langen Lauf
+            same = (literal > 0 && data[pos + literal] == data[pos + literal - 1]) ? same + 1 : 1;
+            literal++;
+            if (same >= IPS_RLE_MIN) {
+                literal -= same;
+                break;
+            }
+        }
+        if (literal == 0) {
+            literal = 1; // nur bei der verschobenen Adresse: ein Byte vor dem Lauf
+        }
+        put_number(out, at - (size_t)shifted, 3);
+        put_number(out, literal + (size_t)shifted, 2);
+        if (shifted) {
+            unsigned char before = data_buffer_get_byte(buffer, at - 1);
+            put_bytes(out, &before, 1);
+        }
+        put_bytes(out, &data[pos], literal);
+        pos += literal;
+    }
+    return 0;
+}
+
+/**
+ * @brief Schreibt Bytes als Zeilen `offset: hexbytes`.
+ */
+static void put_list(PatchOutput *out, size_t offset, const unsigned char *data, size_t length) {
+    char line[32 + 2 * LIST_BYTES_PER_LINE];
+    for (size_t pos = 0; pos < length; pos += LIST_BYTES_PER_LINE) {
+        size_t count = length - pos;
+        if (count > LIST_BYTES_PER_LINE) {
+            count = LIST_BYTES_PER_LINE;
+        }
+        int used = snprintf(line, sizeof(line), "%08zx: ", offset + pos);
+        dump_hex(data + pos, count, line + used, 0);
+        used += (int)(2 * count);
+        line[used++] = '\n';
+        put_bytes(out, line, (size_t)used);
+    }
+}
+
+/**
+ * @brief Schreibt einen BPS-Patch.
+ *
+ * Abschnitte an ihrer alten Stelle werden zu `SourceRead`, verschobene
+ * zu `SourceCopy`, neue Bytes zu `TargetRead`. Die Prüfsummen über Datei
+ * und Inhalt erfordern, beide einmal vollständig zu lesen.
+ */
+static int write_bps(const DataBuffer *buffer, const SegmentList *list, int baseFd,
+                     size_t baseSize, PatchOutput *out) {
+    unsigned char *chunk = (unsigned char *)malloc(PATCH_CHUNK);
+    if (!chunk) {
+        fatal_error("patch_export", "out of memory");
+    }
+    put_bytes(out, "BPS1", 4);
+    put_varint(out, baseSize);
+    put_varint(out, buffer->size);
+    put_varint(out, 0); // keine Metadaten
+
+    size_t sourceRelative = 0; // Lesezeiger der Kopierbefehle in der Datei
+    for (size_t i = 0; i < list->count; i++) {
+        const PatchSegment *segment = &list->items[i];
+        uint64_t length = (uint64_t)segment->length - 1;
+        if (segment->copy && segment->source == segment->target) {
+            put_varint(out, (length << 2) | BPS_SOURCE_READ);
+        } else if (segment->copy) {
+            put_varint(out, (length << 2) | BPS_SOURCE_COPY);
+            uint64_t distance = (segment->source >= sourceRelative)
+                                    ? (uint64_t)(segment->source - sourceRelative) << 1
+                                    : ((uint64_t)(sourceRelative - segment->source) << 1) | 1u;
+            put_varint(out, distance);
+            sourceRelative = segment->source + segment->length;
+        } else {
+            put_varint(out, (length << 2) | BPS_TARGET_READ);
+            for (size_t done = 0; done < segment->length;) {
+                size_t count = segment->length - done;
+                if (count > PATCH_CHUNK) {
+                    count = PATCH_CHUNK;
+                }
+                size_t offset = segment->target + done;
+                data_buffer_get_range(buffer, offset, offset + count, chunk);
+                put_bytes(out, chunk, count);
+                done += count;
+            }
+        }
+    }
+
+    uint32_t sourceCrc = 0;
+    for (size_t done = 0; done < baseSize;) {
+        size_t count = (baseSize - done < PATCH_CHUNK) ? baseSize - done : PATCH_CHUNK;
+        if (readFileAt(baseFd, done, chunk, count) != (long long)count) {
+            free(chunk);
+            return PATCH_ERROR;
+        }
+        sourceCrc = hash_crc32(sourceCrc, chunk, count);
+        done += count;
+    }
+    uint32_t targetCrc = 0;
+    for (size_t done = 0; done < buffer->size;) {
+        size_t count = (buffer->size - done < PATCH_CHUNK) ? buffer->size - done : PATCH_CHUNK;
+        data_buffer_get_range(buffer, done, done + count, chunk);
+        targetCrc = hash_crc32(targetCrc, chunk, count);
+        done += count;
+    }
+    free(chunk);
+
+    uint32_t crcs[2] = {sourceCrc, targetCrc};
+    for (int i = 0; i < 2; i++) {
+        unsigned char bytes[4] = {(unsigned char)crcs[i], (unsigned char)(crcs[i] >> 8),
+                                  (unsigned char)(crcs[i] >> 16), (unsigned char)(crcs[i] >> 24)};
+        put_bytes(out, bytes, 4);
+    }
+    uint32_t patchCrc = hash_crc32(0, out->bytes, out->length);
+    unsigned char bytes[4] = {(unsigned char)patchCrc, (unsigned char)(patchCrc >> 8),
+                              (unsigned char)(patchCrc >> 16), (unsigned char)(patchCrc >> 24)};
+    put_bytes(out, bytes, 4);
+    return 0;
+}
+
+/**
+ * @brief Hängt Bytes an den Patch an.
+ */
+static void put_bytes(PatchOutput *out, const void *bytes, size_t length) {
+    if (out->length + length > out->capacity) {
+        size_t capacity = out->capacity ? out->capacity : 4096;
+        while (capacity < out->length + length) {
+            capacity *= 2;
+        }
+        unsigned char *grown = (unsigned char *)realloc(out->bytes, capacity);
+        if (!grown) {
+            fatal_error("patch_export", "out of memory");
+        }
+        out->bytes = grown;
+        out->capacity = capacity;
+    }
+    memcpy(out->bytes + out->length, bytes, length);
+    out->length += length;
+}
+
+/**
+ * @brief Hängt eine Zahl mit `width` Bytes im Big-Endian-Format an, wie IPS sie nutzt.
+ */
+static void put_number(PatchOutput *out, size_t value, int width) {
+    unsigned char bytes[4];
+    for (int i = 0; i < width; i++) {
+        bytes[i] = (unsigned char)(value >> (8 * (width - 1 - i)));
+    }
+    put_bytes(out, bytes, (size_t)width);
+}
+
+/**
+ * @brief Hängt eine Zahl in der BPS-Kodierung an.
+ *
+ * Je Byte sieben Bits, das letzte Byte trägt das oberste Bit; nach
+ * jedem Byte wird eins abgezogen, damit jede Zahl genau eine Form hat.
+ */
+static void put_varint(PatchOutput *out, uint64_t value) {
+    for (;;) {
+        unsigned char bits = (unsigned char)(value & 0x7F);
+        value >>= 7;
+        if (value == 0) {
+            bits |= 0x80;
+            put_bytes(out, &bits, 1);
+            return;
+        }
+        put_bytes(out, &bits, 1);
+        value--;
+    }
+}
+
+/**
+ * @brief Prüft oder schreibt die Sätze eines IPS-Patches.
+ * @param write 0 = nur prüfen, 1 = schreiben
+ */
+static int apply_ips(int fd, const unsigned char *patch, size_t length, int write) {
+    size_t pos = 5;
+    for (;;) {
+        if (pos + 3 > length) {
+            return PATCH_ERROR; // Endmarke fehlt
+        }
+        if (memcmp(patch + pos, "EOF", 3) == 0) {
+            pos += 3;
+            break;
+        }
+        if (pos + 5 > length) {
+            return PATCH_ERROR;
+        }
+        size_t offset = ((size_t)patch[pos] << 16) | ((size_t)patch[pos + 1] << 8) | patch[pos + 2];
+        size_t size = ((size_t)patch[pos + 3] << 8) | patch[pos + 4];
+        pos += 5;
+        if (size == 0) { // RLE: Anzahl und Wert
+            if (pos + 3 > length) {
+                return PATCH_ERROR;
+            }
+            size_t count = ((size_t)patch[pos] << 8) | patch[pos + 1];
+            if (write && fill_range(fd, offset, count, patch[pos + 2]) != 0) {
+                return PATCH_ERROR;
+            }
+            pos += 3;
+        } else {
+            if (pos + size > length) {
+                return PATCH_ERROR;
+            }
+            if (write && writeFileAt(fd, offset, patch + pos, size) != 0) {
+                return PATCH_ERROR;
+            }
+            pos += size;
+        }
+    }
+    if (pos + 3 <= length && write) { // Erweiterung: neue Dateigröße hinter der Endmarke
+        size_t size = ((size_t)patch[pos] << 16) | ((size_t)patch[pos + 1] << 8) | patch[pos + 2];
+        if (resizeFile(fd, size) != 0) {
+            return PATCH_ERROR;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Prüft oder schreibt die Zeilen einer Liste.
+ *
+ * Jede Zeile ist leer, ein Kommentar ab `#`, `size: n` für die neue
+ * Dateigröße oder `offset: hexbytes` mit hexadezimaler Position; die
+ * Hex-Ziffern dürfen durch Leerzeichen getrennt sein.
+ *
+ * @param scratch nimmt die Bytes einer Zeile auf
+ * @param write   0 = nur prüfen, 1 = schreiben
+ */
+static int apply_list(int fd, const unsigned char *patch, size_t length, unsigned char *scratch,
+                      int write) {
+    const unsigned char *pos = patch;
+    const unsigned char *end = patch + length;
+    while (pos < end) {
+        const unsigned char *lineEnd = memchr(pos, '\n', (size_t)(end - pos));
+        if (!lineEnd) {
+            lineEnd = end;
+        }
+        while (pos < lineEnd && (*pos == ' ' || *pos == '\t' || *pos == '\r')) {
+            pos++;
+        }
+        if (pos == lineEnd || *pos == '#') {
+            pos = lineEnd + (lineEnd < end);
+            continue;
+        }
+
+        int sizeLine = (lineEnd - pos >= 5 && memcmp(pos, "size:", 5) == 0);
+        uint64_t offset = 0;
+        if (sizeLine) {
+            pos += 5;
+        } else if (read_number(&pos, lineEnd, 16, &offset) != 0 || pos >= lineEnd || *pos != ':') {
+            return PATCH_ERROR;
+        } else {
+            pos++;
+        }
+
+        if (sizeLine) {
+            uint64_t size = 0;
+            while (pos < lineEnd && *pos == ' ') {
+                pos++;
+            }
+            if (read_number(&pos, lineEnd, 0, &size) != 0 || size > SIZE_MAX) {
+                return PATCH_ERROR;
+            }
+            if (write && resizeFile(fd, (size_t)size) != 0) {
+                return PATCH_ERROR;
+            }
+        } else {
+            size_t count = 0;
+            int high = -1; // angefangenes Byte
+            for (; pos < lineEnd; pos++) {
+                if (*pos == ' ' || *pos == '\t' || *pos == '\r') {
+                    continue;
+                }
+                int value = hex_value(*pos);
+                if (value < 0) {
+                    return PATCH_ERROR;
+                }
+                if (high < 0) {
+                    high = value;
+                } else {
+                    scratch[count++] = (unsigned char)(high << 4 | value);
+                    high = -1;
+                }
+            }
+            if (high >= 0 || offset + count > SIZE_MAX) {
+                return PATCH_ERROR; // ungerade Anzahl an Ziffern
+            }
+            if (write && writeFileAt(fd, (size_t)offset, scratch, count) != 0) {
+                return PATCH_ERROR;
+            }
+        }
+        while (pos < lineEnd && (*pos == ' ' || *pos == '\t' || *pos == '\r')) {
+            pos++;
+        }
+        if (pos != lineEnd) {
+            return PATCH_ERROR;
+        }
+        pos = lineEnd + (lineEnd < end);
+    }
+    return 0;
+}
+
+/**
+ * @brief Prüft und wendet einen BPS-Patch an.
+ *
+ * Reihenfolge: Verschiebungen, dann neue Bytes und Kopien innerhalb des
+ * Ziels in Patchreihenfolge, zuletzt die neue Größe. `SourceRead`
+ * kostet nichts, da diese Bytes schon an ihrer Stelle stehen.
+ */
+static int apply_bps(int fd, size_t size, const unsigned char *patch, size_t length) {
+    if (length < 4 + BPS_FOOTER) {
+        return PATCH_ERROR;
+    }
+    const unsigned char *footer = patch + length - 4;
+    uint32_t stored = (uint32_t)footer[0] | (uint32_t)footer[1] << 8 | (uint32_t)footer[2] << 16 |
+                      (uint32_t)footer[3] << 24;
+    if (hash_crc32(0, patch, length - 4) != stored) {
+        return PATCH_ERROR; // Patch beschädigt
+    }
+
+    BpsApply self = {0};
+    self.fd = fd;
+    self.patch = patch;
+    self.end = length - BPS_FOOTER;
+    size_t pos = 4;
+    uint64_t metadata = 0;
+    if (read_varint(patch, self.end, &pos, &self.source_size) != 0 ||
+        read_varint(patch, self.end, &pos, &self.target_size) != 0 ||
+        read_varint(patch, self.end, &pos, &metadata) != 0 || metadata > self.end - pos ||
+        self.target_size > SIZE_MAX) {
+        return PATCH_ERROR;
+    }
+    if (self.source_size != size) {
+        return PATCH_UNSUPPORTED; // Patch gehört zu einer anderen Datei
+    }
+    self.actions = pos + (size_t)metadata;
+
+    int result = walk_bps(&self, 0);
+    if (result == 0) {
+        self.chunk = (unsigned char *)malloc(PATCH_CHUNK);
+        if (!self.chunk) {
+            fatal_error("patch_apply", "out of memory");
+        }
+        result = run_moves(&self);
+    }
+    if (result == 0) {
+        result = walk_bps(&self, 1);
+    }
+    if (result == 0 && self.target_size != size && resizeFile(fd, (size_t)self.target_size) != 0) {
+        result = PATCH_ERROR;
+    }
+    for (size_t i = 0; i < self.move_count; i++) {
+        free(self.moves[i].held);
+    }
+    free(self.moves);
+    free(self.chunk);
+    return result;
+}
+
+/**
+ * @brief Geht die Befehle eines BPS-Patches durch.
+ *
+ * Im ersten Durchgang werden alle Grenzen geprüft und die
+ * Verschiebungen gesammelt, im zweiten neue Bytes und Kopien innerhalb
+ * des Ziels geschrieben.
+ *
+ * @param write 0 = prüfen und sammeln, 1 = schreiben
+ */
+static int walk_bps(BpsApply *self, int write) {
+    size_t pos = self->actions;
+    uint64_t output = 0;
+    uint64_t sourceRelative = 0;
+    uint64_t targetRelative = 0;
+    size_t moveCapacity = self->move_count;
+    while (pos < self->end) {
+        uint64_t command;
+        if (read_varint(self->patch, self->end, &pos, &command) != 0) {
+            return PATCH_ERROR;
+        }
+        uint64_t length = (command >> 2) + 1;
+        if (length > self->target_size - output) {
+            return PATCH_ERROR;
+        }
+        switch (command & 3) {
+        case BPS_SOURCE_READ:
+            if (output + length > self->source_size) {
+                return PATCH_ERROR;
+            }
+            break;
+        case BPS_TARGET_READ:
+            if (length > self->end - pos) {
+                return PATCH_ERROR;
+            }
+            if (write && writeFileAt(self->fd, (size_t)output, self->patch + pos, (size_t)length) != 0) {
+                return PATCH_ERROR;
+            }
+            pos += (size_t)length;
+            break;
+        case BPS_SOURCE_COPY:
+        case BPS_TARGET_COPY: {
+            uint64_t distance;
+            if (read_varint(self->patch, self->end, &pos, &distance) != 0) {
+                return PATCH_ERROR;
+            }
+            int source = ((command & 3) == BPS_SOURCE_COPY);
+            uint64_t *relative = source ? &sourceRelative : &targetRelative;
+            uint64_t delta = distance >> 1;
+            if ((distance & 1) ? delta > *relative : delta > UINT64_MAX - *relative) {
+                return PATCH_ERROR;
+            }
+            uint64_t from = (distance & 1) ? *relative - delta : *relative + delta;
+            if (source) {
+                if (from > self->source_size || length > self->source_size - from) {
+                    return PATCH_ERROR;
+                }
+                if (!write && from != output) { // Kopie an dieselbe Stelle kostet nichts
+                    if (self->move_count == moveCapacity) {
+                        moveCapacity = moveCapacity ? moveCapacity * 2 : 16;
+                        PatchMove *moves = (PatchMove *)realloc(self->moves,
+                                                                moveCapacity * sizeof(*moves));
+                        if (!moves) {
+                            fatal_error("patch_apply", "out of memory");
+                        }
+                        self->moves = moves;
+                    }
+                    self->moves[self->move_count++] =
+                        (PatchMove){(size_t)output, (size_t)from, (size_t)length, NULL, 0};
+                }
+            } else {
+                if (from >= output) {
+                    return PATCH_ERROR; // Ziel darf nur Geschriebenes kopieren
+                }
+                // in Schritten höchstens des Abstands, damit jeder Schritt nur fertige Bytes liest
+                size_t step = (size_t)(output - from);
+                for (uint64_t done = 0; write && done < length;) {
+                    size_t count = (size_t)(length - done);
+                    count = (count < step) ? count : step;
+                    count = (count < PATCH_CHUNK) ? count : PATCH_CHUNK;
+                    if (readFileAt(self->fd, (size_t)(from + done), self->chunk, count) !=
+                            (long long)count ||
+                        writeFileAt(self->fd, (size_t)(output + done), self->chunk, count) != 0) {
+                        return PATCH_ERROR;
+                    }
+                    done += count;
+                }
+            }
+            *relative = from + length;
+            break;
+        }
+        }
+        output += length;
+    }
+    return (output == self->target_size) ? 0 : PATCH_ERROR;
+}
+
+/**
+ * @brief Führt alle Verschiebungen aus, ohne eine noch benötigte Quelle zu überschreiben.
+ *
+ * Eine Verschiebung ist frei, wenn ihr Ziel keine Quelle einer anderen
+ * offenen Verschiebung trifft. Gibt es keine freie mehr, liegen die
+ * übrigen im Kreis (etwa zwei vertauschte Blöcke); dann wird die
+ * kleinste in den Speicher gelesen und blockiert danach keine andere.
+ */
+static int run_moves(BpsApply *self) {
+    size_t open = self->move_count;
+    while (open > 0) {
+        int progress = 0;
+        for (size_t i = 0; i < self->move_count; i++) {
+            PatchMove *move = &self->moves[i];
+            if (move->done) {
+                continue;
+            }
+            int blocked = 0;
+            for (size_t j = 0; j < self->move_count && !blocked; j++) {
+                const PatchMove *other = &self->moves[j];
+                blocked = (j != i && !other->done && !other->held &&
+                           overlaps(move->target, move->length, other->source, other->length));
+            }
+            if (blocked) {
+                continue;
+            }
+            int result = move->held
+                             ? writeFileAt(self->fd, move->target, move->held, move->length)
+                             : copy_within(self->fd, move->target, move->source, move->length,
+                                           self->chunk);
+            if (result != 0) {
+                return PATCH_ERROR;
+            }
+            move->done = 1;
+            open--;
+            progress = 1;
+        }
+        if (progress) {
+            continue;
+        }
+        PatchMove *smallest = NULL;
+        for (size_t i = 0; i < self->move_count; i++) {
+            PatchMove *move = &self->moves[i];
+            if (!move->done && !move->held && (!smallest || move->length < smallest->length)) {
+                smallest = move;
+            }
+        }
+        smallest->held = (unsigned char *)malloc(smallest->length);
+        if (!smallest->held) {
+            return PATCH_ERROR;
+        }
+        if (readFileAt(self->fd, smallest->source, smallest->held, smallest->length) !=
+            (long long)smallest->length) {
+            return PATCH_ERROR;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Kopiert einen Bereich innerhalb einer Datei, auch bei Überlappung.
+ *
+ * Wie bei `memmove` wird nach hinten vom Ende her kopiert.
+ */
+static int copy_within(int fd, size_t target, size_t source, size_t length, unsigned char *chunk) {
+    int backward = (target > source);
+    for (size_t done = 0; done < length;) {
+        size_t count = (length - done < PATCH_CHUNK) ? length - done : PATCH_CHUNK;
+        size_t skip = backward ? length - done - count : done;
+        if (readFileAt(fd, source + skip, chunk, count) != (long long)count ||
+            writeFileAt(fd, target + skip, chunk, count) != 0) {
+            return -1;
+        }
+        done += count;
+    }
+    return 0;
+}
+
+/**
+ * @brief Füllt einen Bereich mit einem Bytewert.
+ */
+static int fill_range(int fd, size_t offset, size_t length, unsigned char value) {
+    unsigned char block[4096];
+    memset(block, value, sizeof(block));
+    for (size_t done = 0; done < length;) {
+        size_t count = (length - done < sizeof(block)) ? length - done : sizeof(block);
+        if (writeFileAt(fd, offset + done, block, count) != 0) {
+            return -1;
+        }
+        done += count;
+    }
+    return 0;
+}
+
+/**
+ * @brief Liest eine Zahl in der BPS-Kodierung.
+ * @return 0 bei Erfolg, -1 bei abgeschnittener oder zu großer Zahl
+ */
+static int read_varint(const unsigned char *patch, size_t end, size_t *pos, uint64_t *out) {
+    uint64_t value = 0;
+    uint64_t shift = 1;
+    while (*pos < end) {
+        unsigned char bits = patch[(*pos)++];
+        value += (uint64_t)(bits & 0x7F) * shift;
+        if (bits & 0x80) {
+            *out = value;
+            return 0;
+        }
+        if (shift > (UINT64_MAX >> 14)) {
+            return -1;
+        }
+        shift <<= 7;
+        value += shift;
+    }
+    return -1;
+}
+
+/**
+ * @brief Liest eine Zahl der Liste.
+ * @param base 16 = hexadezimal mit optionalem `0x`, 0 = dezimal oder mit `0x`
+ * @return 0 bei Erfolg, -1 ohne Ziffern oder bei Überlauf
+ */
+static int read_number(const unsigned char **pos, const unsigned char *end, int base,
+                       uint64_t *out) {
+    const unsigned char *at = *pos;
+    if (end - at > 2 && at[0] == '0' && (at[1] == 'x' || at[1] == 'X')) {
+        at += 2;
+        base = 16;
+    }
+    if (base == 0) {
+        base = 10;
+    }
+    uint64_t value = 0;
+    const unsigned char *first = at;
+    for (; at < end; at++) {
+        int digit = hex_value(*at);
+        if (digit < 0 || digit >= base) {
+            break;
+        }
+        if (value > (UINT64_MAX - (uint64_t)digit) / (uint64_t)base) {
+            return -1;
+        }
+        value = value * (uint64_t)base + (uint64_t)digit;
+    }
+    if (at == first) {
+        return -1;
+    }
+    *pos = at;
+    *out = value;
+    return 0;
+}
+
+/**
+ * @brief Wert einer Hex-Ziffer oder -1.
+ */
+static int hex_value(int ch) {
+    if (ch >= '0' && ch <= '9') {
+        return ch - '0';
+    }
+    if (ch >= 'a' && ch <= 'f') {
+        return ch - 'a' + 10;
+    }
+    if (ch >= 'A' && ch <= 'F') {
+        return ch - 'A' + 10;
+    }
+    return -1;
+}
+
+/**
+ * @brief Prüft, ob sich zwei Bereiche überschneiden.
+ */
+static int overlaps(size_t a, size_t aLength, size_t b, size_t bLength) {
+    return a < b + bLength && b < a + aLength;
+}
+
+//* ----------------------------------- Init und Deinit -----------------------------------
@@ -0,0 +1,71 @@
+#ifndef PATCH_FILE_H
+#define PATCH_FILE_H
+
+/**
+ * @file Patch_File.h
+ * @brief Schnittstelle für Patches im IPS-, BPS- und Listenformat.
+ *
+ * Der Export beschreibt, wie aus der Datei auf dem Datenträger der
+ * aktuelle Inhalt eines `DataBuffer` wird. Das Anwenden läuft ohne
+ * Oberfläche und schreibt nur die Bereiche, die der Patch berührt,
+ * an Ort und Stelle in die Zieldatei; deren übrige Bytes werden weder
+ * gelesen noch geladen.
+ */
+
+#include "Data_Buffer.h" // Inhalt und Änderungen des Exports
+
+//* ---------------------------- Globale Konstanten oder Defines --------------------------
+#define PATCH_ERROR -1       /**< Lese- oder Schreibfehler, ungültiger Patch */
+#define PATCH_UNSUPPORTED -2 /**< Änderungen im Format nicht darstellbar oder Ziel passt nicht */
+
+//* ------------------------------------- Strukturen --------------------------------------
+/**
+ * @brief Patchformat.
+ */
+typedef enum {
+    PATCH_IPS,         /**< IPS: überschriebene Bereiche bis 16 MiB, Kürzen als Erweiterung */
+    PATCH_BPS,         /**< BPS: Kopier- und Datenbefehle, auch für Einfügen und Löschen */
+    PATCH_LIST,        /**< Textliste `offset: hexbytes`, `size: n` bei neuer Größe */
+    PATCH_FORMAT_COUNT /**< Anzahl der Formate */
+} PatchFormat;
+
+//* ------------------------------------- Funktionen --------------------------------------
+/**
+ * @brief Übersetzt einen Formatnamen (`ips`, `bps`, `list`).
+ * @return 0 bei Erfolg, -1 bei unbekanntem Namen
+ */
+int patch_format_parse(const char *name, PatchFormat *out);
+
+/**
+ * @brief Wählt das Format nach der Dateiendung, ohne bekannte Endung die Liste.
+ */
+PatchFormat patch_format_for_path(const char *path);
+
+/**
+ * @brief Schreibt die Änderungen seit dem Laden oder Speichern als Patch.
+ *
+ * Ohne Einfügen und Löschen sind das die geänderten Bytes. Sonst wird
+ * der Stückbaum gegen die geladene Datei verglichen; das ist nur
+ * möglich, solange seitdem nicht gespeichert wurde.
+ *
+ * @param buffer   bearbeiteter Inhalt
+ * @param basePath Datei, auf die der Patch passen soll
+ * @param path     Ziel des Patches, wird absturzsicher ersetzt
+ * @param format   Patchformat
+ * @return 0 bei Erfolg, `PATCH_ERROR` oder `PATCH_UNSUPPORTED`
+ */
+int patch_export(const DataBuffer *buffer, const char *basePath, const char *path,
+                 PatchFormat format);
+
+/**
+ * @brief Wendet einen Patch an Ort und Stelle auf eine Datei an.
+ *
+ * Das Format wird am Inhalt erkannt. Läuft ohne ncurses.
+ *
+ * @param patchPath  Patchdatei
+ * @param targetPath zu ändernde Datei
+ * @return 0 bei Erfolg, `PATCH_ERROR` oder `PATCH_UNSUPPORTED`
+ */
+int patch_apply(const char *patchPath, const char *targetPath);
+
+#endif // PATCH_FILE_H
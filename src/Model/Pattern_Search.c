@@ -0,0 +1,420 @@
+/**
+ * @file Pattern_Search.c
+ * @brief Mustersuche im Daten-Buffer.
+ *
+ * Die Startpositionen werden in Abschnitte von `PATTERN_SEARCH_SEGMENT`
+ * geteilt, die in Suchrichtung der Reihe nach an die Threads vergeben
+ * werden. Jeder Thread liest seinen Abschnitt samt der folgenden
+ * `length - 1` Bytes, damit auch Treffer über die Abschnittsgrenze
+ * hinweg vollständig geprüft werden. Innerhalb eines Abschnitts findet
+ * `byte_scan_find` Kandidaten anhand der beiden seltensten Bytes, erst
+ * diese werden mit dem ganzen Muster verglichen. Weil Abschnitte nur
+ * in Suchrichtung vergeben werden, sind beim ersten Fund alle davor
+ * liegenden bereits in Arbeit; spätere werden nicht mehr begonnen.
+ */
+
+//* -------------------------------------- Includes ---------------------------------------
+#include "Pattern_Search.h" // Schnittstelle dieses Moduls
+#include <ctype.h>           // isxdigit, isalpha und isspace
+#include <stdint.h>          // SIZE_MAX
+#include <stdlib.h>          // malloc und free
+#include <string.h>          // memset
+#ifndef _WIN32
+#include <pthread.h>         // Such-Threads und Sperre
+#include <unistd.h>          // sysconf für die Anzahl der Prozessoren
+#endif
+#include "Err_Log.h"        // Fehlerbehandlung
+
+//* ---------------------------- Globale Konstanten oder Defines --------------------------
+#define CASE_FOLD_MASK 0xDF /**< ohne das Bit, in dem sich ASCII-Groß- und Kleinbuchstaben unterscheiden */
+
+/**
+ * @brief Gemeinsamer Auftrag aller Such-Threads.
+ */
+typedef struct {
+    const DataBuffer *buffer;       /**< durchsuchter Buffer */
+    const SearchPattern *pattern;   /**< Muster */
+    size_t first;                   /**< erste Startposition */
+    size_t last;                    /**< hinter der letzten Startposition */
+    size_t segments;                /**< Anzahl der Abschnitte */
+    int backward;                   /**< 1 = letzter Treffer gesucht */
+#ifndef _WIN32
+    pthread_mutex_t lock;           /**< schützt die folgenden Felder */
+#endif
+    size_t next_segment;            /**< nächster Abschnitt in Suchrichtung */
+    size_t hit_segment;             /**< Abschnitt des besten Treffers, sonst SIZE_MAX */
+    size_t hit;                     /**< Position des besten Treffers */
+} SearchJob;
+
+// Vorwärtsdeklarationen der Helferfunktionen
+static int parse_hex(SearchPattern *self, const char *text);
+static int parse_text(SearchPattern *self, const char *text, int fold);
+static int nibble_value(char c, unsigned char *value, unsigned char *mask);
+static int commonness(unsigned char value, unsigned char mask);
+static void choose_probes(SearchPattern *self);
+static int matches(const SearchPattern *self, const unsigned char *data);
+static int scan_block(const SearchPattern *self, const unsigned char *data, size_t count,
+                      int backward, size_t *out);
+static int search_range(const DataBuffer *buffer, const SearchPattern *pattern, size_t first,
+                        size_t last, int backward, size_t *out);
+static int claim_segment(SearchJob *job, size_t *outSegment);
+static void report_hit(SearchJob *job, size_t segment, size_t hit);
+static void *worker(void *context);
+#ifndef _WIN32
+static int thread_count(const SearchJob *job);
+#endif
+
+//* ------------------------------------- Funktionen --------------------------------------
+/**
+ * @brief Übersetzt die Eingabe in ein Suchmuster.
+ *
+ * @param self Zeiger auf das Muster
+ * @param text Eingabe als Hex-Muster, `"Text` oder `i"Text`
+ * @return 0 bei Erfolg, -1 bei ungültiger oder leerer Eingabe
+ */
+int pattern_search_parse(SearchPattern *self, const char *text) {
+    memset(self, 0, sizeof(*self));
+    while (isspace((unsigned char)*text)) {
+        text++;
+    }
+    int result;
+    if (text[0] == '"') {
+        result = parse_text(self, text + 1, 0);
+    } else if ((text[0] == 'i' || text[0] == 'I') && text[1] == '"') {
+        result = parse_text(self, text + 2, 1);
+    } else {
+        result = parse_hex(self, text);
+    }
+    if (result != 0 || self->length == 0) {
+        return -1;
+    }
+    choose_probes(self);
+    return 0;
+}
+
+/**
+ * @brief Sucht den ersten Treffer, der ab `from` beginnt.
+ */
+int pattern_search_next(const DataBuffer *buffer, const SearchPattern *pattern, size_t from,
+                        size_t *out) {
+    if (pattern->length > buffer->size) {
+        return -1;
+    }
+    return search_range(buffer, pattern, from, buffer->size - pattern->length + 1, 0, out);
+}
+
+/**
+ * @brief Sucht den letzten Treffer, der vor `before` beginnt.
+ */
+int pattern_search_prev(const DataBuffer *buffer, const SearchPattern *pattern, size_t before,
+                        size_t *out) {
+    if (pattern->length > buffer->size) {
+        return -1;
+    }
+    size_t last = buffer->size - pattern->length + 1;
+    return search_range(buffer, pattern, 0, (before < last) ? before : last, 1, out);
+}
+
+//* ---------------------------------- Helfer Funktionen ----------------------------------
+/** @brief Liest Ziffernpaare mit `?` als Platzhalter für ein Nibble. */
+static int parse_hex(SearchPattern *self, const char *text) {
+    int high = 1; // nächstes Nibble ist das obere
+    for (; *text; text++) {
+        if (isspace((unsigned char)*text)) {
+            continue;
+        }
+        unsigned char value;
+        unsigned char mask;
+        if (nibble_value(*text, &value, &mask) != 0) {
+            return -1;
+        }
+        if (high) {
+            if (self->length == SEARCH_PATTERN_MAX) {
+                return -1; // Muster zu lang
+            }
+            self->bytes[self->length] = (unsigned char)(value << 4);
+            self->masks[self->length] = (unsigned char)(mask << 4);
+        } else {
+            self->bytes[self->length] |= value;
+            self->masks[self->length] |= mask;
+            self->length++;
+        }
+        high = !high;
+    }
+    return high ? 0 : -1; // halbes Byte am Ende
+}
+
+/** @brief Übernimmt Text bis zum optionalen schließenden `"`. */
+static int parse_text(SearchPattern *self, const char *text, int fold) {
+    size_t length = strlen(text);
+    if (length > 0 && text[length - 1] == '"') {
+        length--;
+    }
+    if (length > SEARCH_PATTERN_MAX) {
+        return -1;
+    }
+    for (size_t i = 0; i < length; i++) {
+        unsigned char c = (unsigned char)text[i];
+        unsigned char mask = (fold && c < 0x80 && isalpha(c)) ? CASE_FOLD_MASK : 0xFF;
+        self->bytes[i] = c & mask;
+        self->masks[i] = mask;
+    }
+    self->length = length;
+    return 0;
+}
+
+/** @brief Wert und Maske eines Nibbles, `?` passt auf jeden Wert. */
+static int nibble_value(char c, unsigned char *value, unsigned char *mask) {
+    if (c == '?') {
+        *value = 0;
+        *mask = 0;
+        return 0;
+    }
+    if (!isxdigit((unsigned char)c)) {
+        return -1;
+    }
+    *value = (unsigned char)(isdigit((unsigned char)c) ? c - '0' : (tolower((unsigned char)c) - 'a' + 10));
+    *mask = 0x0F;
+    return 0;
+}
+
+/**
+ * @brief Schätzt, wie häufig ein Byte in typischen Dateien vorkommt.
+ *
+ * Nullbytes, Füllbytes und Kleinbuchstaben sind häufig, Bytes oberhalb
+ * von 0x7F selten. Jedes offene Bit verdoppelt die passenden Werte.
+ *
+ * @return kleiner = seltener
+ */
+static int commonness(unsigned char value, unsigned char mask) {
+    int base;
+    if (value == 0x00) {
+        base = 8;
+    } else if (value == 0xFF) {
+        base = 6;
+    } else if (value == ' ' || (value >= 'a' && value <= 'z')) {
+        base = 5;
+    } else if (value >= 0x21 && value < 0x7F) {
+        base = 4;
+    } else if (value < 0x20) {
+        base = 3;
+    } else {
+        base = 2;
+    }
+    int open = 8 - __builtin_popcount(mask);
+    return base + 2 * open;
+}
+
+/**
+ * @brief Wählt die beiden voraussichtlich seltensten Bytes als Vorfilter.
+ *
+ * Besteht das Muster nur aus Platzhaltern, passen die Proben überall.
+ */
+static void choose_probes(SearchPattern *self) {
+    size_t best[2] = { SIZE_MAX, SIZE_MAX };
+    int score[2] = { 0, 0 };
+    for (size_t i = 0; i < self->length; i++) {
+        if (self->masks[i] == 0) {
+            continue;
+        }
+        int current = commonness(self->bytes[i], self->masks[i]);
+        if (best[0] == SIZE_MAX || current < score[0]) {
+            best[1] = best[0];
+            score[1] = score[0];
+            best[0] = i;
+            score[0] = current;
+        } else if (best[1] == SIZE_MAX || current < score[1]) {
+            best[1] = i;
+            score[1] = current;
+        }
+    }
+    if (best[1] == SIZE_MAX) {
+        best[1] = best[0]; // nur ein verglichenes Byte
+    }
+    for (int k = 0; k < 2; k++) {
+        ByteProbe *probe = &self->probes[k];
+        if (best[k] == SIZE_MAX) {
+            probe->offset = 0;
+            probe->mask = 0;
+            probe->value = 0;
+        } else {
+            probe->offset = best[k];
+            probe->mask = self->masks[best[k]];
+            probe->value = self->bytes[best[k]];
+        }
+    }
+}
+
+/** @brief Vergleicht das ganze Muster ab `data`. */
+static int matches(const SearchPattern *self, const unsigned char *data) {
+    for (size_t i = 0; i < self->length; i++) {
+        if ((data[i] & self->masks[i]) != self->bytes[i]) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * @brief Sucht in einem gelesenen Block den ersten bzw. letzten Treffer.
+ *
+ * `data` enthält `count + length - 1` Bytes.
+ *
+ * @return 1 bei einem Treffer, sonst 0
+ */
+static int scan_block(const SearchPattern *self, const unsigned char *data, size_t count,
+                      int backward, size_t *out) {
+    int found = 0;
+    size_t pos = 0;
+    while (pos < count) {
+        size_t candidate = pos + byte_scan_find(data + pos, count - pos, &self->probes[0],
+                                                &self->probes[1]);
+        if (candidate >= count) {
+            break;
+        }
+        if (matches(self, data + candidate)) {
+            *out = candidate;
+            found = 1;
+            if (!backward) {
+                break; // der erste genügt
+            }
+        }
+        pos = candidate + 1;
+    }
+    return found;
+}
+
+/**
+ * @brief Durchsucht die Startpositionen `[first, last)` mit mehreren Threads.
+ *
+ * Liefert die Quelle nicht aus mehreren Threads zugleich, oder ist der
+ * Bereich kleiner als zwei Abschnitte, sucht der aufrufende Thread
+ * allein.
+ */
+static int search_range(const DataBuffer *buffer, const SearchPattern *pattern, size_t first,
+                        size_t last, int backward, size_t *out) {
+    if (first >= last) {
+        return -1;
+    }
+    SearchJob job;
+    memset(&job, 0, sizeof(job));
+    job.buffer = buffer;
+    job.pattern = pattern;
+    job.first = first;
+    job.last = last;
+    job.segments = (last - first + PATTERN_SEARCH_SEGMENT - 1) / PATTERN_SEARCH_SEGMENT;
+    job.backward = backward;
+    job.hit_segment = SIZE_MAX;
+
+#ifndef _WIN32
+    pthread_mutex_init(&job.lock, NULL);
+    byte_scan_prepare(); // Variante wählen, bevor die Threads sie lesen
+    pthread_t threads[PATTERN_SEARCH_THREADS];
+    int started = 0;
+    int wanted = thread_count(&job);
+    for (int i = 1; i < wanted; i++) { // der aufrufende Thread sucht mit
+        if (pthread_create(&threads[started], NULL, worker, &job) != 0) {
+            break;
+        }
+        started++;
+    }
+    worker(&job);
+    for (int i = 0; i < started; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    pthread_mutex_destroy(&job.lock);
+#else
+    worker(&job);
+#endif
+
+    if (job.hit_segment == SIZE_MAX) {
+        return -1;
+    }
+    *out = job.hit;
+    return 0;
+}
+
+/**
+ * @brief Vergibt den nächsten Abschnitt in Suchrichtung.
+ * @return 1 wenn ein Abschnitt vergeben wurde, 0 wenn keiner mehr nötig ist
+ */
+static int claim_segment(SearchJob *job, size_t *outSegment) {
+#ifndef _WIN32
+    pthread_mutex_lock(&job->lock);
+#endif
+    size_t order = job->next_segment;
+    int claimed = order < job->segments && order < job->hit_segment;
+    if (claimed) {
+        job->next_segment++;
+    }
+#ifndef _WIN32
+    pthread_mutex_unlock(&job->lock);
+#endif
+    *outSegment = order;
+    return claimed;
+}
+
+/** @brief Merkt einen Treffer, wenn er in Suchrichtung vor dem bisher besten liegt. */
+static void report_hit(SearchJob *job, size_t segment, size_t hit) {
+#ifndef _WIN32
+    pthread_mutex_lock(&job->lock);
+#endif
+    if (segment < job->hit_segment) {
+        job->hit_segment = segment;
+        job->hit = hit;
+    }
+#ifndef _WIN32
+    pthread_mutex_unlock(&job->lock);
+#endif
+}
+
+/**
+ * @brief Liest und durchsucht Abschnitte, bis keiner mehr nötig ist.
+ */
+static void *worker(void *context) {
+    SearchJob *job = (SearchJob *)context;
+    size_t overlap = job->pattern->length - 1; // Treffer über die Abschnittsgrenze
+    unsigned char *block = (unsigned char *)malloc(PATTERN_SEARCH_SEGMENT + overlap);
+    if (!block) {
+        fatal_error("pattern_search", "out of memory");
+    }
+    size_t order;
+    while (claim_segment(job, &order)) {
+        size_t index = job->backward ? job->segments - 1 - order : order;
+        size_t start = job->first + index * PATTERN_SEARCH_SEGMENT;
+        size_t count = job->last - start;
+        if (count > PATTERN_SEARCH_SEGMENT) {
+            count = PATTERN_SEARCH_SEGMENT;
+        }
+        data_buffer_get_range(job->buffer, start, start + count + overlap, block);
+        size_t hit;
+        if (scan_block(job->pattern, block, count, job->backward, &hit)) {
+            report_hit(job, order, start + hit);
+        }
+    }
+    free(block);
+    return NULL;
+}
+
+#ifndef _WIN32
+/** @brief Anzahl der Threads für einen Auftrag, den aufrufenden eingeschlossen. */
+static int thread_count(const SearchJob *job) {
+    if (job->segments < 2 || !data_buffer_reads_concurrently(job->buffer)) {
+        return 1;
+    }
+    long online = 1;
+#ifdef _SC_NPROCESSORS_ONLN
+    online = sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+    if (online < 1) {
+        online = 1;
+    }
+    if (online > PATTERN_SEARCH_THREADS) {
+        online = PATTERN_SEARCH_THREADS;
+    }
+    if ((size_t)online > job->segments) {
+        online = (long)job->segments;
+    }
+    return (int)online;
+}
+#endif
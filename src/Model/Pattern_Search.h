@@ -0,0 +1,77 @@
+#ifndef PATTERN_SEARCH_H
+#define PATTERN_SEARCH_H
+
+/**
+ * @file Pattern_Search.h
+ * @brief Schnittstelle der Mustersuche im Daten-Buffer.
+ *
+ * Ein Muster ist eine Folge von Bytes, von denen jedes nur in den Bits
+ * seiner Maske verglichen wird. So lassen sich Platzhalter für ganze
+ * Bytes oder einzelne Nibbles ebenso ausdrücken wie Text ohne
+ * Unterscheidung von Groß- und Kleinschreibung. Gesucht wird in
+ * Abschnitten, die auf mehrere Threads verteilt werden.
+ */
+
+#include <stddef.h>       // stellt den Typ size_t bereit
+#include "Byte_Scan.h"   // Vorfilter für Kandidaten
+#include "Data_Buffer.h" // durchsuchter Inhalt
+
+//* ---------------------------- Globale Konstanten oder Defines --------------------------
+#define SEARCH_PATTERN_MAX 256           /**< längstes Muster in Bytes */
+#define PATTERN_SEARCH_SEGMENT (1u << 20) /**< Startpositionen je Arbeitsauftrag */
+#define PATTERN_SEARCH_THREADS 8         /**< höchstens so viele Such-Threads */
+
+//* ------------------------------------- Strukturen --------------------------------------
+/**
+ * @brief Übersetztes Suchmuster.
+ *
+ * Ein Byte passt, wenn `(byte & masks[i]) == bytes[i]`. Die beiden
+ * Proben sind die voraussichtlich seltensten Bytes des Musters und
+ * dienen dem vektorisierten Vorfilter.
+ */
+typedef struct {
+    unsigned char bytes[SEARCH_PATTERN_MAX]; /**< erwartete Bits je Byte */
+    unsigned char masks[SEARCH_PATTERN_MAX]; /**< verglichene Bits je Byte, 0 = Platzhalter */
+    size_t length;                           /**< Länge des Musters */
+    ByteProbe probes[2];                     /**< Bedingungen für den Vorfilter */
+} SearchPattern;
+
+//* ------------------------------------- Funktionen --------------------------------------
+/**
+ * @brief Übersetzt die Eingabe in ein Suchmuster.
+ *
+ * Hex-Muster bestehen aus Ziffernpaaren, Leerzeichen werden ignoriert;
+ * `?` steht für ein beliebiges Nibble, `??` also für ein beliebiges
+ * Byte (z. B. `4D 5A ?? 0?`). Beginnt die Eingabe mit `"`, wird der
+ * folgende Text gesucht, mit `i"` ohne Unterscheidung von Groß- und
+ * Kleinschreibung. Ein schließendes `"` ist optional.
+ *
+ * @param self Zeiger auf das Muster
+ * @param text Eingabe
+ * @return 0 bei Erfolg, -1 bei ungültiger oder leerer Eingabe
+ */
+int pattern_search_parse(SearchPattern *self, const char *text);
+
+/**
+ * @brief Sucht den ersten Treffer, der ab `from` beginnt.
+ * @param buffer  durchsuchter Buffer
+ * @param pattern Muster
+ * @param from    erste mögliche Startposition
+ * @param out     erhält die Startposition des Treffers
+ * @return 0 bei Erfolg, -1 wenn es keinen Treffer gibt
+ */
+int pattern_search_next(const DataBuffer *buffer, const SearchPattern *pattern, size_t from,
+                        size_t *out);
+
+/**
+ * @brief Sucht den letzten Treffer, der vor `before` beginnt.
+ * @param buffer  durchsuchter Buffer
+ * @param pattern Muster
+ * @param before  Startpositionen ab hier zählen nicht mehr
+ * @param out     erhält die Startposition des Treffers
+ * @return 0 bei Erfolg, -1 wenn es keinen Treffer gibt
+ */
+int pattern_search_prev(const DataBuffer *buffer, const SearchPattern *pattern, size_t before,
+                        size_t *out);
+
+#endif // PATTERN_SEARCH_H
@@ -0,0 +1,535 @@
+/**
+ * @file Piece_Table.c
+ * @brief Implementierung der Piece-Table.
+ *
+ * Der Stückbaum ist als Treap umgesetzt: Die Reihenfolge der Knoten
+ * entspricht der Reihenfolge im Inhalt, die Zufallsprioritäten halten
+ * den Baum im Erwartungswert balanciert. Alle Änderungen werden auf
+ * die zwei Grundoperationen Teilen (`split`) und Verbinden (`merge`)
+ * zurückgeführt. Neue Bytes werden nur an den Anhang-Buffer angehängt,
+ * bestehende Stücke bleiben unverändert und können daher gefahrlos
+ * von Clips mitbenutzt werden.
+ */
+
+//* -------------------------------------- Includes ---------------------------------------
+#include "Piece_Table.h"   // Schnittstelle dieses Moduls
+#include <stdlib.h>         // malloc, realloc und free
+#include <string.h>         // memcpy und memset
+#include "Err_Log.h"       // fatale Fehler bei Speichermangel
+
+//* ---------------------------- Globale Konstanten oder Defines --------------------------
+#define ADD_BUFFER_MIN_CAPACITY 4096 // Startgröße des Anhang-Buffers
+
+// Vorwärtsdeklarationen der Helferfunktionen
+static PieceNode *new_node(PieceTable *self, PieceKind kind, size_t start, size_t length);
+static void update(PieceNode *node);
+static PieceNode *merge(PieceNode *left, PieceNode *right);
+static void split(PieceTable *self, PieceNode *node, size_t offset, PieceNode **left,
+                  PieceNode **right);
+static void read_tree(const PieceTable *self, const PieceNode *node, size_t offset,
+                      unsigned char *dest, size_t length);
+static void copy_piece(const PieceTable *self, const PieceNode *node, size_t offset,
+                       unsigned char *dest, size_t length);
+static size_t append_add(PieceTable *self, const unsigned char *bytes, size_t length);
+static int extend_last(PieceNode *node, PieceKind kind, size_t start, size_t length);
+static PieceNode *clone_tree(const PieceNode *node);
+static int visit_tree(const PieceNode *node, PieceVisitor visitor, void *context);
+static int visit_range(const PieceNode *node, size_t offset, size_t length,
+                       PieceRangeVisitor visitor, void *context);
+static void free_tree(PieceNode *node);
+
+//* ------------------------------------- Funktionen --------------------------------------
+/**
+ * @brief Liefert ein einzelnes Byte.
+ * @param self   Zeiger auf die Piece-Table
+ * @param offset Position im Inhalt
+ * @return Wert des Bytes oder 0 außerhalb des Inhalts
+ */
+unsigned char piece_table_get_byte(const PieceTable *self, size_t offset) {
+    const PieceNode *node = self->root;
+    while (node) { // Baum entlang der Teilbaumlängen absteigen
+        size_t leftTotal = node->left ? node->left->total : 0;
+        if (offset < leftTotal) {
+            node = node->left;
+        } else if (offset < leftTotal + node->length) {
+            unsigned char value = 0;
+            copy_piece(self, node, offset - leftTotal, &value, 1); // Byte aus dem Stück
+            return value;
+        } else {
+            offset -= leftTotal + node->length;
+            node = node->right;
+        }
+    }
+    return 0; // außerhalb des Inhalts
+}
+
+/**
+ * @brief Kopiert einen Bereich in einen externen Buffer.
+ * @param self   Zeiger auf die Piece-Table
+ * @param offset Startposition
+ * @param dest   Ziel-Buffer
+ * @param length Anzahl der Bytes, muss im Inhalt liegen
+ */
+void piece_table_read(const PieceTable *self, size_t offset, unsigned char *dest,
+                      size_t length) {
+    read_tree(self, self->root, offset, dest, length);
+}
+
+/**
+ * @brief Besucht alle Stücke in Inhaltsreihenfolge.
+ *
+ * Damit lassen sich z. B. beim Speichern unveränderte Originalbereiche
+ * erkennen und gesondert behandeln.
+ *
+ * @param self    Zeiger auf die Piece-Table
+ * @param visitor Funktion, die für jedes Stück aufgerufen wird
+ * @param context Zeiger, der unverändert an den Visitor geht
+ * @return 0 oder der Rückgabewert des abbrechenden Visitors
+ */
+int piece_table_for_each(const PieceTable *self, PieceVisitor visitor, void *context) {
+    return visit_tree(self->root, visitor, context);
+}
+
+/**
+ * @brief Besucht die Stücke, die einen Bereich überdecken.
+ *
+ * Im Gegensatz zu `piece_table_for_each` werden nur die betroffenen
+ * Teilbäume besucht, der Aufwand hängt also nicht von der Gesamtzahl
+ * der Stücke ab.
+ *
+ * @param self    Zeiger auf die Piece-Table
+ * @param offset  Beginn des Bereichs
+ * @param length  Länge des Bereichs
+ * @param visitor Funktion, die für jeden Stückabschnitt aufgerufen wird
+ * @param context Zeiger, der unverändert an den Visitor geht
+ * @return 0 oder der Rückgabewert des abbrechenden Visitors
+ */
+int piece_table_for_range(const PieceTable *self, size_t offset, size_t length,
+                          PieceRangeVisitor visitor, void *context) {
+    size_t total = piece_table_length(self);
+    if (offset >= total) {
+        return 0;
+    }
+    if (length > total - offset) {
+        length = total - offset; // auf das Inhaltsende begrenzen
+    }
+    return visit_range(self->root, offset, length, visitor, context);
+}
+
+/**
+ * @brief Fügt Bytes an einer Position ein.
+ *
+ * Schließt das vorherige Stück direkt an das Ende des Anhang-Buffers an,
+ * wird es verlängert statt ein neues Stück anzulegen. Fortlaufendes
+ * Tippen erzeugt so nur ein einziges Stück.
+ *
+ * @param self   Zeiger auf die Piece-Table
+ * @param offset Einfügeposition (0 bis Länge)
+ * @param bytes  einzufügende Bytes
+ * @param length Anzahl der Bytes
+ */
+void piece_table_insert(PieceTable *self, size_t offset, const unsigned char *bytes,
+                        size_t length) {
+    if (length == 0) {
+        return; // nichts einzufügen
+    }
+    size_t addStart = append_add(self, bytes, length); // Bytes an den Anhang hängen
+
+    PieceNode *left;
+    PieceNode *right;
+    split(self, self->root, offset, &left, &right);     // an der Einfügeposition teilen
+    if (!extend_last(left, PIECE_ADD, addStart, length)) { // vorheriges Stück verlängern?
+        left = merge(left, new_node(self, PIECE_ADD, addStart, length));
+    }
+    self->root = merge(left, right);                    // wieder zusammensetzen
+}
+
+/**
+ * @brief Hängt einen Bereich der Originalquelle an das Inhaltsende.
+ *
+ * Wird von wachsenden Quellen genutzt, wenn neue Bytes eingetroffen
+ * sind. Schließt das letzte Stück direkt an, wird es nur verlängert.
+ *
+ * @param self   Zeiger auf die Piece-Table
+ * @param start  Startposition in der Quelle
+ * @param length Anzahl der Bytes
+ */
+void piece_table_append_original(PieceTable *self, size_t start, size_t length) {
+    if (length == 0) {
+        return; // nichts anzuhängen
+    }
+    if (!extend_last(self->root, PIECE_ORIGINAL, start, length)) {
+        self->root = merge(self->root, new_node(self, PIECE_ORIGINAL, start, length));
+    }
+}
+
+/**
+ * @brief Entfernt einen Bereich.
+ * @param self   Zeiger auf die Piece-Table
+ * @param offset Startposition
+ * @param length Anzahl der zu entfernenden Bytes
+ */
+void piece_table_erase(PieceTable *self, size_t offset, size_t length) {
+    PieceClip removed;
+    piece_table_cut(self, offset, length, &removed); // Bereich herauslösen
+    piece_clip_free(&removed);                      // und verwerfen
+}
+
+/**
+ * @brief Überschreibt einen Bereich mit neuen Bytes.
+ * @param self   Zeiger auf die Piece-Table
+ * @param offset Startposition
+ * @param bytes  neue Bytes
+ * @param length Anzahl der Bytes, muss im Inhalt liegen
+ */
+void piece_table_replace(PieceTable *self, size_t offset, const unsigned char *bytes,
+                         size_t length) {
+    piece_table_erase(self, offset, length);          // alte Bytes entfernen
+    piece_table_insert(self, offset, bytes, length);  // neue Bytes einsetzen
+}
+
+/**
+ * @brief Kopiert einen Bereich als Stückreferenzen in einen Clip.
+ *
+ * Es werden nur die Stückbeschreibungen dupliziert, nicht die Bytes.
+ *
+ * @param self   Zeiger auf die Piece-Table
+ * @param offset Startposition
+ * @param length Länge des Bereichs
+ * @param out    Ziel-Clip
+ */
+void piece_table_copy(PieceTable *self, size_t offset, size_t length, PieceClip *out) {
+    PieceNode *left;
+    PieceNode *middle;
+    PieceNode *right;
+    split(self, self->root, offset, &left, &middle);   // vor dem Bereich teilen
+    split(self, middle, length, &middle, &right);      // hinter dem Bereich teilen
+    out->root = clone_tree(middle);                    // Stücke duplizieren
+    out->length = middle ? middle->total : 0;
+    self->root = merge(merge(left, middle), right);    // Baum wiederherstellen
+}
+
+/**
+ * @brief Schneidet einen Bereich aus und übergibt ihn als Clip.
+ * @param self   Zeiger auf die Piece-Table
+ * @param offset Startposition
+ * @param length Länge des Bereichs
+ * @param out    Ziel-Clip
+ */
+void piece_table_cut(PieceTable *self, size_t offset, size_t length, PieceClip *out) {
+    PieceNode *left;
+    PieceNode *middle;
+    PieceNode *right;
+    split(self, self->root, offset, &left, &middle);   // vor dem Bereich teilen
+    split(self, middle, length, &middle, &right);      // hinter dem Bereich teilen
+    out->root = middle;                                // Stücke übernehmen
+    out->length = middle ? middle->total : 0;
+    self->root = merge(left, right);                   // Rest verbinden
+}
+
+/**
+ * @brief Fügt einen Clip an einer Position ein.
+ * @param self   Zeiger auf die Piece-Table
+ * @param offset Einfügeposition (0 bis Länge)
+ * @param clip   einzufügender Clip, bleibt unverändert
+ */
+void piece_table_paste(PieceTable *self, size_t offset, const PieceClip *clip) {
+    if (!clip->root) {
+        return; // leerer Clip
+    }
+    PieceNode *left;
+    PieceNode *right;
+    split(self, self->root, offset, &left, &right);
+    self->root = merge(merge(left, clone_tree(clip->root)), right);
+}
+
+/**
+ * @brief Gibt einen Clip frei.
+ * @param clip Zeiger auf den Clip
+ */
+void piece_clip_free(PieceClip *clip) {
+    free_tree(clip->root);
+    clip->root = NULL;
+    clip->length = 0;
+}
+
+//* ---------------------------------- Helfer Funktionen ----------------------------------
+/**
+ * @brief Legt einen neuen Knoten mit Zufallspriorität an.
+ */
+static PieceNode *new_node(PieceTable *self, PieceKind kind, size_t start, size_t length) {
+    PieceNode *node = (PieceNode *)malloc(sizeof(*node));
+    if (!node) {
+        fatal_error("piece_table", "out of memory");
+    }
+    // xorshift32 liefert ausreichend zufällige Prioritäten
+    self->seed ^= self->seed << 13;
+    self->seed ^= self->seed >> 17;
+    self->seed ^= self->seed << 5;
+    node->left = NULL;
+    node->right = NULL;
+    node->priority = self->seed;
+    node->kind = kind;
+    node->start = start;
+    node->length = length;
+    node->total = length;
+    return node;
+}
+
+/** @brief Berechnet die Teilbaumlänge eines Knotens neu. */
+static void update(PieceNode *node) {
+    node->total = node->length + (node->left ? node->left->total : 0) +
+                  (node->right ? node->right->total : 0);
+}
+
+/**
+ * @brief Verbindet zwei Bäume, alle Stücke von `left` liegen vor `right`.
+ */
+static PieceNode *merge(PieceNode *left, PieceNode *right) {
+    if (!left) {
+        return right;
+    }
+    if (!right) {
+        return left;
+    }
+    if (left->priority > right->priority) { // höhere Priorität wird Wurzel
+        left->right = merge(left->right, right);
+        update(left);
+        return left;
+    }
+    right->left = merge(left, right->left);
+    update(right);
+    return right;
+}
+
+/**
+ * @brief Teilt einen Baum so, dass `left` genau `offset` Bytes enthält.
+ *
+ * Ein Stück, das über die Teilungsstelle reicht, wird in zwei Stücke
+ * zerlegt.
+ */
+static void split(PieceTable *self, PieceNode *node, size_t offset, PieceNode **left,
+                  PieceNode **right) {
+    if (!node) {
+        *left = NULL;
+        *right = NULL;
+        return;
+    }
+    size_t leftTotal = node->left ? node->left->total : 0;
+    if (offset <= leftTotal) { // Teilungsstelle im linken Teilbaum
+        split(self, node->left, offset, left, &node->left);
+        update(node);
+        *right = node;
+    } else if (offset >= leftTotal + node->length) { // Teilungsstelle rechts
+        split(self, node->right, offset - leftTotal - node->length, &node->right, right);
+        update(node);
+        *left = node;
+    } else { // Teilungsstelle innerhalb dieses Stücks
+        size_t inner = offset - leftTotal;
+        PieceNode *tail = new_node(self, node->kind, node->start + inner, node->length - inner);
+        PieceNode *rest = node->right;
+        node->length = inner;  // vorderer Teil bleibt im Knoten
+        node->right = NULL;
+        update(node);
+        *left = node;
+        *right = merge(tail, rest); // hinterer Teil vor die restlichen Stücke
+    }
+}
+
+/**
+ * @brief Liest einen Bereich aus einem Teilbaum.
+ */
+static void read_tree(const PieceTable *self, const PieceNode *node, size_t offset,
+                      unsigned char *dest, size_t length) {
+    while (node && length > 0) {
+        size_t leftTotal = node->left ? node->left->total : 0;
+        if (offset < leftTotal) { // Anfang liegt im linken Teilbaum
+            size_t part = leftTotal - offset;
+            if (part > length) {
+                part = length;
+            }
+            read_tree(self, node->left, offset, dest, part);
+            dest += part;
+            offset += part;
+            length -= part;
+        }
+        offset -= leftTotal; // ab hier relativ zum aktuellen Stück
+        if (length > 0 && offset < node->length) {
+            size_t part = node->length - offset;
+            if (part > length) {
+                part = length;
+            }
+            copy_piece(self, node, offset, dest, part);
+            dest += part;
+            length -= part;
+            offset = node->length;
+        }
+        offset -= node->length; // relativ zum rechten Teilbaum
+        node = node->right;
+    }
+}
+
+/**
+ * @brief Besucht die Stückabschnitte eines Bereichs in einem Teilbaum.
+ */
+static int visit_range(const PieceNode *node, size_t offset, size_t length,
+                       PieceRangeVisitor visitor, void *context) {
+    while (node && length > 0) {
+        size_t leftTotal = node->left ? node->left->total : 0;
+        if (offset < leftTotal) { // Anfang liegt im linken Teilbaum
+            size_t part = leftTotal - offset;
+            if (part > length) {
+                part = length;
+            }
+            int result = visit_range(node->left, offset, part, visitor, context);
+            if (result != 0) {
+                return result;
+            }
+            offset += part;
+            length -= part;
+        }
+        offset -= leftTotal; // ab hier relativ zum aktuellen Stück
+        if (length > 0 && offset < node->length) {
+            size_t part = node->length - offset;
+            if (part > length) {
+                part = length;
+            }
+            int result = visitor(context, node, offset, part);
+            if (result != 0) {
+                return result;
+            }
+            length -= part;
+            offset = node->length;
+        }
+        offset -= node->length; // relativ zum rechten Teilbaum
+        node = node->right;
+    }
+    return 0;
+}
+
+/**
+ * @brief Kopiert Bytes aus einem einzelnen Stück.
+ */
+static void copy_piece(const PieceTable *self, const PieceNode *node, size_t offset,
+                       unsigned char *dest, size_t length) {
+    if (node->kind == PIECE_ADD) {
+        memcpy(dest, self->add + node->start + offset, length);
+    } else {
+        data_source_read(self->original, node->start + offset, dest, length);
+    }
+}
+
+/**
+ * @brief Hängt Bytes an den Anhang-Buffer an.
+ * @return Startposition der Bytes im Anhang-Buffer
+ */
+static size_t append_add(PieceTable *self, const unsigned char *bytes, size_t length) {
+    if (self->add_length + length > self->add_capacity) { // Kapazität verdoppeln
+        size_t capacity = self->add_capacity ? self->add_capacity : ADD_BUFFER_MIN_CAPACITY;
+        while (capacity < self->add_length + length) {
+            capacity *= 2;
+        }
+        unsigned char *grown = (unsigned char *)realloc(self->add, capacity);
+        if (!grown) {
+            fatal_error("piece_table", "out of memory");
+        }
+        self->add = grown;
+        self->add_capacity = capacity;
+    }
+    size_t start = self->add_length;
+    memcpy(self->add + start, bytes, length);
+    self->add_length += length;
+    return start;
+}
+
+/**
+ * @brief Verlängert das letzte Stück, wenn es gleicher Herkunft ist und direkt vor `start` endet.
+ * @return 1 wenn verlängert wurde, sonst 0
+ */
+static int extend_last(PieceNode *node, PieceKind kind, size_t start, size_t length) {
+    if (!node) {
+        return 0;
+    }
+    if (node->right) { // letztes Stück liegt im rechten Teilbaum
+        if (extend_last(node->right, kind, start, length)) {
+            node->total += length;
+            return 1;
+        }
+        return 0;
+    }
+    if (node->kind == kind && node->start + node->length == start) {
+        node->length += length;
+        node->total += length;
+        return 1;
+    }
+    return 0;
+}
+
+/** @brief Dupliziert einen Teilbaum samt Prioritäten. */
+static PieceNode *clone_tree(const PieceNode *node) {
+    if (!node) {
+        return NULL;
+    }
+    PieceNode *copy = (PieceNode *)malloc(sizeof(*copy));
+    if (!copy) {
+        fatal_error("piece_table", "out of memory");
+    }
+    *copy = *node;
+    copy->left = clone_tree(node->left);
+    copy->right = clone_tree(node->right);
+    return copy;
+}
+
+/** @brief Durchläuft einen Teilbaum in Inhaltsreihenfolge. */
+static int visit_tree(const PieceNode *node, PieceVisitor visitor, void *context) {
+    while (node) {
+        int result = visit_tree(node->left, visitor, context);
+        if (result == 0) {
+            result = visitor(context, node);
+        }
+        if (result != 0) {
+            return result; // Abbruch weiterreichen
+        }
+        node = node->right;
+    }
+    return 0;
+}
+
+/** @brief Gibt einen Teilbaum frei. */
+static void free_tree(PieceNode *node) {
+    while (node) { // rechten Ast iterativ, linken rekursiv abbauen
+        PieceNode *right = node->right;
+        free_tree(node->left);
+        free(node);
+        node = right;
+    }
+}
+
+//* ----------------------------------- Init und Deinit -----------------------------------
+/**
+ * @brief Initialisiert die Piece-Table mit der kompletten Originalquelle.
+ * @param self     Zeiger auf die Piece-Table
+ * @param original Quelle der Originalbytes, muss länger leben als die Tabelle
+ * @return 0 bei Erfolg
+ */
+int piece_table_init(PieceTable *self, const DataSource *original) {
+    memset(self, 0, sizeof(*self));
+    self->original = original;
+    self->seed = 2463534242u; // beliebiger Startwert ungleich 0
+    if (original->size > 0) {  // anfangs ein Stück über die ganze Quelle
+        self->root = new_node(self, PIECE_ORIGINAL, 0, original->size);
+    }
+    return 0;
+}
+
+/**
+ * @brief Gibt alle Stücke und den Anhang-Buffer frei.
+ * @param self Zeiger auf die Piece-Table
+ * @return 0 bei Erfolg
+ */
+int piece_table_deinit(PieceTable *self) {
+    free_tree(self->root);
+    free(self->add);
+    memset(self, 0, sizeof(*self));
+    return 0;
+}
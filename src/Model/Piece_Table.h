@@ -0,0 +1,164 @@
+#ifndef PIECE_TABLE_H
+#define PIECE_TABLE_H
+
+/**
+ * @file Piece_Table.h
+ * @brief Schnittstelle der Piece-Table für Einfügen und Löschen.
+ *
+ * Die Piece-Table beschreibt den aktuellen Inhalt als Folge von
+ * Stücken, die entweder auf die unveränderte Originalquelle oder auf
+ * einen nur wachsenden Anhang-Buffer verweisen. Die Stücke liegen in
+ * einem nach Offset balancierten Baum (Treap), in dem jeder Knoten
+ * die Gesamtlänge seines Teilbaums kennt. Dadurch kosten Suchen,
+ * Einfügen und Löschen unabhängig von der Dateigröße nur O(log n).
+ * Ausgeschnittene oder kopierte Bereiche werden als Stückreferenzen
+ * gehalten, ohne Bytes zu kopieren.
+ */
+
+#include <stddef.h>        // stellt den Typ size_t bereit
+#include "Data_Source.h"  // Quelle der Originalbytes
+
+//* ---------------------------- Globale Konstanten oder Defines --------------------------
+
+//* ------------------------------------- Strukturen --------------------------------------
+/** Herkunft eines Stücks */
+typedef enum {
+    PIECE_ORIGINAL, /**< Bytes aus der Originalquelle */
+    PIECE_ADD       /**< Bytes aus dem Anhang-Buffer */
+} PieceKind;
+
+/**
+ * @brief Knoten im Baum der Stücke.
+ */
+typedef struct PieceNode {
+    struct PieceNode *left;  /**< Stücke vor diesem Stück */
+    struct PieceNode *right; /**< Stücke nach diesem Stück */
+    unsigned int priority;   /**< Zufallspriorität für die Balance */
+    PieceKind kind;          /**< Herkunft der Bytes */
+    size_t start;            /**< Startposition in Quelle bzw. Anhang */
+    size_t length;           /**< Länge des Stücks */
+    size_t total;            /**< Gesamtlänge des Teilbaums */
+} PieceNode;
+
+/**
+ * @brief Ausgeschnittener oder kopierter Bereich als Stückreferenzen.
+ *
+ * Ein Clip ist nur zusammen mit der Piece-Table gültig, aus der er
+ * stammt, da er auf deren Quelle und Anhang-Buffer verweist.
+ */
+typedef struct {
+    PieceNode *root; /**< Baum der referenzierten Stücke */
+    size_t length;   /**< Länge des Bereichs in Bytes */
+} PieceClip;
+
+/**
+ * @brief Verwaltet Stückbaum, Originalquelle und Anhang-Buffer.
+ */
+typedef struct {
+    PieceNode *root;          /**< Wurzel des Stückbaums */
+    const DataSource *original; /**< unveränderte Originalquelle */
+    unsigned char *add;       /**< Anhang-Buffer für neue Bytes */
+    size_t add_length;        /**< belegte Bytes im Anhang-Buffer */
+    size_t add_capacity;      /**< reservierte Bytes im Anhang-Buffer */
+    unsigned int seed;        /**< Zustand des Zufallsgenerators */
+} PieceTable;
+
+/**
+ * @brief Wird für jedes Stück in Inhaltsreihenfolge aufgerufen.
+ * @return 0 zum Fortfahren, sonst Abbruch mit diesem Wert
+ */
+typedef int (*PieceVisitor)(void *context, const PieceNode *piece);
+
+/**
+ * @brief Wird für jeden Stückabschnitt eines Bereichs aufgerufen.
+ * @param skip   Anzahl der Bytes am Stückanfang, die nicht zum Bereich gehören
+ * @param length Anzahl der Bytes des Stücks innerhalb des Bereichs
+ * @return 0 zum Fortfahren, sonst Abbruch mit diesem Wert
+ */
+typedef int (*PieceRangeVisitor)(void *context, const PieceNode *piece, size_t skip,
+                                 size_t length);
+
+//* ------------------------------------- Funktionen --------------------------------------
+/**
+ * @brief Liefert die aktuelle Länge des Inhalts.
+ */
+static inline size_t piece_table_length(const PieceTable *self) {
+    return self->root ? self->root->total : 0;
+}
+
+/**
+ * @brief Liefert ein einzelnes Byte.
+ */
+unsigned char piece_table_get_byte(const PieceTable *self, size_t offset);
+
+/**
+ * @brief Kopiert einen Bereich in einen externen Buffer.
+ */
+void piece_table_read(const PieceTable *self, size_t offset, unsigned char *dest,
+                      size_t length);
+
+/**
+ * @brief Besucht alle Stücke in Inhaltsreihenfolge.
+ */
+int piece_table_for_each(const PieceTable *self, PieceVisitor visitor, void *context);
+
+/**
+ * @brief Besucht die Stücke, die einen Bereich überdecken.
+ */
+int piece_table_for_range(const PieceTable *self, size_t offset, size_t length,
+                          PieceRangeVisitor visitor, void *context);
+
+/**
+ * @brief Fügt Bytes an einer Position ein.
+ */
+void piece_table_insert(PieceTable *self, size_t offset, const unsigned char *bytes,
+                        size_t length);
+
+/**
+ * @brief Hängt einen Bereich der Originalquelle an das Inhaltsende.
+ */
+void piece_table_append_original(PieceTable *self, size_t start, size_t length);
+
+/**
+ * @brief Entfernt einen Bereich.
+ */
+void piece_table_erase(PieceTable *self, size_t offset, size_t length);
+
+/**
+ * @brief Überschreibt einen Bereich mit neuen Bytes.
+ */
+void piece_table_replace(PieceTable *self, size_t offset, const unsigned char *bytes,
+                         size_t length);
+
+/**
+ * @brief Kopiert einen Bereich als Stückreferenzen in einen Clip.
+ */
+void piece_table_copy(PieceTable *self, size_t offset, size_t length, PieceClip *out);
+
+/**
+ * @brief Schneidet einen Bereich aus und übergibt ihn als Clip.
+ */
+void piece_table_cut(PieceTable *self, size_t offset, size_t length, PieceClip *out);
+
+/**
+ * @brief Fügt einen Clip an einer Position ein.
+ */
+void piece_table_paste(PieceTable *self, size_t offset, const PieceClip *clip);
+
+/**
+ * @brief Gibt einen Clip frei.
+ */
+void piece_clip_free(PieceClip *clip);
+
+//* ----------------------------------- Init und Deinit -----------------------------------
+/**
+ * @brief Initialisiert die Piece-Table mit der kompletten Originalquelle.
+ */
+int piece_table_init(PieceTable *self, const DataSource *original);
+
+/**
+ * @brief Gibt alle Stücke und den Anhang-Buffer frei.
+ */
+int piece_table_deinit(PieceTable *self);
+
+#endif // PIECE_TABLE_H
@@ -0,0 +1,228 @@
+/**
+ * @file Range_Digest.c
+ * @brief Prüfsummen über einen Bereich des Buffers.
+ *
+ * Ein Auftrag besteht aus je einer Aufgabe für MD5, SHA-1 und SHA-256
+ * sowie einer CRC32-Aufgabe je Thread über einen Teil des Bereichs.
+ * Die Threads holen sich Aufgaben, bis keine mehr übrig ist; die
+ * langsamen Verfahren werden zuerst vergeben. Jede Aufgabe liest ihre
+ * Bytes selbst in Schritten von `RANGE_DIGEST_CHUNK`.
+ */
+
+//* -------------------------------------- Includes ---------------------------------------
+#include "Range_Digest.h" // Schnittstelle dieses Moduls
+#include <stdlib.h>        // malloc und free
+#include <string.h>        // memset
+#ifndef _WIN32
+#include <pthread.h>       // Threads und Sperre
+#include <unistd.h>        // sysconf für die Anzahl der Prozessoren
+#endif
+#include "Err_Log.h"      // Fehlerbehandlung
+
+//* ---------------------------- Globale Konstanten oder Defines --------------------------
+/**
+ * @brief Gemeinsamer Auftrag aller Threads.
+ */
+typedef struct {
+    const DataBuffer *buffer;  /**< gelesener Buffer */
+    size_t start;              /**< erstes Byte */
+    size_t end;                /**< hinter dem letzten Byte */
+    size_t segments;           /**< Anzahl der CRC32-Abschnitte */
+    uint32_t *segment_crcs;    /**< CRC32 je Abschnitt */
+    RangeDigest *out;          /**< Ergebnis */
+#ifndef _WIN32
+    pthread_mutex_t lock;      /**< schützt `next_task` */
+#endif
+    size_t next_task;          /**< nächste zu vergebende Aufgabe */
+} DigestJob;
+
+// Vorwärtsdeklarationen der Helferfunktionen
+static void digest_all(const DataBuffer *buffer, size_t start, size_t end, RangeDigest *out);
+static void run_task(DigestJob *job, size_t task, unsigned char *chunk);
+static int claim_task(DigestJob *job, size_t *outTask);
+static void *worker(void *context);
+static unsigned char *alloc_chunk(void);
+#ifndef _WIN32
+static int thread_count(const DataBuffer *buffer, size_t start, size_t end);
+#endif
+
+//* ------------------------------------- Funktionen --------------------------------------
+/**
+ * @brief Berechnet alle Prüfsummen des Bereichs `[start, end)`.
+ */
+void range_digest_compute(const DataBuffer *buffer, size_t start, size_t end, RangeDigest *out) {
+    memset(out, 0, sizeof(*out));
+    if (end > buffer->size) {
+        end = buffer->size;
+    }
+    if (start > end) {
+        start = end;
+    }
+    hash_digest_prepare(); // Varianten wählen, bevor die Threads sie lesen
+#ifndef _WIN32
+    int wanted = thread_count(buffer, start, end);
+    if (wanted > 1) {
+        DigestJob job;
+        memset(&job, 0, sizeof(job));
+        job.buffer = buffer;
+        job.start = start;
+        job.end = end;
+        job.segments = (size_t)wanted;
+        job.out = out;
+        job.segment_crcs = (uint32_t *)calloc(job.segments, sizeof(uint32_t));
+        if (!job.segment_crcs) {
+            fatal_error("range_digest_compute", "out of memory");
+        }
+        pthread_mutex_init(&job.lock, NULL);
+        pthread_t threads[RANGE_DIGEST_THREADS];
+        int started = 0;
+        for (int i = 1; i < wanted; i++) { // der aufrufende Thread rechnet mit
+            if (pthread_create(&threads[started], NULL, worker, &job) != 0) {
+                break;
+            }
+            started++;
+        }
+        worker(&job);
+        for (int i = 0; i < started; i++) {
+            pthread_join(threads[i], NULL);
+        }
+        pthread_mutex_destroy(&job.lock);
+
+        size_t length = end - start;
+        uint32_t crc = 0;
+        for (size_t i = 0; i < job.segments; i++) { // Abschnitte zusammensetzen
+            size_t first = start + length * i / job.segments;
+            size_t last = start + length * (i + 1) / job.segments;
+            crc = hash_crc32_combine(crc, job.segment_crcs[i], last - first);
+        }
+        out->crc32 = crc;
+        free(job.segment_crcs);
+        return;
+    }
+#endif
+    digest_all(buffer, start, end, out);
+}
+
+//* ---------------------------------- Helfer Funktionen ----------------------------------
+/**
+ * @brief Rechnet alle Verfahren in einem Durchlauf im aufrufenden Thread.
+ */
+static void digest_all(const DataBuffer *buffer, size_t start, size_t end, RangeDigest *out) {
+    unsigned char *chunk = alloc_chunk();
+    HashState states[HASH_KIND_COUNT];
+    for (int kind = 0; kind < HASH_KIND_COUNT; kind++) {
+        hash_state_init(&states[kind], (HashKind)kind);
+    }
+    uint32_t crc = 0;
+    for (size_t pos = start; pos < end;) {
+        size_t count = (end - pos > RANGE_DIGEST_CHUNK) ? RANGE_DIGEST_CHUNK : end - pos;
+        data_buffer_get_range(buffer, pos, pos + count, chunk);
+        crc = hash_crc32(crc, chunk, count);
+        for (int kind = 0; kind < HASH_KIND_COUNT; kind++) {
+            hash_state_update(&states[kind], chunk, count);
+        }
+        pos += count;
+    }
+    out->crc32 = crc;
+    for (int kind = 0; kind < HASH_KIND_COUNT; kind++) {
+        hash_state_final(&states[kind], out->digests[kind]);
+    }
+    free(chunk);
+}
+
+/**
+ * @brief Führt eine Aufgabe aus: zuerst die Verfahren aus `HashKind`, dann die CRC32-Abschnitte.
+ */
+static void run_task(DigestJob *job, size_t task, unsigned char *chunk) {
+    size_t first = job->start;
+    size_t last = job->end;
+    HashState state;
+    int hashing = task < HASH_KIND_COUNT;
+    if (hashing) {
+        hash_state_init(&state, (HashKind)task);
+    } else {
+        size_t segment = task - HASH_KIND_COUNT;
+        size_t length = job->end - job->start;
+        first = job->start + length * segment / job->segments;
+        last = job->start + length * (segment + 1) / job->segments;
+    }
+    uint32_t crc = 0;
+    for (size_t pos = first; pos < last;) {
+        size_t count = (last - pos > RANGE_DIGEST_CHUNK) ? RANGE_DIGEST_CHUNK : last - pos;
+        data_buffer_get_range(job->buffer, pos, pos + count, chunk);
+        if (hashing) {
+            hash_state_update(&state, chunk, count);
+        } else {
+            crc = hash_crc32(crc, chunk, count);
+        }
+        pos += count;
+    }
+    if (hashing) {
+        hash_state_final(&state, job->out->digests[task]); // jede Aufgabe schreibt nur ihr Feld
+    } else {
+        job->segment_crcs[task - HASH_KIND_COUNT] = crc;
+    }
+}
+
+/**
+ * @brief Vergibt die nächste Aufgabe.
+ * @return 1 wenn eine Aufgabe vergeben wurde, 0 wenn alle vergeben sind
+ */
+static int claim_task(DigestJob *job, size_t *outTask) {
+#ifndef _WIN32
+    pthread_mutex_lock(&job->lock);
+#endif
+    size_t task = job->next_task;
+    int claimed = task < HASH_KIND_COUNT + job->segments;
+    if (claimed) {
+        job->next_task++;
+    }
+#ifndef _WIN32
+    pthread_mutex_unlock(&job->lock);
+#endif
+    *outTask = task;
+    return claimed;
+}
+
+/**
+ * @brief Arbeitet Aufgaben ab, bis keine mehr übrig ist.
+ */
+static void *worker(void *context) {
+    DigestJob *job = (DigestJob *)context;
+    unsigned char *chunk = alloc_chunk();
+    size_t task;
+    while (claim_task(job, &task)) {
+        run_task(job, task, chunk);
+    }
+    free(chunk);
+    return NULL;
+}
+
+/** @brief Reserviert einen Leseschritt. */
+static unsigned char *alloc_chunk(void) {
+    unsigned char *chunk = (unsigned char *)malloc(RANGE_DIGEST_CHUNK);
+    if (!chunk) {
+        fatal_error("range_digest", "out of memory");
+    }
+    return chunk;
+}
+
+#ifndef _WIN32
+/** @brief Anzahl der Threads, den aufrufenden eingeschlossen. */
+static int thread_count(const DataBuffer *buffer, size_t start, size_t end) {
+    if (end - start < 2 * RANGE_DIGEST_CHUNK || !data_buffer_reads_concurrently(buffer)) {
+        return 1; // kleine Bereiche lohnen keine Threads
+    }
+    long online = 1;
+#ifdef _SC_NPROCESSORS_ONLN
+    online = sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+    if (online < 1) {
+        online = 1;
+    }
+    if (online > RANGE_DIGEST_THREADS) {
+        online = RANGE_DIGEST_THREADS;
+    }
+    return (int)online;
+}
+#endif
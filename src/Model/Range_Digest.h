@@ -0,0 +1,46 @@
+#ifndef RANGE_DIGEST_H
+#define RANGE_DIGEST_H
+
+/**
+ * @file Range_Digest.h
+ * @brief Schnittstelle der Prüfsummen über einen Bereich des Buffers.
+ *
+ * Berechnet CRC32, MD5, SHA-1 und SHA-256 eines Bereichs in einem
+ * Auftrag. MD5 und die SHA-Verfahren sind in sich sequenziell und
+ * laufen deshalb je in einem eigenen Thread; CRC32 wird zusätzlich in
+ * Abschnitte geteilt, deren Werte am Ende zusammengesetzt werden.
+ */
+
+#include <stddef.h>        // stellt den Typ size_t bereit
+#include <stdint.h>        // feste Breite für CRC32
+#include "Data_Buffer.h"  // gelesener Inhalt
+#include "Hash_Digest.h"  // Verfahren
+
+//* ---------------------------- Globale Konstanten oder Defines --------------------------
+#define RANGE_DIGEST_CHUNK (1u << 20) /**< Bytes je Leseschritt */
+#define RANGE_DIGEST_THREADS 8        /**< höchstens so viele Threads */
+
+//* ------------------------------------- Strukturen --------------------------------------
+/**
+ * @brief Prüfsummen eines Bereichs.
+ */
+typedef struct {
+    uint32_t crc32;                                           /**< CRC32 */
+    unsigned char digests[HASH_KIND_COUNT][HASH_DIGEST_MAX]; /**< je Verfahren aus `HashKind` */
+} RangeDigest;
+
+//* ------------------------------------- Funktionen --------------------------------------
+/**
+ * @brief Berechnet alle Prüfsummen des Bereichs `[start, end)`.
+ *
+ * Liefert die Quelle nicht aus mehreren Threads zugleich, rechnet der
+ * aufrufende Thread alle Verfahren in einem Durchlauf.
+ *
+ * @param buffer gelesener Buffer
+ * @param start  erstes Byte
+ * @param end    hinter dem letzten Byte
+ * @param out    erhält die Prüfsummen
+ */
+void range_digest_compute(const DataBuffer *buffer, size_t start, size_t end, RangeDigest *out);
+
+#endif // RANGE_DIGEST_H
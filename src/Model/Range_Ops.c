@@ -0,0 +1,464 @@
+/**
+ * @file Range_Ops.c
+ * @brief Operationen über einen Bereich des Buffers.
+ *
+ * Ein Schlüssel der Länge k wird einmal zu einem Strom aus vielen
+ * ganzen Wiederholungen ausgerollt, dessen Länge zugleich ein Vielfaches
+ * der Vektorbreite ist. Jeder Kernaufruf verknüpft so Vektor für Vektor
+ * Daten und Strom ohne Rest- oder Phasenrechnung; nach jedem Aufruf
+ * beginnt der Strom wieder mit derselben Phase. Drehen und Umkehren
+ * nutzen Byte-Shuffles. Auf x86 wird die passende Variante (AVX2,
+ * SSSE3/SSE2) beim ersten Aufruf einmalig gewählt.
+ */
+
+//* -------------------------------------- Includes ---------------------------------------
+#include "Range_Ops.h"  // Schnittstelle dieses Moduls
+#include <ctype.h>       // isspace, isalnum und isxdigit
+#include <stdint.h>      // SIZE_MAX
+#include <stdlib.h>      // malloc und free
+#include <string.h>      // strlen, strncmp und memcpy
+#include "Err_Log.h"    // Fehlerbehandlung
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define RANGE_OPS_X86 1
+#include <immintrin.h>  // SSE2-, SSSE3- und AVX2-Intrinsics
+#endif
+
+//* ---------------------------- Globale Konstanten oder Defines --------------------------
+#define KEY_STREAM 4096 /**< der ausgerollte Schlüssel ist mindestens halb so lang */
+#define VECTOR_BYTES 32 /**< breiteste Vektorbreite, der Strom ist ein Vielfaches davon */
+
+/** Signatur einer Variante für Muster und Schlüssel */
+typedef void (*KeyKernel)(RangeOpKind kind, unsigned char *data, const unsigned char *stream,
+                          size_t length);
+/** Signatur einer Variante zum Drehen der Bytereihenfolge */
+typedef void (*SwapKernel)(size_t width, unsigned char *data, size_t length);
+/** Signatur einer Variante zum Umkehren */
+typedef void (*ReverseKernel)(unsigned char *data, size_t length);
+
+/** Namen in der Reihenfolge von `RangeOpKind` */
+static const char *const OP_NAMES[RANGE_OP_COUNT] = {
+    "fill", "xor", "and", "or", "add", "sub", "swap16", "swap32", "swap64", "reverse"
+};
+
+// Vorwärtsdeklarationen der Helferfunktionen
+static int needs_key(RangeOpKind kind);
+static size_t clamp_end(const RangeOp *op, const DataBuffer *buffer, size_t start, size_t end);
+static size_t swap_width(RangeOpKind kind);
+static int parse_key(RangeOp *out, const char *text);
+static int hex_value(int ch);
+static void apply_key(const RangeOp *op, size_t phase, unsigned char *data, size_t length);
+static void reverse_range(DataBuffer *buffer, size_t start, size_t end, unsigned char *chunk);
+static unsigned char combine_byte(RangeOpKind kind, unsigned char value, unsigned char key);
+static void key_bytes(RangeOpKind kind, unsigned char *data, const unsigned char *stream,
+                      size_t length);
+static void swap_bytes(size_t width, unsigned char *data, size_t length);
+static void reverse_bytes(unsigned char *data, size_t length);
+static void select_kernels(void);
+
+static KeyKernel keyKernel = NULL;         /**< gewählte Variante für Muster und Schlüssel */
+static SwapKernel swapKernel = NULL;       /**< gewählte Variante zum Drehen */
+static ReverseKernel reverseKernel = NULL; /**< gewählte Variante zum Umkehren */
+
+//* ------------------------------------- Funktionen --------------------------------------
+/**
+ * @brief Übersetzt eine Eingabe wie `xor 5a 3c`, `fill "abc` oder `swap32`.
+ */
+int range_op_parse(RangeOp *out, const char *text) {
+    memset(out, 0, sizeof(*out));
+    while (isspace((unsigned char)*text)) {
+        text++;
+    }
+    size_t nameLength = 0;
+    while (isalnum((unsigned char)text[nameLength])) {
+        nameLength++;
+    }
+    int kind = 0;
+    while (kind < RANGE_OP_COUNT && (strlen(OP_NAMES[kind]) != nameLength ||
+                                     strncmp(OP_NAMES[kind], text, nameLength) != 0)) {
+        kind++;
+    }
+    if (kind == RANGE_OP_COUNT) {
+        return -1; // unbekannte Operation
+    }
+    out->kind = (RangeOpKind)kind;
+    text += nameLength;
+    while (isspace((unsigned char)*text)) {
+        text++;
+    }
+    if (!needs_key(out->kind)) {
+        return (*text == '\0') ? 0 : -1;
+    }
+    return parse_key(out, text);
+}
+
+/**
+ * @brief Name einer Art, wie er in der Eingabe steht.
+ */
+const char *range_op_name(RangeOpKind kind) {
+    return (kind < RANGE_OP_COUNT) ? OP_NAMES[kind] : "";
+}
+
+/**
+ * @brief Rechnet einen Abschnitt an Ort und Stelle um.
+ */
+void range_op_transform(const RangeOp *op, size_t phase, unsigned char *data, size_t length) {
+    if (!keyKernel) {
+        select_kernels(); // einmalig, das Ergebnis ist bei jedem Aufruf gleich
+    }
+    if (op->kind == RANGE_OP_REVERSE) {
+        reverseKernel(data, length);
+    } else if (swap_width(op->kind) > 0) {
+        swapKernel(swap_width(op->kind), data, length);
+    } else {
+        apply_key(op, phase, data, length);
+    }
+}
+
+/**
+ * @brief Wendet eine Operation auf `[start, end)` an.
+ *
+ * Jeder Abschnitt wird gelesen, umgerechnet und mit einem Aufruf
+ * zurückgeschrieben; Füllen muss nichts lesen. Die Gruppe im Journal
+ * fasst alle Abschnitte zu einem Schritt zusammen.
+ */
+size_t range_op_apply(const RangeOp *op, DataBuffer *buffer, size_t start, size_t end) {
+    end = clamp_end(op, buffer, start, end);
+    if (start >= end || (needs_key(op->kind) && op->key_length == 0)) {
+        return 0;
+    }
+    if (!keyKernel) {
+        select_kernels();
+    }
+    size_t chunkSize = (op->kind == RANGE_OP_REVERSE) ? 2 * RANGE_OP_CHUNK : RANGE_OP_CHUNK;
+    unsigned char *chunk = (unsigned char *)malloc(chunkSize);
+    if (!chunk) {
+        fatal_error("range_op_apply", "out of memory");
+    }
+    data_buffer_begin_group(buffer);
+    if (op->kind == RANGE_OP_REVERSE) {
+        reverse_range(buffer, start, end, chunk);
+    } else {
+        for (size_t pos = start; pos < end;) {
+            size_t count = (end - pos > RANGE_OP_CHUNK) ? RANGE_OP_CHUNK : end - pos;
+            if (op->kind != RANGE_OP_FILL) {
+                data_buffer_get_range(buffer, pos, pos + count, chunk);
+            }
+            range_op_transform(op, pos - start, chunk, count);
+            data_buffer_overwrite(buffer, pos, chunk, count);
+            pos += count;
+        }
+    }
+    data_buffer_end_group(buffer);
+    free(chunk);
+    return end - start;
+}
+
+/**
+ * @brief Prüft vorab, ob `range_op_apply` als ein Schritt zurückgenommen werden kann.
+ */
+int range_op_fits_undo(const RangeOp *op, const DataBuffer *buffer, size_t start, size_t end) {
+    end = clamp_end(op, buffer, start, end);
+    if (start >= end) {
+        return 1; // nichts zu merken
+    }
+    size_t length = end - start;
+    size_t chunks = length / RANGE_OP_CHUNK + 2;       // Rest und Mitte beim Umkehren
+    return length <= SIZE_MAX / 2 && undo_journal_fits(&buffer->journal, chunks, 2 * length);
+}
+
+//* ---------------------------------- Helfer Funktionen ----------------------------------
+/** @brief 1, wenn die Art ein Muster oder einen Schlüssel braucht. */
+static int needs_key(RangeOpKind kind) {
+    return kind <= RANGE_OP_SUB;
+}
+
+/** @brief Ende des bearbeiteten Bereichs, beim Drehen nur bis zum letzten vollständigen Wort. */
+static size_t clamp_end(const RangeOp *op, const DataBuffer *buffer, size_t start, size_t end) {
+    if (end > buffer->size) {
+        end = buffer->size;
+    }
+    size_t width = swap_width(op->kind);
+    if (width > 0 && end > start) {
+        end = start + (end - start) / width * width; // nur vollständige Wörter
+    }
+    return end;
+}
+
+/** @brief Wortbreite beim Drehen, 0 für alle anderen Arten. */
+static size_t swap_width(RangeOpKind kind) {
+    switch (kind) {
+    case RANGE_OP_SWAP16:
+        return 2;
+    case RANGE_OP_SWAP32:
+        return 4;
+    case RANGE_OP_SWAP64:
+        return 8;
+    default:
+        return 0;
+    }
+}
+
+/**
+ * @brief Liest Hex-Bytes oder nach `"` einen Text als Schlüssel.
+ *
+ * Ein schließendes `"` ist wie bei der Mustersuche optional und gehört
+ * nicht zum Schlüssel.
+ * @return 0 bei Erfolg, -1 bei ungültiger oder leerer Eingabe
+ */
+static int parse_key(RangeOp *out, const char *text) {
+    if (*text == '"') {
+        size_t length = strlen(text + 1);
+        if (length > 0 && text[length] == '"') {
+            length--; // schließendes `"` wie bei der Suche
+        }
+        if (length == 0 || length > RANGE_OP_KEY_MAX) {
+            return -1;
+        }
+        memcpy(out->key, text + 1, length);
+        out->key_length = length;
+        return 0;
+    }
+    while (*text != '\0') {
+        if (isspace((unsigned char)*text)) {
+            text++;
+            continue;
+        }
+        int high = hex_value(text[0]);
+        int low = (high >= 0) ? hex_value(text[1]) : -1;
+        if (low < 0 || out->key_length == RANGE_OP_KEY_MAX) {
+            return -1; // nur ganze Bytes
+        }
+        out->key[out->key_length++] = (unsigned char)(high * 16 + low);
+        text += 2;
+    }
+    return (out->key_length > 0) ? 0 : -1;
+}
+
+/** @brief Wert einer Hex-Ziffer, -1 wenn keine. */
+static int hex_value(int ch) {
+    if (!isxdigit((unsigned char)ch)) {
+        return -1;
+    }
+    return isdigit((unsigned char)ch) ? ch - '0' : tolower((unsigned char)ch) - 'a' + 10;
+}
+
+/**
+ * @brief Verknüpft einen Abschnitt mit dem ab `phase` wiederholten Schlüssel.
+ *
+ * Der Strom umfasst `period` Bytes, ein gemeinsames Vielfaches von
+ * Schlüssellänge und Vektorbreite, sowie eine weitere Wiederholung für
+ * den Versatz der Phase.
+ */
+static void apply_key(const RangeOp *op, size_t phase, unsigned char *data, size_t length) {
+    unsigned char stream[KEY_STREAM + RANGE_OP_KEY_MAX];
+    size_t keyLength = op->key_length;
+    size_t unit = keyLength * VECTOR_BYTES;           // Vielfaches von beidem
+    size_t period = (KEY_STREAM / unit) * unit;       // mindestens KEY_STREAM / 2
+    for (size_t i = 0; i < period + keyLength; i++) {
+        stream[i] = op->key[i % keyLength];
+    }
+    const unsigned char *shifted = stream + phase % keyLength;
+    for (size_t done = 0; done < length;) {
+        size_t count = (length - done > period) ? period : length - done;
+        keyKernel(op->kind, data + done, shifted, count);
+        done += count;                                 // Phase bleibt gleich
+    }
+}
+
+/**
+ * @brief Kehrt einen Bereich um, indem Abschnitte von beiden Enden getauscht werden.
+ * @param chunk Platz für zwei Abschnitte
+ */
+static void reverse_range(DataBuffer *buffer, size_t start, size_t end, unsigned char *chunk) {
+    size_t low = start;
+    size_t high = end;
+    while (high - low > 2 * RANGE_OP_CHUNK) {
+        unsigned char *front = chunk;
+        unsigned char *back = chunk + RANGE_OP_CHUNK;
+        data_buffer_get_range(buffer, low, low + RANGE_OP_CHUNK, front);
+        data_buffer_get_range(buffer, high - RANGE_OP_CHUNK, high, back);
+        reverseKernel(front, RANGE_OP_CHUNK);
+        reverseKernel(back, RANGE_OP_CHUNK);
+        data_buffer_overwrite(buffer, low, back, RANGE_OP_CHUNK);
+        data_buffer_overwrite(buffer, high - RANGE_OP_CHUNK, front, RANGE_OP_CHUNK);
+        low += RANGE_OP_CHUNK;
+        high -= RANGE_OP_CHUNK;
+    }
+    data_buffer_get_range(buffer, low, high, chunk); // Mitte passt in einen Durchgang
+    reverseKernel(chunk, high - low);
+    data_buffer_overwrite(buffer, low, chunk, high - low);
+}
+
+/** @brief Verknüpft ein Byte mit einem Schlüsselbyte. */
+static unsigned char combine_byte(RangeOpKind kind, unsigned char value, unsigned char key) {
+    switch (kind) {
+    case RANGE_OP_FILL:
+        return key;
+    case RANGE_OP_XOR:
+        return (unsigned char)(value ^ key);
+    case RANGE_OP_AND:
+        return (unsigned char)(value & key);
+    case RANGE_OP_OR:
+        return (unsigned char)(value | key);
+    case RANGE_OP_ADD:
+        return (unsigned char)(value + key);
+    case RANGE_OP_SUB:
+        return (unsigned char)(value - key);
+    default:
+        return value;
+    }
+}
+
+/** @brief Muster und Schlüssel Byte für Byte. */
+static void key_bytes(RangeOpKind kind, unsigned char *data, const unsigned char *stream,
+                      size_t length) {
+    for (size_t i = 0; i < length; i++) {
+        data[i] = combine_byte(kind, data[i], stream[i]);
+    }
+}
+
+/** @brief Dreht die Bytereihenfolge Wort für Wort. */
+static void swap_bytes(size_t width, unsigned char *data, size_t length) {
+    for (size_t word = 0; word + width <= length; word += width) {
+        for (size_t a = word, b = word + width - 1; a < b; a++, b--) {
+            unsigned char swap = data[a];
+            data[a] = data[b];
+            data[b] = swap;
+        }
+    }
+}
+
+/** @brief Kehrt einen Speicherbereich Byte für Byte um. */
+static void reverse_bytes(unsigned char *data, size_t length) {
+    if (length < 2) {
+        return;
+    }
+    for (size_t a = 0, b = length - 1; a < b; a++, b--) {
+        unsigned char swap = data[a];
+        data[a] = data[b];
+        data[b] = swap;
+    }
+}
+
+#ifdef RANGE_OPS_X86
+/** @brief Muster und Schlüssel mit 16 Bytes je Schritt (SSE2). */
+__attribute__((target("sse2")))
+static void key_sse2(RangeOpKind kind, unsigned char *data, const unsigned char *stream,
+                     size_t length) {
+    size_t i = 0;
+    for (; i + 16 <= length; i += 16) {
+        __m128i key = _mm_loadu_si128((const __m128i *)(stream + i));
+        __m128i value = _mm_loadu_si128((const __m128i *)(data + i));
+        switch (kind) {
+        case RANGE_OP_FILL: value = key; break;
+        case RANGE_OP_XOR: value = _mm_xor_si128(value, key); break;
+        case RANGE_OP_AND: value = _mm_and_si128(value, key); break;
+        case RANGE_OP_OR: value = _mm_or_si128(value, key); break;
+        case RANGE_OP_ADD: value = _mm_add_epi8(value, key); break;
+        case RANGE_OP_SUB: value = _mm_sub_epi8(value, key); break;
+        default: break;
+        }
+        _mm_storeu_si128((__m128i *)(data + i), value);
+    }
+    key_bytes(kind, data + i, stream + i, length - i);
+}
+
+/** @brief Muster und Schlüssel mit 32 Bytes je Schritt (AVX2). */
+__attribute__((target("avx2")))
+static void key_avx2(RangeOpKind kind, unsigned char *data, const unsigned char *stream,
+                     size_t length) {
+    size_t i = 0;
+    for (; i + 32 <= length; i += 32) {
+        __m256i key = _mm256_loadu_si256((const __m256i *)(stream + i));
+        __m256i value = _mm256_loadu_si256((const __m256i *)(data + i));
+        switch (kind) {
+        case RANGE_OP_FILL: value = key; break;
+        case RANGE_OP_XOR: value = _mm256_xor_si256(value, key); break;
+        case RANGE_OP_AND: value = _mm256_and_si256(value, key); break;
+        case RANGE_OP_OR: value = _mm256_or_si256(value, key); break;
+        case RANGE_OP_ADD: value = _mm256_add_epi8(value, key); break;
+        case RANGE_OP_SUB: value = _mm256_sub_epi8(value, key); break;
+        default: break;
+        }
+        _mm256_storeu_si256((__m256i *)(data + i), value);
+    }
+    key_bytes(kind, data + i, stream + i, length - i);
+}
+
+/** @brief Dreht die Bytereihenfolge mit einem 16-Byte-Shuffle (SSSE3). */
+__attribute__((target("ssse3")))
+static void swap_ssse3(size_t width, unsigned char *data, size_t length) {
+    unsigned char order[16];
+    for (size_t j = 0; j < 16; j++) {
+        order[j] = (unsigned char)(j / width * width + width - 1 - j % width);
+    }
+    __m128i mask = _mm_loadu_si128((const __m128i *)order);
+    size_t i = 0;
+    for (; i + 16 <= length; i += 16) {
+        __m128i value = _mm_loadu_si128((const __m128i *)(data + i));
+        _mm_storeu_si128((__m128i *)(data + i), _mm_shuffle_epi8(value, mask));
+    }
+    swap_bytes(width, data + i, length - i);
+}
+
+/** @brief Dreht die Bytereihenfolge mit einem 32-Byte-Shuffle (AVX2). */
+__attribute__((target("avx2")))
+static void swap_avx2(size_t width, unsigned char *data, size_t length) {
+    unsigned char order[32];
+    for (size_t j = 0; j < 32; j++) { // der Shuffle arbeitet je 16-Byte-Hälfte
+        order[j] = (unsigned char)(j % 16 / width * width + width - 1 - j % 16 % width);
+    }
+    __m256i mask = _mm256_loadu_si256((const __m256i *)order);
+    size_t i = 0;
+    for (; i + 32 <= length; i += 32) {
+        __m256i value = _mm256_loadu_si256((const __m256i *)(data + i));
+        _mm256_storeu_si256((__m256i *)(data + i), _mm256_shuffle_epi8(value, mask));
+    }
+    swap_bytes(width, data + i, length - i);
+}
+
+/** @brief Kehrt um, indem je 32 Bytes von beiden Enden gedreht und getauscht werden (AVX2). */
+__attribute__((target("avx2")))
+static void reverse_avx2(unsigned char *data, size_t length) {
+    const __m256i mask = _mm256_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0,
+                                          15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+    size_t low = 0;
+    size_t high = length;
+    while (high - low >= 64) {
+        __m256i front = _mm256_loadu_si256((const __m256i *)(data + low));
+        __m256i back = _mm256_loadu_si256((const __m256i *)(data + high - 32));
+        front = _mm256_permute4x64_epi64(_mm256_shuffle_epi8(front, mask), 0x4E); // Hälften tauschen
+        back = _mm256_permute4x64_epi64(_mm256_shuffle_epi8(back, mask), 0x4E);
+        _mm256_storeu_si256((__m256i *)(data + low), back);
+        _mm256_storeu_si256((__m256i *)(data + high - 32), front);
+        low += 32;
+        high -= 32;
+    }
+    reverse_bytes(data + low, high - low);
+}
+#endif
+
+/**
+ * @brief Wählt die schnellsten Varianten, die der Prozessor unterstützt.
+ */
+static void select_kernels(void) {
+    keyKernel = key_bytes;
+    swapKernel = swap_bytes;
+    reverseKernel = reverse_bytes;
+#ifdef RANGE_OPS_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        swapKernel = swap_avx2;
+        reverseKernel = reverse_avx2;
+        keyKernel = key_avx2;
+        return;
+    }
+    if (__builtin_cpu_supports("ssse3")) {
+        swapKernel = swap_ssse3;
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        keyKernel = key_sse2;
+    }
+#endif
+}
@@ -0,0 +1,115 @@
+#ifndef RANGE_OPS_H
+#define RANGE_OPS_H
+
+/**
+ * @file Range_Ops.h
+ * @brief Schnittstelle der Operationen über einen Bereich des Buffers.
+ *
+ * Ein Bereich kann mit einem wiederholten Muster gefüllt, mit einem
+ * Schlüssel verknüpft (XOR, AND, OR, Addition und Subtraktion mit
+ * Überlauf), wortweise in der Bytereihenfolge gedreht oder als Ganzes
+ * umgekehrt werden. Der Bereich wird abschnittsweise gelesen, mit
+ * vektorisierten Kernen umgerechnet und zurückgeschrieben; alle
+ * Abschnitte bilden im Journal einen gemeinsamen Schritt.
+ */
+
+#include <stddef.h>        // stellt den Typ size_t bereit
+#include "Data_Buffer.h"  // bearbeiteter Inhalt
+
+//* ---------------------------- Globale Konstanten oder Defines --------------------------
+#define RANGE_OP_KEY_MAX 64            /**< höchstens so viele Bytes in Muster oder Schlüssel */
+#define RANGE_OP_CHUNK (8u * 1024u * 1024u) /**< Bytes je Abschnitt */
+
+//* ------------------------------------- Strukturen --------------------------------------
+/**
+ * @brief Art der Operation.
+ */
+typedef enum {
+    RANGE_OP_FILL,    /**< mit dem Muster füllen */
+    RANGE_OP_XOR,     /**< mit dem Schlüssel XOR-verknüpfen */
+    RANGE_OP_AND,     /**< mit dem Schlüssel UND-verknüpfen */
+    RANGE_OP_OR,      /**< mit dem Schlüssel ODER-verknüpfen */
+    RANGE_OP_ADD,     /**< Schlüssel addieren, modulo 256 */
+    RANGE_OP_SUB,     /**< Schlüssel subtrahieren, modulo 256 */
+    RANGE_OP_SWAP16,  /**< Bytereihenfolge je 16-Bit-Wort drehen */
+    RANGE_OP_SWAP32,  /**< Bytereihenfolge je 32-Bit-Wort drehen */
+    RANGE_OP_SWAP64,  /**< Bytereihenfolge je 64-Bit-Wort drehen */
+    RANGE_OP_REVERSE, /**< Bereich umkehren */
+    RANGE_OP_COUNT    /**< Anzahl der Arten */
+} RangeOpKind;
+
+/**
+ * @brief Übersetzte Operation.
+ *
+ * Der Schlüssel wiederholt sich ab dem ersten Byte des Bereichs.
+ */
+typedef struct {
+    RangeOpKind kind;                      /**< Art der Operation */
+    unsigned char key[RANGE_OP_KEY_MAX];   /**< Muster oder Schlüssel */
+    size_t key_length;                     /**< Länge des Schlüssels, 0 bei Arten ohne Schlüssel */
+} RangeOp;
+
+//* ------------------------------------- Funktionen --------------------------------------
+/**
+ * @brief Übersetzt eine Eingabe wie `xor 5a 3c`, `fill "abc` oder `swap32`.
+ *
+ * Auf den Namen folgen Hex-Bytes, wahlweise durch Leerzeichen getrennt,
+ * oder nach `"` ein Text, ein schließendes `"` ist optional. Drehen und
+ * Umkehren erwarten keinen Schlüssel.
+ *
+ * @param out  erhält die Operation
+ * @param text Eingabe
+ * @return 0 bei Erfolg, -1 bei ungültiger Eingabe
+ */
+int range_op_parse(RangeOp *out, const char *text);
+
+/**
+ * @brief Name einer Art, wie er in der Eingabe steht.
+ */
+const char *range_op_name(RangeOpKind kind);
+
+/**
+ * @brief Rechnet einen Abschnitt an Ort und Stelle um.
+ *
+ * Für alle Arten außer `RANGE_OP_REVERSE`, das nur über den ganzen
+ * Bereich Sinn ergibt. Beim Drehen muss `length` ein Vielfaches der
+ * Wortbreite sein.
+ *
+ * @param op     Operation
+ * @param phase  Abstand des Abschnitts vom Anfang des Bereichs
+ * @param data   Bytes des Abschnitts
+ * @param length Länge des Abschnitts
+ */
+void range_op_transform(const RangeOp *op, size_t phase, unsigned char *data, size_t length);
+
+/**
+ * @brief Wendet eine Operation auf `[start, end)` an.
+ *
+ * Beim Drehen bleiben Bytes hinter dem letzten vollständigen Wort
+ * unverändert. Die Bearbeitung lässt sich mit einem Schritt zurücknehmen,
+ * solange sie ins Budget des Journals passt.
+ *
+ * @param op     Operation
+ * @param buffer bearbeiteter Buffer
+ * @param start  erstes Byte
+ * @param end    hinter dem letzten Byte
+ * @return Anzahl der bearbeiteten Bytes
+ */
+size_t range_op_apply(const RangeOp *op, DataBuffer *buffer, size_t start, size_t end);
+
+/**
+ * @brief Prüft vorab, ob `range_op_apply` als ein Schritt zurückgenommen werden kann.
+ *
+ * Jeder Abschnitt belegt im Journal seine alten und neuen Bytes. Passt
+ * die ganze Operation nicht ins Budget, leert sie beim Anwenden den
+ * bisherigen Verlauf und kann selbst nicht zurückgenommen werden.
+ *
+ * @param op     Operation
+ * @param buffer bearbeiteter Buffer
+ * @param start  erstes Byte
+ * @param end    hinter dem letzten Byte
+ * @return 1 wenn sie ins Budget des Journals passt, sonst 0
+ */
+int range_op_fits_undo(const RangeOp *op, const DataBuffer *buffer, size_t start, size_t end);
+
+#endif // RANGE_OPS_H
@@ -0,0 +1,376 @@
+/**
+ * @file Signature_Scan.c
+ * @brief Suche nach vielen Signaturen in einem Durchlauf.
+ *
+ * Aus den Signaturen wird zuerst ein Trie gebaut und dieser dann per
+ * Breitensuche zu einem vollständigen Automaten ergänzt: Fehlende
+ * Übergänge übernehmen den Übergang des Fehlerzustands. Damit kostet
+ * jedes Byte genau einen Zugriff auf die Tabelle, unabhängig von der
+ * Anzahl der Signaturen. Zustände mit 16 Bit halten die Tabelle klein
+ * genug für den Cache; das oberste Bit spart beim Durchlauf die
+ * Nachfrage, ob im Zustand eine Signatur endet. Signaturen, die als
+ * Suffix in einer längeren enden, erreicht man über die Kette
+ * `dictionary`.
+ */
+
+//* -------------------------------------- Includes ---------------------------------------
+#include "Signature_Scan.h" // Schnittstelle dieses Moduls
+#include <ctype.h>           // isspace
+#include <stdio.h>           // Signaturdatei lesen
+#include <stdlib.h>          // malloc, calloc, realloc und free
+#include <string.h>          // memset, strchr und memcpy
+#include "Pattern_Search.h" // gleiche Mustersyntax wie bei der Suche
+#include "Err_Log.h"        // Fehlerbehandlung
+
+//* ---------------------------- Globale Konstanten oder Defines --------------------------
+#define HIT_FLAG 0x8000u             /**< Zustand mit Ausgabe */
+#define STATE_MASK 0x7FFFu           /**< Zustandsnummer ohne Markierung */
+#define SIGNATURE_LINE_MAX 1024      /**< längste Zeile der Signaturdatei */
+#define INITIAL_HIT_CAPACITY 16      /**< erste Größe eines Fundstellenfelds */
+
+/**
+ * @brief Bytefolge einer Signatur während des Aufbaus.
+ */
+typedef struct {
+    unsigned char bytes[SEARCH_PATTERN_MAX]; /**< Bytefolge */
+    size_t length;                           /**< Länge */
+} SignatureBytes;
+
+// Vorwärtsdeklarationen der Helferfunktionen
+static int read_file(SignatureScan *self, const char *path, SignatureBytes **outBytes);
+static int parse_line(char *line, Signature *signature, SignatureBytes *bytes);
+static char *trim(char *text);
+static int build_automaton(SignatureScan *self, const SignatureBytes *bytes);
+static void restart(SignatureScan *self);
+static void scan_chunk(SignatureScan *self, const unsigned char *data, size_t length);
+static void report(SignatureScan *self, size_t state, size_t end);
+static void add_hit(SignatureScan *self, Signature *signature, size_t offset);
+
+//* ------------------------------------- Funktionen --------------------------------------
+/**
+ * @brief Setzt den Durchlauf fort.
+ *
+ * Hat sich der Buffer seit dem letzten Schritt geändert, werden alle
+ * Fundstellen verworfen und der Durchlauf beginnt von vorn. Wächst der
+ * Buffer nur, wird am bisherigen Ende fortgesetzt.
+ *
+ * @param self   Zeiger auf die Suche
+ * @param budget höchstens so viele Bytes durchsuchen
+ * @return 1 wenn noch Bytes ausstehen, 0 wenn alles durchsucht ist
+ */
+int signature_scan_step(SignatureScan *self, size_t budget) {
+    if (self->revision != self->buffer->revision) {
+        restart(self);
+    }
+    while (budget > 0 && self->scanned < self->buffer->size) {
+        size_t length = self->buffer->size - self->scanned;
+        if (length > SIGNATURE_SCAN_CHUNK) {
+            length = SIGNATURE_SCAN_CHUNK;
+        }
+        if (length > budget) {
+            length = budget;
+        }
+        data_buffer_get_range(self->buffer, self->scanned, self->scanned + length, self->chunk);
+        scan_chunk(self, self->chunk, length);
+        self->scanned += length;
+        budget -= length;
+    }
+    return signature_scan_pending(self);
+}
+
+/**
+ * @brief Liefert den Fortschritt des Durchlaufs in Prozent.
+ */
+unsigned int signature_scan_progress(const SignatureScan *self) {
+    if (self->revision != self->buffer->revision) {
+        return 0;
+    }
+    if (self->buffer->size == 0 || self->scanned >= self->buffer->size) {
+        return 100;
+    }
+    return (unsigned int)((unsigned long long)self->scanned * 100 / self->buffer->size);
+}
+
+/**
+ * @brief Index der ersten Fundstelle einer Signatur ab `pos` (binäre Suche).
+ */
+size_t signature_scan_first_from(const SignatureScan *self, size_t signature, size_t pos) {
+    const Signature *entry = &self->signatures[signature];
+    size_t low = 0;
+    size_t high = entry->hit_count;
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        if (entry->hits[middle] < pos) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+//* ---------------------------------- Helfer Funktionen ----------------------------------
+/**
+ * @brief Liest alle Signaturen der Datei.
+ * @return 0 bei Erfolg, Zeilennummer bei fehlerhafter Zeile, -1 wenn die Datei fehlt
+ */
+static int read_file(SignatureScan *self, const char *path, SignatureBytes **outBytes) {
+    FILE *file = fopen(path, "r");
+    if (!file) {
+        return -1;
+    }
+    Signature *signatures = (Signature *)calloc(SIGNATURE_MAX_COUNT, sizeof(Signature));
+    SignatureBytes *bytes = (SignatureBytes *)malloc(SIGNATURE_MAX_COUNT * sizeof(SignatureBytes));
+    if (!signatures || !bytes) {
+        fatal_error("signature_scan_init", "out of memory");
+    }
+    self->signatures = signatures;
+    *outBytes = bytes;
+
+    char line[SIGNATURE_LINE_MAX];
+    int number = 0;
+    int result = 0;
+    while (fgets(line, sizeof(line), file)) {
+        number++;
+        char *text = trim(line);
+        if (text[0] == '\0' || text[0] == '#') {
+            continue;
+        }
+        if (self->count == SIGNATURE_MAX_COUNT ||
+            parse_line(text, &signatures[self->count], &bytes[self->count]) != 0) {
+            result = number;
+            break;
+        }
+        self->count++;
+    }
+    fclose(file);
+    if (result == 0 && self->count == 0) {
+        result = -1; // keine einzige Signatur
+    }
+    return result;
+}
+
+/** @brief Zerlegt `Name = Muster`; Platzhalter sind nicht erlaubt. */
+static int parse_line(char *line, Signature *signature, SignatureBytes *bytes) {
+    char *separator = strchr(line, '=');
+    if (!separator) {
+        return -1;
+    }
+    *separator = '\0';
+    char *name = trim(line);
+    size_t nameLength = strlen(name);
+    if (nameLength == 0 || nameLength >= SIGNATURE_NAME_MAX) {
+        return -1;
+    }
+    SearchPattern pattern;
+    if (pattern_search_parse(&pattern, separator + 1) != 0) {
+        return -1;
+    }
+    for (size_t i = 0; i < pattern.length; i++) {
+        if (pattern.masks[i] != 0xFF) {
+            return -1; // der Automat vergleicht nur ganze Bytes
+        }
+    }
+    memcpy(signature->name, name, nameLength + 1);
+    signature->length = pattern.length;
+    memcpy(bytes->bytes, pattern.bytes, pattern.length);
+    bytes->length = pattern.length;
+    return 0;
+}
+
+/** @brief Entfernt Leerraum an Anfang und Ende. */
+static char *trim(char *text) {
+    while (isspace((unsigned char)*text)) {
+        text++;
+    }
+    size_t length = strlen(text);
+    while (length > 0 && isspace((unsigned char)text[length - 1])) {
+        text[--length] = '\0';
+    }
+    return text;
+}
+
+/**
+ * @brief Baut Trie und vollständige Übergangstabelle.
+ * @return 0 bei Erfolg, -1 wenn die Signaturen zu viele Zustände brauchen
+ */
+static int build_automaton(SignatureScan *self, const SignatureBytes *bytes) {
+    size_t limit = 1;
+    for (size_t i = 0; i < self->count; i++) {
+        limit += bytes[i].length;
+    }
+    if (limit > SIGNATURE_MAX_STATES) {
+        return -1;
+    }
+    self->table = (uint16_t *)calloc(limit * 256, sizeof(uint16_t));
+    self->output = (int32_t *)malloc(limit * sizeof(int32_t));
+    self->dictionary = (uint16_t *)calloc(limit, sizeof(uint16_t));
+    self->same_next = (int32_t *)malloc(self->count * sizeof(int32_t));
+    uint16_t *fail = (uint16_t *)calloc(limit, sizeof(uint16_t));
+    uint16_t *queue = (uint16_t *)malloc(limit * sizeof(uint16_t));
+    if (!self->table || !self->output || !self->dictionary || !self->same_next || !fail ||
+        !queue) {
+        fatal_error("signature_scan_init", "out of memory");
+    }
+    for (size_t i = 0; i < limit; i++) {
+        self->output[i] = -1;
+    }
+
+    // Trie: Übergang 0 bedeutet hier noch "kein Kind", die Wurzel ist nie Kind
+    self->state_count = 1;
+    for (size_t i = 0; i < self->count; i++) {
+        size_t state = 0;
+        for (size_t k = 0; k < bytes[i].length; k++) {
+            uint16_t *next = &self->table[state * 256 + bytes[i].bytes[k]];
+            if (*next == 0) {
+                *next = (uint16_t)self->state_count++;
+            }
+            state = *next;
+        }
+        self->same_next[i] = self->output[state]; // gleiche Bytefolgen verketten
+        self->output[state] = (int32_t)i;
+    }
+
+    // Breitensuche: Fehlerzustände sind flacher und daher schon vollständig
+    size_t head = 0;
+    size_t tail = 0;
+    for (int c = 0; c < 256; c++) {
+        uint16_t child = self->table[c];
+        if (child != 0) {
+            queue[tail++] = child; // Fehlerzustand ist die Wurzel
+        }
+    }
+    while (head < tail) {
+        size_t state = queue[head++];
+        for (int c = 0; c < 256; c++) {
+            uint16_t *next = &self->table[state * 256 + c];
+            uint16_t fallback = self->table[fail[state] * 256 + c];
+            if (*next == 0) {
+                *next = fallback; // fehlender Übergang wie im Fehlerzustand
+                continue;
+            }
+            uint16_t child = *next;
+            fail[child] = fallback;
+            self->dictionary[child] = (self->output[fallback] >= 0) ? fallback
+                                                                    : self->dictionary[fallback];
+            queue[tail++] = child;
+        }
+    }
+    free(fail);
+    free(queue);
+
+    // Zustände mit Ausgabe direkt in der Tabelle markieren
+    for (size_t i = 0; i < self->state_count * 256; i++) {
+        uint16_t target = self->table[i];
+        if (self->output[target] >= 0 || self->dictionary[target] != 0) {
+            self->table[i] = (uint16_t)(target | HIT_FLAG);
+        }
+    }
+    return 0;
+}
+
+/** @brief Verwirft alle Fundstellen und beginnt am Anfang des Buffers. */
+static void restart(SignatureScan *self) {
+    for (size_t i = 0; i < self->count; i++) {
+        self->signatures[i].hit_count = 0;
+    }
+    self->total_hits = 0;
+    self->truncated = 0;
+    self->scanned = 0;
+    self->state = 0;
+    self->revision = self->buffer->revision;
+}
+
+/** @brief Führt den Automaten über einen Abschnitt. */
+static void scan_chunk(SignatureScan *self, const unsigned char *data, size_t length) {
+    const uint16_t *table = self->table;
+    unsigned int state = self->state;
+    for (size_t i = 0; i < length; i++) {
+        state = table[((state & STATE_MASK) << 8) | data[i]];
+        if (state & HIT_FLAG) {
+            report(self, state & STATE_MASK, self->scanned + i);
+        }
+    }
+    self->state = (uint16_t)state;
+}
+
+/** @brief Trägt alle Signaturen ein, die bei `end` enden. */
+static void report(SignatureScan *self, size_t state, size_t end) {
+    for (size_t current = state; current != 0; current = self->dictionary[current]) {
+        for (int32_t i = self->output[current]; i >= 0; i = self->same_next[i]) {
+            Signature *signature = &self->signatures[i];
+            add_hit(self, signature, end + 1 - signature->length);
+        }
+    }
+}
+
+/** @brief Hängt eine Fundstelle an; der Durchlauf liefert sie aufsteigend. */
+static void add_hit(SignatureScan *self, Signature *signature, size_t offset) {
+    if (self->total_hits >= SIGNATURE_MAX_HITS) {
+        self->truncated = 1;
+        return;
+    }
+    if (signature->hit_count == signature->hit_capacity) {
+        size_t capacity = signature->hit_capacity ? signature->hit_capacity * 2
+                                                  : INITIAL_HIT_CAPACITY;
+        size_t *hits = (size_t *)realloc(signature->hits, capacity * sizeof(size_t));
+        if (!hits) {
+            fatal_error("signature_scan", "out of memory");
+        }
+        signature->hits = hits;
+        signature->hit_capacity = capacity;
+    }
+    signature->hits[signature->hit_count++] = offset;
+    self->total_hits++;
+}
+
+//* ----------------------------------- Init und Deinit -----------------------------------
+/**
+ * @brief Lädt einen Signatursatz und bereitet den Durchlauf vor.
+ *
+ * @param self   Zeiger auf die Suche
+ * @param path   Pfad der Signaturdatei
+ * @param buffer zu durchsuchender Buffer
+ * @return 0 bei Erfolg, sonst die Nummer der fehlerhaften Zeile oder -1
+ */
+int signature_scan_init(SignatureScan *self, const char *path, const DataBuffer *buffer) {
+    memset(self, 0, sizeof(*self));
+    self->buffer = buffer;
+    SignatureBytes *bytes = NULL;
+    int result = read_file(self, path, &bytes);
+    if (result == 0) {
+        result = build_automaton(self, bytes);
+    }
+    free(bytes);
+    if (result != 0) {
+        signature_scan_deinit(self);
+        return result;
+    }
+    self->chunk = (unsigned char *)malloc(SIGNATURE_SCAN_CHUNK);
+    if (!self->chunk) {
+        fatal_error("signature_scan_init", "out of memory");
+    }
+    restart(self);
+    return 0;
+}
+
+/**
+ * @brief Gibt Automat und Ergebnisse frei.
+ * @param self Zeiger auf die Suche
+ * @return 0 bei Erfolg
+ */
+int signature_scan_deinit(SignatureScan *self) {
+    if (self->signatures) {
+        for (size_t i = 0; i < self->count; i++) {
+            free(self->signatures[i].hits);
+        }
+    }
+    free(self->signatures);
+    free(self->table);
+    free(self->output);
+    free(self->same_next);
+    free(self->dictionary);
+    free(self->chunk);
+    memset(self, 0, sizeof(*self));
+    return 0;
+}
@@ -0,0 +1,117 @@
+#ifndef SIGNATURE_SCAN_H
+#define SIGNATURE_SCAN_H
+
+/**
+ * @file Signature_Scan.h
+ * @brief Schnittstelle der Suche nach vielen Signaturen zugleich.
+ *
+ * Die Signaturen eines Satzes werden zu einem Aho-Corasick-Automaten
+ * übersetzt, der den Inhalt in einem einzigen Durchlauf nach allen
+ * zugleich durchsucht. Der Durchlauf geschieht schrittweise, damit der
+ * Controller ihn zwischen Eingaben fortsetzen kann. Für jede Signatur
+ * entsteht ein aufsteigend sortierter Index ihrer Fundstellen. Ändert
+ * sich der Inhalt, beginnt die Suche von vorn.
+ */
+
+#include <stddef.h>       // stellt den Typ size_t bereit
+#include <stdint.h>       // feste Breiten für die Übergangstabelle
+#include "Data_Buffer.h" // durchsuchter Inhalt
+
+//* ---------------------------- Globale Konstanten oder Defines --------------------------
+#define SIGNATURE_NAME_MAX 32              /**< Länge eines Namens inklusive Nullbyte */
+#define SIGNATURE_MAX_COUNT 1024           /**< höchstens so viele Signaturen je Satz */
+#define SIGNATURE_MAX_STATES 32768         /**< Zustände des Automaten, das oberste Bit markiert Treffer */
+#define SIGNATURE_MAX_HITS (1u << 24)      /**< höchstens so viele Fundstellen insgesamt merken */
+#define SIGNATURE_SCAN_CHUNK (1024 * 1024) /**< Bytes je Leseschritt */
+
+//* ------------------------------------- Strukturen --------------------------------------
+/**
+ * @brief Eine Signatur und ihre bisher gefundenen Stellen.
+ */
+typedef struct {
+    char name[SIGNATURE_NAME_MAX]; /**< Name aus der Signaturdatei */
+    size_t length;                 /**< Länge der Bytefolge */
+    size_t *hits;                  /**< Startpositionen, aufsteigend */
+    size_t hit_count;              /**< Anzahl der Fundstellen */
+    size_t hit_capacity;           /**< Plätze in `hits` */
+} Signature;
+
+/**
+ * @brief Automat, Durchlaufzustand und Ergebnisse eines Signatursatzes.
+ *
+ * `table` enthält für jeden Zustand 256 Folgezustände, sodass je Byte
+ * genau ein Tabellenzugriff nötig ist. Ist im Folgezustand das oberste
+ * Bit gesetzt, endet dort mindestens eine Signatur.
+ */
+typedef struct {
+    Signature *signatures;      /**< Signaturen in Dateireihenfolge */
+    size_t count;               /**< Anzahl der Signaturen */
+    uint16_t *table;            /**< Übergänge, `state * 256 + byte` */
+    int32_t *output;            /**< je Zustand: Signatur, die genau dort endet, sonst -1 */
+    int32_t *same_next;         /**< je Signatur: nächste mit gleicher Bytefolge, sonst -1 */
+    uint16_t *dictionary;       /**< je Zustand: nächster kürzerer Zustand mit Ausgabe, 0 = keiner */
+    size_t state_count;         /**< Anzahl der Zustände */
+    const DataBuffer *buffer;   /**< durchsuchter Buffer */
+    unsigned long revision;     /**< Stand des Buffers beim Durchlauf */
+    size_t scanned;             /**< bis hierhin durchsucht */
+    uint16_t state;             /**< Zustand des Automaten bei `scanned` */
+    size_t total_hits;          /**< Fundstellen aller Signaturen */
+    int truncated;              /**< 1, wenn Fundstellen wegen `SIGNATURE_MAX_HITS` fehlen */
+    unsigned char *chunk;       /**< Leseschritt */
+} SignatureScan;
+
+//* ------------------------------------- Funktionen --------------------------------------
+/**
+ * @brief Setzt den Durchlauf fort.
+ *
+ * @param self   Zeiger auf die Suche
+ * @param budget höchstens so viele Bytes durchsuchen
+ * @return 1 wenn noch Bytes ausstehen, 0 wenn alles durchsucht ist
+ */
+int signature_scan_step(SignatureScan *self, size_t budget);
+
+/**
+ * @brief Prüft, ob noch Bytes zu durchsuchen sind.
+ */
+static inline int signature_scan_pending(const SignatureScan *self) {
+    return self->revision != self->buffer->revision || self->scanned < self->buffer->size;
+}
+
+/**
+ * @brief Liefert den Fortschritt des Durchlaufs in Prozent.
+ */
+unsigned int signature_scan_progress(const SignatureScan *self);
+
+/**
+ * @brief Index der ersten Fundstelle einer Signatur ab `pos`.
+ * @param self      Zeiger auf die Suche
+ * @param signature Index der Signatur
+ * @param pos       Position
+ * @return Index in `hits`, `hit_count` wenn keine folgt
+ */
+size_t signature_scan_first_from(const SignatureScan *self, size_t signature, size_t pos);
+
+//* ----------------------------------- Init und Deinit -----------------------------------
+/**
+ * @brief Lädt einen Signatursatz und bereitet den Durchlauf vor.
+ *
+ * Jede Zeile der Datei hat die Form `Name = Muster`; das Muster ist ein
+ * Hex-Muster oder `"Text` wie bei der Mustersuche, jedoch ohne
+ * Platzhalter. Leere Zeilen und Zeilen, die mit `#` beginnen, werden
+ * ignoriert.
+ *
+ * @param self   Zeiger auf die Suche
+ * @param path   Pfad der Signaturdatei
+ * @param buffer zu durchsuchender Buffer
+ * @return 0 bei Erfolg, sonst die Nummer der fehlerhaften Zeile oder -1
+ */
+int signature_scan_init(SignatureScan *self, const char *path, const DataBuffer *buffer);
+
+/**
+ * @brief Gibt Automat und Ergebnisse frei.
+ * @param self Zeiger auf die Suche
+ * @return 0 bei Erfolg
+ */
+int signature_scan_deinit(SignatureScan *self);
+
+#endif // SIGNATURE_SCAN_H
@@ -0,0 +1,197 @@
+/**
+ * @file Stream_Arena.c
+ * @brief Blockweiser Speicher für eingehende Datenströme.
+ *
+ * Neue Bytes werden immer an den jüngsten Block angehängt. Ist er voll,
+ * wird ein weiterer Block angelegt; nur das kleine Zeigerfeld wird bei
+ * Bedarf vergrößert. Im Ringmodus werden vollständig gefüllte Blöcke am
+ * Anfang freigegeben, sobald ohne sie das Budget noch erfüllt ist.
+ */
+
+//* -------------------------------------- Includes ---------------------------------------
+#include "Stream_Arena.h"   // Schnittstelle dieses Moduls
+#include <stdlib.h>          // malloc, realloc und free
+#include <string.h>          // memcpy, memmove und memset
+#include "File_Manager.h"   // nicht blockierendes Lesen
+
+//* ---------------------------- Globale Konstanten oder Defines --------------------------
+// Vorwärtsdeklarationen der Helferfunktionen
+static unsigned char *writable_chunk(StreamArena *self, size_t *room);
+static void drop_oldest(StreamArena *self);
+
+//* ------------------------------------- Funktionen --------------------------------------
+/**
+ * @brief Übernimmt die derzeit verfügbaren Bytes des Stroms.
+ *
+ * Es wird nie blockiert. Pro Aufruf werden höchstens
+ * `STREAM_ARENA_FILL_LIMIT` Bytes gelesen, damit die Oberfläche auch bei
+ * schnellen Quellen bedienbar bleibt.
+ *
+ * @param self Zeiger auf die Arena
+ * @return 1 wenn Bytes hinzukamen, 0 wenn nicht, -1 wenn der Strom endete
+ */
+int stream_arena_fill(StreamArena *self) {
+    if (self->eof) {
+        return -1;
+    }
+    size_t total = 0;
+    while (total < STREAM_ARENA_FILL_LIMIT) {
+        size_t room = 0;
+        unsigned char *dest = writable_chunk(self, &room);
+        if (!dest) {
+            break;                                  // kein Speicher: später erneut
+        }
+        long long got = readAvailable(self->fd, dest, room);
+        if (got == READ_WOULD_BLOCK) {
+            break;                                  // alles Verfügbare gelesen
+        }
+        if (got <= 0) {
+            self->eof = 1;                          // Ende oder Lesefehler
+            break;
+        }
+        self->end += (size_t)got;
+        total += (size_t)got;
+        drop_oldest(self);                          // Speicher auch während des Lesens begrenzen
+    }
+    if (total > 0) {
+        return 1;
+    }
+    return self->eof ? -1 : 0;
+}
+
+/**
+ * @brief Kopiert einen Bereich aus der Arena.
+ *
+ * Bereits verworfene Bytes werden als 0 geliefert.
+ *
+ * @param self   Zeiger auf die Arena
+ * @param offset absoluter Startoffset
+ * @param dest   Ziel-Buffer
+ * @param length Anzahl der Bytes
+ */
+void stream_arena_read(const StreamArena *self, size_t offset, unsigned char *dest,
+                       size_t length) {
+    if (offset < self->base) {                      // Anfang bereits verworfen
+        size_t gone = self->base - offset;
+        if (gone > length) {
+            gone = length;
+        }
+        memset(dest, 0, gone);
+        dest += gone;
+        offset += gone;
+        length -= gone;
+    }
+    while (length > 0) {
+        size_t relative = offset - self->base;      // Blöcke beginnen bei `base`
+        size_t chunk = self->first + relative / STREAM_ARENA_CHUNK_SIZE;
+        size_t inner = relative % STREAM_ARENA_CHUNK_SIZE;
+        size_t part = STREAM_ARENA_CHUNK_SIZE - inner;
+        if (part > length) {
+            part = length;
+        }
+        memcpy(dest, self->chunks[chunk] + inner, part);
+        dest += part;
+        offset += part;
+        length -= part;
+    }
+}
+
+//* ---------------------------------- Helfer Funktionen ----------------------------------
+/**
+ * @brief Liefert freien Platz im jüngsten Block, legt ihn bei Bedarf an.
+ * @param room erhält die Anzahl freier Bytes
+ * @return Schreibposition oder NULL ohne Speicher
+ */
+static unsigned char *writable_chunk(StreamArena *self, size_t *room) {
+    size_t stored = self->end - self->base;          // belegte Bytes in allen Blöcken
+    size_t reserved = self->count * STREAM_ARENA_CHUNK_SIZE;
+    if (stored < reserved) {                         // jüngster Block hat noch Platz
+        size_t used = stored % STREAM_ARENA_CHUNK_SIZE;
+        *room = STREAM_ARENA_CHUNK_SIZE - used;
+        return self->chunks[self->first + self->count - 1] + used;
+    }
+
+    if (self->first + self->count == self->capacity) {
+        if (self->first > 0) {                      // freigewordene Plätze vorne nutzen
+            memmove(self->chunks, self->chunks + self->first,
+                    self->count * sizeof(*self->chunks));
+            self->first = 0;
+        } else {
+            size_t capacity = self->capacity ? self->capacity * 2 : 16;
+            unsigned char **grown = realloc(self->chunks, capacity * sizeof(*grown));
+            if (!grown) {
+                return NULL;
+            }
+            self->chunks = grown;                   // nur Zeiger werden umkopiert
+            self->capacity = capacity;
+        }
+    }
+
+    unsigned char *chunk = malloc(STREAM_ARENA_CHUNK_SIZE);
+    if (!chunk) {
+        return NULL;
+    }
+    self->chunks[self->first + self->count] = chunk;
+    self->count++;
+    *room = STREAM_ARENA_CHUNK_SIZE;
+    return chunk;
+}
+
+/**
+ * @brief Gibt im Ringmodus die ältesten Blöcke frei.
+ *
+ * Ein Block wird nur verworfen, wenn die verbleibenden Bytes das Budget
+ * weiterhin erfüllen. Der jüngste Block bleibt immer erhalten.
+ */
+static void drop_oldest(StreamArena *self) {
+    if (self->ring_budget == 0) {
+        return; // alles behalten
+    }
+    while (self->count > 1 && self->end - self->base - STREAM_ARENA_CHUNK_SIZE >=
+                                  self->ring_budget) {
+        free(self->chunks[self->first]);
+        self->chunks[self->first] = NULL;
+        self->first++;
+        self->count--;
+        self->base += STREAM_ARENA_CHUNK_SIZE;
+    }
+}
+
+//* ----------------------------------- Init und Deinit -----------------------------------
+/**
+ * @brief Öffnet einen Datenstrom und legt die Arena an.
+ *
+ * Die Arena beginnt leer; alle Bytes, auch die bereits wartenden,
+ * kommen über `stream_arena_fill` hinzu. So erfährt der Aufrufer von
+ * jedem im Ringmodus verworfenen Block.
+ *
+ * @param self        Zeiger auf die Arena
+ * @param path        Pfad des Stroms oder `-` für die Standardeingabe
+ * @param ring_budget Obergrenze im Ringmodus in Bytes, 0 = alles behalten
+ * @return 0 bei Erfolg, sonst -1
+ */
+int stream_arena_init(StreamArena *self, const char *path, size_t ring_budget) {
+    memset(self, 0, sizeof(*self));
+    self->ring_budget = ring_budget;
+    if (openInputStream(path, &self->fd) != 0) {
+        self->fd = -1;
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Gibt alle Blöcke frei und schließt den Strom.
+ * @param self Zeiger auf die Arena
+ * @return 0 bei Erfolg
+ */
+int stream_arena_deinit(StreamArena *self) {
+    for (size_t i = 0; i < self->count; i++) {
+        free(self->chunks[self->first + i]);
+    }
+    free(self->chunks);
+    closeFile(self->fd);
+    memset(self, 0, sizeof(*self));
+    self->fd = -1;
+    return 0;
+}
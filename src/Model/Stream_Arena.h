@@ -0,0 +1,69 @@
+#ifndef STREAM_ARENA_H
+#define STREAM_ARENA_H
+
+/**
+ * @file Stream_Arena.h
+ * @brief Schnittstelle des Speichers für eingehende Datenströme.
+ *
+ * Nicht adressierbare Quellen wie die Standardeingabe, Pipes oder
+ * serielle Geräte können weder eingeblendet noch vorab vermessen
+ * werden. Die Arena sammelt ihre Bytes in Blöcken fester Größe, die nie
+ * umkopiert werden; wächst der Strom, kommt lediglich ein neuer Block
+ * hinzu. Im Ringmodus werden die ältesten Blöcke verworfen, sobald das
+ * Speicherbudget überschritten ist, sodass auch lange Mitschnitte mit
+ * konstantem Speicher auskommen.
+ */
+
+#include <stddef.h> // stellt den Typ size_t bereit
+
+//* ---------------------------- Globale Konstanten oder Defines --------------------------
+#define STREAM_ARENA_CHUNK_SIZE (256 * 1024)         /**< Größe eines Blocks in Bytes */
+#define STREAM_ARENA_FILL_LIMIT (4u * 1024u * 1024u) /**< höchstens so viele Bytes pro Abruf */
+
+//* ------------------------------------- Strukturen --------------------------------------
+/**
+ * @brief Blockweise gesammelte Bytes eines Datenstroms.
+ *
+ * Offsets sind absolut ab Beginn des Stroms. Im Ringmodus beginnen die
+ * noch vorhandenen Bytes bei `base`.
+ */
+typedef struct {
+    int fd;                 /**< Deskriptor des Datenstroms */
+    unsigned char **chunks; /**< Zeiger auf die Blöcke */
+    size_t first;           /**< Index des ältesten noch vorhandenen Blocks */
+    size_t count;           /**< Anzahl vorhandener Blöcke ab `first` */
+    size_t capacity;        /**< Plätze im Zeigerfeld */
+    size_t base;            /**< absoluter Offset des ältesten Bytes */
+    size_t end;             /**< absoluter Offset hinter dem neuesten Byte */
+    size_t ring_budget;     /**< Obergrenze im Ringmodus in Bytes, 0 = unbegrenzt */
+    int eof;                /**< 1, sobald der Strom beendet ist */
+} StreamArena;
+
+//* ------------------------------------- Funktionen --------------------------------------
+/**
+ * @brief Übernimmt die derzeit verfügbaren Bytes des Stroms.
+ */
+int stream_arena_fill(StreamArena *self);
+
+/**
+ * @brief Kopiert einen Bereich aus der Arena.
+ */
+void stream_arena_read(const StreamArena *self, size_t offset, unsigned char *dest,
+                       size_t length);
+
+//* ----------------------------------- Init und Deinit -----------------------------------
+/**
+ * @brief Öffnet einen Datenstrom und legt die Arena an.
+ * @param self        Zeiger auf die Arena
+ * @param path        Pfad des Stroms oder `-` für die Standardeingabe
+ * @param ring_budget Obergrenze im Ringmodus in Bytes, 0 = alles behalten
+ * @return 0 bei Erfolg, sonst -1
+ */
+int stream_arena_init(StreamArena *self, const char *path, size_t ring_budget);
+
+/**
+ * @brief Gibt alle Blöcke frei und schließt den Strom.
+ */
+int stream_arena_deinit(StreamArena *self);
+
+#endif // STREAM_ARENA_H
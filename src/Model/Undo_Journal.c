@@ -0,0 +1,459 @@
+/**
+ * @file Undo_Journal.c
+ * @brief Journal für Rückgängig und Wiederholen.
+ *
+ * Die Bytes aller Einträge werden der Reihe nach in eine Ring-Arena
+ * geschrieben. Bis zum Budget wächst die Arena durch Verdoppeln, danach
+ * läuft sie im Kreis: Passt ein neuer Eintrag nicht mehr hinter den
+ * neuesten, beginnt er wieder am Anfang der Arena, und die ältesten
+ * Gruppen werden verdrängt, bis genug Platz frei ist. Getippte Bytes
+ * verlängern den neuesten Eintrag, solange er direkt am Ende der Arena
+ * liegt.
+ */
+
+//* -------------------------------------- Includes ---------------------------------------
+#include "Undo_Journal.h"   // Schnittstelle dieses Moduls
+#include <stdlib.h>          // realloc und free
+#include <string.h>          // memmove und memset
+#include "Err_Log.h"        // fatale Fehler bei Speichermangel
+
+//* ---------------------------- Globale Konstanten oder Defines --------------------------
+#define UNDO_RING_MIN_CAPACITY (64 * 1024) /**< Startgröße der Arena */
+#define UNDO_RECORDS_MIN_CAPACITY 64       /**< Startgröße des Felds der Einträge */
+
+// Vorwärtsdeklarationen der Helferfunktionen
+static int try_extend(UndoJournal *self, size_t offset, size_t old_length, size_t new_length,
+                      unsigned char **old_out, unsigned char **new_out);
+static int alloc_payload(UndoJournal *self, size_t length, size_t *position);
+static int ring_is_linear(const UndoJournal *self);
+static void grow_ring(UndoJournal *self, size_t needed);
+static void reserve_record(UndoJournal *self);
+static int evict_oldest(UndoJournal *self);
+static void truncate_redo(UndoJournal *self);
+static void give_up(UndoJournal *self);
+static size_t record_cost(const UndoRecord *record);
+
+//* ------------------------------------- Funktionen --------------------------------------
+/**
+ * @brief Reserviert Platz für eine neue Bearbeitung.
+ *
+ * Noch nicht wiederholte Einträge werden verworfen. Getippte Bytes, die
+ * direkt hinter dem neuesten getippten Eintrag liegen, verlängern ihn,
+ * statt einen neuen Eintrag anzulegen. Passt die Bearbeitung selbst in
+ * ein leeres Journal nicht, wird das Journal geleert; eine offene Gruppe
+ * wird dann bis zu ihrem Ende nicht mehr aufgezeichnet.
+ *
+ * @param self       Zeiger auf das Journal
+ * @param offset     Position im Inhalt
+ * @param old_length Anzahl der ersetzten Bytes
+ * @param new_length Anzahl der eingesetzten Bytes
+ * @param typed      1 = getipptes Byte, darf an den neuesten Eintrag angehängt werden
+ * @param old_out    erhält das Ziel für die alten Bytes
+ * @param new_out    erhält das Ziel für die neuen Bytes
+ * @return 0 bei Erfolg, -1 wenn die Bearbeitung nicht ins Budget passt
+ */
+int undo_journal_record(UndoJournal *self, size_t offset, size_t old_length,
+                        size_t new_length, int typed, unsigned char **old_out,
+                        unsigned char **new_out) {
+    if (self->discard_group || old_length + new_length == 0) {
+        return -1; // Gruppe bereits verworfen oder nichts zu merken
+    }
+    truncate_redo(self); // neue Bearbeitung beendet das Wiederholen
+
+    if (typed && try_extend(self, offset, old_length, new_length, old_out, new_out)) {
+        return 0; // an den laufenden Eintrag angehängt
+    }
+
+    UndoRecord record;
+    record.offset = offset;
+    record.old_length = old_length;
+    record.new_length = new_length;
+    record.payload = 0;
+    record.group = self->open_group ? self->open_group : ++self->next_group;
+    record.typed = typed;
+
+    size_t cost = record_cost(&record);
+    if (cost > self->budget || old_length > self->budget || new_length > self->budget) {
+        give_up(self); // passt in keinem Fall
+        return -1;
+    }
+    while (self->used + cost > self->budget) { // älteste Gruppen verdrängen
+        if (evict_oldest(self) != 0) {
+            give_up(self);
+            return -1;
+        }
+    }
+    if (alloc_payload(self, old_length + new_length, &record.payload) != 0) {
+        give_up(self);
+        return -1;
+    }
+
+    reserve_record(self);
+    self->records[self->count++] = record;
+    self->applied = self->count;
+    self->used += cost;
+    self->run_open = typed;
+
+    *old_out = self->ring + record.payload;
+    *new_out = self->ring + record.payload + old_length;
+    return 0;
+}
+
+/**
+ * @brief Prüft, ob ein an `offset` überschriebenes getipptes Byte den laufenden Eintrag fortsetzt.
+ *
+ * Damit kann auch ein Byte, das seinen Wert behält, einen getippten
+ * Lauf weiterführen, ohne außerhalb eines Laufs einen leeren Schritt
+ * anzulegen.
+ *
+ * @param self   Zeiger auf das Journal
+ * @param offset Position des nächsten getippten Bytes
+ * @return 1 wenn ein überschreibender Lauf direkt davor endet, sonst 0
+ */
+int undo_journal_continues_run(const UndoJournal *self, size_t offset) {
+    if (!self->run_open || self->count == self->first) {
+        return 0;
+    }
+    const UndoRecord *top = &self->records[self->count - 1];
+    return top->typed && top->old_length == top->new_length &&
+           top->offset + top->new_length == offset;
+}
+
+/**
+ * @brief Nimmt die jüngste angewendete Gruppe zurück.
+ *
+ * Die Einträge sind von alt nach neu geordnet, der Aufrufer muss sie in
+ * umgekehrter Reihenfolge rückgängig machen.
+ *
+ * @param self  Zeiger auf das Journal
+ * @param first erhält den ältesten Eintrag der Gruppe
+ * @return Anzahl der Einträge, 0 wenn nichts zurückzunehmen ist
+ */
+size_t undo_journal_undo(UndoJournal *self, const UndoRecord **first) {
+    if (self->applied == self->first) {
+        return 0;
+    }
+    unsigned long group = self->records[self->applied - 1].group;
+    size_t n = 0;
+    while (self->applied > self->first && self->records[self->applied - 1].group == group) {
+        self->applied--;
+        n++;
+    }
+    *first = &self->records[self->applied];
+    self->run_open = 0; // Tippen danach beginnt einen neuen Eintrag
+    return n;
+}
+
+/**
+ * @brief Wendet die zuletzt zurückgenommene Gruppe erneut an.
+ *
+ * Die Einträge sind von alt nach neu geordnet und werden in dieser
+ * Reihenfolge wiederholt.
+ *
+ * @param self  Zeiger auf das Journal
+ * @param first erhält den ältesten Eintrag der Gruppe
+ * @return Anzahl der Einträge, 0 wenn nichts zu wiederholen ist
+ */
+size_t undo_journal_redo(UndoJournal *self, const UndoRecord **first) {
+    if (self->applied == self->count) {
+        return 0;
+    }
+    unsigned long group = self->records[self->applied].group;
+    size_t start = self->applied;
+    while (self->applied < self->count && self->records[self->applied].group == group) {
+        self->applied++;
+    }
+    *first = &self->records[start];
+    self->run_open = 0;
+    return self->applied - start;
+}
+
+/**
+ * @brief Prüft, ob eine Gruppe aus `records` Einträgen mit zusammen `bytes` alten und neuen Bytes ins Budget passt.
+ *
+ * Ältere Gruppen werden dafür notfalls verdrängt; passt die Gruppe auch
+ * in ein leeres Journal nicht, leert `undo_journal_record` beim Anwenden
+ * den ganzen Verlauf.
+ *
+ * @param self    Zeiger auf das Journal
+ * @param records Anzahl der Einträge
+ * @param bytes   alte und neue Bytes zusammen
+ * @return 1 wenn die Gruppe passt, sonst 0
+ */
+int undo_journal_fits(const UndoJournal *self, size_t records, size_t bytes) {
+    if (bytes > self->budget || records > (self->budget - bytes) / sizeof(UndoRecord)) {
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief Beginnt eine Gruppe, die in einem Schritt zurückgenommen wird.
+ * @param self Zeiger auf das Journal
+ */
+void undo_journal_begin_group(UndoJournal *self) {
+    if (self->group_depth++ == 0) { // nur die äußerste Gruppe zählt
+        self->open_group = ++self->next_group;
+        self->discard_group = 0;
+    }
+    self->run_open = 0;
+}
+
+/**
+ * @brief Beendet die mit `undo_journal_begin_group` begonnene Gruppe.
+ * @param self Zeiger auf das Journal
+ */
+void undo_journal_end_group(UndoJournal *self) {
+    if (self->group_depth == 0) {
+        return; // keine offene Gruppe
+    }
+    if (--self->group_depth == 0) {
+        self->open_group = 0;
+        self->discard_group = 0;
+    }
+    self->run_open = 0;
+}
+
+/**
+ * @brief Verwirft alle Einträge.
+ *
+ * Arena und Feld der Einträge bleiben für weitere Bearbeitungen reserviert.
+ *
+ * @param self Zeiger auf das Journal
+ */
+void undo_journal_clear(UndoJournal *self) {
+    self->first = 0;
+    self->count = 0;
+    self->applied = 0;
+    self->head = 0;
+    self->used = 0;
+    self->run_open = 0;
+}
+
+//* ---------------------------------- Helfer Funktionen ----------------------------------
+/**
+ * @brief Hängt ein getipptes Byte an den neuesten Eintrag an.
+ *
+ * Einfügen verlängert nur die neuen Bytes. Beim Überschreiben wachsen
+ * alte und neue Bytes, dafür werden die neuen Bytes um eine Stelle
+ * verschoben; `UNDO_JOURNAL_RUN_LIMIT` begrenzt diesen Aufwand.
+ *
+ * @return 1 wenn verlängert wurde, sonst 0
+ */
+static int try_extend(UndoJournal *self, size_t offset, size_t old_length, size_t new_length,
+                      unsigned char **old_out, unsigned char **new_out) {
+    if (!self->run_open || self->count == self->first || new_length != 1 || old_length > 1) {
+        return 0;
+    }
+    UndoRecord *top = &self->records[self->count - 1];
+    if (!top->typed || top->offset + top->new_length != offset ||
+        top->new_length >= UNDO_JOURNAL_RUN_LIMIT ||
+        (self->open_group && top->group != self->open_group)) {
+        return 0; // nicht direkt dahinter oder Eintrag voll
+    }
+    if (old_length == 0 ? top->old_length != 0 : top->old_length != top->new_length) {
+        return 0; // Einfügen und Überschreiben nicht mischen
+    }
+    size_t grow = old_length + new_length;
+    size_t end = top->payload + top->old_length + top->new_length;
+    size_t limit = ring_is_linear(self) ? self->capacity : self->records[self->first].payload;
+    if (end != self->head || limit - self->head < grow || self->used + grow > self->budget) {
+        return 0; // kein Platz direkt dahinter
+    }
+
+    unsigned char *base = self->ring + top->payload;
+    if (old_length > 0) { // neue Bytes verschieben, damit das alte Byte dazwischen passt
+        memmove(base + top->old_length + 1, base + top->old_length, top->new_length);
+    }
+    top->old_length += old_length;
+    *old_out = base + top->old_length - old_length;
+    *new_out = base + top->old_length + top->new_length;
+    top->new_length += new_length;
+    self->head += grow;
+    self->used += grow;
+    return 1;
+}
+
+/**
+ * @brief Reserviert zusammenhängenden Platz in der Arena.
+ *
+ * Zuerst wird hinter dem neuesten Eintrag gesucht, dann die Arena bis
+ * zum Budget vergrößert, dann am Anfang der Arena begonnen. Reicht das
+ * nicht, werden die ältesten Gruppen verdrängt.
+ *
+ * @return 0 bei Erfolg, sonst -1
+ */
+static int alloc_payload(UndoJournal *self, size_t length, size_t *position) {
+    while (1) {
+        int empty = (self->first == self->count);
+        if (empty) {
+            self->head = 0; // leere Arena beginnt von vorn
+        }
+        if (empty || ring_is_linear(self)) {
+            if (self->capacity - self->head >= length) {
+                break; // passt hinter den neuesten Eintrag
+            }
+            if (self->capacity < self->budget) {
+                grow_ring(self, self->head + length);
+                continue;
+            }
+            if (!empty && length <= self->records[self->first].payload) {
+                self->head = 0; // vor dem ältesten Eintrag ist genug frei
+                break;
+            }
+        } else if (self->records[self->first].payload - self->head >= length) {
+            break; // passt in die Lücke vor dem ältesten Eintrag
+        }
+        if (empty || evict_oldest(self) != 0) {
+            return -1;
+        }
+    }
+    *position = self->head;
+    self->head += length;
+    return 0;
+}
+
+/**
+ * @brief Prüft, ob die Einträge ohne Umbruch in der Arena liegen.
+ */
+static int ring_is_linear(const UndoJournal *self) {
+    return self->records[self->count - 1].payload >= self->records[self->first].payload;
+}
+
+/** @brief Vergrößert die Arena durch Verdoppeln, höchstens bis zum Budget. */
+static void grow_ring(UndoJournal *self, size_t needed) {
+    size_t capacity = self->capacity ? self->capacity : UNDO_RING_MIN_CAPACITY;
+    while (capacity < needed) {
+        capacity *= 2;
+    }
+    if (capacity > self->budget) {
+        capacity = self->budget;
+    }
+    unsigned char *grown = (unsigned char *)realloc(self->ring, capacity);
+    if (!grown) {
+        fatal_error("undo_journal", "out of memory");
+    }
+    self->ring = grown;
+    self->capacity = capacity;
+}
+
+/**
+ * @brief Stellt sicher, dass hinter dem neuesten Eintrag ein Platz frei ist.
+ *
+ * Sind mindestens die Hälfte der Plätze durch verdrängte Einträge frei,
+ * werden die Einträge nach vorn geschoben, sonst wird das Feld verdoppelt.
+ */
+static void reserve_record(UndoJournal *self) {
+    if (self->count < self->record_capacity) {
+        return;
+    }
+    if (self->first > 0 && self->first >= self->record_capacity / 2) {
+        memmove(self->records, self->records + self->first,
+                (self->count - self->first) * sizeof(UndoRecord));
+        self->count -= self->first;
+        self->applied -= self->first;
+        self->first = 0;
+        return;
+    }
+    size_t capacity = self->record_capacity ? self->record_capacity * 2
+                                            : UNDO_RECORDS_MIN_CAPACITY;
+    UndoRecord *grown = (UndoRecord *)realloc(self->records, capacity * sizeof(UndoRecord));
+    if (!grown) {
+        fatal_error("undo_journal", "out of memory");
+    }
+    self->records = grown;
+    self->record_capacity = capacity;
+}
+
+/**
+ * @brief Verdrängt die älteste Gruppe.
+ *
+ * Die offene Gruppe wird nie teilweise verdrängt, sonst ließe sie sich
+ * nicht mehr vollständig zurücknehmen.
+ *
+ * @return 0 bei Erfolg, -1 wenn nichts verdrängt werden kann
+ */
+static int evict_oldest(UndoJournal *self) {
+    if (self->first == self->count) {
+        return -1;
+    }
+    unsigned long group = self->records[self->first].group;
+    if (self->open_group && group == self->open_group) {
+        return -1;
+    }
+    while (self->first < self->count && self->records[self->first].group == group) {
+        self->used -= record_cost(&self->records[self->first]);
+        self->first++;
+    }
+    if (self->applied < self->first) {
+        self->applied = self->first;
+    }
+    if (self->first == self->count) {
+        undo_journal_clear(self); // letzte Gruppe verdrängt
+    }
+    return 0;
+}
+
+/** @brief Verwirft alle zurückgenommenen, noch nicht wiederholten Einträge. */
+static void truncate_redo(UndoJournal *self) {
+    if (self->applied == self->count) {
+        return;
+    }
+    if (self->applied == self->first) {
+        undo_journal_clear(self); // alles war zurückgenommen
+        return;
+    }
+    for (size_t i = self->applied; i < self->count; i++) {
+        self->used -= record_cost(&self->records[i]);
+    }
+    self->count = self->applied;
+    const UndoRecord *newest = &self->records[self->count - 1];
+    self->head = newest->payload + newest->old_length + newest->new_length;
+}
+
+/**
+ * @brief Leert das Journal, wenn eine Bearbeitung nicht mehr hineinpasst.
+ *
+ * Eine offene Gruppe bleibt bis zu ihrem Ende ohne Aufzeichnung, damit
+ * nicht nur ihr hinterer Teil zurückgenommen werden kann.
+ */
+static void give_up(UndoJournal *self) {
+    undo_journal_clear(self);
+    if (self->group_depth > 0) {
+        self->discard_group = 1;
+    }
+}
+
+/** @brief Anteil eines Eintrags am Budget. */
+static size_t record_cost(const UndoRecord *record) {
+    return sizeof(UndoRecord) + record->old_length + record->new_length;
+}
+
+//* ----------------------------------- Init und Deinit -----------------------------------
+/**
+ * @brief Initialisiert ein leeres Journal.
+ *
+ * Arena und Feld der Einträge werden erst bei der ersten Bearbeitung
+ * angelegt.
+ *
+ * @param self   Zeiger auf das Journal
+ * @param budget Obergrenze in Bytes, 0 = `UNDO_JOURNAL_DEFAULT_BUDGET`
+ * @return 0 bei Erfolg
+ */
+int undo_journal_init(UndoJournal *self, size_t budget) {
+    memset(self, 0, sizeof(*self));
+    self->budget = budget ? budget : UNDO_JOURNAL_DEFAULT_BUDGET;
+    return 0;
+}
+
+/**
+ * @brief Gibt Arena und Einträge frei.
+ * @param self Zeiger auf das Journal
+ * @return 0 bei Erfolg
+ */
+int undo_journal_deinit(UndoJournal *self) {
+    free(self->ring);
+    free(self->records);
+    memset(self, 0, sizeof(*self));
+    return 0;
+}
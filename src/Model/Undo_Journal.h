@@ -0,0 +1,165 @@
+#ifndef UNDO_JOURNAL_H
+#define UNDO_JOURNAL_H
+
+/**
+ * @file Undo_Journal.h
+ * @brief Schnittstelle des Journals für Rückgängig und Wiederholen.
+ *
+ * Jede Bearbeitung wird als Delta aus Position, alten und neuen Bytes
+ * festgehalten. Die Bytes liegen in einer Ring-Arena mit festem
+ * Speicherbudget; ist es ausgeschöpft, werden die ältesten Einträge
+ * verdrängt. Fortlaufend getippte Bytes werden zu einem einzigen Eintrag
+ * zusammengefasst, und Einträge einer Gruppe werden gemeinsam
+ * zurückgenommen. Auch große Bereiche kosten so beim Zurücknehmen nur
+ * ein Kopieren am Stück.
+ */
+
+#include <stddef.h> // stellt den Typ size_t bereit
+
+//* ---------------------------- Globale Konstanten oder Defines --------------------------
+#define UNDO_JOURNAL_DEFAULT_BUDGET (64u * 1024u * 1024u) /**< Budget ohne Vorgabe in Bytes */
+#define UNDO_JOURNAL_RUN_LIMIT 4096                        /**< höchstens so viele getippte Bytes pro Eintrag */
+
+//* ------------------------------------- Strukturen --------------------------------------
+/**
+ * @brief Eine Bearbeitung: `old_length` Bytes ab `offset` wurden durch `new_length` Bytes ersetzt.
+ *
+ * In der Arena liegen ab `payload` zuerst die alten, direkt danach die
+ * neuen Bytes.
+ */
+typedef struct {
+    size_t offset;       /**< Position im Inhalt */
+    size_t old_length;   /**< Anzahl der ersetzten Bytes */
+    size_t new_length;   /**< Anzahl der eingesetzten Bytes */
+    size_t payload;      /**< Start der Bytes in der Arena */
+    unsigned long group; /**< Einträge derselben Gruppe werden gemeinsam zurückgenommen */
+    int typed;           /**< 1, wenn der Eintrag aus getippten Bytes besteht */
+} UndoRecord;
+
+/**
+ * @brief Journal aller Bearbeitungen seit dem Laden.
+ *
+ * Die Einträge `records[first]` bis `records[count - 1]` sind von alt
+ * nach neu geordnet. Einträge vor `applied` sind angewendet und können
+ * zurückgenommen werden, die übrigen wiederholt.
+ */
+typedef struct {
+    unsigned char *ring;      /**< Ring-Arena für alte und neue Bytes */
+    size_t capacity;          /**< reservierte Bytes der Arena */
+    size_t head;              /**< nächste freie Position in der Arena */
+    UndoRecord *records;      /**< Einträge, ältester bei `first` */
+    size_t first;             /**< Index des ältesten Eintrags */
+    size_t count;             /**< Index hinter dem neuesten Eintrag */
+    size_t applied;           /**< Index hinter dem letzten angewendeten Eintrag */
+    size_t record_capacity;   /**< Plätze im Feld der Einträge */
+    size_t budget;            /**< Obergrenze für Bytes und Einträge zusammen */
+    size_t used;              /**< derzeit belegter Anteil des Budgets */
+    unsigned long next_group; /**< zuletzt vergebene Gruppennummer */
+    unsigned long open_group; /**< Nummer der offenen Gruppe, 0 = keine */
+    int group_depth;          /**< Verschachtelungstiefe der offenen Gruppe */
+    int discard_group;        /**< 1, wenn die offene Gruppe nicht mehr ins Budget passt */
+    int run_open;             /**< 1, solange der neueste Eintrag verlängert werden darf */
+} UndoJournal;
+
+//* ------------------------------------- Funktionen --------------------------------------
+/**
+ * @brief Reserviert Platz für eine neue Bearbeitung.
+ *
+ * Der Aufrufer füllt danach die alten und neuen Bytes über `old_out`
+ * und `new_out`. Die Zeiger bleiben bis zum nächsten Aufruf einer
+ * Journal-Funktion gültig.
+ *
+ * @param self       Zeiger auf das Journal
+ * @param offset     Position im Inhalt
+ * @param old_length Anzahl der ersetzten Bytes
+ * @param new_length Anzahl der eingesetzten Bytes
+ * @param typed      1 = getipptes Byte, darf an den neuesten Eintrag angehängt werden
+ * @param old_out    erhält das Ziel für die alten Bytes
+ * @param new_out    erhält das Ziel für die neuen Bytes
+ * @return 0 bei Erfolg, -1 wenn die Bearbeitung nicht ins Budget passt
+ */
+int undo_journal_record(UndoJournal *self, size_t offset, size_t old_length,
+                        size_t new_length, int typed, unsigned char **old_out,
+                        unsigned char **new_out);
+
+/**
+ * @brief Nimmt die jüngste angewendete Gruppe zurück.
+ * @param self  Zeiger auf das Journal
+ * @param first erhält den ältesten Eintrag der Gruppe, die übrigen folgen direkt
+ * @return Anzahl der Einträge, 0 wenn nichts zurückzunehmen ist
+ */
+size_t undo_journal_undo(UndoJournal *self, const UndoRecord **first);
+
+/**
+ * @brief Wendet die zuletzt zurückgenommene Gruppe erneut an.
+ * @param self  Zeiger auf das Journal
+ * @param first erhält den ältesten Eintrag der Gruppe, die übrigen folgen direkt
+ * @return Anzahl der Einträge, 0 wenn nichts zu wiederholen ist
+ */
+size_t undo_journal_redo(UndoJournal *self, const UndoRecord **first);
+
+/**
+ * @brief Prüft, ob ein an `offset` überschriebenes getipptes Byte den laufenden Eintrag fortsetzt.
+ */
+int undo_journal_continues_run(const UndoJournal *self, size_t offset);
+
+/**
+ * @brief Prüft, ob eine Gruppe aus `records` Einträgen mit zusammen `bytes` alten und neuen Bytes ins Budget passt.
+ */
+int undo_journal_fits(const UndoJournal *self, size_t records, size_t bytes);
+
+/**
+ * @brief Prüft, ob es einen Schritt zum Zurücknehmen gibt.
+ */
+static inline int undo_journal_can_undo(const UndoJournal *self) {
+    return self->applied > self->first;
+}
+
+/**
+ * @brief Beginnt eine Gruppe, die in einem Schritt zurückgenommen wird.
+ *
+ * Gruppen dürfen verschachtelt werden, es zählt die äußerste.
+ */
+void undo_journal_begin_group(UndoJournal *self);
+
+/**
+ * @brief Beendet die mit `undo_journal_begin_group` begonnene Gruppe.
+ */
+void undo_journal_end_group(UndoJournal *self);
+
+/**
+ * @brief Verwirft alle Einträge.
+ */
+void undo_journal_clear(UndoJournal *self);
+
+/**
+ * @brief Liefert die alten Bytes eines Eintrags.
+ */
+static inline const unsigned char *undo_journal_old_bytes(const UndoJournal *self,
+                                                          const UndoRecord *record) {
+    return self->ring + record->payload;
+}
+
+/**
+ * @brief Liefert die neuen Bytes eines Eintrags.
+ */
+static inline const unsigned char *undo_journal_new_bytes(const UndoJournal *self,
+                                                          const UndoRecord *record) {
+    return self->ring + record->payload + record->old_length;
+}
+
+//* ----------------------------------- Init und Deinit -----------------------------------
+/**
+ * @brief Initialisiert ein leeres Journal.
+ * @param self   Zeiger auf das Journal
+ * @param budget Obergrenze in Bytes, 0 = `UNDO_JOURNAL_DEFAULT_BUDGET`
+ * @return 0 bei Erfolg
+ */
+int undo_journal_init(UndoJournal *self, size_t budget);
+
+/**
+ * @brief Gibt Arena und Einträge frei.
+ */
+int undo_journal_deinit(UndoJournal *self);
+
+#endif // UNDO_JOURNAL_H
@@ -0,0 +1,467 @@
+/**
+ * @file Value_Format.c
+ * @brief Zahlenwerte aus 2, 4 oder 8 Bytes lesen, formatieren und eingeben.
+ *
+ * Eine Zeile wird in einem Aufruf formatiert. Hexadezimale Typen werden
+ * in Big-Endian-Reihenfolge gebracht und mit dem Hex-Kern der
+ * Textausgabe in einem Stück umgewandelt. Dezimalzahlen entstehen von
+ * hinten mit einer Tabelle aller zweistelligen Ziffernpaare.
+ * Gleitkommawerte werden mit Zehnerpotenzen aus zwei Tabellen auf eine
+ * ganze Zahl mit 6 bzw. 15 Stellen skaliert, die dieselbe Tabelle in
+ * Ziffern wandelt; die Schreibweise entspricht `%g`.
+ */
+
+//* -------------------------------------- Includes ---------------------------------------
+#include "Value_Format.h"  // Schnittstelle dieses Moduls
+#include <ctype.h>          // isdigit und isxdigit
+#include <errno.h>          // Bereichsfehler von strtoull und strtod
+#include <math.h>           // isinf für Überläufe bei der Eingabe
+#include <stdlib.h>         // strtoull, strtoll, strtof und strtod
+#include <string.h>         // memcpy, memset und strncmp
+#include "Dump_Export.h"   // Hex-Kern für ganze Zeilen
+
+//* ---------------------------- Globale Konstanten oder Defines --------------------------
+#define HEX_CHUNK 64        /**< Bytes, die je Aufruf des Hex-Kerns umgeordnet werden */
+#define POW10_STEP 28       /**< Abstand der großen Zehnerpotenzen, 10^27 ist in long double exakt */
+#define F32_DIGITS 6        /**< signifikante Stellen von f32, überstehen jede Umwandlung */
+#define F64_DIGITS 15       /**< signifikante Stellen von f64 */
+
+/**
+ * @brief Eigenschaften eines Typs.
+ */
+typedef struct {
+    const char *name; /**< Name ohne Byte-Reihenfolge */
+    int size;         /**< Breite in Bytes */
+    int width;        /**< größte Anzahl Zeichen, etwa `-32768` für s16 */
+} ValueInfo;
+
+/** Eigenschaften in der Reihenfolge von `ValueType` */
+static const ValueInfo VALUE_INFO[VALUE_TYPE_COUNT] = {
+    {"u16", 2, 5},  {"s16", 2, 6},  {"x16", 2, 4},
+    {"u32", 4, 10}, {"s32", 4, 11}, {"x32", 4, 8},
+    {"u64", 8, 20}, {"s64", 8, 20}, {"x64", 8, 16},
+    {"f32", 4, 12}, {"f64", 8, 22}
+};
+
+/** Ziffernpaare 00 bis 99 */
+static const char DIGIT_PAIRS[200] =
+    "0001020304050607080910111213141516171819"
+    "2021222324252627282930313233343536373839"
+    "4041424344454647484950515253545556575859"
+    "6061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+/** 10^0 bis 10^27, alle exakt darstellbar */
+static const long double POW10_SMALL[POW10_STEP] = {
+    1e0L,  1e1L,  1e2L,  1e3L,  1e4L,  1e5L,  1e6L,  1e7L,  1e8L,  1e9L,
+    1e10L, 1e11L, 1e12L, 1e13L, 1e14L, 1e15L, 1e16L, 1e17L, 1e18L, 1e19L,
+    1e20L, 1e21L, 1e22L, 1e23L, 1e24L, 1e25L, 1e26L, 1e27L
+};
+
+/** 10^(28 * i), reicht mit 15 Stellen bis unter die kleinste Subnormale */
+static const long double POW10_LARGE[] = {
+    1e0L,   1e28L,  1e56L,  1e84L,  1e112L, 1e140L, 1e168L,
+    1e196L, 1e224L, 1e252L, 1e280L, 1e308L, 1e336L
+};
+
+// Vorwärtsdeklarationen der Helferfunktionen
+static void format_hex_row(int size, int bigEndian, const unsigned char *bytes, size_t count,
+                           char *out);
+static void format_cell(ValueType type, uint64_t raw, char *cell, int width);
+static char *put_decimal(uint64_t value, char *end);
+static int format_float(double value, int digits, char *out);
+static long double scale10(long double value, int exponent);
+static int floor_log10_pow2(int exponent);
+
+//* ------------------------------------- Funktionen --------------------------------------
+/**
+ * @brief Übersetzt einen Typnamen samt optionaler Byte-Reihenfolge.
+ */
+int value_type_parse(const char *name, ValueType *type, int *bigEndian) {
+    for (int candidate = 0; candidate < VALUE_TYPE_COUNT; candidate++) {
+        const char *prefix = VALUE_INFO[candidate].name;
+        size_t length = strlen(prefix);
+        if (strncmp(name, prefix, length) != 0) {
+            continue;
+        }
+        const char *order = name + length;
+        if (*order != '\0' && strcmp(order, "le") != 0 && strcmp(order, "be") != 0) {
+            return -1;
+        }
+        *type = (ValueType)candidate;
+        *bigEndian = (strcmp(order, "be") == 0);
+        return 0;
+    }
+    return -1;
+}
+
+/**
+ * @brief Liefert den Namen eines Typs.
+ */
+const char *value_type_name(ValueType type) {
+    return VALUE_INFO[type].name;
+}
+
+/**
+ * @brief Liefert die Breite eines Elements in Bytes.
+ */
+int value_type_size(ValueType type) {
+    return VALUE_INFO[type].size;
+}
+
+/**
+ * @brief Liefert die größte Anzahl Zeichen eines formatierten Werts.
+ */
+int value_type_width(ValueType type) {
+    return VALUE_INFO[type].width;
+}
+
+/**
+ * @brief Prüft, ob ein Zeichen in der Eingabe eines Werts vorkommen kann.
+ *
+ * Gleitkommatypen erlauben zusätzlich Exponent, `inf` und `nan`.
+ */
+int value_type_accepts(ValueType type, int ch) {
+    if (ch <= 0 || ch > 127) {
+        return 0; // Funktionstasten und Nicht-ASCII
+    }
+    switch (type) {
+    case VALUE_X16:
+    case VALUE_X32:
+    case VALUE_X64:
+        return isxdigit(ch) || ch == 'x' || ch == 'X';
+    case VALUE_U16:
+    case VALUE_U32:
+    case VALUE_U64:
+        return isdigit(ch);
+    case VALUE_S16:
+    case VALUE_S32:
+    case VALUE_S64:
+        return isdigit(ch) || ch == '-' || ch == '+';
+    default:
+        return isdigit(ch) || strchr("+-.eEinfaINFA", ch) != NULL;
+    }
+}
+
+/**
+ * @brief Liest einen Rohwert aus 1 bis 8 Bytes.
+ */
+uint64_t value_load(const unsigned char *bytes, int size, int bigEndian) {
+    uint64_t value = 0;
+    if (bigEndian) {
+        for (int i = 0; i < size; i++) {
+            value = (value << 8) | bytes[i];
+        }
+    } else {
+        for (int i = size - 1; i >= 0; i--) {
+            value = (value << 8) | bytes[i];
+        }
+    }
+    return value;
+}
+
+/**
+ * @brief Formatiert aufeinanderfolgende Elemente rechtsbündig in Spalten.
+ */
+void value_format_row(ValueType type, int bigEndian, const unsigned char *bytes, size_t count,
+                      char *out) {
+    int size = VALUE_INFO[type].size;
+    int width = VALUE_INFO[type].width;
+    if (type == VALUE_X16 || type == VALUE_X32 || type == VALUE_X64) {
+        format_hex_row(size, bigEndian, bytes, count, out); // Breite ist genau zwei Ziffern je Byte
+        return;
+    }
+    for (size_t i = 0; i < count; i++) {
+        uint64_t raw = value_load(bytes + i * (size_t)size, size, bigEndian);
+        format_cell(type, raw, out + i * (size_t)width, width);
+    }
+}
+
+/**
+ * @brief Formatiert ein Element als Text ohne führende Leerzeichen.
+ */
+void value_format(ValueType type, int bigEndian, const unsigned char *bytes, char *out) {
+    int width = VALUE_INFO[type].width;
+    char cell[VALUE_TEXT_MAX];
+    value_format_row(type, bigEndian, bytes, 1, cell);
+    int start = 0;
+    while (start < width - 1 && cell[start] == ' ') {
+        start++;
+    }
+    memcpy(out, cell + start, (size_t)(width - start));
+    out[width - start] = '\0';
+}
+
+/**
+ * @brief Wandelt eingegebenen Text in die Bytes eines Elements.
+ */
+int value_parse(ValueType type, int bigEndian, const char *text, unsigned char *out) {
+    int size = VALUE_INFO[type].size;
+    uint64_t mask = (size == 8) ? UINT64_MAX : ((uint64_t)1 << (8 * size)) - 1u;
+    uint64_t raw;
+    char *end;
+    errno = 0;
+    switch (type) {
+    case VALUE_X16:
+    case VALUE_X32:
+    case VALUE_X64:
+        if (text[0] == '0' && (text[1] == 'x' || text[1] == 'X')) {
+            text += 2; // optionales Präfix
+        }
+        if (!isxdigit((unsigned char)text[0])) {
+            return -1; // strtoull nähme auch Leerzeichen und Vorzeichen
+        }
+        raw = strtoull(text, &end, 16);
+        if (*end != '\0' || errno == ERANGE || raw > mask) {
+            return -1;
+        }
+        break;
+    case VALUE_U16:
+    case VALUE_U32:
+    case VALUE_U64:
+        if (!isdigit((unsigned char)text[0])) {
+            return -1;
+        }
+        raw = strtoull(text, &end, 10);
+        if (*end != '\0' || errno == ERANGE || raw > mask) {
+            return -1;
+        }
+        break;
+    case VALUE_S16:
+    case VALUE_S32:
+    case VALUE_S64: {
+        if (!isdigit((unsigned char)text[0]) && text[0] != '-' && text[0] != '+') {
+            return -1;
+        }
+        long long value = strtoll(text, &end, 10);
+        long long limit = (long long)(mask >> 1); // größter positiver Wert
+        if (end == text || *end != '\0' || errno == ERANGE || value > limit || value < -limit - 1) {
+            return -1;
+        }
+        raw = (uint64_t)value & mask;
+        break;
+    }
+    case VALUE_F32: {
+        float value = strtof(text, &end);
+        if (end == text || *end != '\0' || (errno == ERANGE && isinf(value))) {
+            return -1; // zu groß für f32
+        }
+        uint32_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        raw = bits;
+        break;
+    }
+    default: {
+        double value = strtod(text, &end);
+        if (end == text || *end != '\0' || (errno == ERANGE && isinf(value))) {
+            return -1;
+        }
+        memcpy(&raw, &value, sizeof(raw));
+        break;
+    }
+    }
+    for (int i = 0; i < size; i++) {
+        out[bigEndian ? size - 1 - i : i] = (unsigned char)(raw >> (8 * i));
+    }
+    return 0;
+}
+
+//* ---------------------------------- Helfer Funktionen ----------------------------------
+/**
+ * @brief Formatiert hexadezimale Elemente einer Zeile.
+ *
+ * Die Bytes werden blockweise in Big-Endian-Reihenfolge gebracht; danach
+ * stehen die Hex-Ziffern des Kerns bereits in der richtigen Reihenfolge.
+ */
+static void format_hex_row(int size, int bigEndian, const unsigned char *bytes, size_t count,
+                           char *out) {
+    size_t length = count * (size_t)size;
+    if (bigEndian) {
+        dump_hex(bytes, length, out, 0);
+        return;
+    }
+    unsigned char ordered[HEX_CHUNK];
+    for (size_t done = 0; done < length; done += HEX_CHUNK) {
+        size_t chunk = (length - done < HEX_CHUNK) ? length - done : HEX_CHUNK; // Vielfaches von size
+        for (size_t i = 0; i < chunk; i += (size_t)size) {
+            for (int b = 0; b < size; b++) {
+                ordered[i + (size_t)b] = bytes[done + i + (size_t)(size - 1 - b)];
+            }
+        }
+        dump_hex(ordered, chunk, out + 2 * done, 0);
+    }
+}
+
+// Schreibt einen Rohwert rechtsbündig in eine Spalte der angegebenen Breite
+static void format_cell(ValueType type, uint64_t raw, char *cell, int width) {
+    char *end = cell + width;
+    char *start;
+    switch (type) {
+    case VALUE_S16:
+    case VALUE_S32:
+    case VALUE_S64: {
+        int shift = 64 - 8 * VALUE_INFO[type].size;
+        int64_t value = (int64_t)(raw << shift) >> shift; // Vorzeichen erweitern
+        start = put_decimal((value < 0) ? 0u - (uint64_t)value : (uint64_t)value, end);
+        if (value < 0) {
+            *--start = '-';
+        }
+        break;
+    }
+    case VALUE_F32:
+    case VALUE_F64: {
+        double value;
+        if (type == VALUE_F32) {
+            uint32_t bits = (uint32_t)raw;
+            float single;
+            memcpy(&single, &bits, sizeof(single));
+            value = single;
+        } else {
+            memcpy(&value, &raw, sizeof(value));
+        }
+        char text[VALUE_TEXT_MAX];
+        int length = format_float(value, (type == VALUE_F32) ? F32_DIGITS : F64_DIGITS, text);
+        start = end - length;
+        memcpy(start, text, (size_t)length);
+        break;
+    }
+    default:
+        start = put_decimal(raw, end);
+        break;
+    }
+    memset(cell, ' ', (size_t)(start - cell));
+}
+
+// Schreibt die Dezimalziffern eines Werts rückwärts bis `end`, liefert die erste Ziffer
+static char *put_decimal(uint64_t value, char *end) {
+    char *out = end;
+    while (value >= 100u) {
+        unsigned int pair = (unsigned int)(value % 100u);
+        value /= 100u;
+        out -= 2;
+        memcpy(out, DIGIT_PAIRS + 2 * pair, 2);
+    }
+    if (value >= 10u) {
+        out -= 2;
+        memcpy(out, DIGIT_PAIRS + 2 * value, 2);
+    } else {
+        *--out = (char)('0' + value);
+    }
+    return out;
+}
+
+/**
+ * @brief Formatiert einen Gleitkommawert wie `%.<digits>g`.
+ *
+ * Der Betrag wird mit einer Zehnerpotenz so skaliert, dass sein ganzzahliger
+ * Teil genau `digits` Stellen hat; die Schätzung des Exponenten aus dem
+ * Zweierexponenten liegt höchstens um eins daneben und wird korrigiert.
+ * Nachfolgende Nullen entfallen. Bei f64 weicht die letzte Stelle in
+ * seltenen Fällen knapp an der Rundungsgrenze um eins von `printf` ab.
+ *
+ * @return Anzahl der geschriebenen Zeichen, ohne Abschluss
+ */
+static int format_float(double value, int digits, char *out) {
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    int length = 0;
+    if (bits >> 63) {
+        out[length++] = '-';
+    }
+    int biased = (int)((bits >> 52) & 0x7FFu);
+    uint64_t fraction = bits & (((uint64_t)1 << 52) - 1u);
+    if (biased == 0x7FF) {
+        memcpy(out + length, fraction ? "nan" : "inf", 3);
+        return length + 3;
+    }
+    if (biased == 0 && fraction == 0) {
+        out[length++] = '0';
+        return length;
+    }
+    int exponent2 = biased - 1023;
+    if (biased == 0) { // subnormal: Exponent am höchsten gesetzten Bit
+        exponent2 = -1022;
+        while (!(fraction & ((uint64_t)1 << 52))) {
+            fraction <<= 1;
+            exponent2--;
+        }
+    }
+    long double magnitude = (bits >> 63) ? -(long double)value : (long double)value;
+    int exponent = floor_log10_pow2(exponent2);
+    long double scaled = scale10(magnitude, digits - 1 - exponent);
+    if (scaled >= POW10_SMALL[digits]) {
+        exponent++;
+        scaled = scale10(magnitude, digits - 1 - exponent);
+    } else if (scaled < POW10_SMALL[digits - 1]) {
+        exponent--;
+        scaled = scale10(magnitude, digits - 1 - exponent);
+    }
+    uint64_t mantissa = (uint64_t)scaled;
+    long double rest = scaled - (long double)mantissa;
+    if (rest > 0.5L || (rest == 0.5L && (mantissa & 1u))) {
+        mantissa++; // genau in der Mitte zur geraden Ziffer wie printf
+    }
+    if ((long double)mantissa >= POW10_SMALL[digits]) {
+        mantissa /= 10u; // Rundung auf die nächste Zehnerpotenz
+        exponent++;
+    }
+
+    char figures[24];
+    put_decimal(mantissa, figures + digits); // genau `digits` Ziffern
+    int significant = digits;
+    while (significant > 1 && figures[significant - 1] == '0') {
+        significant--;
+    }
+
+    if (exponent < -4 || exponent >= digits) { // wissenschaftliche Schreibweise
+        out[length++] = figures[0];
+        if (significant > 1) {
+            out[length++] = '.';
+            memcpy(out + length, figures + 1, (size_t)(significant - 1));
+            length += significant - 1;
+        }
+        out[length++] = 'e';
+        out[length++] = (exponent < 0) ? '-' : '+';
+        unsigned int power = (unsigned int)((exponent < 0) ? -exponent : exponent);
+        if (power >= 100u) {
+            out[length++] = (char)('0' + power / 100u);
+            power %= 100u;
+        }
+        memcpy(out + length, DIGIT_PAIRS + 2 * power, 2);
+        return length + 2;
+    }
+    if (exponent < 0) { // 0.000ddd
+        out[length++] = '0';
+        out[length++] = '.';
+        memset(out + length, '0', (size_t)(-exponent - 1));
+        length += -exponent - 1;
+        memcpy(out + length, figures, (size_t)significant);
+        return length + significant;
+    }
+    int integral = exponent + 1; // Stellen vor dem Komma
+    if (significant <= integral) {
+        memcpy(out + length, figures, (size_t)significant);
+        memset(out + length + significant, '0', (size_t)(integral - significant));
+        return length + integral;
+    }
+    memcpy(out + length, figures, (size_t)integral);
+    length += integral;
+    out[length++] = '.';
+    memcpy(out + length, figures + integral, (size_t)(significant - integral));
+    return length + significant - integral;
+}
+
+// Multipliziert mit 10^exponent, negative Exponenten teilen
+static long double scale10(long double value, int exponent) {
+    int magnitude = (exponent < 0) ? -exponent : exponent;
+    long double factor = POW10_SMALL[magnitude % POW10_STEP] * POW10_LARGE[magnitude / POW10_STEP];
+    return (exponent < 0) ? value / factor : value * factor;
+}
+
+// floor(exponent * log10(2)) für |exponent| < 1700, 78913 / 2^18 nähert log10(2)
+static int floor_log10_pow2(int exponent) {
+    int product = exponent * 78913;
+    return (product >= 0) ? product / 262144 : -((-product + 262143) / 262144);
+}
+
+//* ----------------------------------- Init und Deinit -----------------------------------
@@ -0,0 +1,105 @@
+#ifndef VALUE_FORMAT_H
+#define VALUE_FORMAT_H
+
+/**
+ * @file Value_Format.h
+ * @brief Schnittstelle für Zahlenwerte aus 2, 4 oder 8 Bytes.
+ *
+ * Ganzzahlen mit und ohne Vorzeichen, hexadezimal und IEEE-754-Gleitkomma
+ * werden in Little- oder Big-Endian gelesen, zeilenweise als Text in
+ * Spalten fester Breite formatiert und aus eingegebenem Text wieder in
+ * Bytes gewandelt. Die Formatierung kommt ohne `printf` aus.
+ */
+
+#include <stddef.h> // stellt den Typ size_t bereit
+#include <stdint.h> // feste Breiten für Rohwerte
+
+//* ---------------------------- Globale Konstanten oder Defines --------------------------
+#define VALUE_TEXT_MAX 32 /**< Platz für einen Wert als Text samt Abschluss */
+#define VALUE_SIZE_MAX 8  /**< größte Elementbreite in Bytes */
+
+//* ------------------------------------- Strukturen --------------------------------------
+/**
+ * @brief Typ eines Elements.
+ *
+ * `u` ohne, `s` mit Vorzeichen, `x` hexadezimal, `f` Gleitkomma; die
+ * Zahl ist die Breite in Bit.
+ */
+typedef enum {
+    VALUE_U16,       /**< 16 Bit ohne Vorzeichen */
+    VALUE_S16,       /**< 16 Bit mit Vorzeichen */
+    VALUE_X16,       /**< 16 Bit hexadezimal */
+    VALUE_U32,       /**< 32 Bit ohne Vorzeichen */
+    VALUE_S32,       /**< 32 Bit mit Vorzeichen */
+    VALUE_X32,       /**< 32 Bit hexadezimal */
+    VALUE_U64,       /**< 64 Bit ohne Vorzeichen */
+    VALUE_S64,       /**< 64 Bit mit Vorzeichen */
+    VALUE_X64,       /**< 64 Bit hexadezimal */
+    VALUE_F32,       /**< IEEE-754 einfache Genauigkeit, 6 signifikante Stellen */
+    VALUE_F64,       /**< IEEE-754 doppelte Genauigkeit, 15 signifikante Stellen */
+    VALUE_TYPE_COUNT /**< Anzahl der Typen */
+} ValueType;
+
+//* ------------------------------------- Funktionen --------------------------------------
+/**
+ * @brief Übersetzt einen Typnamen wie `u16`, `s32be` oder `f64le`.
+ *
+ * Ohne Endung `le` oder `be` gilt Little-Endian.
+ *
+ * @return 0 bei Erfolg, -1 bei unbekanntem Namen
+ */
+int value_type_parse(const char *name, ValueType *type, int *bigEndian);
+
+/** Liefert den Namen eines Typs ohne Byte-Reihenfolge, etwa `f32`. */
+const char *value_type_name(ValueType type);
+
+/** Liefert die Breite eines Elements in Bytes. */
+int value_type_size(ValueType type);
+
+/** Liefert die größte Anzahl Zeichen eines formatierten Werts. */
+int value_type_width(ValueType type);
+
+/** Prüft, ob ein Zeichen in der Eingabe eines Werts vorkommen kann. */
+int value_type_accepts(ValueType type, int ch);
+
+/**
+ * @brief Liest einen Rohwert aus 1 bis 8 Bytes.
+ * @param bytes     Eingabebytes
+ * @param size      Anzahl der Bytes
+ * @param bigEndian 1 = höchstwertiges Byte zuerst
+ */
+uint64_t value_load(const unsigned char *bytes, int size, int bigEndian);
+
+/**
+ * @brief Formatiert aufeinanderfolgende Elemente rechtsbündig in Spalten.
+ *
+ * Jedes Element belegt genau `value_type_width` Zeichen, ohne Trenner
+ * und ohne Abschluss.
+ *
+ * @param type      Elementtyp
+ * @param bigEndian 1 = Big-Endian
+ * @param bytes     `count * value_type_size` Eingabebytes
+ * @param count     Anzahl der Elemente
+ * @param out       erhält `count * value_type_width` Zeichen
+ */
+void value_format_row(ValueType type, int bigEndian, const unsigned char *bytes, size_t count,
+                      char *out);
+
+/**
+ * @brief Formatiert ein Element als Text ohne führende Leerzeichen.
+ * @param out erhält höchstens `VALUE_TEXT_MAX` Zeichen samt Abschluss
+ */
+void value_format(ValueType type, int bigEndian, const unsigned char *bytes, char *out);
+
+/**
+ * @brief Wandelt eingegebenen Text in die Bytes eines Elements.
+ *
+ * Hexadezimale Typen erwarten Hex-Ziffern, optional mit `0x`, die
+ * übrigen Dezimalzahlen. Werte außerhalb des Typs werden abgelehnt.
+ *
+ * @param out erhält `value_type_size` Bytes in der gewählten Reihenfolge
+ * @return 0 bei Erfolg, -1 bei ungültigem Text
+ */
+int value_parse(ValueType type, int bigEndian, const char *text, unsigned char *out);
+
+#endif // VALUE_FORMAT_H
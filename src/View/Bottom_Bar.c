@@ -4,32 +4,37 @@
  *
  * Dieses Modul setzt die in `Bottom_Bar.h` deklarierten Funktionen
  * um. Es visualisiert Dateistatus und Byteinformationen, berechnet
- * unterschiedliche numerische Interpretationen und nutzt dazu den
- * `Editor` sowie den `DataBuffer`. Fehler bei der Darstellung werden
+ * unterschiedliche numerische Interpretationen in der Byte-Reihenfolge
+ * der Werteansicht und nutzt dazu den `Editor` sowie den `DataBuffer`. Fehler bei der Darstellung werden
  * über das zentrale Fehlerlog gemeldet.
  */
 
 //* -------------------------------------- Includes ---------------------------------------
 #include "Bottom_Bar.h"      // eigene Schnittstelle einbinden
+#include <stdio.h>            // snprintf für Meldungen
 #include <string.h>           // Funktionen wie memset
 #include <stdint.h>           // feste Breiten für Integer-Typen
 #include "Err_Log.h"         // Fehlerbehandlung und Logging
 #include "Ncurses_Check.h"   // Makro zur Fehlerkontrolle
+#include "Value_Format.h"    // Rohwerte lesen und Gleitkomma formatieren
 
 //* ---------------------------- Globale Konstanten oder Defines --------------------------
 
 //* ------------------------------------- Funktionen --------------------------------------
-// Vorwärtsdeklaration der Helferfunktion zur Byte-Interpretation
-static unsigned long long read_unsigned_le(const DataBuffer *buffer, size_t index,
-                                           int byteCount); // Anzahl der Bytes
+// Vorwärtsdeklaration der Helferfunktion
+static void show_text(BottomBar *self, const char *text); // Text ausgeben, falls geändert
 
 /**
  * @brief Zeichnet Status und Byte-Informationen.
+ *
+ * Der Text wird jedes Mal zusammengesetzt, ins Fenster geschrieben
+ * aber nur, wenn er sich vom zuletzt gezeigten unterscheidet.
  */
 void bottom_bar_draw(BottomBar *self, const Editor *editor, const DataBuffer *buffer) {
-    NCURSES_CHECK(wmove(self->win, 1, 1));          // Cursor auf Innenbereich setzen
-    NCURSES_CHECK(wclrtoeol(self->win));            // Zeile bis zum Rand löschen
-    NCURSES_CHECK(box(self->win, 0, 0));            // Rahmen neu zeichnen
+    if (self->message[0] != '\0') {                 // Meldung hat Vorrang
+        show_text(self, self->message);            // bleibt bis zur nächsten Taste
+        return;
+    }
 
     const char *stateText;                         // Zeiger auf Status-Text
     if (!buffer->ever_changed) {                   // Datei wurde nie verändert?
@@ -45,53 +50,154 @@ void bottom_bar_draw(BottomBar *self, const Editor *editor, const DataBuffer *bu
                            (size_t)editor->cursor_y * (size_t)bytesPerLine +
                            (size_t)editor->cursor_x; // Cursorposition berücksichtigen
 
-    unsigned char byteValue = 0;                   // Standardwert für Byte
-    if (absoluteIndex < buffer->size) {            // liegt Index im Buffer?
-        byteValue = buffer->bytes[absoluteIndex];  // Byte auslesen
+    unsigned char raw[4] = {0};                             // fehlende Bytes am Ende zählen als 0
+    if (absoluteIndex < buffer->size) {
+        size_t available = buffer->size - absoluteIndex;
+        size_t count = (available < sizeof(raw)) ? available : sizeof(raw);
+        data_buffer_get_range(buffer, absoluteIndex, absoluteIndex + count, raw); // ein Zugriff
     }
+    unsigned char byteValue = raw[0];
 
-    unsigned long long rawUnsigned32 = read_unsigned_le(buffer, absoluteIndex, 4); // 32 Bit lesen
+    uint64_t rawUnsigned32 = value_load(raw, 4, editor->big_endian); // 32 Bit lesen
     signed char signedValue8 = (signed char)byteValue;      // als s8 interpretieren
     unsigned char unsignedValue8 = byteValue;               // als u8 interpretieren
     int32_t signedValue32 = (int32_t)rawUnsigned32;         // als s32 interpretieren
     uint32_t unsignedValue32 = (uint32_t)rawUnsigned32;     // als u32 interpretieren
+    char floatValue32[VALUE_TEXT_MAX];
+    value_format(VALUE_F32, editor->big_endian, raw, floatValue32); // als f32 interpretieren
 
-    NCURSES_CHECK(mvwprintw(self->win, 1, 1,                 // Text im Fenster ausgeben
-                  "%s s8:%d u8:%u s32:%d u32:%u",
-                  stateText,                                 // Status-Text
-                  (int)signedValue8,                         // Wert als s8
-                  (unsigned int)unsignedValue8,              // Wert als u8
-                  (int)signedValue32,                        // Wert als s32
-                  (unsigned int)unsignedValue32));           // Wert als u32
+    char activity[16] = "";                                 // Hinweis auf Hintergrundarbeit
+    if (buffer->source.loading && buffer->source.size > 0) {
+        snprintf(activity, sizeof(activity), "LOAD %u%% ",
+                 (unsigned int)(buffer->source.loaded * 100 / buffer->source.size));
+    } else if (buffer->source.growing) {
+        snprintf(activity, sizeof(activity), "LIVE ");      // Datenstrom empfängt noch
+    } else if (self->scanning) {
+        snprintf(activity, sizeof(activity), "SCAN %u%% ", self->scan_percent); // Signatursuche
+    }
+    if (editor->follow && !buffer->source.loading) {
+        snprintf(activity, sizeof(activity), "FOLLOW ");    // Ansicht folgt dem Dateiende
+    }
 
-    NCURSES_CHECK(wnoutrefresh(self->win));                 // in Ausgabe-Buffer schreiben
+    char selection[40] = "";                                // Länge der aktiven Auswahl
+    size_t selectStart;
+    size_t selectEnd;
+    if (editor_get_selection(editor, &selectStart, &selectEnd) == 0) {
+        snprintf(selection, sizeof(selection), "SEL %llu ",
+                 (unsigned long long)(selectEnd - selectStart));
+    }
+
+    char modified[40] = "";                                 // Anzahl geänderter Bytes
+    size_t modifiedCount = change_bitmap_count(&buffer->modified);
+    if (modifiedCount > 0) {
+        snprintf(modified, sizeof(modified), "MOD %llu ", (unsigned long long)modifiedCount);
+    }
+
+    char text[sizeof(self->drawn)];
+    snprintf(text, sizeof(text),                             // Statuszeile zusammensetzen
+             "%s %s%s%s%s s8:%d u8:%u s32:%d u32:%u f32:%s%s",
+             editor->insert_mode ? "INS" : "OVR",            // Eingabemodus
+             selection,                                      // Auswahl für Prüfsummen
+             modified,                                       // seit Laden/Speichern geänderte Bytes
+             activity,                                       // Ladefortschritt, LIVE, SCAN oder FOLLOW
+             stateText,                                      // Status-Text
+             (int)signedValue8,                              // Wert als s8
+             (unsigned int)unsignedValue8,                   // Wert als u8
+             (int)signedValue32,                             // Wert als s32
+             (unsigned int)unsignedValue32,                  // Wert als u32
+             floatValue32,                                   // Wert als f32
+             editor->big_endian ? " BE" : "");               // Byte-Reihenfolge, wenn nicht LE
+    show_text(self, text);
 }
 
-//* ---------------------------------- Helfer Funktionen ----------------------------------
 /**
- * @brief Liest einen ganzzahligen Wert im Little-Endian-Format.
+ * @brief Merkt eine Meldung für das nächste Zeichnen vor.
  *
- * Die Funktion holt nacheinander mehrere Bytes aus dem Daten-Buffer und baut
- * daraus einen "unsigned long long" zusammen. Fehlen Bytes am Ende, werden
- * sie als 0 interpretiert.
+ * Die Meldung ersetzt die Byte-Informationen, bis sie mit
+ * `bottom_bar_clear_message` bei der nächsten Taste verschwindet. Bilder,
+ * die Hintergrundarbeit wie die Übersicht nachzeichnet, überdecken sie so
+ * nicht sofort wieder.
+ */
+void bottom_bar_set_message(BottomBar *self, const char *message) {
+    snprintf(self->message, sizeof(self->message), "%s", message); // Meldung kopieren
+}
+
+/**
+ * @brief Entfernt eine angezeigte Meldung beim nächsten Zeichnen.
+ */
+void bottom_bar_clear_message(BottomBar *self) {
+    self->message[0] = '\0';
+}
+
+/**
+ * @brief Erzwingt das erneute Zeichnen beim nächsten Aufruf.
+ */
+void bottom_bar_invalidate(BottomBar *self) {
+    self->drawn_valid = 0;
+}
+
+/**
+ * @brief Fragt in der Bottom-Bar eine Texteingabe ab.
  *
- * @param buffer    Buffer mit den Quelldaten
- * @param index     Startposition im Buffer
- * @param byteCount Anzahl der zu lesenden Bytes
- * @return Zusammengesetzter Wert
+ * Enter bestätigt, Escape bricht ab, die Rücktaste löscht das letzte
+ * Zeichen.
  */
-static unsigned long long read_unsigned_le(const DataBuffer *buffer, size_t index,
-                                           int byteCount) {
-    unsigned long long value = 0;                   // Ergebnis initialisieren
-    for (int i = 0; i < byteCount; i++) {           // Schleife über alle Bytes
-        size_t currentIndex = index + (size_t)i;    // aktuelle Position bestimmen
-        unsigned char currentByte = 0;              // Standardwert außerhalb
-        if (currentIndex < buffer->size) {          // liegt Position im Buffer?
-            currentByte = buffer->bytes[currentIndex]; // Byte auslesen
+int bottom_bar_prompt(BottomBar *self, const char *label, char *out, size_t size) {
+    size_t length = strlen(out);                   // Vorgabe übernehmen
+    int maxX = getmaxx(self->win) - 2;             // nutzbare Breite
+    NCURSES_CHECK(keypad(self->win, TRUE));        // Funktionstasten erkennen
+    self->drawn_valid = 0;                         // Eingabezeile überschreibt den Status
+    while (1) {
+        NCURSES_CHECK(wmove(self->win, 1, 1));
+        NCURSES_CHECK(wclrtoeol(self->win));
+        NCURSES_CHECK(box(self->win, 0, 0));
+        int labelWidth = (int)strlen(label);
+        NCURSES_CHECK(mvwaddnstr(self->win, 1, 1, label, maxX));
+        int visible = maxX - labelWidth;           // Platz für den Eingabetext
+        if (visible > 0) {
+            // bei langen Eingaben nur das Ende anzeigen
+            size_t room = (size_t)(visible - 1);
+            const char *shown = (length > room) ? out + length - room : out;
+            NCURSES_CHECK(mvwaddnstr(self->win, 1, 1 + labelWidth, shown, visible - 1));
+        }
+        NCURSES_CHECK(wrefresh(self->win));
+
+        int key = wgetch(self->win);
+        if (key == '\n' || key == '\r' || key == KEY_ENTER) {
+            return (length > 0) ? 0 : -1;          // leere Eingabe zählt als Abbruch
+        }
+        if (key == 27) {                           // Escape bricht ab
+            return -1;
+        }
+        if (key == KEY_BACKSPACE || key == 127 || key == '\b') {
+            if (length > 0) {
+                out[--length] = '\0';              // letztes Zeichen entfernen
+            }
+        } else if (key >= 32 && key < 127 && length + 1 < size) {
+            out[length++] = (char)key;             // druckbares Zeichen anhängen
+            out[length] = '\0';
         }
-        value |= ((unsigned long long)currentByte) << (8 * i); // Byte verschieben
     }
-    return value;                                  // zusammengesetzten Wert liefern
+}
+
+//* ---------------------------------- Helfer Funktionen ----------------------------------
+/**
+ * @brief Schreibt den Text in die Leiste, sofern er nicht schon dort steht.
+ *
+ * @param self Zeiger auf die Bottom-Bar
+ * @param text anzuzeigender Text
+ */
+static void show_text(BottomBar *self, const char *text) {
+    if (self->drawn_valid && strcmp(self->drawn, text) == 0) {
+        return;                                     // unverändert, nichts ausgeben
+    }
+    NCURSES_CHECK(wmove(self->win, 1, 1));          // Cursor auf Innenbereich setzen
+    NCURSES_CHECK(wclrtoeol(self->win));            // Zeile bis zum Rand löschen
+    NCURSES_CHECK(box(self->win, 0, 0));            // Rahmen neu zeichnen
+    NCURSES_CHECK(mvwaddnstr(self->win, 1, 1, text, getmaxx(self->win) - 2));
+    NCURSES_CHECK(wnoutrefresh(self->win));         // in Ausgabe-Buffer schreiben
+    snprintf(self->drawn, sizeof(self->drawn), "%s", text);
+    self->drawn_valid = 1;
 }
 
 //* ----------------------------------- Init und Deinit -----------------------------------
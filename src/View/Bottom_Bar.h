@@ -27,7 +27,12 @@
  * @brief Struktur der Bottom-Bar.
  */
 typedef struct {                       // Struktur der Bottom-Bar
-    WINDOW *win; /**< Fenster für die Bottom Bar */
+    WINDOW *win;       /**< Fenster für die Bottom Bar */
+    char message[128]; /**< Meldung statt der Byte-Informationen bis zur nächsten Taste */
+    int scanning;      /**< 1, solange die Signatursuche läuft */
+    unsigned int scan_percent; /**< Fortschritt der Signatursuche */
+    char drawn[256];   /**< zuletzt ausgegebener Text */
+    int drawn_valid;   /**< 1 = `drawn` steht so im Fenster */
 } BottomBar;                           // Typname der Struktur
 
 //* ------------------------------------- Funktionen --------------------------------------
@@ -36,6 +41,31 @@ typedef struct {                       // Struktur der Bottom-Bar
  */
 void bottom_bar_draw(BottomBar *self, const Editor *editor, const DataBuffer *buffer); // Statusleiste zeichnen
 
+/**
+ * @brief Merkt eine Meldung für das nächste Zeichnen vor.
+ */
+void bottom_bar_set_message(BottomBar *self, const char *message); // Meldung setzen
+
+/**
+ * @brief Entfernt die Meldung, die Byte-Informationen erscheinen wieder.
+ */
+void bottom_bar_clear_message(BottomBar *self); // Meldung entfernen
+
+/**
+ * @brief Erzwingt das erneute Zeichnen, etwa nach einem Overlay.
+ */
+void bottom_bar_invalidate(BottomBar *self); // beim nächsten Mal neu zeichnen
+
+/**
+ * @brief Fragt in der Bottom-Bar eine Texteingabe ab.
+ * @param self  Zeiger auf die Bottom-Bar
+ * @param label Beschriftung vor dem Eingabefeld
+ * @param out   Ein- und Ausgabe-Buffer, vorhandener Inhalt dient als Vorgabe
+ * @param size  Größe des Buffers
+ * @return 0 bei bestätigter Eingabe, -1 bei Abbruch oder leerer Eingabe
+ */
+int bottom_bar_prompt(BottomBar *self, const char *label, char *out, size_t size); // Eingabe lesen
+
 //* ----------------------------------- Init und Deinit -----------------------------------
 /**
  * @brief Initialisiert die Bottom-Bar.
@@ -2,12 +2,13 @@
  * @file Display_Strategy.c
  * @brief Implementierung der Anzeige-Strategien.
  *
- * Dieses Modul definiert zwei konkrete Strategien zur Darstellung
- * des Buffers: eine hexadezimale und eine binäre Variante. Jede
- * Strategie stellt eine Reihe von Funktionszeigern bereit, die vom
- * Editor während Zeichnen und Eingabeverarbeitung genutzt werden.
- * Durch diese Kapselung lässt sich die Darstellung zur Laufzeit
- * umschalten, ohne den Editorcode zu verändern.
+ * Dieses Modul definiert drei konkrete Strategien zur Darstellung
+ * des Buffers: eine hexadezimale, eine binäre und eine für Zahlenwerte
+ * aus mehreren Bytes. Jede Strategie stellt eine Reihe von
+ * Funktionszeigern bereit, die vom Editor während Zeichnen und
+ * Eingabeverarbeitung genutzt werden. Durch diese Kapselung lässt sich
+ * die Darstellung zur Laufzeit umschalten, ohne den Editorcode zu
+ * verändern.
  */
 
 //* -------------------------------------- Includes ---------------------------------------
@@ -17,99 +18,111 @@
 
 //* ---------------------------- Globale Konstanten oder Defines --------------------------
 // Vorwärtsdeklarationen der Helferfunktionen
-static int hex_bytes_per_line(void);
-static int bin_bytes_per_line(void);
-static int hex_cell_width(void);
-static int bin_cell_width(void);
-static int hex_is_valid_char(int ch);
-static int bin_is_valid_char(int ch);
-static void hex_format_byte(unsigned char byte, char *out);
-static void bin_format_byte(unsigned char byte, char *out);
-static const char *hex_header_label(void);
-static const char *bin_header_label(void);
-static const char *hex_empty_cell(void);
-static const char *bin_empty_cell(void);
+static int hex_bytes_per_line(const Editor *self);
+static int bin_bytes_per_line(const Editor *self);
+static int value_bytes_per_line(const Editor *self);
+static int single_element_size(const Editor *self);
+static int value_element_size(const Editor *self);
+static int hex_cell_width(const Editor *self);
+static int bin_cell_width(const Editor *self);
+static int value_cell_width(const Editor *self);
+static int hex_is_valid_char(const Editor *self, int ch);
+static int bin_is_valid_char(const Editor *self, int ch);
+static int value_is_valid_char(const Editor *self, int ch);
+static const char *hex_header_label(const Editor *self);
+static const char *bin_header_label(const Editor *self);
+static const char *value_header_label(const Editor *self);
 static void hex_reset_pending(Editor *self);
 static void bin_reset_pending(Editor *self);
+static void value_reset_pending(Editor *self);
+
+/** Überschriften der Werteansicht in der Reihenfolge von `ValueType`, Little- und Big-Endian */
+static const char *const VALUE_LABELS[VALUE_TYPE_COUNT][2] = {
+    {"u16 LE", "u16 BE"}, {"s16 LE", "s16 BE"}, {"x16 LE", "x16 BE"},
+    {"u32 LE", "u32 BE"}, {"s32 LE", "s32 BE"}, {"x32 LE", "x32 BE"},
+    {"u64 LE", "u64 BE"}, {"s64 LE", "s64 BE"}, {"x64 LE", "x64 BE"},
+    {"f32 LE", "f32 BE"}, {"f64 LE", "f64 BE"}
+};
 
 /** Strategie für die Hex-Darstellung. */
 const DisplayStrategy HEX_STRATEGY = {
     .bytes_per_line = hex_bytes_per_line,
+    .element_size = single_element_size,
     .cell_width = hex_cell_width,
     .is_valid_char = hex_is_valid_char,
-    .format_byte = hex_format_byte,
     .header_label = hex_header_label,
-    .empty_cell = hex_empty_cell,
     .reset_pending = hex_reset_pending
 };
 
 /** Strategie für die Binär-Darstellung. */
 const DisplayStrategy BIN_STRATEGY = {
     .bytes_per_line = bin_bytes_per_line,
+    .element_size = single_element_size,
     .cell_width = bin_cell_width,
     .is_valid_char = bin_is_valid_char,
-    .format_byte = bin_format_byte,
     .header_label = bin_header_label,
-    .empty_cell = bin_empty_cell,
     .reset_pending = bin_reset_pending
 };
 
+/** Strategie für Zahlenwerte. */
+const DisplayStrategy VALUE_STRATEGY = {
+    .bytes_per_line = value_bytes_per_line,
+    .element_size = value_element_size,
+    .cell_width = value_cell_width,
+    .is_valid_char = value_is_valid_char,
+    .header_label = value_header_label,
+    .reset_pending = value_reset_pending
+};
+
 //* ------------------------------------- Funktionen --------------------------------------
 
 //* ---------------------------------- Helfer Funktionen ----------------------------------
 // Parameterfunktionen
 /** @brief Bytes pro Zeile in der Hex-Ansicht. */
-static int hex_bytes_per_line(void) { return 16; }
+static int hex_bytes_per_line(const Editor *self) { (void)self; return 16; }
 
 /** @brief Bytes pro Zeile in der Binär-Ansicht. */
-static int bin_bytes_per_line(void) { return 4; }
+static int bin_bytes_per_line(const Editor *self) { (void)self; return 4; }
+
+/** @brief Bytes pro Zeile in der Werteansicht, Vielfaches jeder Elementbreite. */
+static int value_bytes_per_line(const Editor *self) { (void)self; return 16; }
+
+/** @brief Hex- und Binärzellen zeigen je ein Byte. */
+static int single_element_size(const Editor *self) { (void)self; return 1; }
+
+/** @brief Breite eines Werts in Bytes. */
+static int value_element_size(const Editor *self) { return value_type_size(self->value_type); }
 
 /** @brief Breite einer Hex-Zelle. */
-static int hex_cell_width(void) { return 3; }
+static int hex_cell_width(const Editor *self) { (void)self; return 3; }
 
 /** @brief Breite einer Binär-Zelle. */
-static int bin_cell_width(void) { return 9; }
+static int bin_cell_width(const Editor *self) { (void)self; return 9; }
+
+/** @brief Breite einer Wertezelle: längster Wert und ein Trenner. */
+static int value_cell_width(const Editor *self) { return value_type_width(self->value_type) + 1; }
 
 /** @brief Prüft, ob ein Zeichen für die Hex-Eingabe gültig ist. */
-static int hex_is_valid_char(int ch) { return isxdigit(ch); }
+static int hex_is_valid_char(const Editor *self, int ch) { (void)self; return isxdigit(ch); }
 
 /** @brief Prüft, ob ein Zeichen für die Binär-Eingabe gültig ist. */
-static int bin_is_valid_char(int ch) { return ch == '0' || ch == '1'; }
+static int bin_is_valid_char(const Editor *self, int ch) { (void)self; return ch == '0' || ch == '1'; }
 
-// Formatierung der Byte-Ausgabe
-/**
- * @brief Formatiert ein Byte als Hex-Zeichenkette.
- * @param byte  Wert, der ausgegeben werden soll
- * @param out   Ziel-Buffer, mindestens 4 Zeichen lang
- */
-static void hex_format_byte(unsigned char byte, char *out) {
-    byte_to_hex_string(byte, out); // Byte in zwei Hex-Zeichen umwandeln
-    out[2] = ' ';                  // Leerzeichen als Trenner anhängen
-    out[3] = '\0';                // String terminieren
-}
-
-/**
- * @brief Formatiert ein Byte als Binär-Zeichenkette.
- * @param byte  Wert, der ausgegeben werden soll
- * @param out   Ziel-Buffer, mindestens 10 Zeichen lang
- */
-static void bin_format_byte(unsigned char byte, char *out) {
-    byte_to_bit_string(byte, out); // Acht Bit in Zeichen wandeln
-    out[8] = ' ';                  // Leerzeichen als Trenner anhängen
-    out[9] = '\0';                // String terminieren
+/** @brief Prüft, ob ein Zeichen in einem Wert des gewählten Typs vorkommen kann. */
+static int value_is_valid_char(const Editor *self, int ch) {
+    return value_type_accepts(self->value_type, ch);
 }
 
 /** @brief Überschrift für die Hex-Spalte. */
-static const char *hex_header_label(void) { return "Hex"; }
+static const char *hex_header_label(const Editor *self) { (void)self; return "Hex"; }
 
 /** @brief Überschrift für die Binär-Spalte. */
-static const char *bin_header_label(void) { return "Bin"; }
+static const char *bin_header_label(const Editor *self) { (void)self; return "Bin"; }
 
-/** @brief Rückgabe für eine leere Hex-Zelle. */
-static const char *hex_empty_cell(void) { return "   "; }
-
-/** @brief Rückgabe für eine leere Binär-Zelle. */
-static const char *bin_empty_cell(void) { return "         "; }
+/** @brief Überschrift für die Wertespalte: Typ und Byte-Reihenfolge. */
+static const char *value_header_label(const Editor *self) {
+    return VALUE_LABELS[self->value_type][self->big_endian ? 1 : 0];
+}
 
 // Zurücksetzen angefangener Eingaben
 /** @brief Setzt ausstehende Hex-Eingaben zurück. */
@@ -121,4 +134,12 @@ static void bin_reset_pending(Editor *self) {
     self->bin_pending_value = 0;  // Zwischengespeicherten Wert löschen
 }
 
+/** @brief Verwirft einen angefangen eingegebenen Wert. */
+static void value_reset_pending(Editor *self) {
+    if (self->value_length > 0) {
+        self->value_length = 0;   // Text leeren
+        self->value_edits++;      // Zelle zeigt wieder den gespeicherten Wert
+    }
+}
+
 //* ----------------------------------- Init und Deinit -----------------------------------
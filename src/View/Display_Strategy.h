@@ -8,9 +8,10 @@
  * Dieser Header beschreibt das Strategiemuster zur Darstellung der
  * Bytewerte im Editor. Über einen Satz von Funktionszeigern werden
  * Parameter wie Bytes pro Zeile, Zellbreite und Formatierung
- * gekapselt. Dadurch kann der Editor flexibel zwischen hexadezimaler
- * und binärer Anzeige wechseln, ohne seine Kernlogik anpassen zu
- * müssen.
+ * gekapselt. Dadurch kann der Editor flexibel zwischen hexadezimaler,
+ * binärer und typisierter Anzeige wechseln, ohne seine Kernlogik
+ * anpassen zu müssen. Eine Zelle zeigt ein Element aus
+ * `element_size` Bytes.
  */
 
 #ifdef _WIN32
@@ -29,13 +30,12 @@ struct Editor; /**< Vorwärtsdeklaration */
  * @brief Funktionszeiger für verschiedene Anzeigeparameter.
  */
 typedef struct DisplayStrategy {
-    int (*bytes_per_line)(void);              /**< Bytes pro Zeile */
-    int (*cell_width)(void);                  /**< Zeichenbreite einer Zelle */
-    int (*is_valid_char)(int ch);             /**< Prüft Eingabezeichen */
-    void (*format_byte)(unsigned char byte, char *out); /**< Formatiert Byte */
-    const char *(*header_label)(void);        /**< Überschrift */
-    const char *(*empty_cell)(void);          /**< Leere Zelle */
-    void (*reset_pending)(struct Editor *self); /**< Eingaben zurücksetzen */
+    int (*bytes_per_line)(const struct Editor *self);         /**< Bytes pro Zeile */
+    int (*element_size)(const struct Editor *self);           /**< Bytes je Zelle */
+    int (*cell_width)(const struct Editor *self);             /**< Zeichenbreite einer Zelle samt Trenner */
+    int (*is_valid_char)(const struct Editor *self, int ch);  /**< Prüft Eingabezeichen */
+    const char *(*header_label)(const struct Editor *self);   /**< Überschrift */
+    void (*reset_pending)(struct Editor *self);               /**< Eingaben zurücksetzen */
 } DisplayStrategy;
 
 //* ------------------------------------- Funktionen --------------------------------------
@@ -47,5 +47,7 @@ typedef struct DisplayStrategy {
 extern const DisplayStrategy HEX_STRATEGY;
 /** Binäre Darstellung */
 extern const DisplayStrategy BIN_STRATEGY;
+/** Zahlenwerte aus 2, 4 oder 8 Bytes, Typ und Reihenfolge stehen im Editor */
+extern const DisplayStrategy VALUE_STRATEGY;
 
 #endif // DISPLAY_STRATEGY_H
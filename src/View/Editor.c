@@ -12,6 +12,7 @@
 
 //* -------------------------------------- Includes ---------------------------------------
 #include "Editor.h"
+#include <stdlib.h>
 #include <string.h>
 #include "Utilities.h"
 #include "Display_Strategy.h"
@@ -50,6 +51,12 @@ int editor_init(Editor *self, int height, int width, int starty, DataBuffer *buf
                         ? &HEX_STRATEGY
                         : &BIN_STRATEGY;            // passende Strategie wählen
     NCURSES_CHECK(keypad(self->win, TRUE));         // Funktionstasten aktivieren
+    NCURSES_CHECK(idlok(self->win, TRUE));          // Scrollen der Datenzeilen als Terminalscrollen ausgeben
+    render_table_init(&self->table, 0);             // Zeichentabellen ohne Farben
+    self->dirty_rows = (unsigned char *)calloc((size_t)height, 1); // je Zeile ein Flag
+    if (!self->dirty_rows) {
+        fatal_error("editor_init", "out of memory");
+    }
     return 0;                                       // Erfolg zurückgeben
 }
 
@@ -60,6 +67,7 @@ int editor_deinit(Editor *self) {
     if (self->win) {                               // Existiert ein Fenster?
         NCURSES_CHECK(delwin(self->win));          // Fenster freigeben
     }
+    free(self->dirty_rows);                        // Zeilenflags freigeben
     memset(self, 0, sizeof(*self));                // Struktur zurücksetzen
     return 0;                                      // Erfolg melden
 }
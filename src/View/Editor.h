@@ -8,8 +8,8 @@
  * Dieser Header definiert die Struktur und die öffentlichen
  * Funktionen des Editorbereichs. Der Editor ist verantwortlich für
  * die Darstellung und Navigation innerhalb der geladenen Daten und
- * nutzt Strategien, um zwischen hexadezimaler und binärer Ansicht zu
- * wechseln. Er interagiert mit dem `DataBuffer`, ohne dessen
+ * nutzt Strategien, um zwischen hexadezimaler, binärer und
+ * typisierter Ansicht zu wechseln. Er interagiert mit dem `DataBuffer`, ohne dessen
  * Lebenszyklus selbst zu verwalten.
  */
 
@@ -19,15 +19,22 @@
 #else
 #include <ncurses.h>
 #endif
+#include <stdint.h>
+#include "Byte_Map.h"
 #include "Data_Buffer.h"
 #include "Display_Strategy.h"
+#include "Render_Table.h"
+#include "Value_Format.h"
 
 //* ---------------------------- Globale Konstanten oder Defines --------------------------
 /** Breiten und Startpositionen */
-#define OFFSET_COL_WIDTH 8                     /**< Breite der Offset-Spalte */
+#define OFFSET_COL_WIDTH 8                     /**< Mindestbreite der Offset-Spalte */
+#define OFFSET_COL_WIDTH_WIDE 12               /**< Offset-Spalte für Dateien über 4 GiB */
 #define HEX_COL_WIDTH 3                        /**< Breite einer Hex-Zelle */
 #define BIN_COL_WIDTH 9                        /**< Breite einer Binär-Zelle */
-#define HEX_START_X (1 + OFFSET_COL_WIDTH + 1) /**< Start des Hex-Bereichs */
+#define EDITOR_MAX_BYTES_PER_LINE 64           /**< Obergrenze für Bytes pro Zeile */
+#define EDITOR_PREFETCH_MAX_STREAK 8           /**< Vorauslesen verdoppelt sich bis 2^8 Seiten */
+#define EDITOR_MAP_WIDTH 2                     /**< Übersichtsspalte: Byteklasse und Entropie */
 
 //* ------------------------------------- Strukturen --------------------------------------
 /** Bereich für den Cursor */
@@ -38,10 +45,37 @@ typedef enum {
 
 /** Anzeigearten */
 typedef enum {
-    DISPLAY_HEX, /**< Hexadezimal */
-    DISPLAY_BIN  /**< Binär */
+    DISPLAY_HEX,  /**< Hexadezimal */
+    DISPLAY_BIN,  /**< Binär */
+    DISPLAY_VALUE /**< Zahlenwerte aus 2, 4 oder 8 Bytes */
 } DisplayMode;
 
+/**
+ * @brief Stand der Anzeige beim letzten Zeichnen.
+ *
+ * Weicht einer der Werte ab, der das ganze Fenster betrifft, wird alles
+ * neu gezeichnet; sonst nur die Zeilen, die seither geändert wurden.
+ */
+typedef struct {
+    int valid;                      /**< 0 = nächstes Zeichnen erneuert das ganze Fenster */
+    size_t start_offset;            /**< gezeigter Ausschnitt */
+    DisplayMode display_mode;       /**< Darstellung */
+    ValueType value_type;           /**< Typ der Werteansicht */
+    int big_endian;                 /**< deren Byte-Reihenfolge */
+    size_t value_index;             /**< Element mit angefangener Eingabe, SIZE_MAX = keines */
+    unsigned long value_edits;      /**< Stand der angefangenen Eingabe */
+    int offset_width;               /**< Breite der Offset-Spalte */
+    unsigned long revision;         /**< Stand des Buffers */
+    unsigned long compare_revision; /**< Stand des Vergleichsinhalts */
+    size_t modified_count;          /**< Anzahl geänderter Bytes */
+    size_t select_start;            /**< gezeigte Auswahl, leer wenn keine */
+    size_t select_end;              /**< hinter dem letzten ausgewählten Byte */
+    uint64_t mark_bit;              /**< gezeigte Bitfolge */
+    size_t mark_bits;               /**< deren Länge, 0 = keine */
+    size_t map_stale;               /**< noch offene Blöcke der Übersicht */
+    unsigned long map_revision;     /**< Stand der Übersicht */
+} EditorDrawn;
+
 /**
  * @brief Struktur für den Editor.
  */
@@ -56,24 +90,49 @@ typedef struct Editor {
     int bin_pending_bits;               /**< Anzahl eingegebener Binärbits */
     unsigned char bin_pending_value;    /**< Zwischenspeicher für Binärwerte */
     DisplayMode display_mode;           /**< Aktueller Anzeigemodus */
+    ValueType value_type;               /**< Elementtyp der Werteansicht */
+    int big_endian;                     /**< 1 = Werte und Inspektor in Big-Endian */
+    char value_text[VALUE_TEXT_MAX];    /**< angefangen eingegebener Wert */
+    int value_length;                   /**< Länge davon, 0 = keine Eingabe */
+    unsigned long value_edits;          /**< zählt Änderungen der Eingabe für das Zeichnen */
+    int insert_mode;                    /**< 1 = Eingaben einfügen, 0 = überschreiben */
+    int scroll_direction;               /**< letzte Scrollrichtung: 1, -1 oder 0 */
+    int scroll_streak;                  /**< Anzahl aufeinanderfolgender Schritte in diese Richtung */
+    int follow;                         /**< 1 = Ansicht bleibt am Ende wachsender Dateien */
+    const DataBuffer *compare;          /**< Vergleichsinhalt, abweichende Bytes hervorheben, NULL = aus */
+    const ByteMap *map;                 /**< Übersicht für die Randspalte, NULL = keine */
+    uint64_t mark_bit;                  /**< erstes hervorgehobenes Bit */
+    size_t mark_bits;                   /**< Anzahl hervorgehobener Bits, 0 = keine */
+    unsigned long mark_revision;        /**< Stand des Buffers, für den die Hervorhebung gilt */
+    int selecting;                      /**< 1 = Auswahl vom Anker bis zum Cursor aktiv */
+    size_t select_anchor;               /**< Byte, an dem die Auswahl begonnen wurde */
     const struct DisplayStrategy *strategy; /**< Strategie für Darstellung */
+    EditorDrawn drawn;                  /**< Stand beim letzten Zeichnen */
+    unsigned char *dirty_rows;          /**< je Datenzeile 1 = neu zu zeichnen */
+    RenderTable table;                  /**< Zeichen und Farben je Bytewert */
 } Editor;
 
 //* ------------------------------------- Funktionen --------------------------------------
 /** Zeichnet den Inhalt des Editors. */
 void editor_draw(Editor *self);
 
+/** Erzwingt beim nächsten Zeichnen eine vollständige Erneuerung, etwa nach einem Overlay. */
+void editor_invalidate(Editor *self);
+
 /** Bewegt den Cursor relativ. */
 void editor_move_cursor(Editor *self, int delta_y, int delta_x);
 
 /** Wechselt zwischen Hex- und ASCII-Bereich. */
 void editor_toggle_area(Editor *self);
 
-/** Wechselt zwischen Hex- und Binärdarstellung. */
+/** Wechselt zwischen Hex- und Binärdarstellung, aus der Werteansicht zurück zu Hex. */
 void editor_toggle_display_mode(Editor *self);
 
+/** Zeigt Zahlenwerte eines Typs, -1 wenn die Zeile nicht ins Fenster passt. */
+int editor_set_value_view(Editor *self, ValueType type, int big_endian);
+
 /** Scrollt die Ansicht um den Offset. */
-void editor_scroll(Editor *self, int delta_offset);
+void editor_scroll(Editor *self, long long delta_offset);
 
 /** Setzt den Editor auf die Anfangsposition. */
 void editor_reset(Editor *self);
@@ -81,28 +140,112 @@ void editor_reset(Editor *self);
 /** Verarbeitet Zeichen und aktualisiert den Buffer. */
 void editor_handle_char(Editor *self, int key);
 
+/** Wechselt zwischen Einfüge- und Überschreibmodus. */
+void editor_toggle_insert_mode(Editor *self);
+
+/** Löscht das Byte unter (oder vor) dem Cursor. */
+void editor_delete_byte(Editor *self, int before_cursor);
+
+/** Setzt den Cursor auf ein Byte und scrollt es in die Ansicht. */
+void editor_jump_to(Editor *self, size_t index);
+
+/** Hebt eine Bitfolge bis zur nächsten Änderung des Inhalts hervor, 0 Bits = keine. */
+void editor_mark_bits(Editor *self, uint64_t first_bit, size_t bit_count);
+
+/** Beginnt eine Auswahl am Cursor oder hebt die aktive Auswahl auf. */
+void editor_toggle_selection(Editor *self);
+
+/** Liefert den ausgewählten Bereich `[start, end)`, 0 bei aktiver Auswahl, sonst -1. */
+int editor_get_selection(const Editor *self, size_t *start, size_t *end);
+
+/** Ermittelt das erste Byte der Übersichtszeile unter einer Fensterposition, 0 bei Treffer. */
+int editor_map_hit(const Editor *self, int y, int x, size_t *offset);
+
+/** Zeigt die letzte Seite mit dem Cursor auf dem letzten Byte. */
+void editor_show_end(Editor *self);
+
+/** Hält die Ansicht fest, nachdem am Anfang Bytes entfernt wurden. */
+void editor_discard_front(Editor *self, size_t removed);
+
+/** Ermittelt den Bereich, der in Scrollrichtung vorab geladen werden sollte. */
+void editor_get_prefetch_range(const Editor *self, size_t *start, size_t *end);
+
 /* Inline-Hilfsfunktionen -------------------------------------------------- */
 
 /**
  * @brief Ermittelt die Breite einer Zelle.
  */
 static inline int getCellWidth(const Editor *self) {
-    return self->strategy->cell_width();
+    return self->strategy->cell_width(self);
 }
 
 /**
  * @brief Gibt Bytes pro Zeile zurück.
  */
 static inline int getBytesPerLine(const Editor *self) {
-    return self->strategy->bytes_per_line();
+    return self->strategy->bytes_per_line(self);
+}
+
+/**
+ * @brief Gibt die Bytes je Zelle zurück, 1 außer in der Werteansicht.
+ */
+static inline int getElementSize(const Editor *self) {
+    return self->strategy->element_size(self);
+}
+
+/**
+ * @brief Ermittelt die Breite der Offset-Spalte für eine Dateigröße.
+ *
+ * Dateien über 4 GiB benötigen mehr als acht Hex-Stellen.
+ */
+static inline int getOffsetColWidthFor(size_t size) {
+    return (size > 0xFFFFFFFFull) ? OFFSET_COL_WIDTH_WIDE : OFFSET_COL_WIDTH;
+}
+
+/**
+ * @brief Ermittelt die Breite der Offset-Spalte.
+ */
+static inline int getOffsetColWidth(const Editor *self) {
+    return getOffsetColWidthFor(self->buffer->size);
+}
+
+/**
+ * @brief Berechnet die Startposition des Datenbereichs.
+ */
+static inline int getHexStartX(const Editor *self) {
+    return 1 + getOffsetColWidth(self) + 1;
 }
 
 /**
  * @brief Berechnet die Startposition des ASCII-Bereichs.
  */
 static inline int getAsciiStartX(const Editor *self) {
-    int bytesPerLine = getBytesPerLine(self);
-    return HEX_START_X + bytesPerLine * getCellWidth(self) + 1;
+    int cells = getBytesPerLine(self) / getElementSize(self);
+    return getHexStartX(self) + cells * getCellWidth(self) + 1;
+}
+
+/**
+ * @brief Berechnet die Startposition der Zelle, die ein Byte der Zeile zeigt.
+ */
+static inline int getCellX(const Editor *self, int col) {
+    return getHexStartX(self) + (col / getElementSize(self)) * getCellWidth(self);
+}
+
+/**
+ * @brief Schrittweite des Cursors: ein Element im Datenbereich, ein Byte im ASCII-Bereich.
+ */
+static inline int getCursorStep(const Editor *self) {
+    return (self->cursor_area == AREA_HEX) ? getElementSize(self) : 1;
+}
+
+/**
+ * @brief Berechnet die Startposition der Übersichtsspalte am rechten Rand.
+ * @return Spalte oder -1, wenn keine Übersicht gesetzt ist oder der Platz fehlt
+ */
+static inline int getMapStartX(const Editor *self) {
+    int x = getmaxx(self->win) - 1 - EDITOR_MAP_WIDTH;
+    int asciiEnd = getAsciiStartX(self) + getBytesPerLine(self);
+    return (self->map && x - 1 > asciiEnd) ? x : -1; // Kopfzeile "Map" beginnt eine Spalte davor
 }
 
 /**
@@ -112,6 +255,16 @@ static inline size_t idx(const Editor *self, int row, int col) {
     return self->start_offset + (size_t)row * (size_t)getBytesPerLine(self) + (size_t)col;
 }
 
+/**
+ * @brief Anzahl der Positionen, die der Cursor erreichen kann.
+ *
+ * Im Einfügemodus darf der Cursor zusätzlich hinter dem letzten Byte
+ * stehen, um Daten am Dateiende anzuhängen.
+ */
+static inline size_t getCursorLimit(const Editor *self) {
+    return self->buffer->size + (self->insert_mode ? 1 : 0);
+}
+
 //* ----------------------------------- Init und Deinit -----------------------------------
 /** Initialisiert den Editor. */
 int editor_init(Editor *self, int height, int width, int starty, DataBuffer *buffer);
@@ -0,0 +1,137 @@
+/**
+ * @file Help_Screen.c
+ * @brief Tastenübersicht als Fenster über dem Editor.
+ *
+ * Wie die Ergebnisliste der Signatursuche ist die Übersicht modal: Sie
+ * liest ihre Tasten selbst und gibt erst beim Schließen zurück. Danach
+ * wird der gesamte Bildschirm beim nächsten Zeichnen erneuert. Neue
+ * Tasten werden in `HELP_KEYS` eingetragen, nicht in der Statusleiste.
+ */
+
+//* -------------------------------------- Includes ---------------------------------------
+#include "Help_Screen.h"    // Schnittstelle dieses Moduls
+#include "Err_Log.h"        // Fehlerbehandlung
+#include "Ncurses_Check.h"  // Makro zur Fehlerkontrolle
+
+//* ---------------------------- Globale Konstanten oder Defines --------------------------
+#define HELP_SCREEN_WIDTH 64 /**< größte Breite des Fensters */
+#define HELP_SCREEN_KEYS 14  /**< Spaltenbreite der Tasten */
+#define HELP_SCREEN_CLOSE 11 /**< Strg+K schließt wie es öffnet */
+
+/** Eine Zeile der Übersicht */
+typedef struct {
+    const char *keys;   /**< Taste oder Tastenfolge */
+    const char *action; /**< Wirkung */
+} HelpEntry;
+
+/** Alle Tasten in der Reihenfolge der Übersicht */
+static const HelpEntry HELP_KEYS[] = {
+    {"Arrows",     "Move the cursor"},
+    {"PgUp/PgDn",  "Scroll one page"},
+    {"Tab",        "Switch between data and ASCII column"},
+    {"Ins",        "Toggle insert and overwrite"},
+    {"Del/Bksp",   "Delete the byte under / before the cursor"},
+    {"F1",         "Toggle hex and binary view"},
+    {"^T",         "Choose view: hex, bin, u16..f64 with le/be"},
+    {"F2",         "Save"},
+    {"F3",         "Reload the file"},
+    {"F4",         "Save as"},
+    {"F5/F6",      "Undo / redo"},
+    {"F7",         "Follow the end of a growing file"},
+    {"F8",         "Find a pattern"},
+    {"^N/^P",      "Next / previous match"},
+    {"F9/F10",     "Next / previous difference"},
+    {"F11",        "Load signatures or list their hits"},
+    {"^B",         "Start or clear a selection"},
+    {"^D",         "Checksums of the selection or file"},
+    {"^E",         "Operation on the selection"},
+    {"^F/^R",      "Next / previous modified byte"},
+    {"^G",         "Next region of another byte class"},
+    {"^X",         "Export changes as a patch"},
+    {"Click map",  "Jump to that part of the file"},
+    {"^K",         "This list"},
+    {"F12",        "Quit"},
+};
+
+#define HELP_KEY_COUNT (int)(sizeof(HELP_KEYS) / sizeof(HELP_KEYS[0])) /**< Anzahl der Zeilen */
+
+// Vorwärtsdeklarationen der Helferfunktionen
+static void draw_help(WINDOW *win, int top);
+
+//* ------------------------------------- Funktionen --------------------------------------
+/**
+ * @brief Zeigt die Tastenübersicht, bis sie geschlossen wird.
+ */
+void help_screen_run(void) {
+    int height = HELP_KEY_COUNT + 2;                    // Zeilen plus Rahmen
+    if (height > LINES - 2) {
+        height = LINES - 2;
+    }
+    int width = (COLS - 4 < HELP_SCREEN_WIDTH) ? COLS - 4 : HELP_SCREEN_WIDTH;
+    WINDOW *win = newwin(height, width, (LINES - height) / 2, (COLS - width) / 2);
+    if (!win) {
+        fatal_error("help_screen_run", "newwin");
+    }
+    NCURSES_CHECK(keypad(win, TRUE));
+    int visible = height - 2;
+    int last = (HELP_KEY_COUNT > visible) ? HELP_KEY_COUNT - visible : 0; // oberste Zeile ganz unten
+    int top = 0;
+    int open = 1;
+    while (open) {
+        draw_help(win, top);
+        switch (wgetch(win)) {
+        case KEY_UP:
+            top -= (top > 0);
+            break;
+        case KEY_DOWN:
+            top += (top < last);
+            break;
+        case KEY_PPAGE:
+            top = (top > visible) ? top - visible : 0;
+            break;
+        case KEY_NPAGE:
+            top = (top + visible < last) ? top + visible : last;
+            break;
+        case 27:                                       // Escape schließt
+        case '\n':
+        case '\r':
+        case KEY_ENTER:
+        case 'q':
+        case HELP_SCREEN_CLOSE:
+            open = 0;
+            break;
+        default:
+            break;
+        }
+    }
+
+    NCURSES_CHECK(delwin(win));
+    NCURSES_CHECK(clearok(curscr, TRUE));              // Reste beim nächsten Zeichnen übermalen
+}
+
+//* ---------------------------------- Helfer Funktionen ----------------------------------
+/**
+ * @brief Zeichnet Rahmen, Titel und die sichtbaren Zeilen.
+ */
+static void draw_help(WINDOW *win, int top) {
+    int width = getmaxx(win) - 2;
+    int visible = getmaxy(win) - 2;
+    NCURSES_CHECK(werase(win));
+    NCURSES_CHECK(box(win, 0, 0));
+    NCURSES_CHECK(mvwaddnstr(win, 0, 2, " Keys ", width - 2));
+    NCURSES_CHECK(mvwaddnstr(win, getmaxy(win) - 1, 2, " Up/Down: Scroll  Esc: Close ",
+                             width - 3));                // untere rechte Ecke frei lassen
+
+    for (int row = 0; row < visible && top + row < HELP_KEY_COUNT; row++) {
+        const HelpEntry *entry = &HELP_KEYS[top + row];
+        NCURSES_CHECK(mvwprintw(win, 1 + row, 1, "%-*.*s", width, width, ""));
+        NCURSES_CHECK(wattron(win, A_BOLD));
+        NCURSES_CHECK(mvwaddnstr(win, 1 + row, 2, entry->keys, width - 1));
+        NCURSES_CHECK(wattroff(win, A_BOLD));
+        if (width > HELP_SCREEN_KEYS + 2) {
+            NCURSES_CHECK(mvwaddnstr(win, 1 + row, 2 + HELP_SCREEN_KEYS, entry->action,
+                                     width - HELP_SCREEN_KEYS - 1));
+        }
+    }
+    NCURSES_CHECK(wrefresh(win));
+}
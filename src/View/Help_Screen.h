@@ -0,0 +1,28 @@
+#ifndef HELP_SCREEN_H
+#define HELP_SCREEN_H
+
+/**
+ * @file Help_Screen.h
+ * @brief Schnittstelle der Tastenübersicht.
+ *
+ * Die Übersicht erscheint als eigenes Fenster über dem Editor und
+ * listet alle Tasten mit ihrer Wirkung. Die obere Statusleiste nennt
+ * nur die wichtigsten, damit sie auch in 80 Spalten vollständig passt.
+ */
+
+#ifdef _WIN32
+#include <ncurses/ncurses.h> // Windows-Spezifikum
+#else
+#include <ncurses.h>         // Standard-ncurses auf Unix
+#endif
+
+//* ------------------------------------- Funktionen --------------------------------------
+/**
+ * @brief Zeigt die Tastenübersicht, bis sie geschlossen wird.
+ *
+ * Pfeiltasten und Bildtasten blättern, wenn nicht alle Zeilen passen.
+ * `Esc`, `Enter`, `q` oder erneut `Strg+K` schließen.
+ */
+void help_screen_run(void);
+
+#endif // HELP_SCREEN_H
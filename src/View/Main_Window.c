@@ -12,13 +12,64 @@
 #include "Err_Log.h"                // Fehlerprotokollierung
 #include "Ncurses_Check.h"          // Makro für ncurses-Fehlerprüfung
 
+/**
+ * @brief Übernimmt Ansicht, Cursor und Darstellung des ersten Editors.
+ */
+static void sync_compare(Main_Window *self) {
+    Editor *compare = &self->compare;
+    const Editor *editor = &self->editor;
+    compare->display_mode = editor->display_mode;                  // gleiche Darstellung
+    compare->strategy = editor->strategy;
+    compare->value_type = editor->value_type;
+    compare->big_endian = editor->big_endian;
+    compare->start_offset = editor->start_offset;                  // gleicher Ausschnitt
+    compare->cursor_y = editor->cursor_y;
+    compare->cursor_x = editor->cursor_x;
+    compare->cursor_area = editor->cursor_area;
+}
+
 /**
  * @brief Zeichnet alle Bereiche des Hauptfensters.
+ *
+ * Jeder Bereich gibt nur aus, was sich seit dem letzten Mal geändert
+ * hat; ans Terminal geht alles gesammelt mit einem `doupdate`.
  */
 void main_window_draw(Main_Window *self) {
     top_bar_draw(&self->top_bar);                                  // obere Leiste zeichnen
     bottom_bar_draw(&self->bottom_bar, &self->editor, self->editor.buffer); // untere Leiste
-    editor_draw(&self->editor);                                    // Editor rendern
+    if (self->comparing) {
+        sync_compare(self);                                        // Editoren synchron halten
+        editor_draw(&self->compare);                               // vor dem Editor mit Cursor
+    }
+    editor_draw(&self->editor);                                    // Editor rendern, zuletzt wegen des Cursors
+    NCURSES_CHECK(doupdate());                                     // gesammelte Änderungen ausgeben
+}
+
+/**
+ * @brief Erzwingt beim nächsten Zeichnen alle Bereiche vollständig.
+ */
+void main_window_invalidate(Main_Window *self) {
+    top_bar_invalidate(&self->top_bar);
+    bottom_bar_invalidate(&self->bottom_bar);
+    editor_invalidate(&self->editor);
+    if (self->comparing) {
+        editor_invalidate(&self->compare);
+    }
+}
+
+/**
+ * @brief Färbt die Bytes beider Editoren nach ihrer Byteklasse ein.
+ */
+int main_window_enable_colors(Main_Window *self) {
+    if (render_table_setup_colors() != 0) {
+        return -1;                                                 // Terminal ohne Farben
+    }
+    render_table_init(&self->editor.table, 1);
+    if (self->comparing) {
+        render_table_init(&self->compare.table, 1);
+    }
+    main_window_invalidate(self);                                  // alle Zeilen mit Farben neu
+    return 0;
 }
 
 /**
@@ -31,9 +82,13 @@ static void view_cleanup(void) {
 /**
  * @brief Prüft die Terminalgröße.
  */
-static void check_terminal_size(void) {
-    int minWidth = 78;                                             // Minimalbreite
-    int minHeight = 10;                                            // Minimalhöhe
+static void check_terminal_size(const DataBuffer *buffer, const DataBuffer *compare) {
+    size_t size = buffer->size;                                    // größter Inhalt bestimmt die Breite
+    if (compare && compare->size > size) {
+        size = compare->size;
+    }
+    int minWidth = 78 + getOffsetColWidthFor(size) - OFFSET_COL_WIDTH; // inkl. Offset-Spalte
+    int minHeight = compare ? 14 : 10;                             // Minimalhöhe, zwei Editoren brauchen mehr
     if (COLS < minWidth || LINES < minHeight) {                    // Größe prüfen
         fatal_error("main_window_init", "terminal size too small");
     }
@@ -42,7 +97,7 @@ static void check_terminal_size(void) {
 /**
  * @brief Initialisiert das Hauptfenster.
  */
-int main_window_init(Main_Window *self, DataBuffer *buffer) {
+int main_window_init(Main_Window *self, DataBuffer *buffer, DataBuffer *compare) {
     memset(self, 0, sizeof(*self));                                // Struktur zurücksetzen
     if (!initscr()) {                                              // ncurses initialisieren
         fatal_error("main_window_init", "initscr");             // Fehlerbehandlung
@@ -51,8 +106,10 @@ int main_window_init(Main_Window *self, DataBuffer *buffer) {
     NCURSES_CHECK(cbreak());                                       // Terminal in cbreak-Modus setzen
     NCURSES_CHECK(noecho());                                       // Eingaben nicht anzeigen
     NCURSES_CHECK(keypad(stdscr, TRUE));                           // Funktionstasten aktivieren
+    mousemask(BUTTON1_PRESSED | BUTTON1_CLICKED, NULL);            // Klicks in die Übersicht, ohne Maus egal
+    mouseinterval(0);                                              // Klick sofort melden
     NCURSES_CHECK(refresh());                                      // Darstellung aktualisieren
-    check_terminal_size();                                         // Terminalgröße überprüfen
+    check_terminal_size(buffer, compare);                          // Terminalgröße überprüfen
 
     int width = COLS;                                              // gesamte Terminalbreite
     int top_height = 3;                                            // Höhe der oberen Leiste
@@ -60,7 +117,17 @@ int main_window_init(Main_Window *self, DataBuffer *buffer) {
     int editor_height = LINES - top_height - bottom_height;        // verbleibende Höhe
 
     top_bar_init(&self->top_bar, width);                           // obere Leiste initialisieren
-    editor_init(&self->editor, editor_height, width, top_height, buffer); // Editor einrichten
+    if (compare) {                                                 // Platz für zwei Editoren teilen
+        int first_height = editor_height / 2;
+        editor_init(&self->editor, first_height, width, top_height, buffer);
+        editor_init(&self->compare, editor_height - first_height, width,
+                    top_height + first_height, compare);
+        self->editor.compare = compare;                            // Unterschiede in beiden markieren
+        self->compare.compare = buffer;
+        self->comparing = 1;
+    } else {
+        editor_init(&self->editor, editor_height, width, top_height, buffer); // Editor einrichten
+    }
     bottom_bar_init(&self->bottom_bar, width, top_height + editor_height); // untere Leiste
 
     return 0;                                                      // Erfolg zurückgeben
@@ -68,9 +135,19 @@ int main_window_init(Main_Window *self, DataBuffer *buffer) {
 
 /**
  * @brief Gibt alle Ressourcen frei.
+ *
+ * Ein zweiter Aufruf tut nichts; so kann `main` die Oberfläche vor der
+ * Rückfrage im Terminal schließen und den Controller danach regulär
+ * freigeben.
  */
 int main_window_deinit(Main_Window *self) {
+    if (self->top_bar.win == NULL) {
+        return 0;                                                  // bereits freigegeben
+    }
     bottom_bar_deinit(&self->bottom_bar);                          // untere Leiste freigeben
+    if (self->comparing) {
+        editor_deinit(&self->compare);                             // zweiten Editor freigeben
+    }
     editor_deinit(&self->editor);                                  // Editor freigeben
     top_bar_deinit(&self->top_bar);                                // obere Leiste freigeben
     NCURSES_CHECK(endwin());                                       // ncurses sauber beenden
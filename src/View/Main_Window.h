@@ -6,7 +6,9 @@
  * @brief Schnittstelle des Hauptfensters.
  *
  * Dieser Header beschreibt die zentrale Fensterstruktur, welche
- * obere und untere Statusleiste sowie Editor vereint.
+ * obere und untere Statusleiste sowie Editor vereint. Im
+ * Vergleichsmodus teilen sich zwei Editoren den Platz; der zweite
+ * folgt dabei stets Ansicht und Cursor des ersten.
  */
 
 #ifdef _WIN32                                 // Plattformabhängige Einbindung
@@ -24,6 +26,8 @@
 typedef struct {
     Top_Bar top_bar;      /**< obere Leiste */
     Editor editor;        /**< Editor-Bereich */
+    Editor compare;       /**< zweiter Editor im Vergleichsmodus */
+    int comparing;        /**< 1, wenn `compare` angezeigt wird */
     BottomBar bottom_bar; /**< untere Leiste */
 } Main_Window;
 
@@ -32,10 +36,24 @@ typedef struct {
  */
 void main_window_draw(Main_Window *self);
 
+/**
+ * @brief Erzwingt beim nächsten Zeichnen alle Bereiche vollständig, etwa nach einem Overlay.
+ */
+void main_window_invalidate(Main_Window *self);
+
+/**
+ * @brief Färbt die Bytes beider Editoren nach ihrer Byteklasse ein.
+ * @return 0 bei Erfolg, -1 wenn das Terminal keine Farben kann
+ */
+int main_window_enable_colors(Main_Window *self);
+
 /**
  * @brief Initialisiert das Hauptfenster.
+ * @param self    Zeiger auf das Hauptfenster
+ * @param buffer  Inhalt des Editors
+ * @param compare Inhalt des zweiten Editors, NULL = kein Vergleich
  */
-int main_window_init(Main_Window *self, DataBuffer *buffer);
+int main_window_init(Main_Window *self, DataBuffer *buffer, DataBuffer *compare);
 
 /**
  * @brief Gibt Ressourcen frei.
@@ -0,0 +1,81 @@
+/**
+ * @file Render_Table.c
+ * @brief Aufbau der Zeichentabellen für die Datenzeilen.
+ *
+ * Die Tabellen werden einmal beim Anlegen des Editors gefüllt, Hex-Ziffern
+ * und ASCII-Zeichen mit denselben Kernen wie `--dump`, sodass Ansicht und
+ * Ausgabe ohne Oberfläche übereinstimmen. Druckbar sind unabhängig von der
+ * Locale genau die Zeichen 0x20 bis 0x7E.
+ */
+
+//* -------------------------------------- Includes ---------------------------------------
+#include "Render_Table.h"
+#include <string.h>
+#include "Dump_Export.h" // Hex-Ziffern und ASCII-Zeichen wie bei `--dump`
+
+//* ---------------------------- Globale Konstanten oder Defines --------------------------
+
+//* ------------------------------------- Funktionen --------------------------------------
+// Vorwärtsdeklarationen der Helferfunktionen
+static short class_pair(unsigned char byte);
+
+/**
+ * @brief Richtet die Farbpaare der Byteklassen ein.
+ */
+int render_table_setup_colors(void) {
+    if (!has_colors() || start_color() == ERR) {
+        return -1;
+    }
+    short background = (use_default_colors() == OK) ? -1 : COLOR_BLACK; // Terminalhintergrund behalten
+    init_pair(RENDER_PAIR_ZERO, COLOR_BLUE, background);
+    init_pair(RENDER_PAIR_FULL, COLOR_RED, background);
+    init_pair(RENDER_PAIR_TEXT, COLOR_CYAN, background);
+    init_pair(RENDER_PAIR_SPACE, COLOR_GREEN, background);
+    init_pair(RENDER_PAIR_CONTROL, COLOR_MAGENTA, background);
+    init_pair(RENDER_PAIR_HIGH, COLOR_YELLOW, background);
+    return 0;
+}
+
+//* ---------------------------------- Helfer Funktionen ----------------------------------
+// Farbpaar der Byteklasse eines Werts
+static short class_pair(unsigned char byte) {
+    if (byte == 0x00) {
+        return RENDER_PAIR_ZERO;
+    }
+    if (byte == 0xFF) {
+        return RENDER_PAIR_FULL;
+    }
+    if (byte >= 0x20 && byte < 0x7F) {
+        return RENDER_PAIR_TEXT;
+    }
+    if (byte == '\t' || byte == '\n' || byte == '\r') {
+        return RENDER_PAIR_SPACE;
+    }
+    return (byte < 0x80) ? RENDER_PAIR_CONTROL : RENDER_PAIR_HIGH;
+}
+
+//* ----------------------------------- Init und Deinit -----------------------------------
+/**
+ * @brief Füllt die Tabellen.
+ */
+void render_table_init(RenderTable *self, int colors) {
+    memset(self, 0, sizeof(*self));
+    unsigned char values[256];
+    for (int value = 0; value < 256; value++) {
+        values[value] = (unsigned char)value;
+    }
+    char hex[512];
+    char glyphs[256];
+    dump_hex(values, 256, hex, 0);  // dieselben Kerne wie die Ausgabe ohne Oberfläche
+    dump_ascii(values, 256, glyphs);
+    for (int value = 0; value < 256; value++) {
+        unsigned char byte = (unsigned char)value;
+        self->hex[value][0] = (chtype)(unsigned char)hex[2 * value];
+        self->hex[value][1] = (chtype)(unsigned char)hex[2 * value + 1];
+        for (int bit = 0; bit < 8; bit++) {
+            self->bits[value][bit] = (byte & (0x80u >> bit)) ? (chtype)'1' : (chtype)'0';
+        }
+        self->glyph[value] = (chtype)(unsigned char)glyphs[value];
+        self->color[value] = colors ? (chtype)COLOR_PAIR(class_pair(byte)) : 0;
+    }
+}
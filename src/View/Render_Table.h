@@ -0,0 +1,59 @@
+#ifndef RENDER_TABLE_H
+#define RENDER_TABLE_H
+
+/**
+ * @file Render_Table.h
+ * @brief Vorberechnete Zeichen je Bytewert für die Datenzeilen.
+ *
+ * Für jeden der 256 Bytewerte liegen Hex-Ziffern, Bitfolge, ASCII-Zeichen
+ * und Farbe der Byteklasse bereits als `chtype` vor. Eine Datenzeile wird
+ * damit ohne Formatierung und ohne Aufrufe je Byte zusammengesetzt und
+ * in einem Stück ausgegeben.
+ */
+
+//* -------------------------------------- Includes ---------------------------------------
+#ifdef _WIN32
+#include <ncurses/ncurses.h>
+#else
+#include <ncurses.h>
+#endif
+
+//* ---------------------------- Globale Konstanten oder Defines --------------------------
+#define RENDER_PAIR_ZERO 1       /**< Farbpaar für Nullbytes */
+#define RENDER_PAIR_FULL 2       /**< Farbpaar für 0xFF */
+#define RENDER_PAIR_TEXT 3       /**< Farbpaar für druckbare ASCII-Zeichen */
+#define RENDER_PAIR_SPACE 4      /**< Farbpaar für Tabulator und Zeilenumbrüche */
+#define RENDER_PAIR_CONTROL 5    /**< Farbpaar für übrige Steuerzeichen */
+#define RENDER_PAIR_HIGH 6       /**< Farbpaar für Bytes ab 0x80 */
+
+//* ------------------------------------- Strukturen --------------------------------------
+/**
+ * @brief Zeichen und Attribute je Bytewert.
+ */
+typedef struct {
+    chtype hex[256][2];   /**< zwei Hex-Ziffern */
+    chtype bits[256][8];  /**< Bitfolge, höchstwertiges Bit zuerst */
+    chtype glyph[256];    /**< ASCII-Zeichen, nicht druckbare als Punkt */
+    chtype color[256];    /**< Farbe der Byteklasse, 0 ohne Farben */
+} RenderTable;
+
+//* ------------------------------------- Funktionen --------------------------------------
+/**
+ * @brief Richtet die Farbpaare der Byteklassen ein.
+ *
+ * Muss nach `initscr` aufgerufen werden. Der Hintergrund des Terminals
+ * bleibt erhalten, sofern es Standardfarben unterstützt.
+ *
+ * @return 0 bei Erfolg, -1 wenn das Terminal keine Farben kann
+ */
+int render_table_setup_colors(void);
+
+//* ----------------------------------- Init und Deinit -----------------------------------
+/**
+ * @brief Füllt die Tabellen.
+ * @param self   Zeiger auf die Tabellen
+ * @param colors 1 = Byteklassen einfärben, setzt `render_table_setup_colors` voraus
+ */
+void render_table_init(RenderTable *self, int colors);
+
+#endif // RENDER_TABLE_H
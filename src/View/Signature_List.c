@@ -0,0 +1,159 @@
+/**
+ * @file Signature_List.c
+ * @brief Ergebnisliste der Signatursuche.
+ *
+ * Die Liste ist modal wie die Eingabe in der Bottom-Bar: Sie liest
+ * ihre Tasten selbst und gibt erst nach `Enter` oder `Esc` zurück.
+ * Danach wird der gesamte Bildschirm beim nächsten Zeichnen erneuert,
+ * damit keine Reste des Fensters stehen bleiben.
+ */
+
+//* -------------------------------------- Includes ---------------------------------------
+#include "Signature_List.h" // Schnittstelle dieses Moduls
+#include <stdio.h>           // snprintf für die Zeilen
+#include <stdlib.h>          // malloc und free
+#include "Err_Log.h"        // Fehlerbehandlung
+#include "Ncurses_Check.h"  // Makro zur Fehlerkontrolle
+
+//* ---------------------------- Globale Konstanten oder Defines --------------------------
+#define SIGNATURE_LIST_WIDTH 76 /**< größte Breite des Fensters */
+#define SIGNATURE_LIST_NAME 20  /**< Spaltenbreite der Namen */
+
+// Vorwärtsdeklarationen der Helferfunktionen
+static void draw_list(WINDOW *win, const SignatureScan *scan, const size_t *current,
+                      size_t selected, size_t top);
+
+//* ------------------------------------- Funktionen --------------------------------------
+/**
+ * @brief Zeigt die Ergebnisliste, bis eine Fundstelle gewählt oder abgebrochen wird.
+ *
+ * @param scan     angezeigte Ergebnisse
+ * @param cursor   aktuelle Position im Editor
+ * @param selected Ein- und Ausgabe: gewählte Signatur
+ * @param out      erhält die gewählte Fundstelle
+ * @return 0 wenn gesprungen werden soll, sonst -1
+ */
+int signature_list_run(const SignatureScan *scan, size_t cursor, size_t *selected, size_t *out) {
+    size_t *current = (size_t *)malloc(scan->count * sizeof(size_t)); // gewählte Fundstelle je Signatur
+    if (!current) {
+        fatal_error("signature_list_run", "out of memory");
+    }
+    for (size_t i = 0; i < scan->count; i++) {
+        size_t first = signature_scan_first_from(scan, i, cursor);
+        size_t count = scan->signatures[i].hit_count;
+        current[i] = (first < count || count == 0) ? first : count - 1; // sonst die letzte davor
+    }
+    if (*selected >= scan->count) {
+        *selected = 0;
+    }
+
+    int height = (int)scan->count + 2;                  // Zeilen plus Rahmen
+    if (height > LINES - 2) {
+        height = LINES - 2;
+    }
+    int width = (COLS - 4 < SIGNATURE_LIST_WIDTH) ? COLS - 4 : SIGNATURE_LIST_WIDTH;
+    WINDOW *win = newwin(height, width, (LINES - height) / 2, (COLS - width) / 2);
+    if (!win) {
+        fatal_error("signature_list_run", "newwin");
+    }
+    NCURSES_CHECK(keypad(win, TRUE));
+    size_t visible = (size_t)(height - 2);
+    size_t top = 0;
+    int result = -1;
+    int open = 1;
+    while (open) {
+        if (*selected < top) {
+            top = *selected;                           // Auswahl sichtbar halten
+        } else if (*selected >= top + visible) {
+            top = *selected - visible + 1;
+        }
+        draw_list(win, scan, current, *selected, top);
+
+        const Signature *signature = &scan->signatures[*selected];
+        size_t *hit = &current[*selected];
+        switch (wgetch(win)) {
+        case KEY_UP:
+            if (*selected > 0) {
+                (*selected)--;
+            }
+            break;
+        case KEY_DOWN:
+            if (*selected + 1 < scan->count) {
+                (*selected)++;
+            }
+            break;
+        case KEY_LEFT:                                 // vorherige Fundstelle
+            if (*hit > 0) {
+                (*hit)--;
+            }
+            break;
+        case KEY_RIGHT:                                // nächste Fundstelle
+            if (*hit + 1 < signature->hit_count) {
+                (*hit)++;
+            }
+            break;
+        case '\n':
+        case '\r':
+        case KEY_ENTER:
+            if (*hit < signature->hit_count) {
+                *out = signature->hits[*hit];
+                result = 0;
+                open = 0;
+            }
+            break;
+        case 27:                                       // Escape schließt
+        case KEY_F(11):
+            open = 0;
+            break;
+        default:
+            break;
+        }
+    }
+
+    NCURSES_CHECK(delwin(win));
+    NCURSES_CHECK(clearok(curscr, TRUE));              // Reste beim nächsten Zeichnen übermalen
+    free(current);
+    return result;
+}
+
+//* ---------------------------------- Helfer Funktionen ----------------------------------
+/**
+ * @brief Zeichnet Rahmen, Titel und die sichtbaren Zeilen.
+ */
+static void draw_list(WINDOW *win, const SignatureScan *scan, const size_t *current,
+                      size_t selected, size_t top) {
+    int width = getmaxx(win) - 2;
+    size_t visible = (size_t)(getmaxy(win) - 2);
+    NCURSES_CHECK(werase(win));
+    NCURSES_CHECK(box(win, 0, 0));
+
+    char title[64];
+    unsigned int progress = signature_scan_progress(scan);
+    snprintf(title, sizeof(title), " Signatures: %u%% scanned%s ", progress,
+             scan->truncated ? ", hits truncated" : "");
+    NCURSES_CHECK(mvwaddnstr(win, 0, 2, title, width - 2));
+    NCURSES_CHECK(mvwaddnstr(win, getmaxy(win) - 1, 2, " Left/Right: Hit  Enter: Jump  Esc: Close ",
+                             width - 3));                // untere rechte Ecke frei lassen
+
+    for (size_t row = 0; row < visible && top + row < scan->count; row++) {
+        size_t i = top + row;
+        const Signature *signature = &scan->signatures[i];
+        char line[160];
+        if (signature->hit_count > 0) {
+            snprintf(line, sizeof(line), "%-*s %9zu hits  %zu/%zu at %llx", SIGNATURE_LIST_NAME,
+                     signature->name, signature->hit_count, current[i] + 1, signature->hit_count,
+                     (unsigned long long)signature->hits[current[i]]);
+        } else {
+            snprintf(line, sizeof(line), "%-*s %9zu hits", SIGNATURE_LIST_NAME, signature->name,
+                     (size_t)0);
+        }
+        if (i == selected) {
+            NCURSES_CHECK(wattron(win, A_REVERSE));
+        }
+        NCURSES_CHECK(mvwprintw(win, 1 + (int)row, 1, "%-*.*s", width, width, line));
+        if (i == selected) {
+            NCURSES_CHECK(wattroff(win, A_REVERSE));
+        }
+    }
+    NCURSES_CHECK(wrefresh(win));
+}
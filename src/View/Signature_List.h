@@ -0,0 +1,38 @@
+#ifndef SIGNATURE_LIST_H
+#define SIGNATURE_LIST_H
+
+/**
+ * @file Signature_List.h
+ * @brief Schnittstelle der Ergebnisliste der Signatursuche.
+ *
+ * Die Liste erscheint als eigenes Fenster über dem Editor. Jede Zeile
+ * zeigt eine Signatur mit der Anzahl ihrer Fundstellen und der gerade
+ * gewählten Fundstelle. Solange die Liste offen ist, ruht der
+ * Durchlauf der Signatursuche.
+ */
+
+#ifdef _WIN32
+#include <ncurses/ncurses.h> // Windows-Spezifikum
+#else
+#include <ncurses.h>         // Standard-ncurses auf Unix
+#endif
+#include <stddef.h>           // stellt den Typ size_t bereit
+#include "Signature_Scan.h"  // angezeigte Ergebnisse
+
+//* ------------------------------------- Funktionen --------------------------------------
+/**
+ * @brief Zeigt die Ergebnisliste, bis eine Fundstelle gewählt oder abgebrochen wird.
+ *
+ * Mit den Pfeiltasten hoch und runter wird die Signatur gewählt, mit
+ * links und rechts die Fundstelle; anfangs ist je Signatur die erste
+ * Fundstelle ab `cursor` gewählt. `Enter` springt, `Esc` schließt.
+ *
+ * @param scan     angezeigte Ergebnisse
+ * @param cursor   aktuelle Position im Editor
+ * @param selected Ein- und Ausgabe: gewählte Signatur
+ * @param out      erhält die gewählte Fundstelle
+ * @return 0 wenn gesprungen werden soll, sonst -1
+ */
+int signature_list_run(const SignatureScan *scan, size_t cursor, size_t *selected, size_t *out);
+
+#endif // SIGNATURE_LIST_H
@@ -5,6 +5,8 @@
  * Dieses Modul enthält die Implementierungen für die obere
  * Statusleiste. Es zeichnet feste Hinweise zu den wichtigsten
  * Tastenkombinationen und verwaltet ein eigenes `ncurses`-Fenster.
+ * Der Hinweis passt in 80 Spalten; alle weiteren Tasten stehen in der
+ * Übersicht von `Help_Screen`.
  * Bei Fehlern während der Initialisierung oder Ausgabe wird das
  * zentrale Fehlerlog informiert.
  */
@@ -21,15 +23,34 @@
 /**
  * @brief Zeichnet Hinweise zu den Tasten.
  *
+ * Der Text ändert sich nicht; nach dem ersten Mal wird erst nach
+ * `top_bar_invalidate` wieder gezeichnet.
+ *
  * @param bar Zeiger auf die zu zeichnende Top-Bar
  */
 void top_bar_draw(Top_Bar *bar) {
-    NCURSES_CHECK(box(bar->win, 0, 0)); // Rahmen um das Fenster zeichnen
-    NCURSES_CHECK(mvwprintw(bar->win, 1, 1, "%s",
-                  "PgUp/PgDn: Scroll  Tab: Switch  F1: Hex/Bin  F2: Save  F3: Reload  F12: Quit"));
+    if (bar->drawn) {
+        return;                         // fester Text, nur einmal ausgeben
+    }
+    bar->drawn = 1;
+    NCURSES_CHECK(werase(bar->win));    // Reste eines Overlays entfernen
+    NCURSES_CHECK(box(bar->win, 0, 0)); // Rahmen um das Fenster zeichnen // Rahmen um das Fenster zeichnen
+    // Text auf die Innenbreite kürzen, damit der Rahmen erhalten bleibt
+    NCURSES_CHECK(mvwaddnstr(bar->win, 1, 1,
+                  "^K: Keys  Tab: Switch  F1: Hex/Bin  F2: Save  F5: Undo  F8: Find  F12: Quit",
+                  getmaxx(bar->win) - 2));
     NCURSES_CHECK(wnoutrefresh(bar->win)); // Ausgaben sammeln, aber noch nicht anzeigen
 }
  
+/**
+ * @brief Erzwingt das erneute Zeichnen beim nächsten Aufruf.
+ *
+ * @param bar Zeiger auf die Top-Bar
+ */
+void top_bar_invalidate(Top_Bar *bar) {
+    bar->drawn = 0;
+}
+
 //* ---------------------------------- Helfer Funktionen ----------------------------------
 
 //* ----------------------------------- Init und Deinit -----------------------------------
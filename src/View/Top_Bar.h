@@ -26,6 +26,7 @@
  */
 typedef struct {           // Daten der Top-Bar
     WINDOW *win; /**< ncurses-Fenster der Top-Bar */
+    int drawn;   /**< 1 = Inhalt steht bereits im Fenster */
 } Top_Bar;                 // Typname der Top-Bar-Struktur
 
 //* ------------------------------------- Funktionen --------------------------------------
@@ -34,6 +35,11 @@ typedef struct {           // Daten der Top-Bar
  */
 void top_bar_draw(Top_Bar *bar);      // zeichnet die Top-Bar
 
+/**
+ * @brief Erzwingt das erneute Zeichnen, etwa nach einem Overlay.
+ */
+void top_bar_invalidate(Top_Bar *bar); // beim nächsten Mal neu zeichnen
+
 //* ----------------------------------- Init und Deinit -----------------------------------
 /**
  * @brief Initialisiert die Top-Bar.
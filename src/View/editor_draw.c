@@ -5,7 +5,8 @@
  * Dieses Modul übernimmt die komplette Darstellung des Editors auf
  * dem Bildschirm. Es zeichnet Rahmen, Überschriften, die eigentlichen
  * Datenzeilen sowie den Cursor. Die Formatierung der Bytewerte
- * richtet sich nach der aktiven `DisplayStrategy`. Alle
+ * richtet sich nach der aktiven `DisplayStrategy`; in der Werteansicht
+ * wird jede Zeile mit einem Aufruf von `value_format_row` formatiert. Alle
  * Zeichenfunktionen prüfen auf Fehler und melden diese über das
  * zentrale Fehlersystem.
  */
@@ -15,30 +16,92 @@
 #include "Utilities.h"
 #include "Display_Strategy.h"
 #include <string.h>
-#include <ctype.h>
+#include <stdint.h>
 #include "Err_Log.h"
 #include "Ncurses_Check.h" // Makro für sichere ncurses-Aufrufe
 
 //* ---------------------------- Globale Konstanten oder Defines --------------------------
+/** Obergrenze für Zeichen einer Datenzeile von der Offset-Spalte bis zum Ende der ASCII-Spalte */
+#define EDITOR_LINE_CELLS (OFFSET_COL_WIDTH_WIDE + 2 + EDITOR_MAX_BYTES_PER_LINE * (BIN_COL_WIDTH + 1))
+/** Obergrenze für Zeichen der formatierten Werte einer Zeile, 2 Bytes je Wert */
+#define EDITOR_VALUE_CHARS (EDITOR_MAX_BYTES_PER_LINE / 2 * VALUE_TEXT_MAX)
 
 //* ------------------------------------- Funktionen --------------------------------------
 // Vorwärtsdeklarationen der Helferfunktionen
 static void draw_editor_frame(Editor *self);
 static void draw_editor_header(Editor *self);
 static void draw_editor_line(Editor *self, int row);
+static void compare_line(const Editor *self, size_t lineStart, const unsigned char *lineBytes,
+                         int bytesPerLine, unsigned char *differs);
+static void mark_line(const Editor *self, size_t lineStart, int bytesPerLine,
+                      unsigned char *marked);
+static void fill_value_cells(const Editor *self, chtype *cells, size_t lineStart,
+                             const unsigned char *lineBytes, size_t available,
+                             const chtype *cellAttrs);
+static void draw_map(Editor *self, int rowCount);
+static void map_row_range(const Editor *self, int row, int rowCount, size_t *start, size_t *end);
 static void update_editor_cursor(Editor *self);
+static int collect_dirty_rows(Editor *self, int rowCount);
+static int scroll_rows(Editor *self, int rowCount);
+static int collect_changes(Editor *self, const DataBuffer *buffer, unsigned long drawnRevision,
+                           int rowCount);
+static void mark_dirty_range(Editor *self, size_t start, size_t end, int rowCount);
+static void mark_dirty_between(Editor *self, size_t a, size_t b, int rowCount);
+static void shown_mark(const Editor *self, uint64_t *bit, size_t *bits);
+static size_t shown_value(const Editor *self);
+static void remember_drawn(Editor *self);
 
-// Gesamten Editorinhalt zeichnen
+// Editorinhalt zeichnen, nur was sich seit dem letzten Mal geändert hat
 void editor_draw(Editor *self) {
     int rowCount = getmaxy(self->win) - 3; // verfügbare Zeilen für Daten
-    NCURSES_CHECK(werase(self->win));      // Fensterinhalt löschen
-    draw_editor_frame(self);   // Rahmen zeichnen
-    draw_editor_header(self);  // Kopfzeile ausgeben
-    for (int row = 0; row < rowCount; row++) { // jede Zeile ausgeben
-        draw_editor_line(self, row);
+    int moved = self->drawn.start_offset != self->start_offset; // Ausschnitt verschoben
+    int full = collect_dirty_rows(self, rowCount); // 1 = ganzes Fenster erneuern
+    if (full) {
+        NCURSES_CHECK(werase(self->win));  // Fensterinhalt löschen
+        draw_editor_frame(self);   // Rahmen zeichnen
+        draw_editor_header(self);  // Kopfzeile ausgeben
+    } else if (moved) {
+        draw_editor_frame(self);   // Rahmen der freigelegten Zeilen ergänzen
     }
+    for (int row = 0; row < rowCount; row++) { // jede betroffene Zeile ausgeben
+        if (full || self->dirty_rows[row]) {
+            draw_editor_line(self, row);
+        }
+    }
+    if (full || moved || self->drawn.revision != self->buffer->revision ||
+        (self->map && (self->drawn.map_stale != self->map->stale_count ||
+                       self->drawn.map_revision != self->map->revision))) {
+        draw_map(self, rowCount);   // Übersicht über die ganze Datei
+    }
+    remember_drawn(self);
     update_editor_cursor(self); // Cursor positionieren
-    NCURSES_CHECK(wrefresh(self->win)); // Fenster aktualisieren
+    NCURSES_CHECK(wnoutrefresh(self->win)); // Ausgabe erst mit doupdate()
+}
+
+// Erzwingt beim nächsten Zeichnen eine vollständige Erneuerung
+void editor_invalidate(Editor *self) {
+    self->drawn.valid = 0;
+}
+
+/**
+ * @brief Ermittelt das erste Byte der Übersichtszeile unter einer Fensterposition.
+ *
+ * @param self   Editorinstanz
+ * @param y      Zeile im Fenster
+ * @param x      Spalte im Fenster
+ * @param offset erhält das erste Byte des Bereichs dieser Zeile
+ * @return 0 wenn die Position in der Übersicht liegt, sonst -1
+ */
+int editor_map_hit(const Editor *self, int y, int x, size_t *offset) {
+    int mapX = getMapStartX(self);
+    int rowCount = getmaxy(self->win) - 3;
+    int row = y - 2;
+    if (mapX < 0 || x < mapX || x >= mapX + EDITOR_MAP_WIDTH || row < 0 || row >= rowCount) {
+        return -1;
+    }
+    size_t end;
+    map_row_range(self, row, rowCount, offset, &end);
+    return (*offset < end) ? 0 : -1;
 }
 
 //* ---------------------------------- Helfer Funktionen ----------------------------------
@@ -51,56 +114,435 @@ static void draw_editor_frame(Editor *self) {
 static void draw_editor_header(Editor *self) {
     NCURSES_CHECK(mvwprintw(self->win, 1, 1, "%s", "Offset")); // Spaltenüberschrift für Offset
     int asciiStartX = getAsciiStartX(self); // Startposition für ASCII-Bereich
-    NCURSES_CHECK(mvwprintw(self->win, 1, HEX_START_X, "%s", self->strategy->header_label()));
+    NCURSES_CHECK(mvwprintw(self->win, 1, getHexStartX(self), "%s", self->strategy->header_label(self)));
     NCURSES_CHECK(mvwprintw(self->win, 1, asciiStartX, "%s", "ASCII"));
 }
 
-// Zeichnet eine Datenzeile
+/**
+ * @brief Zeichnet eine Datenzeile.
+ *
+ * Die ganze Zeile von der Offset-Spalte bis zum Ende der ASCII-Spalte
+ * wird aus den Zeichentabellen in einem Buffer zusammengesetzt und mit
+ * einem einzigen `mvwaddchnstr` ausgegeben. Zeigt eine Zelle mehrere
+ * Bytes, erhält sie die Hervorhebungen aller ihrer Bytes.
+ */
 static void draw_editor_line(Editor *self, int row) {
-    NCURSES_CHECK(mvwprintw(self->win, row + 2, 1, "%08lx", (unsigned long)idx(self, row, 0)));
-    int cellWidth = getCellWidth(self);   // Breite einer Zelle im Hex-Bereich
+    static const char hexDigits[] = "0123456789abcdef";
+    const RenderTable *table = &self->table;
+    int cellWidth = getCellWidth(self);       // Breite einer Zelle im Hex-Bereich
     int bytesPerLine = getBytesPerLine(self); // Anzahl der Bytes pro Zeile
+    int elementSize = getElementSize(self);   // Bytes je Zelle
+    int offsetWidth = getOffsetColWidth(self);
+    int hexStartX = getHexStartX(self);       // Startposition des Datenbereichs
     int asciiStartX = getAsciiStartX(self);   // Startposition des ASCII-Bereichs
+    size_t lineStart = self->start_offset + (size_t)row * (size_t)bytesPerLine; // erster Index der Zeile
 
-    // Hex- oder Binärwerte zeichnen
+    // Bytes der Zeile in einem Schritt aus dem Buffer holen
+    unsigned char lineBytes[EDITOR_MAX_BYTES_PER_LINE];
+    size_t size = self->buffer->size;
+    size_t lineEnd = lineStart + (size_t)bytesPerLine;
+    if (lineEnd > size) {
+        lineEnd = size; // letzte Zeile kann kürzer sein
+    }
+    if (lineStart < lineEnd) {
+        data_buffer_get_range(self->buffer, lineStart, lineEnd, lineBytes);
+    }
+    unsigned char differs[EDITOR_MAX_BYTES_PER_LINE] = {0}; // 1 = Byte weicht vom Vergleich ab
+    if (self->compare) {
+        compare_line(self, lineStart, lineBytes, bytesPerLine, differs);
+    }
+    unsigned char marked[EDITOR_MAX_BYTES_PER_LINE] = {0}; // hervorgehobene Bits je Byte, MSB zuerst
+    if (self->mark_bits > 0 && self->mark_revision == self->buffer->revision) {
+        mark_line(self, lineStart, bytesPerLine, marked);
+    }
+    int bitCells = (self->display_mode == DISPLAY_BIN); // Hervorhebung bitgenau möglich
+    size_t selectStart = 0;
+    size_t selectEnd = 0;                                 // leer, wenn keine Auswahl aktiv ist
+    editor_get_selection(self, &selectStart, &selectEnd);
+
+    // Zeile ab Spalte 1 vorbelegen, Lücken zwischen den Bereichen bleiben leer
+    chtype line[EDITOR_LINE_CELLS];
+    int length = asciiStartX + bytesPerLine - 1;
+    for (int x = 0; x < length; x++) {
+        line[x] = (chtype)' ';
+    }
+    for (int digit = 0; digit < offsetWidth; digit++) {
+        int shift = 4 * (offsetWidth - 1 - digit);
+        line[digit] = (chtype)(unsigned char)hexDigits[((unsigned long long)lineStart >> shift) & 0xFu];
+    }
+
+    chtype elementAttrs[EDITOR_MAX_BYTES_PER_LINE] = {0}; // Werteansicht: Hervorhebung je Zelle
     for (int col = 0; col < bytesPerLine; col++) {
-        size_t index = idx(self, row, col);              // Index im Buffer
-        int x = HEX_START_X + col * cellWidth;           // x-Position der Zelle
-        if (index < self->buffer->size) {                // Daten vorhanden
-            char cellString[10];
-            self->strategy->format_byte(self->buffer->bytes[index], cellString); // Byte formatieren
-            NCURSES_CHECK(mvwprintw(self->win, row + 2, x, "%s", cellString));
-        } else { // außerhalb des Buffers
-            NCURSES_CHECK(mvwprintw(self->win, row + 2, x, "%s", self->strategy->empty_cell()));
+        size_t index = lineStart + (size_t)col;            // Index im Buffer
+        chtype *cell = line + (hexStartX - 1) + col * cellWidth;
+        chtype *glyph = line + (asciiStartX - 1) + col;
+        chtype attr = 0;                                   // gemeinsame Hervorhebung beider Spalten
+        if (change_bitmap_test(&self->buffer->modified, index)) {
+            attr |= A_BOLD;                                // seit Laden/Speichern geändert
+        }
+        if (index >= selectStart && index < selectEnd) {
+            attr |= A_UNDERLINE;                           // Auswahl unterstreichen
+        }
+        chtype cellAttr = attr;
+        if (differs[col] || (marked[col] && !bitCells)) {
+            cellAttr |= A_REVERSE;                         // Unterschied oder Treffer hervorheben
         }
+        chtype glyphAttr = attr | ((differs[col] || marked[col]) ? A_REVERSE : 0);
+        if (elementSize > 1) {                             // Zellen folgen nach der Schleife
+            elementAttrs[col / elementSize] |= cellAttr;
+            if (index < size) {
+                *glyph = table->glyph[lineBytes[col]] | table->color[lineBytes[col]] | glyphAttr;
+            } else {
+                *glyph |= glyphAttr;
+            }
+            continue;
+        }
+        if (index >= size) {                               // außerhalb des Buffers: leere Zelle
+            for (int x = 0; x < cellWidth; x++) {
+                cell[x] |= cellAttr;
+            }
+            *glyph |= glyphAttr;
+            continue;
+        }
+        unsigned char byte = lineBytes[col];
+        chtype color = table->color[byte];
+        if (bitCells) {
+            for (int bit = 0; bit < 8; bit++) {
+                chtype bitAttr = (marked[col] & (0x80u >> bit)) ? A_REVERSE : 0; // einzelne Treffer-Bits
+                cell[bit] = table->bits[byte][bit] | color | cellAttr | bitAttr;
+            }
+        } else {
+            cell[0] = table->hex[byte][0] | color | cellAttr;
+            cell[1] = table->hex[byte][1] | color | cellAttr;
+        }
+        cell[cellWidth - 1] |= cellAttr;                   // Trenner gehört zur Zelle
+        *glyph = table->glyph[byte] | color | glyphAttr;
+    }
+    if (elementSize > 1) {
+        fill_value_cells(self, line + (hexStartX - 1), lineStart, lineBytes,
+                         (lineStart < lineEnd) ? lineEnd - lineStart : 0, elementAttrs);
     }
+    NCURSES_CHECK(mvwaddchnstr(self->win, row + 2, 1, line, length));
+}
 
-    // ASCII-Repräsentation zeichnen
+// Markiert die Bytes einer Zeile, die vom Vergleichsinhalt abweichen
+static void compare_line(const Editor *self, size_t lineStart, const unsigned char *lineBytes,
+                         int bytesPerLine, unsigned char *differs) {
+    size_t size = self->buffer->size;
+    size_t otherSize = self->compare->size;
+    unsigned char otherBytes[EDITOR_MAX_BYTES_PER_LINE];
+    size_t otherEnd = lineStart + (size_t)bytesPerLine;
+    if (otherEnd > otherSize) {
+        otherEnd = otherSize;
+    }
+    if (lineStart < otherEnd) {
+        data_buffer_get_range(self->compare, lineStart, otherEnd, otherBytes);
+    }
     for (int col = 0; col < bytesPerLine; col++) {
-        size_t index = idx(self, row, col);
-        int x = asciiStartX + col; // Spaltenposition im ASCII-Bereich
-        if (index < self->buffer->size) {
-            unsigned char currentChar = self->buffer->bytes[index];
-            if (isprint(currentChar)) { // druckbares Zeichen anzeigen
-                NCURSES_CHECK(mvwaddch(self->win, row + 2, x, (chtype)currentChar));
-            } else { // nicht druckbares Zeichen als Punkt
-                NCURSES_CHECK(mvwaddch(self->win, row + 2, x, (chtype)'.'));
+        size_t index = lineStart + (size_t)col;
+        int mine = index < size;                // Byte im eigenen Inhalt vorhanden
+        int theirs = index < otherSize;         // Byte im Vergleich vorhanden
+        differs[col] = (mine != theirs) || (mine && lineBytes[col] != otherBytes[col]);
+    }
+}
+
+// Ermittelt je Byte der Zeile die Bits, die zur hervorgehobenen Bitfolge gehören
+static void mark_line(const Editor *self, size_t lineStart, int bytesPerLine,
+                      unsigned char *marked) {
+    uint64_t first = self->mark_bit;
+    uint64_t last = first + self->mark_bits; // hinter dem letzten Bit
+    for (int col = 0; col < bytesPerLine; col++) {
+        uint64_t byteBit = (uint64_t)(lineStart + (size_t)col) * 8u; // höchstwertiges Bit des Bytes
+        if (byteBit + 8u <= first || byteBit >= last) {
+            continue;
+        }
+        unsigned int bits = 0xFF;
+        if (first > byteBit) {
+            bits &= 0xFFu >> (first - byteBit);  // Bits vor dem Anfang abschneiden
+        }
+        if (last < byteBit + 8u) {
+            bits &= 0xFFu << (byteBit + 8u - last); // Bits hinter dem Ende abschneiden
+        }
+        marked[col] = (unsigned char)bits;
+    }
+}
+
+/**
+ * @brief Setzt die Zellen einer Zeile der Werteansicht.
+ *
+ * Alle vollständigen Elemente der Zeile werden mit einem Aufruf
+ * formatiert. Ein unvollständiges Element am Dateiende bleibt leer,
+ * das Element mit angefangener Eingabe zeigt deren Text invers.
+ *
+ * @param cells     erste Zelle der Zeile
+ * @param available vorhandene Bytes der Zeile
+ * @param cellAttrs Hervorhebung je Zelle
+ */
+static void fill_value_cells(const Editor *self, chtype *cells, size_t lineStart,
+                             const unsigned char *lineBytes, size_t available,
+                             const chtype *cellAttrs) {
+    int elementSize = getElementSize(self);
+    int cellWidth = getCellWidth(self);
+    int width = value_type_width(self->value_type);  // Zeichen ohne Trenner
+    int cellCount = getBytesPerLine(self) / elementSize;
+    size_t complete = available / (size_t)elementSize;
+    char text[EDITOR_VALUE_CHARS];
+    value_format_row(self->value_type, self->big_endian, lineBytes, complete, text);
+    size_t editing = shown_value(self);               // Element mit angefangener Eingabe
+    for (int e = 0; e < cellCount; e++) {
+        chtype *cell = cells + e * cellWidth;
+        chtype attr = cellAttrs[e];
+        for (int x = 0; x < cellWidth; x++) {
+            cell[x] |= attr;                          // auch Trenner und leere Zellen
+        }
+        if (lineStart + (size_t)(e * elementSize) == editing) {
+            int length = self->value_length;
+            const char *shown = self->value_text;
+            if (length > width) {
+                shown += length - width;              // lange Eingaben: das Ende zeigen
+                length = width;
+            }
+            for (int x = 0; x < length; x++) {
+                cell[width - length + x] = (chtype)(unsigned char)shown[x] | attr | A_REVERSE;
             }
-        } else { // außerhalb des Buffers: Leerzeichen
-            NCURSES_CHECK(mvwaddch(self->win, row + 2, x, (chtype)' '));
+            continue;
+        }
+        if ((size_t)e >= complete) {
+            continue;
+        }
+        for (int x = 0; x < width; x++) {
+            cell[x] = (chtype)(unsigned char)text[e * width + x] | attr;
         }
     }
 }
 
+// Zeichnet je Zeile Byteklasse und Entropie ihres Dateibereichs, den sichtbaren Bereich invers
+static void draw_map(Editor *self, int rowCount) {
+    int x = getMapStartX(self);
+    if (x < 0) {
+        return; // keine Übersicht oder zu schmal
+    }
+    static const char classGlyphs[] = "?ZFTRB"; // in der Reihenfolge von `ByteClass`
+    NCURSES_CHECK(mvwprintw(self->win, 1, x - 1, "%s", "Map"));
+    size_t viewStart = self->start_offset;
+    size_t viewEnd = viewStart + (size_t)rowCount * (size_t)getBytesPerLine(self);
+    for (int row = 0; row < rowCount; row++) {
+        size_t start;
+        size_t end;
+        map_row_range(self, row, rowCount, &start, &end);
+        if (start >= end) {
+            continue; // weniger Bytes als Zeilen
+        }
+        ByteMapStats stats;
+        byte_map_query(self->map, start, end, &stats);
+        ByteClass byteClass = byte_map_classify(&stats);
+        char cell[EDITOR_MAP_WIDTH + 1];
+        cell[0] = classGlyphs[byteClass];
+        unsigned int entropy = byte_map_entropy(&stats) / 1000u; // ganze Bit je Byte
+        cell[1] = (byteClass == BYTE_CLASS_UNKNOWN) ? ' ' : (char)('0' + (entropy > 8u ? 8u : entropy));
+        cell[2] = '\0';
+        int visible = start < viewEnd && end > viewStart; // Zeile zeigt Teile der Ansicht
+        if (visible) {
+            NCURSES_CHECK(wattron(self->win, A_REVERSE));
+        }
+        NCURSES_CHECK(mvwprintw(self->win, row + 2, x, "%s", cell));
+        if (visible) {
+            NCURSES_CHECK(wattroff(self->win, A_REVERSE));
+        }
+    }
+}
+
+// Bereich der Datei, den eine Zeile der Übersicht zusammenfasst
+static void map_row_range(const Editor *self, int row, int rowCount, size_t *start, size_t *end) {
+    size_t size = self->buffer->size;
+    *start = (size_t)((unsigned long long)size * (unsigned long long)row / (unsigned long long)rowCount);
+    *end = (size_t)((unsigned long long)size * (unsigned long long)(row + 1) / (unsigned long long)rowCount);
+}
+
 // Positioniert den Cursor im aktiven Bereich
 static void update_editor_cursor(Editor *self) {
     int cursorY = self->cursor_y + 2; // y-Position innerhalb des Fensters
-    int cellWidth = getCellWidth(self); // Breite einer Zelle
     int asciiStartX = getAsciiStartX(self); // Start des ASCII-Bereichs
     int cursorX = (self->cursor_area == AREA_HEX)
-                      ? HEX_START_X + self->cursor_x * cellWidth
+                      ? getCellX(self, self->cursor_x)
                       : asciiStartX + self->cursor_x; // x-Position abhängig vom Bereich
     NCURSES_CHECK(wmove(self->win, cursorY, cursorX)); // Cursor setzen
 }
 
+/**
+ * @brief Ermittelt die Zeilen, die sich seit dem letzten Zeichnen geändert haben.
+ *
+ * Überschriebene Bytes betreffen nur ihre Zeilen, Einfügen und Löschen
+ * alle Zeilen ab der Änderung. Bei Auswahl und Hervorhebung werden die
+ * Zeilen des alten und des neuen Bereichs erneuert. Ist der Ausschnitt
+ * um weniger als eine Seite ganzer Zeilen verschoben, werden die
+ * gezeichneten Zeilen mitgeschoben und nur die freigelegten erneuert.
+ * Ein weiter verschobener Ausschnitt, eine andere Darstellung oder nicht
+ * mehr bekannte Änderungen erfordern das ganze Fenster.
+ *
+ * @return 1 wenn das ganze Fenster neu zu zeichnen ist, sonst 0
+ */
+static int collect_dirty_rows(Editor *self, int rowCount) {
+    const EditorDrawn *drawn = &self->drawn;
+    if (!drawn->valid || drawn->display_mode != self->display_mode ||
+        drawn->offset_width != getOffsetColWidth(self) ||
+        (self->display_mode == DISPLAY_VALUE && (drawn->value_type != self->value_type ||
+                                                 drawn->big_endian != self->big_endian))) {
+        return 1;
+    }
+    if (drawn->revision == self->buffer->revision &&
+        drawn->modified_count != change_bitmap_count(&self->buffer->modified)) {
+        return 1; // gespeichert: Hervorhebung geänderter Bytes entfällt überall
+    }
+    memset(self->dirty_rows, 0, (size_t)rowCount);
+    if (scroll_rows(self, rowCount) != 0) {
+        return 1;
+    }
+    if (collect_changes(self, self->buffer, drawn->revision, rowCount) != 0) {
+        return 1;
+    }
+    if (self->compare) {
+        if (collect_changes(self, self->compare, drawn->compare_revision, rowCount) != 0) {
+            return 1;
+        }
+    }
+    size_t selectStart = 0;
+    size_t selectEnd = 0;
+    editor_get_selection(self, &selectStart, &selectEnd);
+    if (selectStart != drawn->select_start || selectEnd != drawn->select_end) {
+        if (selectStart == selectEnd || drawn->select_start == drawn->select_end) {
+            mark_dirty_range(self, selectStart, selectEnd, rowCount); // Auswahl neu oder aufgehoben
+            mark_dirty_range(self, drawn->select_start, drawn->select_end, rowCount);
+        } else { // nur die verschobenen Enden
+            mark_dirty_between(self, selectStart, drawn->select_start, rowCount);
+            mark_dirty_between(self, selectEnd, drawn->select_end, rowCount);
+        }
+    }
+    uint64_t markBit;
+    size_t markBits;
+    shown_mark(self, &markBit, &markBits);
+    if (markBit != drawn->mark_bit || markBits != drawn->mark_bits) {
+        mark_dirty_range(self, (size_t)(markBit / 8u), (size_t)((markBit + markBits + 7u) / 8u), rowCount);
+        mark_dirty_range(self, (size_t)(drawn->mark_bit / 8u),
+                         (size_t)((drawn->mark_bit + drawn->mark_bits + 7u) / 8u), rowCount);
+    }
+    size_t valueIndex = shown_value(self);
+    if (valueIndex != drawn->value_index || self->value_edits != drawn->value_edits) {
+        mark_dirty_between(self, valueIndex, valueIndex, rowCount); // angefangene Eingabe
+        mark_dirty_between(self, drawn->value_index, drawn->value_index, rowCount);
+    }
+    return 0;
+}
+
+/**
+ * @brief Schiebt die gezeichneten Datenzeilen mit dem Ausschnitt.
+ *
+ * Verschoben wird nur der Bereich der Datenzeilen; Rahmen, Kopfzeile
+ * und Übersicht bleiben stehen. Mit `idlok` gibt `doupdate` das als
+ * Scrollen des Terminals aus, statt die Zeilen erneut zu senden. Die
+ * freigelegten Zeilen werden als neu zu zeichnen markiert.
+ *
+ * @return 0 wenn nicht oder um ganze Zeilen verschoben, -1 wenn das ganze Fenster neu zu zeichnen ist
+ */
+static int scroll_rows(Editor *self, int rowCount) {
+    size_t from = self->drawn.start_offset;
+    size_t to = self->start_offset;
+    if (from == to) {
+        return 0; // Ausschnitt unverändert
+    }
+    size_t bytesPerLine = (size_t)getBytesPerLine(self);
+    size_t distance = (to > from) ? to - from : from - to;
+    if (distance % bytesPerLine != 0 || distance / bytesPerLine >= (size_t)rowCount) {
+        return -1; // keine ganzen Zeilen oder keine gemeinsame Zeile
+    }
+    int lines = (int)(distance / bytesPerLine);
+    int shift = (to > from) ? lines : -lines; // positiv: Inhalt wandert nach oben
+    NCURSES_CHECK(wsetscrreg(self->win, 2, rowCount + 1)); // nur die Datenzeilen
+    NCURSES_CHECK(scrollok(self->win, TRUE));
+    NCURSES_CHECK(wscrl(self->win, shift));
+    NCURSES_CHECK(scrollok(self->win, FALSE)); // Ausgabe am Rand soll nicht scrollen
+    if (shift > 0) {
+        memset(self->dirty_rows + rowCount - lines, 1, (size_t)lines); // unten freigelegt
+    } else {
+        memset(self->dirty_rows, 1, (size_t)lines);                    // oben freigelegt
+    }
+    return 0;
+}
+
+/**
+ * @brief Markiert die Zeilen, die ein Buffer seit einer Revision geändert hat.
+ * @return 0 bei Erfolg, -1 wenn eine Änderung nicht mehr bekannt ist
+ */
+static int collect_changes(Editor *self, const DataBuffer *buffer, unsigned long drawnRevision,
+                           int rowCount) {
+    for (unsigned long revision = drawnRevision + 1; revision <= buffer->revision; revision++) {
+        DataBufferChange change;
+        if (data_buffer_get_change(buffer, revision, &change) != 0) {
+            return -1;
+        }
+        if (change.removed == change.added) { // überschrieben: nur diese Bytes
+            mark_dirty_range(self, change.start, change.start + change.added, rowCount);
+        } else {                              // verschoben: alles dahinter
+            mark_dirty_range(self, change.start, SIZE_MAX, rowCount);
+        }
+    }
+    return 0;
+}
+
+// Markiert die sichtbaren Zeilen, die Bytes aus [start, end) zeigen
+static void mark_dirty_range(Editor *self, size_t start, size_t end, int rowCount) {
+    size_t bytesPerLine = (size_t)getBytesPerLine(self);
+    size_t viewStart = self->start_offset;
+    size_t viewEnd = viewStart + (size_t)rowCount * bytesPerLine;
+    if (start >= end || end <= viewStart || start >= viewEnd) {
+        return; // leer oder außerhalb der Ansicht
+    }
+    size_t first = (start > viewStart) ? (start - viewStart) / bytesPerLine : 0;
+    size_t last = (end < viewEnd) ? (end - 1 - viewStart) / bytesPerLine : (size_t)rowCount - 1;
+    memset(self->dirty_rows + first, 1, last - first + 1);
+}
+
+// Markiert die Zeilen zwischen zwei Positionen, beide eingeschlossen
+static void mark_dirty_between(Editor *self, size_t a, size_t b, int rowCount) {
+    size_t low = (a < b) ? a : b;
+    size_t high = (a < b) ? b : a;
+    mark_dirty_range(self, low, (high == SIZE_MAX) ? high : high + 1, rowCount);
+}
+
+// Hervorgehobene Bitfolge, wie sie gezeichnet wird; keine, wenn sie nicht mehr gilt
+static void shown_mark(const Editor *self, uint64_t *bit, size_t *bits) {
+    int shown = self->mark_bits > 0 && self->mark_revision == self->buffer->revision;
+    *bit = shown ? self->mark_bit : 0;
+    *bits = shown ? self->mark_bits : 0;
+}
+
+// Element, dessen Zelle eine angefangene Eingabe zeigt, SIZE_MAX wenn keines
+static size_t shown_value(const Editor *self) {
+    if (self->display_mode != DISPLAY_VALUE || self->value_length == 0 ||
+        self->cursor_area != AREA_HEX) {
+        return SIZE_MAX;
+    }
+    return idx(self, self->cursor_y, self->cursor_x);
+}
+
+// Merkt sich den gezeichneten Stand für den nächsten Vergleich
+static void remember_drawn(Editor *self) {
+    EditorDrawn *drawn = &self->drawn;
+    drawn->valid = 1;
+    drawn->start_offset = self->start_offset;
+    drawn->display_mode = self->display_mode;
+    drawn->value_type = self->value_type;
+    drawn->big_endian = self->big_endian;
+    drawn->value_index = shown_value(self);
+    drawn->value_edits = self->value_edits;
+    drawn->offset_width = getOffsetColWidth(self);
+    drawn->revision = self->buffer->revision;
+    drawn->compare_revision = self->compare ? self->compare->revision : 0;
+    drawn->modified_count = change_bitmap_count(&self->buffer->modified);
+    editor_get_selection(self, &drawn->select_start, &drawn->select_end);
+    shown_mark(self, &drawn->mark_bit, &drawn->mark_bits);
+    drawn->map_stale = self->map ? self->map->stale_count : 0;
+    drawn->map_revision = self->map ? self->map->revision : 0;
+}
+
 //* ----------------------------------- Init und Deinit -----------------------------------
@@ -4,8 +4,9 @@
  *
  * Dieses Modul interpretiert sämtliche Tastatureingaben im
  * Editorfenster. Es steuert Cursorbewegung, Scrollen, Bereichswechsel
- * sowie die Eingabe von Hex- oder Binärwerten und aktualisiert bei
- * Bedarf den `DataBuffer`. Durch die Auslagerung der Eingabelogik
+ * sowie die Eingabe von Hex-, Binär- oder Zahlenwerten und aktualisiert
+ * bei Bedarf den `DataBuffer`. In der Werteansicht bewegt sich der
+ * Cursor im Datenbereich um ganze Elemente. Durch die Auslagerung der Eingabelogik
  * bleibt der eigentliche Editor-Code schlank und gut wartbar.
  */
 
@@ -22,17 +23,75 @@ static void advance_cursor(Editor *self);
 static void handle_ascii(Editor *self, int key, size_t index);
 static void handle_hex_input(Editor *self, int key, size_t index);
 static void handle_bin_input(Editor *self, int key, size_t index);
+static void handle_value_input(Editor *self, int key, size_t index);
+static void store_value(Editor *self, size_t index);
+/**
+ * @brief Sammelt die Eingabe eines Werts.
+ *
+ * Enter schreibt den Wert, hexadezimale Werte auch, sobald alle Ziffern
+ * getippt sind.
+ */
+static void handle_value_input(Editor *self, int key, size_t index) {
+    if (key == '\n' || key == '\r' || key == KEY_ENTER) {
+        if (self->value_length > 0) {
+            store_value(self, index);
+        }
+        return;
+    }
+    if (!self->strategy->is_valid_char(self, key) || self->value_length >= VALUE_TEXT_MAX - 1) {
+        return;
+    }
+    self->value_text[self->value_length++] = (char)key; // Zeichen anhängen
+    self->value_text[self->value_length] = '\0';
+    self->value_edits++;
+    int hex = (self->value_type == VALUE_X16 || self->value_type == VALUE_X32 ||
+               self->value_type == VALUE_X64);
+    if (hex && self->value_length == 2 * getElementSize(self)) {
+        store_value(self, index); // alle Ziffern eingegeben
+    }
+}
+
+/**
+ * @brief Schreibt den eingegebenen Wert in voller Elementbreite.
+ *
+ * Alle Bytes des Elements werden mit einem Aufruf überschrieben oder
+ * eingefügt und damit ein Undo-Schritt. Ungültiger Text bleibt zum
+ * Korrigieren stehen.
+ */
+static void store_value(Editor *self, size_t index) {
+    unsigned char bytes[VALUE_SIZE_MAX];
+    if (value_parse(self->value_type, self->big_endian, self->value_text, bytes) != 0) {
+        return; // nicht darstellbar, Eingabe bleibt sichtbar
+    }
+    size_t size = (size_t)getElementSize(self);
+    if (self->insert_mode) {
+        data_buffer_insert(self->buffer, index, bytes, size);
+    } else if (index < self->buffer->size) {
+        size_t end = (size - 1 < self->buffer->size - index) ? index + size : self->buffer->size;
+        unsigned char current[VALUE_SIZE_MAX];
+        data_buffer_get_range(self->buffer, index, end, current);
+        if (memcmp(current, bytes, end - index) != 0) {
+            data_buffer_overwrite(self->buffer, index, bytes, size); // nur echte Änderungen merken
+        }
+    }
+    self->value_length = 0;
+    self->value_edits++;
+    advance_cursor(self);
+}
+
 static void move_cursor_vertical(Editor *self, int deltaY, int rowCount, size_t pageBytes);
 static void move_cursor_horizontal(Editor *self, int deltaX);
 static void clamp_cursor(Editor *self);
+static void store_byte(Editor *self, size_t index, unsigned char value);
+static void track_scroll(Editor *self, size_t previous_offset);
 
 // Dispatch based key handling
 typedef void (*KeyHandlerFn)(Editor *, int, size_t);
-static const KeyHandlerFn dispatch_table[2 /*CursorArea*/][2 /*DisplayMode*/] = {
+static const KeyHandlerFn dispatch_table[2 /*CursorArea*/][3 /*DisplayMode*/] = {
     /* AREA_HEX */
-    { handle_hex_input, handle_bin_input },
+    { handle_hex_input, handle_bin_input, handle_value_input },
     /* AREA_ASCII */
-    { handle_ascii,     handle_ascii }
+    { handle_ascii,     handle_ascii,     handle_ascii }
 };
 
 //* ------------------------------------- Funktionen --------------------------------------
@@ -71,12 +130,14 @@ void editor_move_cursor(Editor *self, int deltaY, int deltaX) {
  * @param self         Editorinstanz
  * @param delta_offset Verschiebung des Startoffsets
  */
-void editor_scroll(Editor *self, int delta_offset) {
+void editor_scroll(Editor *self, long long delta_offset) {
     int rows = getmaxy(self->win) - 3;               // nutzbare Zeilen im Fenster
     size_t page = (size_t)rows * (size_t)getBytesPerLine(self); // Bytes pro Seite
+    size_t previous = self->start_offset;            // für die Scrollrichtung
 
     if (delta_offset > 0) { // nach unten scrollen
-        size_t max_offset = (self->buffer->size > page) ? self->buffer->size - page : 0; // größter gültiger Offset
+        size_t limit = getCursorLimit(self);                        // erreichbare Positionen
+        size_t max_offset = (limit > page) ? limit - page : 0;      // größter gültiger Offset
         size_t new_offset = self->start_offset + (size_t)delta_offset; // neuen Offset berechnen
         if (new_offset > max_offset) {
             new_offset = max_offset; // über Ende hinaus: auf Maximum begrenzen
@@ -91,6 +152,8 @@ void editor_scroll(Editor *self, int delta_offset) {
         }
     }
 
+    track_scroll(self, previous); // Richtung für das Vorausladen merken
+
     // Nach dem Scrollen sicherstellen, dass der Cursor gültig bleibt
     editor_move_cursor(self, 0, 0);
 }
@@ -104,31 +167,146 @@ void editor_toggle_area(Editor *self) {
     } else {
         self->cursor_area = AREA_HEX;   // zurück zum Hex-Bereich
     }
-    clamp_cursor(self); // Cursorposition validieren
+    self->strategy->reset_pending(self); // angefangene Eingabe gehört zum alten Bereich
+    clamp_cursor(self); // Cursorposition validieren, im Datenbereich auf ein Element
 }
 
 /**
  * @brief Schaltet zwischen Hex- und Binärdarstellung um.
+ *
+ * Aus der Werteansicht geht es zurück zur Hex-Darstellung.
  */
 void editor_toggle_display_mode(Editor *self) {
     size_t absoluteIndex = self->start_offset +
                            (size_t)self->cursor_y * (size_t)getBytesPerLine(self) +
                            (size_t)self->cursor_x; // aktuelle absolute Position
-    self->display_mode = (self->display_mode == DISPLAY_HEX) ? DISPLAY_BIN : DISPLAY_HEX; // Modus wechseln
+    self->display_mode = (self->display_mode == DISPLAY_BIN) ? DISPLAY_HEX : DISPLAY_BIN; // Modus wechseln
+    if (self->strategy == &VALUE_STRATEGY) {
+        self->display_mode = DISPLAY_HEX;            // Werteansicht verlassen
+    }
     self->strategy = (self->display_mode == DISPLAY_HEX) ? &HEX_STRATEGY : &BIN_STRATEGY; // passende Strategie
     self->hex_pending = -1;       // angefangene Hex-Eingabe zurücksetzen
     self->bin_pending_bits = 0;   // Bitzähler leeren
     self->bin_pending_value = 0;  // Zwischenspeicher löschen
+    self->value_length = 0;       // angefangenen Wert verwerfen
+    editor_jump_to(self, absoluteIndex); // Cursor auf dasselbe Byte setzen
+}
+
+/**
+ * @brief Zeigt den Datenbereich als Spalten von Zahlenwerten.
+ *
+ * Der Cursor bleibt auf dem Element, das das bisherige Byte enthält.
+ * Passt eine Zeile des Typs nicht in die Fensterbreite, bleibt die
+ * bisherige Darstellung.
+ *
+ * @param self       Editorinstanz
+ * @param type       Elementtyp
+ * @param big_endian 1 = höchstwertiges Byte zuerst
+ * @return 0 bei Erfolg, -1 wenn das Fenster zu schmal ist
+ */
+int editor_set_value_view(Editor *self, ValueType type, int big_endian) {
+    size_t absoluteIndex = idx(self, self->cursor_y, self->cursor_x); // aktuelle absolute Position
+    DisplayMode previousMode = self->display_mode;
+    const DisplayStrategy *previousStrategy = self->strategy;
+    ValueType previousType = self->value_type;
+    int previousOrder = self->big_endian;
+    self->display_mode = DISPLAY_VALUE;
+    self->strategy = &VALUE_STRATEGY;
+    self->value_type = type;
+    self->big_endian = big_endian;
+    if (getAsciiStartX(self) + getBytesPerLine(self) > getmaxx(self->win) - 1) {
+        self->display_mode = previousMode;           // zu schmal: alles wie vorher
+        self->strategy = previousStrategy;
+        self->value_type = previousType;
+        self->big_endian = previousOrder;
+        return -1;
+    }
+    self->hex_pending = -1;       // angefangene Eingaben der vorigen Darstellung verwerfen
+    self->bin_pending_bits = 0;
+    self->bin_pending_value = 0;
+    self->value_length = 0;
+    editor_jump_to(self, absoluteIndex); // Cursor auf das Element mit diesem Byte
+    return 0;
+}
+
+/**
+ * @brief Setzt den Cursor auf ein Byte und scrollt es bei Bedarf in die Ansicht.
+ *
+ * Liegt das Byte außerhalb der aktuellen Seite, beginnt die Ansicht mit
+ * seiner Zeile. Positionen hinter dem Ende werden auf das letzte
+ * erreichbare Byte begrenzt.
+ *
+ * @param self  Editorinstanz
+ * @param index absolute Position des Bytes
+ */
+void editor_jump_to(Editor *self, size_t index) {
+    size_t limit = getCursorLimit(self);
+    if (limit > 0 && index >= limit) {
+        index = limit - 1; // nicht hinter das Ende springen
+    }
     int bytesPerLine = getBytesPerLine(self);
     int rows = getmaxy(self->win) - 3;
     size_t pageBytes = (size_t)rows * (size_t)bytesPerLine; // Größe einer Seite
-    if (absoluteIndex < self->start_offset ||
-        absoluteIndex >= self->start_offset + pageBytes) {
-        self->start_offset = (absoluteIndex / (size_t)bytesPerLine) * (size_t)bytesPerLine; // Seite neu ausrichten
+    if (index < self->start_offset || index >= self->start_offset + pageBytes) {
+        self->start_offset = (index / (size_t)bytesPerLine) * (size_t)bytesPerLine; // Seite neu ausrichten
     }
-    size_t relative = absoluteIndex - self->start_offset; // relative Position auf Seite
+    size_t relative = index - self->start_offset; // relative Position auf Seite
     self->cursor_y = (int)(relative / (size_t)bytesPerLine);
     self->cursor_x = (int)(relative % (size_t)bytesPerLine);
+    clamp_cursor(self);
+}
+
+/**
+ * @brief Hebt eine Bitfolge hervor, etwa einen Treffer der Bitsuche.
+ *
+ * Die Hervorhebung gilt nur für den aktuellen Stand des Buffers und
+ * verschwindet mit der nächsten Änderung des Inhalts.
+ *
+ * @param self      Editorinstanz
+ * @param first_bit erstes Bit, gezählt vom höchstwertigen Bit des ersten Bytes
+ * @param bit_count Anzahl der Bits, 0 hebt die Hervorhebung auf
+ */
+void editor_mark_bits(Editor *self, uint64_t first_bit, size_t bit_count) {
+    self->mark_bit = first_bit;
+    self->mark_bits = bit_count;
+    self->mark_revision = self->buffer->revision;
+}
+
+/**
+ * @brief Beginnt eine Auswahl am Cursor oder hebt die aktive Auswahl auf.
+ *
+ * Die Auswahl reicht vom Anker bis einschließlich des Bytes unter dem
+ * Cursor und folgt jeder Cursorbewegung.
+ *
+ * @param self Editorinstanz
+ */
+void editor_toggle_selection(Editor *self) {
+    self->selecting = !self->selecting;
+    self->select_anchor = idx(self, self->cursor_y, self->cursor_x);
+}
+
+/**
+ * @brief Liefert den ausgewählten Bereich.
+ *
+ * @param self  Editorinstanz
+ * @param start erhält das erste ausgewählte Byte
+ * @param end   erhält die Position hinter dem letzten ausgewählten Byte
+ * @return 0 bei aktiver, nicht leerer Auswahl, sonst -1
+ */
+int editor_get_selection(const Editor *self, size_t *start, size_t *end) {
+    if (!self->selecting) {
+        return -1;
+    }
+    size_t cursor = idx(self, self->cursor_y, self->cursor_x);
+    size_t first = (cursor < self->select_anchor) ? cursor : self->select_anchor;
+    size_t last = (cursor < self->select_anchor) ? self->select_anchor : cursor;
+    size_t size = self->buffer->size;
+    if (first >= size) {
+        return -1; // Auswahl liegt hinter dem Ende
+    }
+    *start = first;
+    *end = (last < size) ? last + 1 : size;
+    return 0;
 }
 
 /**
@@ -146,16 +324,136 @@ void editor_reset(Editor *self) {
     self->bin_pending_bits = 0;            // Anzahl gemerkter Binärbits löschen
     self->bin_pending_value = 0;           // Zwischengespeicherten Binärwert löschen
     self->display_mode = DISPLAY_HEX;      // Standardmäßig Hexanzeige wählen
+    self->value_length = 0;                // angefangenen Wert verwerfen
     self->strategy = (self->display_mode == DISPLAY_HEX)
                        ? &HEX_STRATEGY
                        : &BIN_STRATEGY;    // passende Strategie setzen
+    self->scroll_direction = 0;            // keine Scrollbewegung bekannt
+    self->scroll_streak = 0;
+    self->mark_bits = 0;                   // keine Bitfolge hervorheben
+    self->selecting = 0;                   // keine Auswahl
+}
+
+/**
+ * @brief Zeigt die letzte Seite mit dem Cursor auf dem letzten Byte.
+ *
+ * Die letzte Zeile steht unten im Fenster, wie bei `tail -f`. Eine
+ * angefangene Eingabe bleibt erhalten.
+ *
+ * @param self Editorinstanz
+ */
+void editor_show_end(Editor *self) {
+    size_t size = self->buffer->size;
+    if (size == 0) {
+        return; // nichts anzuzeigen
+    }
+    size_t bytesPerLine = (size_t)getBytesPerLine(self);
+    int rows = getmaxy(self->win) - 3;
+    size_t lines = (size + bytesPerLine - 1) / bytesPerLine;  // Zeilen der Datei
+    size_t firstLine = (lines > (size_t)rows) ? lines - (size_t)rows : 0;
+    self->start_offset = firstLine * bytesPerLine;            // letzte Zeile unten
+    size_t relative = size - 1 - self->start_offset;
+    self->cursor_y = (int)(relative / bytesPerLine);
+    self->cursor_x = (int)(relative % bytesPerLine);
+    clamp_cursor(self);
+}
+
+/**
+ * @brief Hält die Ansicht fest, nachdem am Anfang Bytes entfernt wurden.
+ *
+ * Der Startoffset wird um die entfernten Bytes verringert, sodass
+ * weiterhin dieselben Daten sichtbar sind, solange sie noch existieren.
+ *
+ * @param self    Editorinstanz
+ * @param removed Anzahl der am Anfang entfernten Bytes
+ */
+void editor_discard_front(Editor *self, size_t removed) {
+    size_t bytesPerLine = (size_t)getBytesPerLine(self);
+    removed -= removed % bytesPerLine;      // Zeilenraster beibehalten
+    self->start_offset = (self->start_offset > removed) ? self->start_offset - removed : 0;
+    clamp_cursor(self);                     // Cursor innerhalb der Daten halten
+}
+
+/**
+ * @brief Ermittelt den Bereich, der in Scrollrichtung vorab geladen werden sollte.
+ *
+ * Jeder weitere Schritt in dieselbe Richtung verdoppelt die Anzahl der
+ * Seiten vor dem sichtbaren Bereich, bis `EDITOR_PREFETCH_MAX_STREAK`
+ * Verdopplungen erreicht sind. Schnelles Scrollen schaut so weiter voraus
+ * als einzelnes Blättern. Ohne bekannte Richtung ist der Bereich leer.
+ *
+ * @param self  Editorinstanz
+ * @param start erhält den Anfang des Bereichs
+ * @param end   erhält das Ende des Bereichs (exklusiv)
+ */
+void editor_get_prefetch_range(const Editor *self, size_t *start, size_t *end) {
+    int rows = getmaxy(self->win) - 3;                          // nutzbare Zeilen
+    size_t page = (size_t)rows * (size_t)getBytesPerLine(self); // Bytes pro Seite
+    size_t ahead = page << self->scroll_streak;                 // vorauszuladende Bytes
+    size_t size = self->buffer->size;
+
+    *start = 0;
+    *end = 0;
+    if (self->scroll_direction > 0) {                           // nach unten: hinter der Seite
+        size_t first = self->start_offset + page;
+        if (first < size) {
+            *start = first;
+            *end = (ahead < size - first) ? first + ahead : size;
+        }
+    } else if (self->scroll_direction < 0) {                    // nach oben: vor der Seite
+        *end = self->start_offset;
+        *start = (ahead < self->start_offset) ? self->start_offset - ahead : 0;
+    }
+}
+
+/**
+ * @brief Wechselt zwischen Einfüge- und Überschreibmodus.
+ */
+void editor_toggle_insert_mode(Editor *self) {
+    self->insert_mode = !self->insert_mode; // Modus umschalten
+    self->strategy->reset_pending(self);    // angefangene Eingabe verwerfen
+    clamp_cursor(self);                     // Position hinter dem Ende ggf. verlassen
+}
+
+/**
+ * @brief Löscht ein Byte und passt den Cursor an.
+ * @param self          Editorinstanz
+ * @param before_cursor 1 = Byte vor dem Cursor (Backspace), 0 = Byte unter dem Cursor
+ */
+void editor_delete_byte(Editor *self, int before_cursor) {
+    if (before_cursor && self->value_length > 0) {
+        self->value_text[--self->value_length] = '\0'; // angefangenen Wert korrigieren
+        self->value_edits++;
+        return;
+    }
+    size_t width = (size_t)getCursorStep(self);              // in der Werteansicht ein Element
+    size_t index = idx(self, self->cursor_y, self->cursor_x); // aktuelle Position
+    if (before_cursor) {
+        if (index < width) {
+            return; // vor dem ersten Element gibt es nichts zu löschen
+        }
+        index -= width;
+        move_cursor_horizontal(self, -1);             // Cursor mitbewegen
+        if (idx(self, self->cursor_y, self->cursor_x) != index) {
+            editor_move_cursor(self, -1, 0);          // am Zeilenanfang in die Zeile davor
+            self->cursor_x = getBytesPerLine(self) - (int)width;
+        }
+    }
+    data_buffer_delete(self->buffer, index, index + width); // Byte oder Element entfernen
+    self->strategy->reset_pending(self);                 // angefangene Eingabe verwerfen
+    clamp_cursor(self);                                  // Cursor im gültigen Bereich halten
 }
 
 //* ---------------------------------- Helfer Funktionen ----------------------------------
+// Schreibt ein fertig eingegebenes Byte abhängig vom Einfügemodus
+static void store_byte(Editor *self, size_t index, unsigned char value) {
+    data_buffer_type_byte(self->buffer, index, value, self->insert_mode); // ein Undo-Schritt pro Tippfolge
+}
+
 // Behandelt ASCII-Zeichen direkt als Byte
 static void handle_ascii(Editor *self, int key, size_t index) {
     if (isprint(key)) { // nur druckbare Zeichen akzeptieren
-        data_buffer_set_byte(self->buffer, index, (unsigned char)key); // Byte schreiben
+        store_byte(self, index, (unsigned char)key); // Byte schreiben
         advance_cursor(self); // Cursor weiterbewegen
     }
 }
@@ -168,7 +466,7 @@ static void handle_hex_input(Editor *self, int key, size_t index) {
         self->hex_pending = value; // ersten Nibble merken
     } else {
         unsigned char byte = (unsigned char)((self->hex_pending << 4) | value); // Byte bilden
-        data_buffer_set_byte(self->buffer, index, byte); // Byte in Buffer schreiben
+        store_byte(self, index, byte); // Byte in Buffer schreiben
         self->hex_pending = -1; // Zustand zurücksetzen
         advance_cursor(self); // Cursor zur nächsten Position bewegen
     }
@@ -182,7 +480,7 @@ static void handle_bin_input(Editor *self, int key, size_t index) {
         (unsigned char)((self->bin_pending_value << 1) | (key - '0'));
     self->bin_pending_bits++; // Bitzähler erhöhen
     if (self->bin_pending_bits == 8) { // vollständiges Byte erreicht
-        data_buffer_set_byte(self->buffer, index, self->bin_pending_value);
+        store_byte(self, index, self->bin_pending_value);
         self->bin_pending_bits = 0;    // Zähler zurücksetzen
         self->bin_pending_value = 0;   // Zwischenspeicher leeren
         advance_cursor(self);          // Cursor weiter
@@ -191,6 +489,7 @@ static void handle_bin_input(Editor *self, int key, size_t index) {
 
 static void move_cursor_vertical(Editor *self, int deltaY, int rowCount, size_t pageBytes) {
     int bytesPerLine = getBytesPerLine(self); // Bytes pro Zeile ermitteln
+    size_t previous = self->start_offset;     // für die Scrollrichtung
 
     if (deltaY < 0) { // Bewegung nach oben
         if (self->cursor_y > 0) { // innerhalb des Fensters
@@ -200,26 +499,49 @@ static void move_cursor_vertical(Editor *self, int deltaY, int rowCount, size_t
         }
     } else if (deltaY > 0) { // Bewegung nach unten
         size_t nextIndex = idx(self, self->cursor_y + 1, self->cursor_x); // Index in nächster Zeile
-        if (self->cursor_y < rowCount - 1 && nextIndex < self->buffer->size) {
+        if (self->cursor_y < rowCount - 1 && nextIndex < getCursorLimit(self)) {
             self->cursor_y++; // Zeile nach unten
-        } else if (self->start_offset + pageBytes < self->buffer->size) {
+        } else if (self->start_offset + pageBytes < getCursorLimit(self)) {
             self->start_offset += (size_t)bytesPerLine; // eine Seite nach unten scrollen
         }
     }
+    track_scroll(self, previous); // Richtung für das Vorausladen merken
+}
+
+/**
+ * @brief Merkt sich Richtung und Serie der Scrollbewegungen.
+ *
+ * Bleibt der Startoffset gleich, ändert sich nichts. Ein Richtungswechsel
+ * beginnt eine neue Serie.
+ */
+static void track_scroll(Editor *self, size_t previous_offset) {
+    if (self->start_offset == previous_offset) {
+        return; // Ansicht nicht bewegt
+    }
+    int direction = (self->start_offset > previous_offset) ? 1 : -1;
+    if (direction == self->scroll_direction) {
+        if (self->scroll_streak < EDITOR_PREFETCH_MAX_STREAK) {
+            self->scroll_streak++; // gleiche Richtung: weiter vorausschauen
+        }
+    } else {
+        self->scroll_direction = direction; // neue Richtung
+        self->scroll_streak = 1;
+    }
 }
 
 static void move_cursor_horizontal(Editor *self, int deltaX) {
     int bytesPerLine = getBytesPerLine(self); // Bytes pro Zeile ermitteln
+    int step = getCursorStep(self);           // ein Byte oder ein Element
 
     // Wechsel zwischen Hex- und ASCII-Bereich per Pfeiltasten vermeiden
     if (deltaX < 0) { // nach links
-        if (self->cursor_x > 0) { // nicht über Zeilenanfang hinaus
-            self->cursor_x--;
+        if (self->cursor_x >= step) { // nicht über Zeilenanfang hinaus
+            self->cursor_x -= step;
         }
     } else if (deltaX > 0) { // nach rechts
-        size_t nextIndex = idx(self, self->cursor_y, self->cursor_x + 1); // Index rechts
-        if (self->cursor_x < bytesPerLine - 1 && nextIndex < self->buffer->size) {
-            self->cursor_x++; // Cursor verschieben
+        size_t nextIndex = idx(self, self->cursor_y, self->cursor_x + step); // Index rechts
+        if (self->cursor_x < bytesPerLine - step && nextIndex < getCursorLimit(self)) {
+            self->cursor_x += step; // Cursor verschieben
         }
     }
 
@@ -229,13 +551,24 @@ static void move_cursor_horizontal(Editor *self, int deltaX) {
 
 static void clamp_cursor(Editor *self) {
     size_t lineBytes = 0;
-    size_t lineStart = idx(self, self->cursor_y, 0); // Startindex der aktuellen Zeile
+    size_t limit = getCursorLimit(self);             // erreichbare Positionen
 
     // Anzahl der pro Zeile darstellbaren Bytes ermitteln
     size_t maxPerLine = (size_t)getBytesPerLine(self);
 
-    if (lineStart < self->buffer->size) { // es gibt Daten in dieser Zeile
-        lineBytes = self->buffer->size - lineStart; // verbleibende Bytes bestimmen
+    // Nach dem Löschen kann die Ansicht hinter dem Dateiende liegen
+    while (self->start_offset > 0 && self->start_offset >= limit) {
+        self->start_offset = (self->start_offset > maxPerLine)
+                                 ? self->start_offset - maxPerLine
+                                 : 0;                // eine Zeile zurück
+    }
+    while (self->cursor_y > 0 && idx(self, self->cursor_y, 0) >= limit) {
+        self->cursor_y--;                            // Cursor auf letzte Datenzeile
+    }
+    size_t lineStart = idx(self, self->cursor_y, 0); // Startindex der aktuellen Zeile
+
+    if (lineStart < limit) { // es gibt Daten in dieser Zeile
+        lineBytes = limit - lineStart; // verbleibende Bytes bestimmen
         if (lineBytes > maxPerLine) {
             lineBytes = maxPerLine; // auf Zeilenbreite begrenzen
         }
@@ -244,17 +577,19 @@ static void clamp_cursor(Editor *self) {
         // Cursor am Ende der vorhandenen Daten positionieren
         self->cursor_x = (lineBytes == 0) ? 0 : (int)lineBytes - 1;
     }
+    self->cursor_x -= self->cursor_x % getCursorStep(self); // auf den Anfang eines Elements
 }
 
 // Cursor nach rechts verschieben und am Zeilenende einen Zeilenumbruch auslösen
 static void advance_cursor(Editor *self) {
     int bytesPerLine = getBytesPerLine(self); // Anzahl Bytes pro Zeile
-    size_t nextIndex = idx(self, self->cursor_y, self->cursor_x + 1); // Index des nächsten Bytes
+    int step = getCursorStep(self);           // ein Byte oder ein Element
+    size_t nextIndex = idx(self, self->cursor_y, self->cursor_x + step); // Index des nächsten Elements
 
-    if (self->cursor_x < bytesPerLine - 1 && nextIndex < self->buffer->size) {
+    if (self->cursor_x < bytesPerLine - step && nextIndex < getCursorLimit(self)) {
         // Innerhalb derselben Zeile einen Schritt nach rechts gehen
-        self->cursor_x++;
-    } else if (nextIndex < self->buffer->size) {
+        self->cursor_x += step;
+    } else if (nextIndex < getCursorLimit(self)) {
         // Am Zeilenende: zur nächsten Zeile springen, wenn noch Daten folgen
         int rowCount = getmaxy(self->win) - 3;                           // nutzbare Zeilen im Fenster
         size_t pageBytes = (size_t)rowCount * (size_t)bytesPerLine;       // Bytes pro Seite
@@ -12,52 +12,241 @@
  */
 
 //* -------------------------------------- Includes ---------------------------------------
+#include <stdint.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+#include "Dump_Export.h"
 #include "File_Manager.h"
 #include "Main_Controller.h"
+#include "Patch_File.h"
 
 /**
  * @brief Fragt den Benutzer nach einem gültigen Pfad.
  */
 static void request_valid_path(char *path, size_t size);
 
+/**
+ * @brief Fragt den Nutzer nach einem Zielpfad zum Speichern.
+ */
+static void request_save_path(char *path, size_t size);
+
+/**
+ * @brief Liest eine Größenangabe in Megabyte.
+ */
+static int parse_megabytes(const char *text, size_t *outBytes);
+
+/**
+ * @brief Liest die höchste Bildrate.
+ */
+static int parse_fps(const char *text, int *outFps);
+
+/**
+ * @brief Liest einen Bereich `a:b`.
+ */
+static int parse_range(const char *text, size_t *outStart, size_t *outEnd);
+
+/**
+ * @brief Gibt die Aufrufsyntax aus.
+ */
+static void print_usage(const char *program);
+
 //* ---------------------------- Globale Konstanten oder Defines --------------------------
+#define CACHE_MB_OPTION "--cache-mb" /**< Budget des Block-Caches in MiB */
+#define RING_MB_OPTION "--ring-mb"   /**< Datenströme: nur die letzten MiB behalten */
+#define PRELOAD_OPTION "--preload"   /**< Datei im Hintergrund komplett einlesen */
+#define MMAP_OPTION "--mmap"         /**< Datei einblenden statt über den Block-Cache lesen */
+#define UNDO_MB_OPTION "--undo-mb"   /**< Speicherbudget des Undo-Journals in MiB */
+#define FOLLOW_OPTION "--follow"     /**< Ansicht am Ende wachsender Dateien halten */
+#define SIGNATURES_OPTION "--signatures" /**< Signaturdatei für die Suche im Hintergrund */
+#define COLOR_OPTION "--color"       /**< Bytes nach Byteklasse einfärben */
+#define DUMP_OPTION "--dump"         /**< Bereich ohne Oberfläche formatiert ausgeben */
+#define RANGE_OPTION "--range"       /**< `--dump`: Bereich `a:b` */
+#define FORMAT_OPTION "--format"     /**< `--dump`: xxd, c, base64, ihex oder srec */
+#define APPLY_PATCH_OPTION "--apply-patch" /**< IPS-, BPS- oder Listenpatch ohne Oberfläche anwenden */
+#define FPS_OPTION "--fps"           /**< höchstens so viele Bilder je Sekunde, 0 = unbegrenzt */
 
 //* ------------------------------------- Funktionen --------------------------------------
 /**
  * @brief Startet das Programm und verwaltet den Lebenszyklus.
  *
  * Das Programm erwartet optional einen Dateipfad. Ist dieser ungültig,
- * wird der Nutzer nach einem korrekten Pfad gefragt. Anschließend
- * wird der Controller initialisiert und ausgeführt.
+ * wird der Nutzer nach einem korrekten Pfad gefragt. Mit
+ * `--cache-mb <MiB>` erhält der Block-Cache dieses Speicherbudget,
+ * `--mmap` blendet reguläre Dateien stattdessen ein. `-` liest die
+ * Standardeingabe; Pipes und Zeichengeräte werden ebenfalls als
+ * Datenstrom empfangen, bei `--ring-mb <MiB>` bleiben davon nur die
+ * jüngsten Bytes erhalten. `--preload` liest die Datei im Hintergrund
+ * vollständig in den Speicher. `--undo-mb <MiB>` begrenzt den Speicher
+ * für Rückgängig und Wiederholen. `--follow` hält die Ansicht wie
+ * `tail -f` am Ende, während die Datei wächst. `--signatures <Datei>`
+ * durchsucht den Inhalt im Hintergrund nach allen Signaturen der Datei.
+ * `--color` färbt die Bytes nach ihrer Byteklasse ein. `--dump` gibt die
+ * Datei ohne Oberfläche formatiert auf der Standardausgabe aus, mit
+ * `--range a:b` nur einen Bereich und mit `--format` im gewählten Format.
+ * `--apply-patch <Patch>` schreibt einen Patch ohne Oberfläche an Ort
+ * und Stelle in die Datei. `--fps <n>` begrenzt die Bildrate der Anzeige.
+ * Ein zweiter Pfad öffnet den Vergleichsmodus. Anschließend wird der Controller initialisiert
+ * und ausgeführt.
  *
  * @param argc Anzahl der Argumente
  * @param argv Argumentfeld
  * @return 0 bei Erfolg, sonst 1
  */
 int main(int argc, char *argv[]) {
-    char file_path[256]; // Speicher für den Dateipfad
+    char file_path[256];          // Speicher für den Dateipfad
+    const char *path_arg = NULL;  // Pfad aus den Argumenten
+    const char *compare_arg = NULL; // zweiter Pfad: Vergleichsdatei
+    DataSourceOptions options = {0}; // 0 = Vorgabebudget, Ströme vollständig behalten
+    int follow = 0;               // Ansicht am Dateiende halten
+    const char *signatures_arg = NULL; // Signaturdatei
+    int colors = 0;               // Bytes nach Byteklasse einfärben
+    int dump = 0;                 // nur formatiert ausgeben
+    size_t dump_start = 0;        // Bereich für die Ausgabe
+    size_t dump_end = DUMP_RANGE_END;
+    DumpFormat dump_format = DUMP_XXD;
+    const char *patch_arg = NULL; // Patch, der ohne Oberfläche angewendet wird
+    int fps = CONTROLLER_DEFAULT_FPS; // höchste Bildrate
+
+    // Optionen und Pfad aus den Argumenten lesen
+    for (int i = 1; i < argc; i++) {
+        size_t *budget = NULL;    // Ziel einer Größenoption
+        if (strcmp(argv[i], PRELOAD_OPTION) == 0) {
+            options.preload = 1;
+            continue;
+        }
+        if (strcmp(argv[i], MMAP_OPTION) == 0) {
+            options.mmap = 1;
+            continue;
+        }
+        if (strcmp(argv[i], FOLLOW_OPTION) == 0) {
+            follow = 1;
+            continue;
+        }
+        if (strcmp(argv[i], COLOR_OPTION) == 0) {
+            colors = 1;
+            continue;
+        }
+        if (strcmp(argv[i], DUMP_OPTION) == 0) {
+            dump = 1;
+            continue;
+        }
+        if (strcmp(argv[i], RANGE_OPTION) == 0 || strcmp(argv[i], FORMAT_OPTION) == 0) {
+            int valid = (i + 1 < argc);
+            if (valid && strcmp(argv[i], RANGE_OPTION) == 0) {
+                valid = parse_range(argv[i + 1], &dump_start, &dump_end) == 0;
+            } else if (valid) {
+                valid = dump_format_parse(argv[i + 1], &dump_format) == 0;
+            }
+            if (!valid) {
+                print_usage(argv[0]);
+                return 1;
+            }
+            i++;                  // Wert überspringen
+            continue;
+        }
+        if (strcmp(argv[i], SIGNATURES_OPTION) == 0 && i + 1 < argc) {
+            signatures_arg = argv[++i];
+            continue;
+        }
+        if (strcmp(argv[i], FPS_OPTION) == 0) {
+            if (i + 1 >= argc || parse_fps(argv[i + 1], &fps) != 0) {
+                print_usage(argv[0]);
+                return 1;
+            }
+            i++;                  // Wert überspringen
+            continue;
+        }
+        if (strcmp(argv[i], APPLY_PATCH_OPTION) == 0) {
+            if (i + 1 >= argc) {
+                print_usage(argv[0]);
+                return 1;
+            }
+            patch_arg = argv[++i];
+            continue;
+        }
+        if (strcmp(argv[i], CACHE_MB_OPTION) == 0) {
+            budget = &options.cache_budget;
+        } else if (strcmp(argv[i], RING_MB_OPTION) == 0) {
+            budget = &options.ring_budget;
+        } else if (strcmp(argv[i], UNDO_MB_OPTION) == 0) {
+            budget = &options.undo_budget;
+        }
+        if (budget) {
+            if (i + 1 >= argc || parse_megabytes(argv[i + 1], budget) != 0) {
+                print_usage(argv[0]);
+                return 1;
+            }
+            i++;                  // Wert überspringen
+        } else if (!path_arg) {
+            path_arg = argv[i];   // erstes freies Argument ist der Pfad
+        } else if (!compare_arg) {
+            compare_arg = argv[i]; // zweites freies Argument ist die Vergleichsdatei
+        }
+    }
+    if (dump) {
+        // Ohne Oberfläche: formatieren, ausgeben, fertig
+        if (!path_arg) {
+            print_usage(argv[0]);
+            return 1;
+        }
+        fflush(stdout);
+        if (dump_export(path_arg, dump_start, dump_end, dump_format, fileno(stdout)) != 0) {
+            fprintf(stderr, "Cannot dump %s\n", path_arg);
+            return 1;
+        }
+        return 0;
+    }
+    if (patch_arg) {
+        // Ohne Oberfläche: nur die berührten Bereiche der Datei schreiben
+        if (!path_arg) {
+            print_usage(argv[0]);
+            return 1;
+        }
+        int result = patch_apply(patch_arg, path_arg);
+        if (result == PATCH_UNSUPPORTED) {
+            fprintf(stderr, "Patch %s does not fit %s\n", patch_arg, path_arg);
+            return 1;
+        }
+        if (result != 0) {
+            fprintf(stderr, "Cannot apply patch %s to %s\n", patch_arg, path_arg);
+            return 1;
+        }
+        return 0;
+    }
+    if (compare_arg && !file_exists(compare_arg)) {
+        printf("Cannot open file to compare: %s\n", compare_arg);
+        return 1;
+    }
 
     // Pfad aus Argumenten verwenden oder vom Nutzer anfordern
-    if (argc >= 2 && file_exists(argv[1])) {
-        strncpy(file_path, argv[1], sizeof(file_path) - 1); // Argument kopieren
-        file_path[sizeof(file_path) - 1] = '\0';            // String terminieren
+    if (path_arg && (strcmp(path_arg, STDIN_PATH) == 0 || file_exists(path_arg))) {
+        strncpy(file_path, path_arg, sizeof(file_path) - 1); // Argument kopieren
+        file_path[sizeof(file_path) - 1] = '\0';             // String terminieren
     } else {
         request_valid_path(file_path, sizeof(file_path));   // gültigen Pfad anfordern
     }
 
     // Controller anlegen und initialisieren
     Main_Controller controller;
-    if (main_controller_init(&controller, file_path) != 0) {
+    if (main_controller_init(&controller, file_path, compare_arg, &options) != 0) {
         return 1; // Start fehlgeschlagen
     }
+    main_controller_set_follow(&controller, follow);
+    main_controller_set_fps(&controller, fps);
+    if (colors) {
+        main_window_enable_colors(&controller.view); // ohne Farbunterstützung einfach schwarzweiß
+    }
+    if (signatures_arg) {
+        main_controller_load_signatures(&controller, signatures_arg); // Fehler stehen in der Statusleiste
+    }
 
     // Hauptschleife ausführen
     int run_result = main_controller_run(&controller);
 
     // Status des Buffers sichern
     int unsaved_changes = controller.buffer.edited;          // ungespeicherte Änderungen
+    int is_stream = data_buffer_is_stream(&controller.buffer); // kein Zurückschreiben möglich
     int ever_changed = controller.buffer.ever_changed;       // ob jemals geändert wurde
     char final_path[256];
     strncpy(final_path, controller.file_path, sizeof(final_path) - 1); // Pfad sichern
@@ -71,16 +260,22 @@ int main(int argc, char *argv[]) {
         printf("Would you like to save the file? Press Y to save or N to discard: ");
         int answer = getchar();       // erste Eingabe lesen
         getchar();                    // nachfolgendes Newline entfernen
-        if (answer == 'y' || answer == 'Y') {
+        if ((answer == 'y' || answer == 'Y') && is_stream) {
+            request_save_path(final_path, sizeof(final_path)); // Strom braucht ein Ziel
+            if (data_buffer_save_as(&controller.buffer, final_path) == 0) {
+                unsaved_changes = 0; // Änderungen gespeichert
+            }
+        } else if (answer == 'y' || answer == 'Y') {
             if (data_buffer_save_file(&controller.buffer, final_path) == 0) {
                 unsaved_changes = 0; // Änderungen gespeichert
+            } else {
+                printf("%s changed on disk, not overwritten\n", final_path);
             }
         }
     }
 
-    // Buffer freigeben
-    data_buffer_deinit(&controller.buffer);
-    memset(&controller, 0, sizeof(controller));
+    // Buffer, Überwachung und Indizes freigeben
+    main_controller_deinit(&controller);
 
     // Abschließenden Status der Datei ermitteln
     const char *final_text;
@@ -128,4 +323,108 @@ static void request_valid_path(char *path, size_t size) {
     }
 }
 
+/**
+ * @brief Fragt den Nutzer nach einem Zielpfad zum Speichern.
+ *
+ * Wird für Datenströme genutzt, die nicht an ihren Ursprung
+ * zurückgeschrieben werden können.
+ */
+static void request_save_path(char *path, size_t size) {
+    do {
+        printf("Save to path: ");
+        if (!fgets(path, size, stdin)) {
+            clearerr(stdin);               /* Fehlerzustand zurücksetzen */
+            path[0] = '\0';
+            continue;                     /* neue Eingabe anfordern */
+        }
+        path[strcspn(path, "\n")] = '\0';  /* Newline entfernen */
+    } while (path[0] == '\0');
+}
+
+/**
+ * @brief Liest eine positive Größenangabe in Megabyte.
+ * @param text     Zeichenkette mit der Zahl
+ * @param outBytes erhält die Größe in Bytes
+ * @return 0 bei Erfolg, sonst -1
+ */
+static int parse_megabytes(const char *text, size_t *outBytes) {
+    char *end = NULL;
+    unsigned long long megabytes = strtoull(text, &end, 10);
+    if (end == text || *end != '\0' || megabytes == 0 ||
+        megabytes > (unsigned long long)SIZE_MAX / (1024ull * 1024ull)) {
+        return -1; // keine gültige Zahl
+    }
+    *outBytes = (size_t)megabytes * 1024u * 1024u;
+    return 0;
+}
+
+/**
+ * @brief Liest die höchste Bildrate.
+ * @param text   Zeichenkette mit der Zahl
+ * @param outFps erhält die Bilder je Sekunde, 0 = unbegrenzt
+ * @return 0 bei Erfolg, sonst -1
+ */
+static int parse_fps(const char *text, int *outFps) {
+    char *end = NULL;
+    unsigned long fps = strtoul(text, &end, 10);
+    if (end == text || *end != '\0' || fps > 1000) {
+        return -1; // keine gültige Zahl
+    }
+    *outFps = (int)fps;
+    return 0;
+}
+
+/**
+ * @brief Liest einen Bereich `a:b` mit dezimalen oder `0x`-Grenzen.
+ *
+ * `b` liegt hinter dem letzten Byte; fehlt eine Grenze, gilt Dateianfang
+ * bzw. Dateiende.
+ *
+ * @param text     Zeichenkette mit dem Bereich
+ * @param outStart erhält das erste Byte
+ * @param outEnd   erhält das Ende oder `DUMP_RANGE_END`
+ * @return 0 bei Erfolg, sonst -1
+ */
+static int parse_range(const char *text, size_t *outStart, size_t *outEnd) {
+    const char *colon = strchr(text, ':');
+    if (!colon) {
+        return -1;
+    }
+    char *end = NULL;
+    unsigned long long start = 0;
+    unsigned long long stop = DUMP_RANGE_END;
+    if (colon != text) {
+        start = strtoull(text, &end, 0);
+        if (end != colon) {
+            return -1;
+        }
+    }
+    if (colon[1] != '\0') {
+        stop = strtoull(colon + 1, &end, 0);
+        if (*end != '\0' || stop < start) {
+            return -1;
+        }
+    }
+    if (start > (unsigned long long)SIZE_MAX || stop > (unsigned long long)SIZE_MAX) {
+        return -1;
+    }
+    *outStart = (size_t)start;
+    *outEnd = (size_t)stop;
+    return 0;
+}
+
+/**
+ * @brief Gibt die Aufrufsyntax aus.
+ * @param program Name des Programms
+ */
+static void print_usage(const char *program) {
+    printf("Usage: %s [%s] [%s] [%s] [%s] [%s <MiB>] [%s <MiB>] [%s <MiB>] [%s <file>] [%s <n>] "
+           "[file | -] [compare]\n",
+           program, PRELOAD_OPTION, MMAP_OPTION, FOLLOW_OPTION, COLOR_OPTION, CACHE_MB_OPTION,
+           RING_MB_OPTION, UNDO_MB_OPTION, SIGNATURES_OPTION, FPS_OPTION);
+    printf("       %s %s [%s a:b] [%s xxd|c|base64|ihex|srec] <file | ->\n",
+           program, DUMP_OPTION, RANGE_OPTION, FORMAT_OPTION);
+    printf("       %s %s <patch.ips | patch.bps | list> <file>\n", program, APPLY_PATCH_OPTION);
+}
+
 //* ----------------------------------- Init und Deinit -----------------------------------